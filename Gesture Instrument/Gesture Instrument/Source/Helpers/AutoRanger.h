@@ -0,0 +1,113 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "HandData.h"
+
+// The bounds every axis is normalised against, in sensor mm
+struct PlayArea {
+    float minX = -200.0f, maxX = 200.0f;
+    float minY = 150.0f, maxY = 450.0f;
+    float minZ = -150.0f, maxZ = 150.0f;
+
+    bool operator==(const PlayArea& other) const {
+        return minX == other.minX && maxX == other.maxX
+            && minY == other.minY && maxY == other.maxY
+            && minZ == other.minZ && maxZ == other.maxZ;
+    }
+
+    bool operator!=(const PlayArea& other) const { return !(*this == other); }
+};
+
+// Slowly follows where the hands actually play so the bounds track a performer who drifts during a set.
+// Each axis keeps a decaying estimate of the low and high tail of recent palm positions, a stochastic quantile
+// step per sensor frame, and the bounds walk towards those estimates no faster than the speed limit.
+// O(1) per frame, runs on the Leap thread and the audio thread normalises with the area it publishes
+class AutoRanger {
+public:
+    // How far a bound may move per second, in mm
+    void setMaxSpeed(float mmPerSecond) { maxSpeed = juce::jmax(0.0f, mmPerSecond); }
+
+    // Roughly how many seconds of playing the estimates remember
+    void setTimeConstant(float seconds) { timeConstant = juce::jmax(1.0f, seconds); }
+
+    // Starts again from the given bounds, used when enabled and whenever the performer sets the area by hand
+    void reset(const PlayArea& start) {
+        axes[0].reset(start.minX, start.maxX);
+        axes[1].reset(start.minY, start.maxY);
+        axes[2].reset(start.minZ, start.maxZ);
+        area = start;
+    }
+
+    void process(const HandData& left, const HandData& right, float deltaSeconds) {
+        if (!left.isPresent && !right.isPresent) return;
+
+        // Both hands share the area, each one present gets an equal share of the frame
+        float share = (left.isPresent && right.isPresent) ? 0.5f : 1.0f;
+        float rate = juce::jlimit(0.0f, 1.0f, deltaSeconds * share / timeConstant);
+        float maxStep = maxSpeed * deltaSeconds;
+
+        for (const auto* hand : { &left, &right }) {
+            if (!hand->isPresent) continue;
+
+            axes[0].track(hand->currentHandPositionX, rate);
+            axes[1].track(hand->currentHandPositionY, rate);
+            axes[2].track(hand->currentHandPositionZ, rate);
+        }
+
+        // Same limits as the threshold sliders, low bounds stay below the middle of the room and high above
+        area.minX = axes[0].stepLow(area.minX, maxStep, -350.0f, 0.0f);
+        area.maxX = axes[0].stepHigh(area.maxX, maxStep, 0.0f, 350.0f);
+        area.minY = axes[1].stepLow(area.minY, maxStep, 50.0f, 275.0f);
+        area.maxY = axes[1].stepHigh(area.maxY, maxStep, 275.0f, 500.0f);
+        area.minZ = axes[2].stepLow(area.minZ, maxStep, -225.0f, 0.0f);
+        area.maxZ = axes[2].stepHigh(area.maxZ, maxStep, 0.0f, 225.0f);
+    }
+
+    const PlayArea& getArea() const { return area; }
+
+private:
+    // Share of positions left outside each end of the area
+    static constexpr float tailFraction = 0.05f;
+    static constexpr float minSpan = 60.0f;
+
+    // Tail steps are small, this brings the estimates to a new spread in about one time constant
+    static constexpr float trackingGain = 4.0f;
+
+    struct Axis {
+        float low = 0.0f;
+        float high = 0.0f;
+
+        void reset(float lowBound, float highBound) {
+            low = lowBound;
+            high = highBound;
+        }
+
+        // Step size follows the current spread so the estimate moves the same share of the area on any scale
+        void track(float x, float rate) {
+            float step = juce::jmax(high - low, minSpan) * rate * trackingGain;
+
+            low += (x < low) ? -step * (1.0f - tailFraction) : step * tailFraction;
+            high += (x > high) ? step * (1.0f - tailFraction) : -step * tailFraction;
+
+            if (high - low < minSpan) {
+                float centre = (low + high) / 2.0f;
+                low = centre - minSpan / 2.0f;
+                high = centre + minSpan / 2.0f;
+            }
+        }
+
+        float stepLow(float current, float maxStep, float lowest, float highest) const {
+            return juce::jlimit(lowest, highest, current + juce::jlimit(-maxStep, maxStep, low - current));
+        }
+
+        float stepHigh(float current, float maxStep, float lowest, float highest) const {
+            return juce::jlimit(lowest, highest, current + juce::jlimit(-maxStep, maxStep, high - current));
+        }
+    };
+
+    Axis axes[3];
+    PlayArea area;
+
+    float maxSpeed = 10.0f;
+    float timeConstant = 30.0f;
+};
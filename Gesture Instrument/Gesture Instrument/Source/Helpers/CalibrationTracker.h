@@ -0,0 +1,61 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "HandData.h"
+#include "P2Quantile.h"
+
+// The play area calibration has found so far, in sensor mm
+struct CalibrationBounds {
+    float minX = 0.0f, maxX = 0.0f;
+    float minY = 0.0f, maxY = 0.0f;
+    float minZ = 0.0f, maxZ = 0.0f;
+    int numSamples = 0;
+    int session = 0;
+};
+
+// Finds the play area from every palm position seen during calibration.
+// Each axis keeps a low and a high percentile rather than the raw min and max, so a single glitched frame
+// or a hand leaving the sensor's edge can't stretch the box. Runs on the Leap thread, once per sensor frame
+class CalibrationTracker {
+public:
+    // Percent of samples ignored at each edge, 2 keeps the 2nd to 98th percentile
+    void reset(float trimPercent) {
+        float trim = juce::jlimit(0.0f, 49.0f, trimPercent) / 100.0f;
+
+        for (int axis = 0; axis < 3; ++axis) {
+            lower[axis].reset(trim);
+            upper[axis].reset(1.0f - trim);
+        }
+    }
+
+    void addHand(const HandData& hand) {
+        if (!hand.isPresent) return;
+
+        const float position[3] = { hand.currentHandPositionX, hand.currentHandPositionY, hand.currentHandPositionZ };
+        for (int axis = 0; axis < 3; ++axis) {
+            lower[axis].add(position[axis]);
+            upper[axis].add(position[axis]);
+        }
+    }
+
+    int getNumSamples() const { return lower[0].getCount(); }
+
+    // Limited to the room the stage can show
+    CalibrationBounds getBounds() const {
+        CalibrationBounds bounds;
+        bounds.numSamples = getNumSamples();
+        if (bounds.numSamples == 0) return bounds;
+
+        bounds.minX = juce::jmax(-350.0f, lower[0].get());
+        bounds.maxX = juce::jmin(350.0f, upper[0].get());
+        bounds.minY = juce::jmax(50.0f, lower[1].get());
+        bounds.maxY = juce::jmin(500.0f, upper[1].get());
+        bounds.minZ = juce::jmax(-225.0f, lower[2].get());
+        bounds.maxZ = juce::jmin(225.0f, upper[2].get());
+        return bounds;
+    }
+
+private:
+    P2Quantile lower[3];
+    P2Quantile upper[3];
+};
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <cmath>
+#include "HandData.h"
+#include "OneEuroFilter.h"
+
+// One Euro filtering for every finger joint of a hand, kept as flat arrays so the update is one loop over 60 floats
+class FingerFilterBank {
+public:
+    static constexpr int coordsPerFinger = 12;
+    static constexpr int numCoords = 5 * coordsPerFinger;
+
+    FingerFilterBank() { setParameters(1.0f, 0.01f); }
+
+    // Same units as the palm bank, Hz at rest and Hz per mm/s
+    void setParameters(float minCutoffHz, float jointBeta) {
+        minCutoff = minCutoffHz;
+        beta = jointBeta;
+    }
+
+    void reset() { isInitialised = false; }
+
+    void process(HandData& hand, float deltaSeconds) {
+        if (!hand.isPresent) {
+            reset();
+            return;
+        }
+
+        gather(hand);
+
+        if (!isInitialised) {
+            for (int i = 0; i < numCoords; ++i) {
+                smoothed[i] = raw[i];
+                lastRaw[i] = raw[i];
+                derivative[i] = 0.0f;
+            }
+            isInitialised = true;
+            return;
+        }
+
+        if (deltaSeconds <= 0.0f) {
+            scatter(hand);
+            return;
+        }
+
+        const float derivativeAlpha = getLowPassAlpha(derivativeCutoffHz, deltaSeconds);
+        const float inverseDelta = 1.0f / deltaSeconds;
+        const float omega = juce::MathConstants<float>::twoPi * deltaSeconds;
+
+        // Branch free so the compiler can vectorise it
+        for (int i = 0; i < numCoords; ++i) {
+            float rawDerivative = (raw[i] - lastRaw[i]) * inverseDelta;
+            derivative[i] += (rawDerivative - derivative[i]) * derivativeAlpha;
+
+            float cutoff = minCutoff + beta * std::abs(derivative[i]);
+            float alpha = 1.0f - std::exp(-omega * cutoff);
+
+            smoothed[i] += (raw[i] - smoothed[i]) * alpha;
+            lastRaw[i] = raw[i];
+        }
+
+        scatter(hand);
+    }
+
+private:
+    static constexpr float derivativeCutoffHz = 1.0f;
+
+    float minCutoff = 1.0f;
+    float beta = 0.01f;
+    bool isInitialised = false;
+
+    alignas(16) float raw[numCoords] = {};
+    alignas(16) float lastRaw[numCoords] = {};
+    alignas(16) float derivative[numCoords] = {};
+    alignas(16) float smoothed[numCoords] = {};
+
+    static constexpr float FingerData::* coordMembers[coordsPerFinger] = {
+        &FingerData::tipX, &FingerData::tipY, &FingerData::tipZ,
+        &FingerData::joint1X, &FingerData::joint1Y, &FingerData::joint1Z,
+        &FingerData::joint2X, &FingerData::joint2Y, &FingerData::joint2Z,
+        &FingerData::knuckleX, &FingerData::knuckleY, &FingerData::knuckleZ
+    };
+
+    void gather(const HandData& hand) {
+        for (int f = 0; f < 5; ++f)
+            for (int c = 0; c < coordsPerFinger; ++c)
+                raw[f * coordsPerFinger + c] = hand.fingers[f].*coordMembers[c];
+    }
+
+    void scatter(HandData& hand) const {
+        for (int f = 0; f < 5; ++f)
+            for (int c = 0; c < coordsPerFinger; ++c)
+                hand.fingers[f].*coordMembers[c] = smoothed[f * coordsPerFinger + c];
+    }
+};
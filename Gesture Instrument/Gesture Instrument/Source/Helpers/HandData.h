@@ -1,5 +1,8 @@
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+
 struct FingerData {
     int type = 0;
     float tipX = 0.0f, tipY = 0.0f, tipZ = 0.0f;
@@ -20,4 +23,25 @@ struct HandData {
     bool isPresent = false;
 
     FingerData fingers[5];
+
+    // Sensor frame stamp, so the estimator can tell a new frame from a repeated one
+    long long frameId = 0;
+    double frameTimeSeconds = 0.0;
+
+    // Host clock in seconds when the sensor took the frame, for latency measurements
+    double captureSeconds = 0.0;
+
+    // Host clock when LeapService received the frame and when the Leap thread handed it to the audio thread
+    double receivedSeconds = 0.0;
+    double publishedSeconds = 0.0;
+
+    // Palm velocity in mm/s, filled in by the estimator on the audio thread
+    float velocityX = 0.0f;
+    float velocityY = 0.0f;
+    float velocityZ = 0.0f;
+
+    float getPalmSpeed() const { return std::sqrt(velocityX * velocityX + velocityY * velocityY + velocityZ * velocityZ); }
+
+    // 0-1 for mapping, 1 m/s is full scale
+    float getNormalisedSpeed() const { return std::min(1.0f, getPalmSpeed() / 1000.0f); }
 };
\ No newline at end of file
@@ -0,0 +1,204 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <cmath>
+#include "HandData.h"
+
+// Constant acceleration Kalman filter over the palm and fingertips of one hand.
+// Every coordinate is its own position / velocity / acceleration track, so the 3x3 covariance is kept as six flat arrays
+class HandKalmanEstimator {
+public:
+    static constexpr int numCoords = 18; // palm xyz, then the five tips xyz
+
+    HandKalmanEstimator() { setNoise(defaultJerkNoise, defaultMeasurementNoise); }
+
+    // Jerk spectral density in (mm/s^3)^2 per Hz and sensor noise variance in mm^2
+    void setNoise(float jerkNoise, float measurementNoise) {
+        q = jerkNoise;
+        r = measurementNoise;
+    }
+
+    void reset() {
+        isInitialised = false;
+        secondsSinceMeasurement = 0.0;
+    }
+
+    // Call once per block with the unsmoothed frame. A repeated sensor frame is not a new measurement,
+    // the time since the last one is carried into the prediction instead
+    void update(const HandData& hand, float blockSeconds) {
+        if (!hand.isPresent) {
+            reset();
+            return;
+        }
+
+        secondsSinceMeasurement += blockSeconds;
+
+        // Frames with no id (tests, synthetic input) are always treated as new
+        if (isInitialised && hand.frameId != 0 && hand.frameId == lastFrameId) return;
+
+        gather(hand);
+
+        if (!isInitialised) {
+            for (int i = 0; i < numCoords; ++i) {
+                position[i] = measured[i];
+                velocity[i] = 0.0f;
+                acceleration[i] = 0.0f;
+                p00[i] = r; p01[i] = 0.0f; p02[i] = 0.0f;
+                p11[i] = initialVelocityVariance; p12[i] = 0.0f;
+                p22[i] = initialAccelerationVariance;
+            }
+            isInitialised = true;
+        }
+        else {
+            // Sensor clock when we have it, the audio clock otherwise
+            double dt = secondsSinceMeasurement;
+            if (lastFrameTime > 0.0 && hand.frameTimeSeconds > lastFrameTime)
+                dt = hand.frameTimeSeconds - lastFrameTime;
+
+            step((float)juce::jlimit(minStepSeconds, maxStepSeconds, dt));
+        }
+
+        lastFrameId = hand.frameId;
+        lastFrameTime = hand.frameTimeSeconds;
+        secondsSinceMeasurement = 0.0;
+    }
+
+    // Palm velocity into the hand, used for the speed mapping in every smoothing mode
+    void writeVelocity(HandData& hand) const {
+        if (!hand.isPresent || !isInitialised) {
+            hand.velocityX = hand.velocityY = hand.velocityZ = 0.0f;
+            return;
+        }
+
+        hand.velocityX = velocity[0];
+        hand.velocityY = velocity[1];
+        hand.velocityZ = velocity[2];
+    }
+
+    // Palm and fingertips extrapolated forward, horizon is on top of the age of the last measurement.
+    // The rest of each finger moves with its tip, so the bones keep their length on the stage
+    void writeEstimate(HandData& hand, float horizonSeconds) const {
+        if (!hand.isPresent || !isInitialised) return;
+
+        const float h = horizonSeconds + (float)secondsSinceMeasurement;
+
+        hand.currentHandPositionX = getPredicted(0, h);
+        hand.currentHandPositionY = getPredicted(1, h);
+        hand.currentHandPositionZ = getPredicted(2, h);
+
+        for (int f = 0; f < 5; ++f) {
+            auto& finger = hand.fingers[f];
+            float dx = getPredicted(3 + f * 3, h) - finger.tipX;
+            float dy = getPredicted(4 + f * 3, h) - finger.tipY;
+            float dz = getPredicted(5 + f * 3, h) - finger.tipZ;
+
+            finger.tipX += dx; finger.tipY += dy; finger.tipZ += dz;
+            finger.joint1X += dx; finger.joint1Y += dy; finger.joint1Z += dz;
+            finger.joint2X += dx; finger.joint2Y += dy; finger.joint2Z += dz;
+            finger.knuckleX += dx; finger.knuckleY += dy; finger.knuckleZ += dz;
+        }
+    }
+
+    float getPosition(int coord) const { return position[coord]; }
+    float getVelocity(int coord) const { return velocity[coord]; }
+
+    float getPredicted(int coord, float horizonSeconds) const {
+        return position[coord] + velocity[coord] * horizonSeconds + 0.5f * acceleration[coord] * horizonSeconds * horizonSeconds;
+    }
+
+private:
+    // Leap palm noise is around a millimetre, jerk density picked for the lowest velocity error on a 1 Hz 150 mm sweep
+    static constexpr float defaultJerkNoise = 5.0e7f;
+    static constexpr float defaultMeasurementNoise = 1.0f;
+
+    static constexpr float initialVelocityVariance = 1.0e6f;
+    static constexpr float initialAccelerationVariance = 1.0e8f;
+
+    // Long gaps are clamped so a dropped frame burst can't blow up the covariance
+    static constexpr double minStepSeconds = 1.0e-4;
+    static constexpr double maxStepSeconds = 0.1;
+
+    float q = defaultJerkNoise;
+    float r = defaultMeasurementNoise;
+
+    bool isInitialised = false;
+    long long lastFrameId = 0;
+    double lastFrameTime = 0.0;
+    double secondsSinceMeasurement = 0.0;
+
+    alignas(16) float measured[numCoords] = {};
+    alignas(16) float position[numCoords] = {};
+    alignas(16) float velocity[numCoords] = {};
+    alignas(16) float acceleration[numCoords] = {};
+
+    // Upper triangle of each coordinate's covariance
+    alignas(16) float p00[numCoords] = {};
+    alignas(16) float p01[numCoords] = {};
+    alignas(16) float p02[numCoords] = {};
+    alignas(16) float p11[numCoords] = {};
+    alignas(16) float p12[numCoords] = {};
+    alignas(16) float p22[numCoords] = {};
+
+    void gather(const HandData& hand) {
+        measured[0] = hand.currentHandPositionX;
+        measured[1] = hand.currentHandPositionY;
+        measured[2] = hand.currentHandPositionZ;
+
+        for (int f = 0; f < 5; ++f) {
+            measured[3 + f * 3] = hand.fingers[f].tipX;
+            measured[4 + f * 3] = hand.fingers[f].tipY;
+            measured[5 + f * 3] = hand.fingers[f].tipZ;
+        }
+    }
+
+    // Predict with F = [1 dt dt^2/2; 0 1 dt; 0 0 1] and white jerk noise, then correct with the position measurement
+    void step(float dt) {
+        const float h = dt;
+        const float h2 = 0.5f * dt * dt;
+
+        const float q00 = q * dt * dt * dt * dt * dt / 20.0f;
+        const float q01 = q * dt * dt * dt * dt / 8.0f;
+        const float q02 = q * dt * dt * dt / 6.0f;
+        const float q11 = q * dt * dt * dt / 3.0f;
+        const float q12 = q * dt * dt / 2.0f;
+        const float q22 = q * dt;
+
+        for (int i = 0; i < numCoords; ++i) {
+            float x0 = position[i] + velocity[i] * h + acceleration[i] * h2;
+            float x1 = velocity[i] + acceleration[i] * h;
+            float x2 = acceleration[i];
+
+            // F P
+            float m00 = p00[i] + h * p01[i] + h2 * p02[i];
+            float m01 = p01[i] + h * p11[i] + h2 * p12[i];
+            float m02 = p02[i] + h * p12[i] + h2 * p22[i];
+            float m11 = p11[i] + h * p12[i];
+            float m12 = p12[i] + h * p22[i];
+
+            // (F P) F' + Q
+            float n00 = m00 + h * m01 + h2 * m02 + q00;
+            float n01 = m01 + h * m02 + q01;
+            float n02 = m02 + q02;
+            float n11 = m11 + h * m12 + q11;
+            float n12 = m12 + q12;
+            float n22 = p22[i] + q22;
+
+            float inverseS = 1.0f / (n00 + r);
+            float k0 = n00 * inverseS;
+            float k1 = n01 * inverseS;
+            float k2 = n02 * inverseS;
+
+            float innovation = measured[i] - x0;
+            position[i] = x0 + k0 * innovation;
+            velocity[i] = x1 + k1 * innovation;
+            acceleration[i] = x2 + k2 * innovation;
+
+            p00[i] = n00 - k0 * n00;
+            p01[i] = n01 - k0 * n01;
+            p02[i] = n02 - k0 * n02;
+            p11[i] = n11 - k1 * n01;
+            p12[i] = n12 - k1 * n02;
+            p22[i] = n22 - k2 * n02;
+        }
+    }
+};
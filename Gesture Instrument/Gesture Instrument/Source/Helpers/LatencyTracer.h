@@ -0,0 +1,264 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include "HandData.h"
+#include "ProfilerProbes.h"
+
+// Counts per log bucket that any thread can add to or read without a lock.
+// One writer at a time is assumed, readers see a count that may be a sample or two behind
+class LatencyHistogram {
+public:
+    LatencyHistogram(float lowestValue, float highestValue) : scale(lowestValue, highestValue) {
+        clear();
+    }
+
+    void add(float value) {
+        counts[(size_t)scale.bucketFor(value)].fetch_add(1, std::memory_order_relaxed);
+        total.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void clear() {
+        for (auto& count : counts) count.store(0, std::memory_order_relaxed);
+        total.store(0, std::memory_order_relaxed);
+    }
+
+    int getCount() const { return total.load(std::memory_order_relaxed); }
+
+    // fraction is 0-1, 0.99 for p99. 0 while nothing has been added
+    float getPercentile(float fraction) const {
+        int numSamples = getCount();
+        if (numSamples == 0) return 0.0f;
+
+        int target = juce::jlimit(1, numSamples, (int)std::ceil(fraction * (float)numSamples));
+        int seen = 0;
+
+        for (int bucket = 0; bucket < LogBucketScale::numBuckets; ++bucket) {
+            seen += counts[(size_t)bucket].load(std::memory_order_relaxed);
+            if (seen >= target) return scale.valueOf(bucket);
+        }
+
+        return scale.valueOf(LogBucketScale::numBuckets - 1);
+    }
+
+private:
+    LogBucketScale scale;
+    std::array<std::atomic<int>, LogBucketScale::numBuckets> counts;
+    std::atomic<int> total{ 0 };
+};
+
+// Follows sensor frames from capture to the MIDI or OSC they produced.
+// LeapService stamps capture and receive, the Leap thread stamps the hand off, and the audio thread marks smoothing,
+// routing and output for the first block that picks a new frame up. Stage times go into lock-free histograms and
+// whole frames into a ring that the message thread collects for a Chrome trace (chrome://tracing or Perfetto).
+// Off by default, until then beginBlock is one relaxed load
+class LatencyTracer {
+public:
+    enum Stage {
+        sensor,     // capture to LeapService receiving it
+        leapThread, // receive to the Leap thread publishing it
+        handoff,    // publish to the audio thread picking it up
+        smoothing,  // estimator and One Euro banks
+        routing,    // MidiManager or OscManager
+        output,     // routing done to the first event leaving
+        total,      // capture to the first event leaving
+        numStages
+    };
+
+    struct FrameTrace {
+        long long frameId = 0;
+        double captureSeconds = 0.0;
+        double receivedSeconds = 0.0;
+        double publishedSeconds = 0.0;
+        double pickupSeconds = 0.0;
+        double smoothedSeconds = 0.0;
+        double routedSeconds = 0.0;
+        double emittedSeconds = 0.0; // 0 if the frame produced nothing
+        int numEvents = 0;
+        bool isOsc = false;
+    };
+
+    void setEnabled(bool shouldBeEnabled) { enabled.store(shouldBeEnabled, std::memory_order_relaxed); }
+    bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    // Same clock as HandData::captureSeconds
+    static double now() { return juce::Time::getMillisecondCounterHiRes() * 0.001; }
+
+    static const char* getStageName(Stage stage) {
+        static const char* names[] = { "sensor", "leapThread", "handoff", "smoothing", "routing", "output", "total" };
+        return names[stage];
+    }
+
+    // Audio thread. Starts a trace if the frame is new and tracing is on
+    void beginBlock(const HandData& hand) {
+        isTracing = false;
+        if (!isEnabled() || hand.frameId == lastFrameId || hand.captureSeconds <= 0.0) return;
+
+        lastFrameId = hand.frameId;
+        isTracing = true;
+
+        current = {};
+        current.frameId = hand.frameId;
+        current.captureSeconds = hand.captureSeconds;
+        current.receivedSeconds = hand.receivedSeconds > 0.0 ? hand.receivedSeconds : hand.captureSeconds;
+        current.publishedSeconds = hand.publishedSeconds > 0.0 ? hand.publishedSeconds : current.receivedSeconds;
+        current.pickupSeconds = now();
+    }
+
+    bool isTracingFrame() const { return isTracing; }
+
+    void markSmoothed() {
+        if (isTracing) current.smoothedSeconds = now();
+    }
+
+    void markRouted() {
+        if (isTracing) current.routedSeconds = now();
+    }
+
+    // Audio thread, at the end of the block. emitDelaySeconds is how far into the block the first event sits
+    void endBlock(int numEvents, double emitDelaySeconds, bool isOsc) {
+        if (!isTracing) return;
+        isTracing = false;
+
+        // A muted block returns before routing, the stages it skipped read as 0
+        double endSeconds = now();
+        if (current.smoothedSeconds <= 0.0) current.smoothedSeconds = current.pickupSeconds;
+        if (current.routedSeconds <= 0.0) current.routedSeconds = current.smoothedSeconds;
+
+        current.numEvents = numEvents;
+        current.isOsc = isOsc;
+        if (numEvents > 0) current.emittedSeconds = endSeconds + emitDelaySeconds;
+
+        record(sensor, current.captureSeconds, current.receivedSeconds);
+        record(leapThread, current.receivedSeconds, current.publishedSeconds);
+        record(handoff, current.publishedSeconds, current.pickupSeconds);
+        record(smoothing, current.pickupSeconds, current.smoothedSeconds);
+        record(routing, current.smoothedSeconds, current.routedSeconds);
+
+        if (numEvents > 0) {
+            record(output, current.routedSeconds, current.emittedSeconds);
+            record(total, current.captureSeconds, current.emittedSeconds);
+        }
+
+        int start1, size1, start2, size2;
+        traceFifo.prepareToWrite(1, start1, size1, start2, size2);
+
+        if (size1 == 0) {
+            droppedTraces.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        traceRing[(size_t)start1] = current;
+        traceFifo.finishedWrite(1);
+    }
+
+    // Stage latencies in ms, safe from any thread
+    const LatencyHistogram& getHistogram(Stage stage) const { return histograms[stage]; }
+
+    // Message thread. Call every UI frame while tracing so the ring doesn't fill, keeps the last maxHistory frames
+    void collect() {
+        int start1, size1, start2, size2;
+        traceFifo.prepareToRead(traceFifo.getNumReady(), start1, size1, start2, size2);
+
+        for (int i = 0; i < size1; ++i) history.add(traceRing[(size_t)(start1 + i)]);
+        for (int i = 0; i < size2; ++i) history.add(traceRing[(size_t)(start2 + i)]);
+        traceFifo.finishedRead(size1 + size2);
+
+        if (history.size() > maxHistory) history.removeRange(0, history.size() - maxHistory);
+    }
+
+    const juce::Array<FrameTrace>& getHistory() const { return history; }
+    int getNumDroppedTraces() const { return droppedTraces.load(std::memory_order_relaxed); }
+
+    // Message thread. Forgets the collected frames and the histograms, call while the audio thread isn't tracing
+    void reset() {
+        collect();
+        history.clearQuick();
+        for (auto& histogram : histograms) histogram.clear();
+        droppedTraces.store(0, std::memory_order_relaxed);
+    }
+
+    // Message thread. Every collected frame as Chrome trace events, one track per thread and timestamps in microseconds
+    juce::String createChromeTrace() {
+        collect();
+
+        juce::Array<juce::var> events;
+        const char* tracks[] = { "Sensor", "Leap thread", "Hand off", "Audio thread", "Output" };
+
+        for (int track = 0; track < 5; ++track) {
+            auto* name = new juce::DynamicObject();
+            name->setProperty("name", tracks[track]);
+
+            auto* meta = new juce::DynamicObject();
+            meta->setProperty("name", "thread_name");
+            meta->setProperty("ph", "M");
+            meta->setProperty("pid", 1);
+            meta->setProperty("tid", track + 1);
+            meta->setProperty("args", juce::var(name));
+            events.add(juce::var(meta));
+        }
+
+        auto addSpan = [&events](const FrameTrace& frame, Stage stage, int track, double from, double to) {
+            auto* args = new juce::DynamicObject();
+            args->setProperty("frame", (juce::int64)frame.frameId);
+            args->setProperty("events", frame.numEvents);
+            args->setProperty("output", frame.isOsc ? "osc" : "midi");
+
+            auto* span = new juce::DynamicObject();
+            span->setProperty("name", getStageName(stage));
+            span->setProperty("cat", "frame");
+            span->setProperty("ph", "X");
+            span->setProperty("pid", 1);
+            span->setProperty("tid", track);
+            span->setProperty("ts", from * 1.0e6);
+            span->setProperty("dur", juce::jmax(0.0, to - from) * 1.0e6);
+            span->setProperty("args", juce::var(args));
+            events.add(juce::var(span));
+            };
+
+        for (const auto& frame : history) {
+            addSpan(frame, sensor, 1, frame.captureSeconds, frame.receivedSeconds);
+            addSpan(frame, leapThread, 2, frame.receivedSeconds, frame.publishedSeconds);
+            addSpan(frame, handoff, 3, frame.publishedSeconds, frame.pickupSeconds);
+            addSpan(frame, smoothing, 4, frame.pickupSeconds, frame.smoothedSeconds);
+            addSpan(frame, routing, 4, frame.smoothedSeconds, frame.routedSeconds);
+            if (frame.emittedSeconds > 0.0) addSpan(frame, output, 5, frame.routedSeconds, frame.emittedSeconds);
+        }
+
+        auto* root = new juce::DynamicObject();
+        root->setProperty("traceEvents", events);
+        root->setProperty("displayTimeUnit", "ms");
+        return juce::JSON::toString(juce::var(root));
+    }
+
+    bool exportChromeTrace(const juce::File& file) { return file.replaceWithText(createChromeTrace()); }
+
+private:
+    std::atomic<bool> enabled{ false };
+
+    // Audio thread
+    long long lastFrameId = -1;
+    bool isTracing = false;
+    FrameTrace current;
+
+    // 1 microsecond to 1 second, in ms
+    LatencyHistogram histograms[numStages] = {
+        { 0.001f, 1000.0f }, { 0.001f, 1000.0f }, { 0.001f, 1000.0f }, { 0.001f, 1000.0f },
+        { 0.001f, 1000.0f }, { 0.001f, 1000.0f }, { 0.001f, 1000.0f }
+    };
+
+    void record(Stage stage, double from, double to) {
+        histograms[stage].add((float)(juce::jmax(0.0, to - from) * 1000.0));
+    }
+
+    // Audio thread to message thread
+    static constexpr int ringSize = 512;
+    juce::AbstractFifo traceFifo{ ringSize };
+    std::array<FrameTrace, ringSize> traceRing;
+    std::atomic<int> droppedTraces{ 0 };
+
+    // Message thread, about 30 seconds at 120 Hz
+    static constexpr int maxHistory = 4096;
+    juce::Array<FrameTrace> history;
+};
@@ -8,7 +8,7 @@ void LeapService::stop() {
     }
 }
 
-void LeapService::pollHandData(HandData& leftHand, HandData& rightHand, bool& isConnected) {
+void LeapService::pollHandData(HandData& leftHand, HandData& rightHand, bool& isConnected, const FrameCallback& onTrackingFrame) {
     LEAP_CONNECTION_MESSAGE message;
 
     while (LeapPollConnection(connectionHandle, 0, &message) == eLeapRS_Success) {
@@ -16,6 +16,8 @@ void LeapService::pollHandData(HandData& leftHand, HandData& rightHand, bool& is
         if (message.type == eLeapEventType_Tracking) {
             convertLeapEventToHandData(message.tracking_event, leftHand, rightHand);
             isConnected = true; // Hardware is actively tracking
+
+            if (onTrackingFrame) onTrackingFrame(leftHand, rightHand, isConnected);
         }
         else if (message.type == eLeapEventType_Device) {
             // Sensor was recognised
@@ -45,6 +47,18 @@ void LeapService::convertLeapEventToHandData(const LEAP_TRACKING_EVENT* event, H
     leftHand.isPresent = false;
     rightHand.isPresent = false;
 
+    // Device timestamp is in microseconds. The service clock isn't ours, so the frame's age by that clock
+    // is taken off the host time it arrived at
+    double ageSeconds = juce::jlimit(0.0, 1.0, (double)(LeapGetNow() - event->info.timestamp) * 1.0e-6);
+    double receivedSeconds = juce::Time::getMillisecondCounterHiRes() * 0.001;
+
+    for (auto* h : { &leftHand, &rightHand }) {
+        h->frameId = event->tracking_frame_id;
+        h->frameTimeSeconds = (double)event->info.timestamp * 1.0e-6;
+        h->captureSeconds = receivedSeconds - ageSeconds;
+        h->receivedSeconds = receivedSeconds;
+    }
+
     for (uint32_t i = 0; i < event->nHands; ++i) {
         const LEAP_HAND& hand = event->pHands[i];
         HandData* targetHand = (hand.type == eLeapHandType_Right) ? &rightHand : &leftHand;
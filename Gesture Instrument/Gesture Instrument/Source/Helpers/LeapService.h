@@ -17,8 +17,13 @@ public:
         stop();
     }
 
+    using FrameCallback = std::function<void(const HandData& leftHand, const HandData& rightHand, bool isSensorConnected)>;
+
     void stop();
-    void pollHandData(HandData& leftHand, HandData& rightHand, bool& isSensorConnected);
+
+    // Drains every queued event, leaving the hands at the latest frame. onTrackingFrame sees each tracking frame
+    // as it's parsed, so nothing that happened between polls is skipped
+    void pollHandData(HandData& leftHand, HandData& rightHand, bool& isSensorConnected, const FrameCallback& onTrackingFrame = nullptr);
     void convertLeapEventToHandData(const LEAP_TRACKING_EVENT* event, HandData& leftHand, HandData& rightHand);
 
 private:
@@ -3,6 +3,13 @@
 #include <JuceHeader.h>
 #include "LeapService.h"
 #include "HandData.h"
+#include "OnsetDetector.h"
+#include "CalibrationTracker.h"
+#include "AutoRanger.h"
+#include "TripleBuffer.h"
+#include "ProfilerProbes.h"
+#include "RealtimeVerifier.h"
+#include "RuntimeStats.h"
 
 class LeapThread : public juce::Thread {
 public:
@@ -27,22 +34,31 @@ public:
         HandData persistentRight;
         bool persistentConnected = false;
 
+        // Every frame drained by a poll goes through strike detection, not only the last
+        const LeapService::FrameCallback onTrackingFrame = [this](const HandData& left, const HandData& right, bool connected) {
+            handleFrame(left, right, connected);
+            };
+
         while (!threadShouldExit()) {
-            leapService.pollHandData(persistentLeft, persistentRight, persistentConnected);
+            leapService.pollHandData(persistentLeft, persistentRight, persistentConnected, onTrackingFrame);
 
-            {
-                juce::ScopedLock sl(dataLock);
-                sharedLeft = persistentLeft;
-                sharedRight = persistentRight;
-                sharedConnected = persistentConnected;
-            }
+            // Connection changes, a frame already handled above isn't detected twice
+            handleFrame(persistentLeft, persistentRight, persistentConnected);
 
             wait(5);
         }
     }
 
-    void getLatestData(HandData& outLeft, HandData& outRight, bool& outConnected) {
-        const juce::ScopedTryLock sl(dataLock);
+    // Stands in for the sensor while the thread isn't running, so benchmarks and tests can drive the engine.
+    // The frame goes through the same strike detection and calibration as a polled one
+    void injectFrame(const HandData& left, const HandData& right, bool connected) {
+        jassert(!isThreadRunning());
+        handleFrame(left, right, connected);
+    }
+
+    // False if the polling thread held the lock and the previous frame was handed out again
+    bool getLatestData(HandData& outLeft, HandData& outRight, bool& outConnected) {
+        const CheckedCriticalSection::ScopedTryLockType sl(dataLock);
 
         if (sl.isLocked()) {
             lastLeft = sharedLeft;
@@ -53,11 +69,201 @@ public:
         outLeft = lastLeft;
         outRight = lastRight;
         outConnected = lastConnected;
+        return sl.isLocked();
+    }
+
+    // Frame intervals go here, set before the thread starts
+    void setProfiler(ProfilerProbes* probes) { profiler = probes; }
+
+    // Sensor frame rate and drops for the stats feed, set before the thread starts
+    void setStats(RuntimeStats* runtimeStats) { stats = runtimeStats; }
+
+    void setStrikeThreshold(float thresholdMmPerSecond) { strikeThreshold.store(thresholdMmPerSecond); }
+
+    // Audio thread side of the strike queue, returns how many events were copied
+    int popStrikes(StrikeEvent* dest, int maxEvents) {
+        int start1, size1, start2, size2;
+        strikeFifo.prepareToRead(maxEvents, start1, size1, start2, size2);
+
+        for (int i = 0; i < size1; ++i) dest[i] = strikeBuffer[start1 + i];
+        for (int i = 0; i < size2; ++i) dest[size1 + i] = strikeBuffer[start2 + i];
+
+        strikeFifo.finishedRead(size1 + size2);
+        return size1 + size2;
+    }
+
+    // Message thread. From here until stopCalibration every sensor frame goes into a fresh calibration,
+    // trimPercent of the samples at each edge of every axis are ignored
+    void startCalibration(float trimPercent) {
+        calibrationTrim.store(trimPercent);
+        calibrationSession.fetch_add(1);
+        isCalibrationRunning.store(true);
+    }
+
+    void stopCalibration() { isCalibrationRunning.store(false); }
+
+    // Message thread. False until the current calibration has seen a hand
+    bool getCalibrationBounds(CalibrationBounds& out) {
+        calibrationResults.acquire();
+
+        const auto& latest = calibrationResults.getReadBuffer();
+        if (latest.session != calibrationSession.load() || latest.numSamples == 0) return false;
+
+        out = latest;
+        return true;
+    }
+
+    // Audio thread. Starts auto ranging again from the given area, on switching it on and whenever the area is set by hand
+    void resetAutoRange(const PlayArea& start) {
+        auto& request = autoRangeStarts.getWriteBuffer();
+        request.area = start;
+        request.session = ++requestedRangeSession;
+        autoRangeStarts.publish();
+    }
+
+    void setAutoRangeEnabled(bool shouldRange) { isAutoRangeEnabled.store(shouldRange); }
+    void setAutoRangeSpeed(float mmPerSecond) { autoRangeSpeed.store(mmPerSecond); }
+
+    // Audio thread. False until the ranger has moved the area since the last reset
+    bool getAutoRangeArea(PlayArea& out) {
+        autoRangeResults.acquire();
+
+        const auto& latest = autoRangeResults.getReadBuffer();
+        if (latest.session != requestedRangeSession) return false;
+
+        out = latest.area;
+        return true;
     }
 
 private:
     LeapService leapService;
-    juce::CriticalSection dataLock;
+    CheckedCriticalSection dataLock{ "LeapThread::dataLock" };
+    ProfilerProbes* profiler = nullptr;
+    RuntimeStats* stats = nullptr;
+
+    // Producer side, the polling thread or whoever injects frames
+    long long lastDetectedFrame = -1;
+    double lastCaptureSeconds = 0.0;
+    double lastPublishedSeconds = 0.0;
+
+    void handleFrame(const HandData& left, const HandData& right, bool connected) {
+        // Strikes are found here at sensor rate, the audio thread only samples the latest frame per block
+        if (left.frameId != lastDetectedFrame) {
+            lastDetectedFrame = left.frameId;
+
+            if (profiler != nullptr && lastCaptureSeconds > 0.0)
+                profiler->push(ProfilerProbes::sensorInterval, (float)((left.captureSeconds - lastCaptureSeconds) * 1000.0));
+            lastCaptureSeconds = left.captureSeconds;
+
+            if (stats != nullptr) stats->sensorFrame(left.frameId);
+
+            detectStrikes(left, right);
+            updateCalibration(left, right);
+            updateAutoRange(left, right);
+
+            lastPublishedSeconds = juce::Time::getMillisecondCounterHiRes() * 0.001;
+        }
+
+        const CheckedCriticalSection::ScopedLockType sl(dataLock);
+        sharedLeft = left;
+        sharedRight = right;
+        sharedLeft.publishedSeconds = sharedRight.publishedSeconds = lastPublishedSeconds;
+        sharedConnected = connected;
+    }
+
+    static constexpr int strikeQueueSize = 64;
+    OnsetDetector leftOnsets, rightOnsets;
+    std::atomic<float> strikeThreshold{ 400.0f };
+    juce::AbstractFifo strikeFifo{ strikeQueueSize };
+    StrikeEvent strikeBuffer[strikeQueueSize];
+
+    void detectStrikes(const HandData& left, const HandData& right) {
+        StrikeEvent found[OnsetDetector::numSources * 2];
+
+        leftOnsets.setThreshold(strikeThreshold.load());
+        rightOnsets.setThreshold(strikeThreshold.load());
+
+        int numFound = leftOnsets.process(left, 0, found);
+        numFound += rightOnsets.process(right, 1, found + numFound);
+        if (numFound == 0) return;
+
+        // If the audio side has stalled the queue fills up and new strikes are dropped rather than blocking this thread
+        int start1, size1, start2, size2;
+        strikeFifo.prepareToWrite(numFound, start1, size1, start2, size2);
+
+        for (int i = 0; i < size1; ++i) strikeBuffer[start1 + i] = found[i];
+        for (int i = 0; i < size2; ++i) strikeBuffer[start2 + i] = found[size1 + i];
+
+        strikeFifo.finishedWrite(size1 + size2);
+    }
+
+    // Calibration samples at sensor rate so a busy or minimised editor doesn't drop frames from it
+    CalibrationTracker calibration;
+    std::atomic<bool> isCalibrationRunning{ false };
+    std::atomic<float> calibrationTrim{ 2.0f };
+    std::atomic<int> calibrationSession{ 0 };
+    int trackedSession = 0;
+    TripleBuffer<CalibrationBounds> calibrationResults;
+
+    void updateCalibration(const HandData& left, const HandData& right) {
+        if (!isCalibrationRunning.load()) return;
+
+        int session = calibrationSession.load();
+        if (session != trackedSession) {
+            trackedSession = session;
+            calibration.reset(calibrationTrim.load());
+        }
+
+        if (!left.isPresent && !right.isPresent) return;
+
+        calibration.addHand(left);
+        calibration.addHand(right);
+
+        auto& result = calibrationResults.getWriteBuffer();
+        result = calibration.getBounds();
+        result.session = session;
+        calibrationResults.publish();
+    }
+
+    // Auto range steps once per sensor frame on the sensor's clock, the audio thread only reads the area
+    struct RangedArea {
+        PlayArea area;
+        int session = 0;
+    };
+
+    AutoRanger autoRanger;
+    std::atomic<bool> isAutoRangeEnabled{ false };
+    std::atomic<float> autoRangeSpeed{ 10.0f };
+    TripleBuffer<RangedArea> autoRangeStarts;
+    TripleBuffer<RangedArea> autoRangeResults;
+    int requestedRangeSession = 0;
+    int rangedSession = 0;
+    double lastRangedSeconds = 0.0;
+
+    void updateAutoRange(const HandData& left, const HandData& right) {
+        if (autoRangeStarts.acquire()) {
+            const auto& start = autoRangeStarts.getReadBuffer();
+            autoRanger.reset(start.area);
+            rangedSession = start.session;
+            lastRangedSeconds = 0.0;
+        }
+
+        // Calibration is setting the area itself, hands wandering outside it shouldn't teach the ranger anything
+        if (rangedSession == 0 || !isAutoRangeEnabled.load() || isCalibrationRunning.load()) return;
+
+        // Frames without a sensor stamp (injected ones) fall back to the wall clock, same clamp as the filters
+        double frameSeconds = left.frameTimeSeconds > 0.0 ? left.frameTimeSeconds : juce::Time::getMillisecondCounterHiRes() * 0.001;
+        float deltaSeconds = lastRangedSeconds > 0.0 ? (float)juce::jlimit(0.0, 0.1, frameSeconds - lastRangedSeconds) : 0.0f;
+        lastRangedSeconds = frameSeconds;
+
+        autoRanger.setMaxSpeed(autoRangeSpeed.load());
+        autoRanger.process(left, right, deltaSeconds);
+
+        auto& result = autoRangeResults.getWriteBuffer();
+        result.area = autoRanger.getArea();
+        result.session = rangedSession;
+        autoRangeResults.publish();
+    }
 
     HandData sharedLeft;
     HandData sharedRight;
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <cmath>
+#include "HandData.h"
+
+// Smoothing factor of a one pole low pass with the given cutoff, over a time step in seconds
+inline float getLowPassAlpha(float cutoffHz, float deltaSeconds) {
+    return 1.0f - std::exp(-juce::MathConstants<float>::twoPi * cutoffHz * deltaSeconds);
+}
+
+// One Euro filter: the cutoff rises with speed, so slow movement is smoothed hard and fast movement has little lag
+class OneEuroFilter {
+public:
+    void setParameters(float minCutoffHz, float speedCoefficient, float derivativeCutoffHz) {
+        minCutoff = minCutoffHz;
+        beta = speedCoefficient;
+        derivativeCutoff = derivativeCutoffHz;
+    }
+
+    void reset() {
+        isInitialised = false;
+        derivative = 0.0f;
+    }
+
+    float process(float value, float deltaSeconds) {
+        if (!isInitialised || deltaSeconds <= 0.0f) {
+            if (!isInitialised) {
+                smoothed = value;
+                lastValue = value;
+                derivative = 0.0f;
+                isInitialised = true;
+            }
+            return smoothed;
+        }
+
+        float rawDerivative = (value - lastValue) / deltaSeconds;
+        derivative += (rawDerivative - derivative) * getLowPassAlpha(derivativeCutoff, deltaSeconds);
+
+        float cutoff = minCutoff + beta * std::abs(derivative);
+        smoothed += (value - smoothed) * getLowPassAlpha(cutoff, deltaSeconds);
+        lastValue = value;
+
+        return smoothed;
+    }
+
+    float getValue() const { return smoothed; }
+    float getDerivative() const { return derivative; }
+
+private:
+    float minCutoff = 1.0f;
+    float beta = 0.0f;
+    float derivativeCutoff = 1.0f;
+
+    bool isInitialised = false;
+    float smoothed = 0.0f;
+    float lastValue = 0.0f;
+    float derivative = 0.0f;
+};
+
+// Time step for the filters of one hand. The audio thread reads the latest frame every block, so most blocks at small
+// buffer sizes see a frame that has already been filtered. Those get 0, which holds the filter, and a new frame gets the
+// sensor's own interval, so the cutoff and derivative are the same at any block size
+class SensorFrameClock {
+public:
+    void reset() {
+        hasFrame = false;
+        secondsSinceFrame = 0.0;
+    }
+
+    float advance(const HandData& hand, float blockSeconds) {
+        if (!hand.isPresent) {
+            reset();
+            return 0.0f;
+        }
+
+        secondsSinceFrame += blockSeconds;
+
+        // Frames with no id (tests, synthetic input) are always treated as new
+        if (hasFrame && hand.frameId != 0 && hand.frameId == lastFrameId) return 0.0f;
+
+        // Sensor clock when we have it, the audio clock otherwise
+        double dt = secondsSinceFrame;
+        if (hasFrame && lastFrameTime > 0.0 && hand.frameTimeSeconds > lastFrameTime)
+            dt = hand.frameTimeSeconds - lastFrameTime;
+
+        hasFrame = true;
+        lastFrameId = hand.frameId;
+        lastFrameTime = hand.frameTimeSeconds;
+        secondsSinceFrame = 0.0;
+
+        return (float)juce::jlimit(minStepSeconds, maxStepSeconds, dt);
+    }
+
+private:
+    // Same clamp as the estimator, a dropped frame burst shouldn't look like one slow movement
+    static constexpr double minStepSeconds = 1.0e-4;
+    static constexpr double maxStepSeconds = 0.1;
+
+    bool hasFrame = false;
+    long long lastFrameId = 0;
+    double lastFrameTime = 0.0;
+    double secondsSinceFrame = 0.0;
+};
+
+// Palm position, roll, grab and pinch for one hand
+class PalmFilterBank {
+public:
+    PalmFilterBank() { setParameters(1.0f, 0.01f); }
+
+    // Beta is given per mm/s of palm speed, the other channels scale it to their own units
+    void setParameters(float minCutoffHz, float positionBeta) {
+        for (auto* f : { &posX, &posY, &posZ })
+            f->setParameters(minCutoffHz, positionBeta, derivativeCutoffHz);
+
+        roll.setParameters(minCutoffHz, positionBeta * rollBetaScale, derivativeCutoffHz);
+        grab.setParameters(minCutoffHz, positionBeta * strengthBetaScale, derivativeCutoffHz);
+        pinch.setParameters(minCutoffHz, positionBeta * strengthBetaScale, derivativeCutoffHz);
+    }
+
+    void reset() {
+        for (auto* f : { &posX, &posY, &posZ, &roll, &grab, &pinch }) f->reset();
+    }
+
+    // Filters the hand in place, a hand that is not present resets so re-entry starts from the raw frame
+    void process(HandData& hand, float deltaSeconds) {
+        if (!hand.isPresent) {
+            reset();
+            return;
+        }
+
+        hand.currentHandPositionX = posX.process(hand.currentHandPositionX, deltaSeconds);
+        hand.currentHandPositionY = posY.process(hand.currentHandPositionY, deltaSeconds);
+        hand.currentHandPositionZ = posZ.process(hand.currentHandPositionZ, deltaSeconds);
+        hand.currentWristRotation = roll.process(hand.currentWristRotation, deltaSeconds);
+        hand.grabStrength = grab.process(hand.grabStrength, deltaSeconds);
+        hand.pinchStrength = pinch.process(hand.pinchStrength, deltaSeconds);
+    }
+
+private:
+    static constexpr float derivativeCutoffHz = 1.0f;
+
+    // Roughly a 300 mm/s palm sweep ~ 3 rad/s of roll ~ 3 /s of grab or pinch
+    static constexpr float rollBetaScale = 100.0f;
+    static constexpr float strengthBetaScale = 100.0f;
+
+    OneEuroFilter posX, posY, posZ;
+    OneEuroFilter roll, grab, pinch;
+};
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <cmath>
+#include "HandData.h"
+
+// One detected strike, source 0 is the palm and 1-5 are thumb to pinky
+struct StrikeEvent {
+    int hand = 0; // 0 left, 1 right
+    int source = 0;
+    float velocity = 0.0f; // 0-1 from strike speed
+    double frameTimeSeconds = 0.0;
+    double captureSeconds = 0.0; // Host clock, 0 when the frame didn't come from the sensor
+};
+
+// Where in an audio block a strike's note goes. The block is taken to cover the blockSamples before nowSeconds, so
+// strikes keep their spacing at a fixed one block of latency rather than all landing on the first sample.
+// Strikes older than the block, or without a capture time, go at the start
+inline int getStrikeSampleOffset(const StrikeEvent& strike, double nowSeconds, double sampleRate, int blockSamples) {
+    if (strike.captureSeconds <= 0.0 || sampleRate <= 0.0 || blockSamples <= 0) return 0;
+
+    double ageSamples = (nowSeconds - strike.captureSeconds) * sampleRate;
+    return juce::jlimit(0, blockSamples - 1, blockSamples - 1 - (int)std::lround(ageSamples));
+}
+
+// Finds downward strikes of the palm and every fingertip, runs once per sensor frame on the Leap thread.
+// A strike fires when a fast downward move starts to decelerate, fingertips are measured against the palm
+// so a whole hand strike doesn't also fire five fingers
+class OnsetDetector {
+public:
+    static constexpr int numSources = 6;
+
+    // Speeds in mm/s, anything under the threshold is just movement
+    void setThreshold(float thresholdMmPerSecond) { threshold = thresholdMmPerSecond; }
+
+    void reset() { hasLastFrame = false; }
+
+    // Returns how many events were written to out, at most numSources
+    int process(const HandData& hand, int handIndex, StrikeEvent* out) {
+        if (!hand.isPresent) {
+            reset();
+            return 0;
+        }
+
+        float heights[numSources];
+        heights[0] = hand.currentHandPositionY;
+        for (int f = 0; f < 5; ++f) heights[f + 1] = hand.fingers[f].tipY - hand.currentHandPositionY;
+
+        if (!hasLastFrame) {
+            for (int i = 0; i < numSources; ++i) {
+                lastHeight[i] = heights[i];
+                downSpeed[i] = 0.0f;
+                peakSpeed[i] = 0.0f;
+                state[i] = State::Idle;
+            }
+            lastFrameTime = hand.frameTimeSeconds;
+            hasLastFrame = true;
+            return 0;
+        }
+
+        double dt = hand.frameTimeSeconds - lastFrameTime;
+        if (dt <= 0.0 || dt > maxFrameGapSeconds) dt = nominalFrameSeconds;
+        lastFrameTime = hand.frameTimeSeconds;
+
+        const float inverseDelta = (float)(1.0 / dt);
+        int numEvents = 0;
+
+        for (int i = 0; i < numSources; ++i) {
+            float rawSpeed = (lastHeight[i] - heights[i]) * inverseDelta;
+            lastHeight[i] = heights[i];
+
+            // Half a frame of smoothing takes the edge off the sensor jitter
+            downSpeed[i] += (rawSpeed - downSpeed[i]) * speedSmoothing;
+
+            switch (state[i]) {
+            case State::Idle:
+                if (downSpeed[i] > threshold) {
+                    state[i] = State::Falling;
+                    peakSpeed[i] = downSpeed[i];
+                }
+                break;
+
+            case State::Falling:
+                peakSpeed[i] = juce::jmax(peakSpeed[i], downSpeed[i]);
+                if (downSpeed[i] < peakSpeed[i] * decelerationRatio) {
+                    auto& e = out[numEvents++];
+                    e.hand = handIndex;
+                    e.source = i;
+                    e.velocity = juce::jlimit(0.0f, 1.0f, juce::jmap(peakSpeed[i], threshold, fullScaleSpeed, minimumVelocity, 1.0f));
+                    e.frameTimeSeconds = hand.frameTimeSeconds;
+                    e.captureSeconds = hand.captureSeconds;
+                    state[i] = State::Landed;
+                }
+                break;
+
+            case State::Landed:
+                if (downSpeed[i] < threshold * rearmRatio) state[i] = State::Idle;
+                break;
+            }
+        }
+
+        return numEvents;
+    }
+
+private:
+    enum class State { Idle, Falling, Landed };
+
+    static constexpr float speedSmoothing = 0.6f;
+    static constexpr float decelerationRatio = 0.6f;
+    static constexpr float rearmRatio = 0.3f;
+    static constexpr float fullScaleSpeed = 2000.0f;
+    static constexpr float minimumVelocity = 0.1f;
+    static constexpr double nominalFrameSeconds = 1.0 / 120.0;
+    static constexpr double maxFrameGapSeconds = 0.1;
+
+    float threshold = 400.0f;
+    bool hasLastFrame = false;
+    double lastFrameTime = 0.0;
+
+    float lastHeight[numSources] = {};
+    float downSpeed[numSources] = {};
+    float peakSpeed[numSources] = {};
+    State state[numSources] = {};
+};
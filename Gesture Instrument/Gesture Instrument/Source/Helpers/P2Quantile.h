@@ -0,0 +1,110 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <algorithm>
+
+// Streaming estimate of one quantile with the P-squared algorithm (Jain and Chlamtac).
+// Five markers track the min, max, the quantile and the points halfway to it, each sample nudges them with a
+// parabolic fit, so memory and time per sample are constant no matter how long it runs
+class P2Quantile {
+public:
+    explicit P2Quantile(float quantileToTrack = 0.5f) { reset(quantileToTrack); }
+
+    void reset(float quantileToTrack) {
+        p = juce::jlimit(0.0f, 1.0f, quantileToTrack);
+        count = 0;
+
+        increments[0] = 0.0f;
+        increments[1] = p / 2.0f;
+        increments[2] = p;
+        increments[3] = (1.0f + p) / 2.0f;
+        increments[4] = 1.0f;
+    }
+
+    int getCount() const { return count; }
+
+    void add(float x) {
+        if (count < numMarkers) {
+            heights[count++] = x;
+
+            if (count == numMarkers) {
+                std::sort(heights, heights + numMarkers);
+                for (int i = 0; i < numMarkers; ++i) {
+                    positions[i] = i;
+                    desired[i] = 4.0f * increments[i];
+                }
+            }
+            return;
+        }
+
+        ++count;
+
+        int cell;
+        if (x < heights[0]) {
+            heights[0] = x;
+            cell = 0;
+        }
+        else if (x >= heights[4]) {
+            heights[4] = x;
+            cell = 3;
+        }
+        else {
+            cell = 0;
+            while (cell < 3 && x >= heights[cell + 1]) ++cell;
+        }
+
+        for (int i = cell + 1; i < numMarkers; ++i) ++positions[i];
+        for (int i = 0; i < numMarkers; ++i) desired[i] += increments[i];
+
+        for (int i = 1; i < numMarkers - 1; ++i) {
+            float offset = desired[i] - (float)positions[i];
+
+            if ((offset >= 1.0f && positions[i + 1] - positions[i] > 1) || (offset <= -1.0f && positions[i - 1] - positions[i] < -1)) {
+                int step = offset > 0.0f ? 1 : -1;
+                float candidate = parabolic(i, step);
+
+                // Fall back to a straight line if the parabola would break the marker order
+                if (heights[i - 1] < candidate && candidate < heights[i + 1]) heights[i] = candidate;
+                else heights[i] = linear(i, step);
+
+                positions[i] += step;
+            }
+        }
+    }
+
+    // Exact on the first few samples, the middle marker after that
+    float get() const {
+        if (count == 0) return 0.0f;
+        if (count >= numMarkers) return heights[2];
+
+        float sorted[numMarkers];
+        std::copy(heights, heights + count, sorted);
+        std::sort(sorted, sorted + count);
+        return sorted[juce::roundToInt(p * (float)(count - 1))];
+    }
+
+private:
+    static constexpr int numMarkers = 5;
+
+    float p = 0.5f;
+    int count = 0;
+
+    float heights[numMarkers] = {};
+    int positions[numMarkers] = {};
+    float desired[numMarkers] = {};
+    float increments[numMarkers] = {};
+
+    float parabolic(int i, int step) const {
+        float d = (float)step;
+        float below = (float)(positions[i] - positions[i - 1]);
+        float above = (float)(positions[i + 1] - positions[i]);
+        float span = (float)(positions[i + 1] - positions[i - 1]);
+
+        return heights[i] + d / span * ((below + d) * (heights[i + 1] - heights[i]) / above
+            + (above - d) * (heights[i] - heights[i - 1]) / below);
+    }
+
+    float linear(int i, int step) const {
+        return heights[i] + (float)step * (heights[i + step] - heights[i]) / (float)(positions[i + step] - positions[i]);
+    }
+};
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <unordered_map>
+#include "PresetConfig.h"
+
+// What the host saves in its project. Hosts ask for it on every save and often for undo snapshots too, so it's a
+// compact binary record rather than the preset XML:
+//   int32 magic, int16 format version, then per field: int16 id, int16 payload size, payload (little endian)
+// Records a reader doesn't know are skipped and fields it doesn't find keep their defaults, so older and newer
+// builds open each other's projects. A field whose payload size doesn't match is skipped rather than misread.
+// Projects saved as XML by earlier versions still load
+struct PluginState {
+    static constexpr juce::int32 magic = 0x54534947; // "GIST"
+    static constexpr int formatVersion = 1;
+
+    // Settings for this machine rather than the performance, kept out of preset files. Ids from 500
+    struct HostSettings {
+        bool statsEnabled = false;
+        juce::String statsHost{ "127.0.0.1" };
+        int statsPort = 9001;
+
+        template <typename Settings, typename Visitor>
+        static void visitFields(Settings& s, Visitor&& visit) {
+            visit(500, "statsEnabled", s.statsEnabled, false);
+            visit(501, "statsHost", s.statsHost, juce::String("127.0.0.1"));
+            visit(502, "statsPort", s.statsPort, 9001);
+        }
+    };
+
+    PresetConfig config;
+    HostSettings host;
+
+    void write(juce::MemoryBlock& dest) const {
+        juce::MemoryOutputStream out(dest, false);
+        out.writeInt(magic);
+        out.writeShort((short)formatVersion);
+
+        auto writeField = [&out](int id, const char*, const auto& field, const auto&) { writeRecord(out, id, field); };
+        PresetConfig::visitFields(config, writeField);
+        HostSettings::visitFields(host, writeField);
+    }
+
+    // False if the data is neither binary nor XML state, leaving config and host untouched
+    bool read(const void* data, int sizeInBytes) {
+        if (data == nullptr || sizeInBytes < 6) return false;
+
+        juce::MemoryInputStream in(data, (size_t)sizeInBytes, false);
+        if (in.readInt() != magic) return readXml(data, sizeInBytes);
+
+        // Nothing depends on the version yet, it's there for the day a field changes meaning rather than size
+        in.readShort();
+
+        struct Record {
+            const char* payload;
+            int size;
+        };
+
+        std::unordered_map<int, Record> records;
+        while (in.getNumBytesRemaining() >= 4) {
+            int id = (juce::uint16)in.readShort();
+            int size = (juce::uint16)in.readShort();
+
+            // Truncated, keep what arrived whole
+            if (in.getNumBytesRemaining() < size) break;
+
+            records[id] = { static_cast<const char*>(data) + in.getPosition(), size };
+            in.skipNextBytes(size);
+        }
+
+        PresetConfig fresh;
+        HostSettings freshHost;
+
+        auto readField = [&records](int id, const char*, auto& field, const auto&) {
+            auto found = records.find(id);
+            if (found != records.end()) readRecord(found->second.payload, found->second.size, field);
+            };
+
+        PresetConfig::visitFields(fresh, readField);
+        HostSettings::visitFields(freshHost, readField);
+
+        config = fresh;
+        host = freshHost;
+        return true;
+    }
+
+private:
+    static void writeHeader(juce::OutputStream& out, int id, int size) {
+        out.writeShort((short)id);
+        out.writeShort((short)size);
+    }
+
+    static void writeRecord(juce::OutputStream& out, int id, bool value) {
+        writeHeader(out, id, 1);
+        out.writeByte(value ? 1 : 0);
+    }
+
+    static void writeRecord(juce::OutputStream& out, int id, int value) {
+        writeHeader(out, id, 4);
+        out.writeInt(value);
+    }
+
+    static void writeRecord(juce::OutputStream& out, int id, float value) {
+        writeHeader(out, id, 4);
+        out.writeFloat(value);
+    }
+
+    static void writeRecord(juce::OutputStream& out, int id, const PresetConfig::IntervalList& value) {
+        writeHeader(out, id, 1 + 4 * value.size);
+        out.writeByte((char)value.size);
+        for (int i = 0; i < value.size; ++i) out.writeInt(value.values[(size_t)i]);
+    }
+
+    static void writeRecord(juce::OutputStream& out, int id, const juce::String& value) {
+        int size = (int)juce::jmin(value.getNumBytesAsUTF8(), (size_t)0xffff);
+        writeHeader(out, id, size);
+        out.write(value.toRawUTF8(), (size_t)size);
+    }
+
+    static void readRecord(const char* payload, int size, bool& field) {
+        if (size == 1) field = payload[0] != 0;
+    }
+
+    static void readRecord(const char* payload, int size, int& field) {
+        if (size == 4) field = juce::MemoryInputStream(payload, 4, false).readInt();
+    }
+
+    static void readRecord(const char* payload, int size, float& field) {
+        if (size == 4) field = juce::MemoryInputStream(payload, 4, false).readFloat();
+    }
+
+    static void readRecord(const char* payload, int size, PresetConfig::IntervalList& field) {
+        int count = size > 0 ? (juce::uint8)payload[0] : -1;
+        if (count < 1 || count > PresetConfig::maxScaleIntervals || size != 1 + 4 * count) return;
+
+        juce::MemoryInputStream in(payload + 1, (size_t)(size - 1), false);
+        field.size = count;
+        for (int i = 0; i < count; ++i) field.values[(size_t)i] = in.readInt();
+    }
+
+    static void readRecord(const char* payload, int size, juce::String& field) {
+        field = juce::String::fromUTF8(payload, size);
+    }
+
+    // State from before the binary format, the preset XML with the host settings added as attributes
+    bool readXml(const void* data, int sizeInBytes) {
+        std::unique_ptr<juce::XmlElement> xml(juce::AudioProcessor::getXmlFromBinary(data, sizeInBytes));
+        if (xml == nullptr || !xml->hasTagName(PresetConfig::xmlTag)) return false;
+
+        config = PresetConfig::fromXml(*xml);
+
+        host = {};
+        host.statsEnabled = xml->getBoolAttribute("statsEnabled", host.statsEnabled);
+        host.statsHost = xml->getStringAttribute("statsHost", host.statsHost);
+        host.statsPort = xml->getIntAttribute("statsPort", host.statsPort);
+        return true;
+    }
+};
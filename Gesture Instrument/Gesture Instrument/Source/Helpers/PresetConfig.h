@@ -0,0 +1,281 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+
+// Everything a preset holds, as plain values so a whole configuration can be built off the audio thread and handed
+// over in one piece. Member defaults are a fresh plugin's, the processor captures and applies it field by field.
+// Every field is listed once in visitFields with a stable id for the binary state and its XML attribute name,
+// so adding a setting means adding one line there
+struct PresetConfig {
+    static constexpr int maxScaleIntervals = 12;
+
+    struct IntervalList {
+        std::array<int, maxScaleIntervals> values{};
+        int size = 0;
+    };
+
+    // Routing
+    int outputMode = 1;
+    int currentInstrument = 90;
+
+    // Musical settings
+    int rootNote = 0;
+    int scaleType = 0;
+    IntervalList customScaleIntervals{ { 0, 2, 4, 7, 9 }, 5 };
+    int currentRangeMode = 0;
+    int startNote = 48;
+    int endNote = 72;
+    int octaveRange = 2;
+    bool invertNoteTrigger = false;
+    bool strikeTrigger = false;
+    float strikeThreshold = 400.0f;
+    bool showNoteNames = false;
+    bool globalMute = false;
+
+    // Window and visuals
+    bool isWindowMaximized = false;
+    bool showFloorShadow = true;
+    bool showWallShadow = true;
+
+    // Virtual mouse
+    bool isGestureToMouseEnabled = true;
+    int virtualMouseGestureType = 1;
+    float virtualMouseHoldTime = 1.5f;
+
+    // Gesture targets, GestureTarget values
+    int leftXTarget = 1, leftYTarget = 3, leftZTarget = 1, leftRollTarget = 1, leftGrabTarget = 1, leftPinchTarget = 1;
+    int leftThumbTarget = 1, leftIndexTarget = 1, leftMiddleTarget = 1, leftRingTarget = 1, leftPinkyTarget = 1;
+    int rightXTarget = 1, rightYTarget = 3, rightZTarget = 1, rightRollTarget = 1, rightGrabTarget = 1, rightPinchTarget = 5;
+    int rightThumbTarget = 1, rightIndexTarget = 12, rightMiddleTarget = 1, rightRingTarget = 1, rightPinkyTarget = 1;
+    int leftSpeedTarget = 1, rightSpeedTarget = 1;
+
+    // Play area
+    float minWidthThreshold = -200.0f;
+    float maxWidthThreshold = 200.0f;
+    float minHeightThreshold = 150.0f;
+    float maxHeightThreshold = 450.0f;
+    float minDepthThreshold = -150.0f;
+    float maxDepthThreshold = 150.0f;
+
+    // Calibration and tracking
+    float wristMultiplier = 1.0f;
+    float grabMultiplier = 1.0f;
+    float pinchMultiplier = 1.0f;
+    float calibrationTrimPercent = 2.0f;
+    bool autoRangeEnabled = false;
+    float autoRangeSpeed = 10.0f;
+    float smoothingMinCutoff = 1.0f;
+    float smoothingBeta = 0.01f;
+    int smoothingMode = 0;
+    float predictionHorizonMs = 20.0f;
+
+    // Static parameters
+    float staticVolume = 0.8f;
+    float staticPan = 0.5f;
+    float staticModulation = 0.0f;
+    float staticExpression = 1.0f;
+    float staticCutoff = 1.0f;
+    float staticResonance = 0.0f;
+    float staticAttack = 0.1f;
+    float staticRelease = 0.1f;
+    float staticReverb = 0.1f;
+    float staticChorus = 0.0f;
+    float staticVibrato = 0.0f;
+    float staticWaveform = 0.0f;
+    float staticDelay = 0.0f;
+    float staticDistortion = 0.0f;
+
+    // MPE
+    bool isMpeEnabled = false;
+    bool enableSplitXAxis = false;
+    int mpePitchBendAxis = 1;
+    int mpeTimbreAxis = 2;
+    int mpePressureAxis = 3;
+
+    // Chord builder, one flag per scale degree and per allowed root
+    std::array<bool, 7> leftChordDegrees{ true, false, true, false, true, false, false };
+    std::array<bool, 7> leftAllowedRoots{ true, true, true, true, true, true, true };
+    int leftChordInversionMode = 0;
+    bool leftDropBass = false;
+    std::array<bool, 7> rightChordDegrees{ true, false, true, false, true, false, false };
+    std::array<bool, 7> rightAllowedRoots{ true, true, true, true, true, true, true };
+    int rightChordInversionMode = 0;
+    bool rightDropBass = false;
+    bool chordEngineEnabled = true;
+
+    // Calls visit(id, xmlName, field, xmlDefault) for every field. Ids are the binary state's and are never reused,
+    // a removed field keeps its id retired. xmlDefault is what a preset file without the attribute has always loaded as
+    template <typename Config, typename Visitor>
+    static void visitFields(Config& c, Visitor&& visit) {
+        visit(1, "outputMode", c.outputMode, 1);
+        visit(2, "currentInstrument", c.currentInstrument, 1);
+
+        visit(3, "rootNote", c.rootNote, 0);
+        visit(4, "scaleType", c.scaleType, 0);
+        visit(5, "currentRangeMode", c.currentRangeMode, 1);
+        visit(6, "startNote", c.startNote, 48);
+        visit(7, "endNote", c.endNote, 72);
+        visit(8, "octaveRange", c.octaveRange, 2);
+        visit(9, "invertNoteTrigger", c.invertNoteTrigger, false);
+        visit(10, "strikeTrigger", c.strikeTrigger, false);
+        visit(11, "strikeThreshold", c.strikeThreshold, 400.0f);
+        visit(12, "showNoteNames", c.showNoteNames, false);
+        visit(13, "globalMute", c.globalMute, false);
+        visit(14, "isWindowMaximized", c.isWindowMaximized, false);
+        visit(15, "showFloorShadow", c.showFloorShadow, true);
+        visit(16, "showWallShadow", c.showWallShadow, true);
+
+        visit(17, "isGestureToMouseEnabled", c.isGestureToMouseEnabled, true);
+        visit(18, "virtualMouseGestureType", c.virtualMouseGestureType, 1);
+        visit(19, "virtualMouseHoldTime", c.virtualMouseHoldTime, 1.5f);
+
+        visit(20, "leftXTarget", c.leftXTarget, 99);
+        visit(21, "leftYTarget", c.leftYTarget, 99);
+        visit(22, "leftZTarget", c.leftZTarget, 99);
+        visit(23, "leftRollTarget", c.leftRollTarget, 99);
+        visit(24, "leftGrabTarget", c.leftGrabTarget, 99);
+        visit(25, "leftPinchTarget", c.leftPinchTarget, 99);
+        visit(26, "leftThumbTarget", c.leftThumbTarget, 99);
+        visit(27, "leftIndexTarget", c.leftIndexTarget, 99);
+        visit(28, "leftMiddleTarget", c.leftMiddleTarget, 99);
+        visit(29, "leftRingTarget", c.leftRingTarget, 99);
+        visit(30, "leftPinkyTarget", c.leftPinkyTarget, 99);
+
+        visit(31, "rightXTarget", c.rightXTarget, 99);
+        visit(32, "rightYTarget", c.rightYTarget, 99);
+        visit(33, "rightZTarget", c.rightZTarget, 99);
+        visit(34, "rightRollTarget", c.rightRollTarget, 99);
+        visit(35, "rightGrabTarget", c.rightGrabTarget, 99);
+        visit(36, "rightPinchTarget", c.rightPinchTarget, 99);
+        visit(37, "rightThumbTarget", c.rightThumbTarget, 99);
+        visit(38, "rightIndexTarget", c.rightIndexTarget, 99);
+        visit(39, "rightMiddleTarget", c.rightMiddleTarget, 99);
+        visit(40, "rightRingTarget", c.rightRingTarget, 99);
+        visit(41, "rightPinkyTarget", c.rightPinkyTarget, 99);
+
+        visit(42, "leftSpeedTarget", c.leftSpeedTarget, 1);
+        visit(43, "rightSpeedTarget", c.rightSpeedTarget, 1);
+
+        visit(44, "minWidthThreshold", c.minWidthThreshold, -200.0f);
+        visit(45, "maxWidthThreshold", c.maxWidthThreshold, 200.0f);
+        visit(46, "minHeightThreshold", c.minHeightThreshold, 150.0f);
+        visit(47, "maxHeightThreshold", c.maxHeightThreshold, 450.0f);
+        visit(48, "minDepthThreshold", c.minDepthThreshold, -150.0f);
+        visit(49, "maxDepthThreshold", c.maxDepthThreshold, 150.0f);
+
+        visit(50, "wristMult", c.wristMultiplier, 1.0f);
+        visit(51, "grabMult", c.grabMultiplier, 1.0f);
+        visit(52, "pinchMult", c.pinchMultiplier, 1.0f);
+        visit(53, "calibTrim", c.calibrationTrimPercent, 2.0f);
+        visit(54, "autoRange", c.autoRangeEnabled, false);
+        visit(55, "autoRangeSpeed", c.autoRangeSpeed, 10.0f);
+        visit(56, "smoothMinCutoff", c.smoothingMinCutoff, 1.0f);
+        visit(57, "smoothBeta", c.smoothingBeta, 0.01f);
+        visit(58, "smoothingMode", c.smoothingMode, 0);
+        visit(59, "predictionMs", c.predictionHorizonMs, 20.0f);
+
+        visit(60, "staticVolume", c.staticVolume, 1.0f);
+        visit(61, "staticPan", c.staticPan, 0.5f);
+        visit(62, "staticModulation", c.staticModulation, 0.0f);
+        visit(63, "staticExpression", c.staticExpression, 0.0f);
+        visit(64, "staticCutoff", c.staticCutoff, 1.0f);
+        visit(65, "staticResonance", c.staticResonance, 0.1f);
+        visit(66, "staticAttack", c.staticAttack, 0.1f);
+        visit(67, "staticRelease", c.staticRelease, 0.1f);
+        visit(68, "staticReverb", c.staticReverb, 0.0f);
+        visit(69, "staticChorus", c.staticChorus, 0.0f);
+        visit(70, "staticVibrato", c.staticVibrato, 0.0f);
+        visit(71, "staticWaveform", c.staticWaveform, 0.0f);
+        visit(72, "staticDelay", c.staticDelay, 0.0f);
+        visit(73, "staticDistortion", c.staticDistortion, 0.0f);
+
+        visit(74, "customScaleIntervals", c.customScaleIntervals, IntervalList{ { 0, 2, 4, 7, 9 }, 5 });
+        visit(75, "isMpeEnabled", c.isMpeEnabled, false);
+        visit(76, "enableSplitXAxis", c.enableSplitXAxis, false);
+        visit(77, "mpePitchBendAxis", c.mpePitchBendAxis, 1);
+        visit(78, "mpeTimbreAxis", c.mpeTimbreAxis, 2);
+        visit(79, "mpePressureAxis", c.mpePressureAxis, 3);
+
+        static const char* leftDegreeNames[] = { "l_deg1", "l_deg2", "l_deg3", "l_deg4", "l_deg5", "l_deg6", "l_deg7" };
+        static const char* leftRootNames[] = { "l_r1", "l_r2", "l_r3", "l_r4", "l_r5", "l_r6", "l_r7" };
+        static const char* rightDegreeNames[] = { "r_deg1", "r_deg2", "r_deg3", "r_deg4", "r_deg5", "r_deg6", "r_deg7" };
+        static const char* rightRootNames[] = { "r_r1", "r_r2", "r_r3", "r_r4", "r_r5", "r_r6", "r_r7" };
+        static constexpr bool degreeDefaults[] = { true, false, true, false, true, false, false };
+
+        for (int i = 0; i < 7; ++i) {
+            visit(80 + i, leftDegreeNames[i], c.leftChordDegrees[(size_t)i], degreeDefaults[i]);
+            visit(87 + i, leftRootNames[i], c.leftAllowedRoots[(size_t)i], true);
+            visit(100 + i, rightDegreeNames[i], c.rightChordDegrees[(size_t)i], degreeDefaults[i]);
+            visit(107 + i, rightRootNames[i], c.rightAllowedRoots[(size_t)i], true);
+        }
+
+        visit(94, "l_invMode", c.leftChordInversionMode, 0);
+        visit(95, "l_dropB", c.leftDropBass, false);
+        visit(114, "r_invMode", c.rightChordInversionMode, 0);
+        visit(115, "r_dropB", c.rightDropBass, false);
+        visit(120, "chEng", c.chordEngineEnabled, true);
+    }
+
+    // Human editable preset files
+    std::unique_ptr<juce::XmlElement> toXml() const {
+        auto xml = std::make_unique<juce::XmlElement>(xmlTag);
+
+        visitFields(*this, [&xml](int, const char* name, const auto& field, const auto&) {
+            xml->setAttribute(name, toXmlValue(field));
+            });
+
+        return xml;
+    }
+
+    // Attributes the file doesn't have load as they always have, see visitFields
+    static PresetConfig fromXml(const juce::XmlElement& xml) {
+        PresetConfig config;
+
+        visitFields(config, [&xml](int, const char* name, auto& field, const auto& xmlDefault) {
+            readXmlValue(xml, name, field, xmlDefault);
+            });
+
+        return config;
+    }
+
+    static constexpr const char* xmlTag = "GestureInstrumentState";
+
+    static juce::String toString(const IntervalList& list) {
+        juce::String text;
+        for (int i = 0; i < list.size; ++i) {
+            text += juce::String(list.values[(size_t)i]);
+            if (i < list.size - 1) text += ",";
+        }
+        return text;
+    }
+
+    static IntervalList parseIntervals(const juce::String& text) {
+        IntervalList list;
+        auto tokens = juce::StringArray::fromTokens(text, ",", "");
+
+        for (const auto& token : tokens) {
+            if (list.size == maxScaleIntervals) break;
+            if (token.trim().isNotEmpty()) list.values[(size_t)list.size++] = token.getIntValue();
+        }
+        return list;
+    }
+
+private:
+    static bool toXmlValue(bool value) { return value; }
+    static int toXmlValue(int value) { return value; }
+    static double toXmlValue(float value) { return (double)value; }
+    static juce::String toXmlValue(const IntervalList& value) { return toString(value); }
+
+    static void readXmlValue(const juce::XmlElement& xml, const char* name, bool& field, bool fallback) { field = xml.getBoolAttribute(name, fallback); }
+    static void readXmlValue(const juce::XmlElement& xml, const char* name, int& field, int fallback) { field = xml.getIntAttribute(name, fallback); }
+
+    static void readXmlValue(const juce::XmlElement& xml, const char* name, float& field, float fallback) {
+        field = (float)xml.getDoubleAttribute(name, (double)fallback);
+    }
+
+    static void readXmlValue(const juce::XmlElement& xml, const char* name, IntervalList& field, const IntervalList& fallback) {
+        auto parsed = parseIntervals(xml.getStringAttribute(name));
+        field = parsed.size > 0 ? parsed : fallback;
+    }
+};
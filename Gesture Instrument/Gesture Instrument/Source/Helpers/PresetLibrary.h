@@ -0,0 +1,371 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <vector>
+#include "PresetConfig.h"
+#include "PluginState.h"
+#include "../MIDI/GestureTarget.h"
+
+// Every preset file in a set of folders, parsed ahead of time on a background thread so switching presets in a show is
+// a lookup and a requestConfig, no file access or XML. What was parsed is cached in an index file, so a restart only
+// reparses files whose size or modification time changed. Folders are polled every few seconds and only rescanned when
+// their own modification time moves, which it does when a preset is saved from the settings page, copied in or
+// deleted while the plugin is open.
+// Index layout: int32 magic, int16 version, int32 folder count, folder paths, int32 preset count, then per preset its
+// path, int64 modification time in ms, int64 size and the config as a PluginState blob (int32 size, bytes).
+// Names, summaries and search text are rebuilt from the config on load rather than stored
+class PresetLibrary : private juce::Thread {
+public:
+    static constexpr juce::int32 indexMagic = 0x58504947; // "GIPX"
+    static constexpr int indexVersion = 1;
+    static constexpr int pollIntervalMs = 2000;
+
+    struct Preset {
+        juce::File file;
+        juce::String name;
+        juce::Time modified;
+        juce::int64 sizeInBytes = 0;
+        PresetConfig config;
+        juce::String summary;    // Mode, scale and mappings, for the browser
+        juce::String searchText; // Name and summary in lower case
+    };
+
+    using PresetList = std::vector<Preset>;
+
+    // The library the editor shares through a SharedResourcePointer. Starts with the user preset folder and the
+    // presets that ship with the plugin, folders presets are saved to or loaded from get added as they're used
+    PresetLibrary() : PresetLibrary(getDefaultIndexFile()) {
+        addDirectory(getUserPresetDirectory());
+        addDirectory(getBundledPresetDirectory());
+        startThread(juce::Thread::Priority::background);
+    }
+
+    // Nothing is scanned until scan is called, for callers that want it on their own thread
+    explicit PresetLibrary(const juce::File& indexFileToUse) : juce::Thread("Preset Library"), indexFile(indexFileToUse) {}
+
+    ~PresetLibrary() override {
+        signalThreadShouldExit();
+        notify();
+        stopThread(4000);
+    }
+
+    // Any thread. Only the folder's own files are scanned, not its subfolders. A folder that doesn't exist yet is
+    // kept and scanned once it does
+    void addDirectory(const juce::File& directory) {
+        if (directory == juce::File{}) return;
+
+        {
+            const juce::ScopedLock sl(directoryLock);
+            if (directories.contains(directory)) return;
+            directories.add(directory);
+        }
+
+        directoriesChanged.store(true);
+        rescan();
+    }
+
+    juce::Array<juce::File> getDirectories() const {
+        const juce::ScopedLock sl(directoryLock);
+        return directories;
+    }
+
+    // Wakes the background thread instead of waiting for the next poll, and scans every folder whether it has
+    // changed or not, for edits made in place that don't touch the folder
+    void rescan() {
+        rescanRequested.store(true);
+        notify();
+    }
+
+    // Brings the library up to date on the calling thread, reparsing only what changed, then publishes the new list
+    // and rewrites the index if anything did. The background thread calls this every poll
+    void scan() {
+        const juce::ScopedLock sl(scanLock);
+
+        if (!isIndexLoaded) {
+            isIndexLoaded = true;
+            loadIndex();
+        }
+
+        PresetList found;
+        bool changed = false;
+
+        for (const auto& directory : getDirectories()) {
+            for (const auto& file : directory.findChildFiles(juce::File::findFiles, false, "*.xml")) {
+                if (threadShouldExit()) return;
+
+                auto modified = file.getLastModificationTime();
+                auto size = file.getSize();
+
+                if (auto* known = findIndexed(file); known != nullptr && known->modified == modified && known->sizeInBytes == size) {
+                    found.push_back(*known);
+                    continue;
+                }
+
+                // Files that aren't presets are remembered too, so they aren't reparsed every poll
+                auto rejected = rejectedFiles.find(file.getFullPathName());
+                if (rejected != rejectedFiles.end() && rejected->second.modified == modified && rejected->second.sizeInBytes == size) continue;
+
+                changed = true;
+                auto xml = juce::XmlDocument::parse(file);
+
+                if (xml == nullptr || !xml->hasTagName(PresetConfig::xmlTag)) {
+                    rejectedFiles[file.getFullPathName()] = { modified, size };
+                    continue;
+                }
+
+                found.push_back(makePreset(file, modified, size, PresetConfig::fromXml(*xml)));
+            }
+        }
+
+        // Anything deleted or moved away
+        changed = changed || found.size() != indexed.size();
+
+        if (changed) {
+            std::sort(found.begin(), found.end(), [](const Preset& a, const Preset& b) { return a.name.compareNatural(b.name) < 0; });
+            indexed = found;
+            publish(indexed);
+        }
+
+        bool foldersChanged = directoriesChanged.exchange(false);
+        if (changed || foldersChanged) saveIndex();
+    }
+
+    // What the background thread runs every poll. Scans only if a folder was added, asked for with rescan, or one
+    // of the folders' modification times has moved since the last scan. Returns whether it scanned
+    bool scanIfChanged() {
+        const juce::ScopedLock sl(scanLock);
+
+        bool changed = rescanRequested.exchange(false) || directoriesChanged.load();
+
+        for (const auto& directory : getDirectories()) {
+            auto modified = directory.getLastModificationTime();
+            auto& stamp = directoryStamps[directory.getFullPathName()];
+
+            changed = changed || stamp != modified;
+            stamp = modified;
+        }
+
+        if (changed) scan();
+        return changed;
+    }
+
+    // Any thread, never waits for a scan. Sorted by name
+    std::shared_ptr<const PresetList> getPresets() const {
+        const juce::ScopedLock sl(presetLock);
+        return presets;
+    }
+
+    // Goes up by one every time a different list is published
+    int getGeneration() const { return generation.load(); }
+
+    // Positions in the list of the presets whose name or summary contain every word of the query, in any order and
+    // any case. An empty query matches everything
+    static std::vector<int> search(const PresetList& list, const juce::String& query) {
+        auto words = juce::StringArray::fromTokens(query.toLowerCase(), " \t", "");
+        words.removeEmptyStrings();
+
+        std::vector<int> matches;
+        for (int i = 0; i < (int)list.size(); ++i) {
+            const auto& text = list[(size_t)i].searchText;
+            bool matchesAll = std::all_of(words.begin(), words.end(), [&text](const juce::String& word) { return text.contains(word); });
+            if (matchesAll) matches.push_back(i);
+        }
+        return matches;
+    }
+
+    // One line for the browser, e.g. "MIDI | D Minor | MPE | L: Y Pitch | R: Pinch Mod Wheel, Index Vibrato"
+    static juce::String describe(const PresetConfig& c) {
+        static const char* noteNames[] = { "C", "C#", "D", "D#", "E", "F", "F#", "G", "G#", "A", "A#", "B" };
+        static const char* scaleNames[] = { "Chromatic", "Major", "Minor", "Major Pentatonic", "Minor Pentatonic", "Blues", "Dorian",
+                                            "Mixolydian", "Lydian", "Phrygian", "Harmonic Minor", "Locrian", "Unquantised", "Custom" };
+
+        juce::StringArray parts;
+
+        // OutputMode::OSC_Only is 0
+        parts.add(c.outputMode == 0 ? "OSC" : "MIDI");
+
+        juce::String scale = juce::isPositiveAndBelow(c.scaleType, 14) ? scaleNames[c.scaleType] : "Chromatic";
+        parts.add(juce::String(noteNames[((c.rootNote % 12) + 12) % 12]) + " " + scale);
+
+        if (c.isMpeEnabled) parts.add("MPE");
+
+        auto describeHand = [](const char* hand, std::initializer_list<std::pair<const char*, int>> targets) {
+            juce::StringArray mapped;
+            for (const auto& [axis, target] : targets) {
+                auto name = getTargetName(static_cast<GestureTarget>(target));
+                if (name != "None") mapped.add(juce::String(axis) + " " + name);
+            }
+            return mapped.isEmpty() ? juce::String() : juce::String(hand) + ": " + mapped.joinIntoString(", ");
+            };
+
+        auto left = describeHand("L", { { "X", c.leftXTarget }, { "Y", c.leftYTarget }, { "Z", c.leftZTarget }, { "Roll", c.leftRollTarget },
+                                        { "Grab", c.leftGrabTarget }, { "Pinch", c.leftPinchTarget }, { "Speed", c.leftSpeedTarget },
+                                        { "Thumb", c.leftThumbTarget }, { "Index", c.leftIndexTarget }, { "Middle", c.leftMiddleTarget },
+                                        { "Ring", c.leftRingTarget }, { "Pinky", c.leftPinkyTarget } });
+
+        auto right = describeHand("R", { { "X", c.rightXTarget }, { "Y", c.rightYTarget }, { "Z", c.rightZTarget }, { "Roll", c.rightRollTarget },
+                                         { "Grab", c.rightGrabTarget }, { "Pinch", c.rightPinchTarget }, { "Speed", c.rightSpeedTarget },
+                                         { "Thumb", c.rightThumbTarget }, { "Index", c.rightIndexTarget }, { "Middle", c.rightMiddleTarget },
+                                         { "Ring", c.rightRingTarget }, { "Pinky", c.rightPinkyTarget } });
+
+        if (left.isNotEmpty()) parts.add(left);
+        if (right.isNotEmpty()) parts.add(right);
+
+        return parts.joinIntoString(" | ");
+    }
+
+    static juce::File getDefaultIndexFile() {
+        return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+            .getChildFile("Gesture Instrument").getChildFile("PresetIndex.bin");
+    }
+
+    static juce::File getUserPresetDirectory() {
+        return juce::File::getSpecialLocation(juce::File::userDocumentsDirectory).getChildFile("Gesture Instrument Presets");
+    }
+
+    // The XML Presets folder from the repository, found by walking up from the plugin binary. Empty if the plugin
+    // was installed somewhere without it
+    static juce::File getBundledPresetDirectory() {
+        auto start = juce::File::getSpecialLocation(juce::File::currentExecutableFile);
+
+        for (auto folder = start.getParentDirectory(); ; folder = folder.getParentDirectory()) {
+            if (folder.getChildFile("XML Presets").isDirectory()) return folder.getChildFile("XML Presets");
+            if (folder.isRoot()) break;
+        }
+
+        return {};
+    }
+
+private:
+    struct FileStamp {
+        juce::Time modified;
+        juce::int64 sizeInBytes = 0;
+    };
+
+    const juce::File indexFile;
+
+    juce::CriticalSection directoryLock;
+    juce::Array<juce::File> directories;
+    std::atomic<bool> directoriesChanged{ false };
+    std::atomic<bool> rescanRequested{ false };
+
+    // Scan thread state
+    juce::CriticalSection scanLock;
+    bool isIndexLoaded = false;
+    PresetList indexed;
+    std::map<juce::String, FileStamp> rejectedFiles;
+    std::map<juce::String, juce::Time> directoryStamps;
+
+    juce::CriticalSection presetLock;
+    std::shared_ptr<const PresetList> presets = std::make_shared<const PresetList>();
+    std::atomic<int> generation{ 0 };
+
+    void run() override {
+        while (!threadShouldExit()) {
+            scanIfChanged();
+            wait(pollIntervalMs);
+        }
+    }
+
+    void publish(const PresetList& list) {
+        auto published = std::make_shared<const PresetList>(list);
+
+        {
+            const juce::ScopedLock sl(presetLock);
+            presets = std::move(published);
+        }
+
+        generation.fetch_add(1);
+    }
+
+    const Preset* findIndexed(const juce::File& file) const {
+        for (const auto& preset : indexed)
+            if (preset.file == file) return &preset;
+        return nullptr;
+    }
+
+    static Preset makePreset(const juce::File& file, juce::Time modified, juce::int64 size, const PresetConfig& config) {
+        Preset preset;
+        preset.file = file;
+        preset.name = file.getFileNameWithoutExtension();
+        preset.modified = modified;
+        preset.sizeInBytes = size;
+        preset.config = config;
+        preset.summary = describe(config);
+        preset.searchText = (preset.name + " " + preset.summary).toLowerCase();
+        return preset;
+    }
+
+    // The last scan's list straight away, so the browser has something to show before the folders are looked at
+    void loadIndex() {
+        juce::MemoryBlock data;
+        if (!indexFile.loadFileAsData(data)) return;
+
+        juce::MemoryInputStream in(data, false);
+        if (in.readInt() != indexMagic || in.readShort() != indexVersion) return;
+
+        int numDirectories = in.readInt();
+        for (int i = 0; i < numDirectories && !in.isExhausted(); ++i) {
+            juce::File directory(in.readString());
+
+            const juce::ScopedLock sl(directoryLock);
+            directories.addIfNotAlreadyThere(directory);
+        }
+
+        PresetList loaded;
+        int numPresets = in.readInt();
+
+        for (int i = 0; i < numPresets && !in.isExhausted(); ++i) {
+            juce::File file(in.readString());
+            auto modified = juce::Time(in.readInt64());
+            auto size = in.readInt64();
+
+            int stateSize = in.readInt();
+            if (stateSize <= 0 || stateSize > in.getNumBytesRemaining()) break;
+
+            juce::MemoryBlock state;
+            in.readIntoMemoryBlock(state, stateSize);
+
+            PluginState parsed;
+            if (parsed.read(state.getData(), (int)state.getSize())) loaded.push_back(makePreset(file, modified, size, parsed.config));
+        }
+
+        indexed = loaded;
+        publish(indexed);
+    }
+
+    void saveIndex() {
+        juce::MemoryBlock data;
+
+        {
+            juce::MemoryOutputStream out(data, false);
+            out.writeInt(indexMagic);
+            out.writeShort((short)indexVersion);
+
+            auto folders = getDirectories();
+            out.writeInt(folders.size());
+            for (const auto& directory : folders) out.writeString(directory.getFullPathName());
+
+            out.writeInt((int)indexed.size());
+            for (const auto& preset : indexed) {
+                out.writeString(preset.file.getFullPathName());
+                out.writeInt64(preset.modified.toMilliseconds());
+                out.writeInt64(preset.sizeInBytes);
+
+                PluginState state;
+                state.config = preset.config;
+
+                juce::MemoryBlock blob;
+                state.write(blob);
+                out.writeInt((int)blob.getSize());
+                out.write(blob.getData(), blob.getSize());
+            }
+        }
+
+        indexFile.getParentDirectory().createDirectory();
+        indexFile.replaceWithData(data.getData(), data.getSize());
+    }
+};
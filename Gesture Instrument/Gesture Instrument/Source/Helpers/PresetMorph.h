@@ -0,0 +1,150 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <cmath>
+#include "PresetConfig.h"
+#include "HandData.h"
+#include "AutoRanger.h"
+#include "../MIDI/GestureTarget.h"
+
+// How a requested preset takes over from the one playing. The preset always lands whole at a block boundary, this
+// only decides what happens to held notes and whether the static parameters jump or glide there
+struct PresetTransition {
+    enum class Notes {
+        handOver, // Held notes keep sounding and move to the new preset's notes the next time the hand is read
+        release   // Everything held is let go at the boundary
+    };
+
+    enum class Morph {
+        none, // Statics jump to the new preset's
+        time, // Statics glide over morphSeconds
+        leftX, leftY, leftZ, rightX, rightY, rightZ // Statics follow the hand across the play area, old preset at the low end
+    };
+
+    Notes notes = Notes::handOver;
+    Morph morph = Morph::none;
+    float morphSeconds = 2.0f;
+};
+
+// Audio thread side of a transition. Keeps the statics of the preset being left and of the one arriving, and works
+// out where between them each block sits. Gesture morphs last until the next transition replaces them
+class PresetMorph {
+public:
+    struct Static {
+        float PresetConfig::* field;
+        GestureTarget target;
+    };
+
+    // Every static parameter and the target it's sent as, the same pairs the static dials use
+    static constexpr int numStatics = 14;
+    static constexpr std::array<Static, numStatics> statics{ {
+        { &PresetConfig::staticVolume, GestureTarget::Volume },
+        { &PresetConfig::staticPan, GestureTarget::Pan },
+        { &PresetConfig::staticModulation, GestureTarget::Modulation },
+        { &PresetConfig::staticExpression, GestureTarget::Expression },
+        { &PresetConfig::staticCutoff, GestureTarget::Cutoff },
+        { &PresetConfig::staticResonance, GestureTarget::Resonance },
+        { &PresetConfig::staticAttack, GestureTarget::Attack },
+        { &PresetConfig::staticRelease, GestureTarget::Release },
+        { &PresetConfig::staticReverb, GestureTarget::Reverb },
+        { &PresetConfig::staticChorus, GestureTarget::Chorus },
+        { &PresetConfig::staticVibrato, GestureTarget::Vibrato },
+        { &PresetConfig::staticWaveform, GestureTarget::Waveform },
+        { &PresetConfig::staticDelay, GestureTarget::Delay },
+        { &PresetConfig::staticDistortion, GestureTarget::Distortion }
+    } };
+
+    // from is what's playing now, including wherever an unfinished morph had got to
+    void start(const PresetConfig& from, const PresetConfig& to, const PresetTransition& transition) {
+        for (size_t i = 0; i < statics.size(); ++i) {
+            startValues[i] = from.*(statics[i].field);
+            endValues[i] = to.*(statics[i].field);
+
+            // The synth already has the old values, from the dials or the last transition
+            sentValues[i] = startValues[i];
+        }
+
+        morph = transition.morph;
+        morphSeconds = transition.morphSeconds;
+        position = 0.0f;
+        isRunning = true;
+
+        if (morph == PresetTransition::Morph::none || (morph == PresetTransition::Morph::time && morphSeconds <= 0.0f)) position = 1.0f;
+    }
+
+    // True while the statics still need writing, including the block a time morph ends in
+    bool isActive() const { return isRunning; }
+
+    bool isFollowingGesture() const { return morph != PresetTransition::Morph::none && morph != PresetTransition::Morph::time; }
+
+    PresetTransition::Morph getMorph() const { return morph; }
+
+    float getPosition() const { return position; }
+
+    // Moves on by one block. handPosition is the followed axis from 0 to 1, or negative while that hand is away,
+    // which holds the statics where they are
+    void advance(float blockSeconds, float handPosition) {
+        if (!isRunning) return;
+
+        if (isFollowingGesture()) {
+            if (handPosition >= 0.0f) position = juce::jlimit(0.0f, 1.0f, handPosition);
+            return;
+        }
+
+        if (position < 1.0f) position = juce::jmin(1.0f, position + blockSeconds / morphSeconds);
+
+        // This block writes the end values, then the statics belong to the dials again
+        if (position >= 1.0f) isRunning = false;
+    }
+
+    float getValue(int index) const {
+        auto i = (size_t)index;
+        return position >= 1.0f ? endValues[i] : juce::jmap(position, startValues[i], endValues[i]);
+    }
+
+    // True if a static has moved at least minStep since it was last sent, or has just reached its end value, and
+    // marks it sent. Keeps a glide from sending more than the output can resolve
+    bool takeChange(int index, float minStep) {
+        auto i = (size_t)index;
+        float value = getValue(index);
+
+        if (value == sentValues[i]) return false;
+        if (std::abs(value - sentValues[i]) < minStep && value != endValues[i]) return false;
+
+        sentValues[i] = value;
+        return true;
+    }
+
+    // Where the hand sits along the axis a gesture morph follows, 0 to 1 across the play area, -1 without that hand
+    static float getHandPosition(PresetTransition::Morph morph, const HandData& leftHand, const HandData& rightHand, const PlayArea& area) {
+        using Morph = PresetTransition::Morph;
+
+        bool isLeft = morph == Morph::leftX || morph == Morph::leftY || morph == Morph::leftZ;
+        const auto& hand = isLeft ? leftHand : rightHand;
+        if (!hand.isPresent) return -1.0f;
+
+        auto normalise = [](float value, float low, float high) {
+            return high > low ? juce::jlimit(0.0f, 1.0f, (value - low) / (high - low)) : 0.0f;
+            };
+
+        switch (morph) {
+        case Morph::leftX: case Morph::rightX: return normalise(hand.currentHandPositionX, area.minX, area.maxX);
+        case Morph::leftY: case Morph::rightY: return normalise(hand.currentHandPositionY, area.minY, area.maxY);
+
+        // Inverted, as the Z axis is everywhere else
+        case Morph::leftZ: case Morph::rightZ: return 1.0f - normalise(hand.currentHandPositionZ, area.minZ, area.maxZ);
+        default: return -1.0f;
+        }
+    }
+
+private:
+    std::array<float, numStatics> startValues{};
+    std::array<float, numStatics> endValues{};
+    std::array<float, numStatics> sentValues{};
+
+    PresetTransition::Morph morph = PresetTransition::Morph::none;
+    float morphSeconds = 0.0f;
+    float position = 1.0f;
+    bool isRunning = false;
+};
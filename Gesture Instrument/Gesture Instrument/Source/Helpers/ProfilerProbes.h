@@ -0,0 +1,207 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <cmath>
+
+// Timings from one thread on their way to the message thread.
+// Pushing never blocks or allocates, a full ring drops the sample and counts it instead
+class ProbeRing {
+public:
+    // Producer side
+    void push(float value) {
+        int start1, size1, start2, size2;
+        fifo.prepareToWrite(1, start1, size1, start2, size2);
+
+        if (size1 == 0) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        samples[start1] = value;
+        fifo.finishedWrite(1);
+    }
+
+    // Consumer side, hands every waiting sample to the callback
+    template <typename Callback>
+    void drain(Callback&& callback) {
+        int start1, size1, start2, size2;
+        fifo.prepareToRead(fifo.getNumReady(), start1, size1, start2, size2);
+
+        for (int i = 0; i < size1; ++i) callback(samples[start1 + i]);
+        for (int i = 0; i < size2; ++i) callback(samples[start2 + i]);
+
+        fifo.finishedRead(size1 + size2);
+    }
+
+    int takeDropped() { return dropped.exchange(0, std::memory_order_relaxed); }
+
+private:
+    static constexpr int capacity = 1024;
+
+    juce::AbstractFifo fifo{ capacity };
+    float samples[capacity] = {};
+    std::atomic<int> dropped{ 0 };
+};
+
+// Log spaced buckets, so microseconds and whole seconds get the same relative precision.
+// Bucket 0 holds everything at or below the lowest value and reads back as 0, the last one everything above the highest
+class LogBucketScale {
+public:
+    static constexpr int numBuckets = 128;
+
+    LogBucketScale(float lowestValue, float highestValue)
+        : lowest(lowestValue), logRange(std::log(highestValue / lowestValue)) {
+    }
+
+    int bucketFor(float value) const {
+        if (!(value > lowest)) return 0;
+
+        float position = std::log(value / lowest) / logRange;
+        return juce::jlimit(1, numBuckets - 1, 1 + (int)(position * (float)(numBuckets - 2)));
+    }
+
+    float valueOf(int bucket) const {
+        if (bucket == 0) return 0.0f;
+
+        float position = ((float)bucket - 0.5f) / (float)(numBuckets - 2);
+        return lowest * std::exp(juce::jmin(1.0f, position) * logRange);
+    }
+
+private:
+    float lowest;
+    float logRange;
+};
+
+// Percentiles over the last few seconds of samples.
+// The window is a ring of slices so old samples fall out a slice at a time
+class RollingHistogram {
+public:
+    static constexpr int numBuckets = LogBucketScale::numBuckets;
+    static constexpr int numSlices = 8;
+
+    RollingHistogram(float lowestValue, float highestValue) : scale(lowestValue, highestValue) {
+        clear();
+    }
+
+    void add(float value) {
+        ++slices[(size_t)current][(size_t)scale.bucketFor(value)];
+        ++sliceCounts[(size_t)current];
+    }
+
+    // Starts a new slice, forgetting the oldest one
+    void advance() {
+        current = (current + 1) % numSlices;
+        slices[(size_t)current].fill(0);
+        sliceCounts[(size_t)current] = 0;
+    }
+
+    void clear() {
+        for (auto& slice : slices) slice.fill(0);
+        sliceCounts.fill(0);
+    }
+
+    int getCount() const {
+        int total = 0;
+        for (int count : sliceCounts) total += count;
+        return total;
+    }
+
+    // fraction is 0-1, 0.99 for p99. 0 while the window is empty
+    float getPercentile(float fraction) const {
+        int total = getCount();
+        if (total == 0) return 0.0f;
+
+        int target = juce::jlimit(1, total, (int)std::ceil(fraction * (float)total));
+        int seen = 0;
+
+        for (int bucket = 0; bucket < numBuckets; ++bucket) {
+            for (const auto& slice : slices) seen += slice[(size_t)bucket];
+            if (seen >= target) return scale.valueOf(bucket);
+        }
+
+        return scale.valueOf(numBuckets - 1);
+    }
+
+private:
+    LogBucketScale scale;
+
+    std::array<std::array<int, numBuckets>, numSlices> slices;
+    std::array<int, numSlices> sliceCounts;
+    int current = 0;
+};
+
+// Low overhead timings for the editor's profiler overlay.
+// Each probe has a single producing thread, the overlay drains them all on the message thread.
+// Nothing is measured unless the overlay is showing, until then a probe is one relaxed load
+class ProfilerProbes {
+public:
+    enum Probe {
+        blockTime,      // processBlock, ms                         audio thread
+        blockLoad,      // processBlock share of the block, %       audio thread
+        sensorToOutput, // frame capture to MIDI or OSC out, ms     audio thread
+        oscMessages,    // OSC messages sent per block              audio thread
+        sensorInterval, // time between sensor frames, ms           Leap thread
+        uiFrame,        // editor frame callback, ms                message thread
+        uiPaint,        // editor paint, ms                         message thread
+        numProbes
+    };
+
+    void setEnabled(bool shouldBeEnabled) { enabled.store(shouldBeEnabled, std::memory_order_relaxed); }
+    bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    void push(Probe probe, float value) {
+        if (isEnabled()) rings[probe].push(value);
+    }
+
+    ProbeRing& getRing(Probe probe) { return rings[probe]; }
+
+    static juce::int64 now() { return juce::Time::getHighResolutionTicks(); }
+
+    static float ticksToMs(juce::int64 ticks) {
+        return (float)(juce::Time::highResolutionTicksToSeconds(ticks) * 1000.0);
+    }
+
+    // Times its own scope into a probe
+    class ScopedTimer {
+    public:
+        ScopedTimer(ProfilerProbes& owner, Probe probeToUse)
+            : probes(owner), probe(probeToUse), startTicks(owner.isEnabled() ? now() : 0) {
+        }
+
+        ~ScopedTimer() {
+            if (startTicks != 0) probes.push(probe, ticksToMs(now() - startTicks));
+        }
+
+    private:
+        ProfilerProbes& probes;
+        Probe probe;
+        juce::int64 startTicks;
+    };
+
+    // Times a whole audio block, and how much of the time the block stands for it took
+    class ScopedBlockTimer {
+    public:
+        ScopedBlockTimer(ProfilerProbes& owner, int numSamples, double sampleRate)
+            : probes(owner), startTicks(owner.isEnabled() ? now() : 0),
+              blockMs(sampleRate > 0.0 ? (float)(numSamples * 1000.0 / sampleRate) : 0.0f) {
+        }
+
+        ~ScopedBlockTimer() {
+            if (startTicks == 0) return;
+
+            float elapsedMs = ticksToMs(now() - startTicks);
+            probes.push(blockTime, elapsedMs);
+            if (blockMs > 0.0f) probes.push(blockLoad, 100.0f * elapsedMs / blockMs);
+        }
+
+    private:
+        ProfilerProbes& probes;
+        juce::int64 startTicks;
+        float blockMs;
+    };
+
+private:
+    std::atomic<bool> enabled{ false };
+    ProbeRing rings[numProbes];
+};
@@ -0,0 +1,267 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <mutex>
+#include <vector>
+
+#ifndef GESTURE_RT_VERIFY
+ #define GESTURE_RT_VERIFY 0
+#endif
+
+// Catches real-time violations on the audio thread. Only active in builds with GESTURE_RT_VERIFY=1 (the unit test
+// target), everywhere else the hooks below are empty and compile away.
+// processBlock opens a Scope, and while one is open on a thread anything that can block it is recorded against the
+// innermost Site with a backtrace: heap allocation (the test runner's operator new calls onAllocation), blocking
+// entry to a CheckedCriticalSection, calls marked with onBlockingCall and loops that run past their LoopGuard
+class RealtimeVerifier {
+public:
+    enum class Kind {
+        allocation,
+        lock,
+        blockingCall,
+        loop,
+        overrun
+    };
+
+    struct Violation {
+        Kind kind = Kind::allocation;
+        juce::String site;
+        juce::String detail;
+        juce::String backtrace; // Where it first happened
+        int count = 0;
+    };
+
+    static const char* getKindName(Kind kind) {
+        switch (kind) {
+        case Kind::allocation:   return "allocation";
+        case Kind::lock:         return "lock";
+        case Kind::blockingCall: return "blocking call";
+        case Kind::loop:         return "unbounded loop";
+        case Kind::overrun:      return "overrun";
+        }
+        return "";
+    }
+
+    // Loops guarded by a LoopGuard may run this many times per block before they count as unbounded
+    static constexpr int maxLoopIterations = 10000;
+
+    // Violations are only recorded while enabled, so tests can switch it on around the part they check
+    static void setEnabled(bool shouldBeEnabled) { getState().enabled.store(shouldBeEnabled); }
+
+    // A Scope that runs this many times longer than the audio it stands for is an overrun. 0 switches the check off
+    static void setOverrunFactor(double factor) { getState().overrunFactor.store(factor); }
+
+    static std::vector<Violation> getViolations() {
+        auto& state = getState();
+        std::lock_guard<std::mutex> lock(state.lock);
+        return state.violations;
+    }
+
+    static void clear() {
+        auto& state = getState();
+        std::lock_guard<std::mutex> lock(state.lock);
+        state.violations.clear();
+    }
+
+    static juce::String describe(const Violation& violation) {
+        juce::String text;
+        text << getKindName(violation.kind) << " in " << violation.site;
+        if (violation.detail.isNotEmpty()) text << " (" << violation.detail << ")";
+        text << ", " << violation.count << (violation.count == 1 ? " time" : " times");
+        return text;
+    }
+
+    // Hooks
+
+    static void onAllocation() {
+#if GESTURE_RT_VERIFY
+        if (isWatching()) report(Kind::allocation, nullptr);
+#endif
+    }
+
+    static void onLock(const char* lockName) {
+#if GESTURE_RT_VERIFY
+        if (isWatching()) report(Kind::lock, lockName);
+#else
+        juce::ignoreUnused(lockName);
+#endif
+    }
+
+    static void onBlockingCall(const char* callName) {
+#if GESTURE_RT_VERIFY
+        if (isWatching()) report(Kind::blockingCall, callName);
+#else
+        juce::ignoreUnused(callName);
+#endif
+    }
+
+    // The audio callback, everything on this thread until it closes is checked
+    class Scope {
+    public:
+        Scope(int numSamples, double sampleRate) {
+#if GESTURE_RT_VERIFY
+            ++threadState().depth;
+            startTicks = juce::Time::getHighResolutionTicks();
+            blockSeconds = sampleRate > 0.0 ? numSamples / sampleRate : 0.0;
+#else
+            juce::ignoreUnused(numSamples, sampleRate);
+#endif
+        }
+
+        ~Scope() {
+#if GESTURE_RT_VERIFY
+            double factor = getState().overrunFactor.load();
+            double elapsed = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+
+            if (factor > 0.0 && blockSeconds > 0.0 && elapsed > blockSeconds * factor && isWatching())
+                report(Kind::overrun, nullptr);
+
+            --threadState().depth;
+#endif
+        }
+
+    private:
+#if GESTURE_RT_VERIFY
+        juce::int64 startTicks = 0;
+        double blockSeconds = 0.0;
+#endif
+        JUCE_DECLARE_NON_COPYABLE(Scope)
+    };
+
+    // Names the code violations are blamed on, the innermost one wins
+    class Site {
+    public:
+        explicit Site(const char* siteName) {
+#if GESTURE_RT_VERIFY
+            previous = threadState().site;
+            threadState().site = siteName;
+#else
+            juce::ignoreUnused(siteName);
+#endif
+        }
+
+        ~Site() {
+#if GESTURE_RT_VERIFY
+            threadState().site = previous;
+#endif
+        }
+
+    private:
+#if GESTURE_RT_VERIFY
+        const char* previous = nullptr;
+#endif
+        JUCE_DECLARE_NON_COPYABLE(Site)
+    };
+
+    // Counts the iterations of a loop whose length depends on data, call iterate() once per pass
+    class LoopGuard {
+    public:
+        explicit LoopGuard(const char* loopName) {
+#if GESTURE_RT_VERIFY
+            name = loopName;
+#else
+            juce::ignoreUnused(loopName);
+#endif
+        }
+
+        void iterate() {
+#if GESTURE_RT_VERIFY
+            if (++iterations == maxLoopIterations + 1 && isWatching()) report(Kind::loop, name);
+#endif
+        }
+
+    private:
+#if GESTURE_RT_VERIFY
+        const char* name = nullptr;
+        int iterations = 0;
+#endif
+        JUCE_DECLARE_NON_COPYABLE(LoopGuard)
+    };
+
+private:
+    struct State {
+        std::atomic<bool> enabled{ false };
+        std::atomic<double> overrunFactor{ 0.0 };
+        std::mutex lock;
+        std::vector<Violation> violations;
+    };
+
+    struct ThreadState {
+        int depth = 0;
+        const char* site = nullptr;
+        bool isReporting = false;
+    };
+
+    static State& getState() {
+        static State state;
+        return state;
+    }
+
+    static ThreadState& threadState() {
+        static thread_local ThreadState state;
+        return state;
+    }
+
+    static bool isWatching() {
+        const auto& thread = threadState();
+        return thread.depth > 0 && !thread.isReporting && getState().enabled.load(std::memory_order_relaxed);
+    }
+
+    // Recording allocates, so the thread stops being watched until it's done
+    static void report(Kind kind, const char* detail) {
+        auto& thread = threadState();
+        thread.isReporting = true;
+
+        juce::String site = thread.site != nullptr ? thread.site : "processBlock";
+        juce::String detailText = detail != nullptr ? detail : "";
+
+        {
+            auto& state = getState();
+            std::lock_guard<std::mutex> lock(state.lock);
+
+            auto existing = std::find_if(state.violations.begin(), state.violations.end(), [&](const Violation& v) {
+                return v.kind == kind && v.site == site && v.detail == detailText;
+                });
+
+            if (existing != state.violations.end()) {
+                ++existing->count;
+            }
+            else {
+                Violation violation;
+                violation.kind = kind;
+                violation.site = site;
+                violation.detail = detailText;
+                violation.backtrace = juce::SystemStats::getStackBacktrace();
+                violation.count = 1;
+                state.violations.push_back(violation);
+            }
+        }
+
+        thread.isReporting = false;
+    }
+};
+
+// A CriticalSection that reports blocking entry from inside a RealtimeVerifier::Scope.
+// Wraps the lock rather than deriving from it, so nothing can reach the unchecked enter through a juce::CriticalSection
+// reference or juce::ScopedLock. Trying the lock never blocks, so tryEnter is left alone
+class CheckedCriticalSection {
+public:
+    explicit CheckedCriticalSection(const char* lockName) : name(lockName) {}
+
+    void enter() const noexcept {
+        RealtimeVerifier::onLock(name);
+        lock.enter();
+    }
+
+    bool tryEnter() const noexcept { return lock.tryEnter(); }
+    void exit() const noexcept { lock.exit(); }
+
+    using ScopedLockType = juce::GenericScopedLock<CheckedCriticalSection>;
+    using ScopedTryLockType = juce::GenericScopedTryLock<CheckedCriticalSection>;
+
+private:
+    juce::CriticalSection lock;
+    const char* name;
+
+    JUCE_DECLARE_NON_COPYABLE(CheckedCriticalSection)
+};
\ No newline at end of file
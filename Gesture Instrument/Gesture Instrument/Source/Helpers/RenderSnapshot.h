@@ -0,0 +1,27 @@
+#pragma once
+
+#include "HandData.h"
+#include "AutoRanger.h"
+
+// Everything the editor draws from the audio thread, published as one piece after each block
+struct RenderSnapshot {
+    static constexpr int maxNotes = 8;
+
+    // Bumped every time the contents change, the editor skips repainting when it hasn't moved
+    unsigned long long version = 0;
+
+    HandData leftHand;
+    HandData rightHand;
+    bool isSensorConnected = false;
+
+    // -1 when nothing drove them this block, same as the managers' live values
+    float liveSustain = -1.0f;
+    float livePortamento = -1.0f;
+
+    int leftNotes[maxNotes] = { -1, -1, -1, -1, -1, -1, -1, -1 };
+    int rightNotes[maxNotes] = { -1, -1, -1, -1, -1, -1, -1, -1 };
+
+    // The bounds the managers normalised against, only differs from the thresholds while auto ranging
+    PlayArea playArea;
+    bool isAutoRanging = false;
+};
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+
+// Health counters from every thread for the /stats OSC feed.
+// Each counter has one producing thread that only adds to relaxed atomics, the publisher takes and zeroes them once
+// per period. Nothing is counted while the feed is off, until then every call is one relaxed load
+class RuntimeStats {
+public:
+    static constexpr int numMidiChannels = 16;
+
+    // One period's worth, as rates where that makes sense
+    struct Snapshot {
+        double periodSeconds = 0.0;
+
+        float sensorFps = 0.0f;
+        float sensorDroppedPerSecond = 0.0f;   // gaps in the sensor's frame ids, frames LeapC had that we never saw
+        float framesSkippedPerSecond = 0.0f;   // new frames from the Leap thread that no block read before the next one replaced them
+        float framesRepeatedPerSecond = 0.0f;  // blocks that read the same frame as the block before
+        float stalenessMeanMs = 0.0f;          // age of the frame getLatestData handed out, publish to pickup
+        float stalenessMaxMs = 0.0f;
+        int lockMisses = 0;                    // blocks where the Leap thread held the lock and the last frame was reused
+
+        std::array<float, numMidiChannels> midiEventsPerSecond{};
+        float oscPacketsPerSecond = 0.0f;
+
+        float audioLoadMeanPercent = 0.0f;     // processBlock time over the time its blocks stand for
+        float audioLoadMaxPercent = 0.0f;
+        float audioBlocksPerSecond = 0.0f;
+
+        float uiFps = 0.0f;
+    };
+
+    void setEnabled(bool shouldBeEnabled) { enabled.store(shouldBeEnabled, std::memory_order_relaxed); }
+    bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    // Leap thread, once per new sensor frame
+    void sensorFrame(long long frameId) {
+        if (!isEnabled()) return;
+
+        sensorFrames.fetch_add(1, std::memory_order_relaxed);
+        if (lastSensorFrame > 0 && frameId > lastSensorFrame + 1)
+            sensorDropped.fetch_add((int)juce::jmin(frameId - lastSensorFrame - 1, (long long)1000000), std::memory_order_relaxed);
+
+        lastSensorFrame = frameId;
+    }
+
+    // Audio thread, once per block with the frame getLatestData returned
+    void framePickedUp(long long frameId, double publishedSeconds, bool wasLocked) {
+        if (!isEnabled()) return;
+
+        if (!wasLocked) lockMisses.fetch_add(1, std::memory_order_relaxed);
+
+        if (frameId == lastPickedUpFrame) {
+            framesRepeated.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        framesPickedUp.fetch_add(1, std::memory_order_relaxed);
+        lastPickedUpFrame = frameId;
+
+        if (publishedSeconds <= 0.0) return;
+
+        float ageMs = (float)juce::jmax(0.0, (juce::Time::getMillisecondCounterHiRes() * 0.001 - publishedSeconds) * 1000.0);
+        stalenessSumMs.store(stalenessSumMs.load(std::memory_order_relaxed) + ageMs, std::memory_order_relaxed);
+        stalenessCount.fetch_add(1, std::memory_order_relaxed);
+        if (ageMs > stalenessMaxMs.load(std::memory_order_relaxed)) stalenessMaxMs.store(ageMs, std::memory_order_relaxed);
+    }
+
+    // Audio thread, once per block with everything it sent
+    void output(const juce::MidiBuffer& midi, int oscPackets) {
+        if (!isEnabled()) return;
+
+        for (const auto metadata : midi) {
+            int channel = metadata.getMessage().getChannel();
+            if (channel >= 1 && channel <= numMidiChannels) midiEvents[(size_t)(channel - 1)].fetch_add(1, std::memory_order_relaxed);
+        }
+
+        oscSent.fetch_add(oscPackets, std::memory_order_relaxed);
+    }
+
+    // Message thread, once per editor frame
+    void uiFrame() {
+        if (isEnabled()) uiFrames.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Times processBlock against the audio it stands for
+    class ScopedBlock {
+    public:
+        ScopedBlock(RuntimeStats& owner, int numSamples, double sampleRate)
+            : stats(owner), startTicks(owner.isEnabled() ? juce::Time::getHighResolutionTicks() : 0),
+              blockSeconds(sampleRate > 0.0 ? numSamples / sampleRate : 0.0) {
+        }
+
+        ~ScopedBlock() {
+            if (startTicks == 0 || blockSeconds <= 0.0) return;
+
+            double busySeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+            stats.addBlock(busySeconds, blockSeconds);
+        }
+
+    private:
+        RuntimeStats& stats;
+        juce::int64 startTicks;
+        double blockSeconds;
+    };
+
+    // Publisher thread. Rates over the period since the last call, and everything starts counting again from zero
+    Snapshot take(double periodSeconds) {
+        Snapshot s;
+        s.periodSeconds = periodSeconds;
+        if (periodSeconds <= 0.0) return s;
+
+        auto perSecond = [periodSeconds](int count) { return (float)(count / periodSeconds); };
+
+        s.sensorFps = perSecond(sensorFrames.exchange(0, std::memory_order_relaxed));
+        s.sensorDroppedPerSecond = perSecond(sensorDropped.exchange(0, std::memory_order_relaxed));
+        s.framesSkippedPerSecond = juce::jmax(0.0f, s.sensorFps - perSecond(framesPickedUp.exchange(0, std::memory_order_relaxed)));
+        s.framesRepeatedPerSecond = perSecond(framesRepeated.exchange(0, std::memory_order_relaxed));
+        s.lockMisses = lockMisses.exchange(0, std::memory_order_relaxed);
+
+        int stalenessSamples = stalenessCount.exchange(0, std::memory_order_relaxed);
+        float stalenessSum = stalenessSumMs.exchange(0.0f, std::memory_order_relaxed);
+        s.stalenessMeanMs = stalenessSamples > 0 ? stalenessSum / (float)stalenessSamples : 0.0f;
+        s.stalenessMaxMs = stalenessMaxMs.exchange(0.0f, std::memory_order_relaxed);
+
+        for (int channel = 0; channel < numMidiChannels; ++channel)
+            s.midiEventsPerSecond[(size_t)channel] = perSecond(midiEvents[(size_t)channel].exchange(0, std::memory_order_relaxed));
+        s.oscPacketsPerSecond = perSecond(oscSent.exchange(0, std::memory_order_relaxed));
+
+        int blocks = audioBlocks.exchange(0, std::memory_order_relaxed);
+        double busy = audioBusySeconds.exchange(0.0, std::memory_order_relaxed);
+        double audio = audioSeconds.exchange(0.0, std::memory_order_relaxed);
+        s.audioLoadMeanPercent = audio > 0.0 ? (float)(100.0 * busy / audio) : 0.0f;
+        s.audioLoadMaxPercent = audioLoadMaxPercent.exchange(0.0f, std::memory_order_relaxed);
+        s.audioBlocksPerSecond = perSecond(blocks);
+
+        s.uiFps = perSecond(uiFrames.exchange(0, std::memory_order_relaxed));
+        return s;
+    }
+
+private:
+    std::atomic<bool> enabled{ false };
+
+    // Leap thread
+    long long lastSensorFrame = 0;
+    std::atomic<int> sensorFrames{ 0 };
+    std::atomic<int> sensorDropped{ 0 };
+
+    // Audio thread. A sum or max read and written back can lose a sample that races with take, which is fine here
+    long long lastPickedUpFrame = 0;
+    std::atomic<int> framesPickedUp{ 0 };
+    std::atomic<int> framesRepeated{ 0 };
+    std::atomic<int> lockMisses{ 0 };
+    std::atomic<float> stalenessSumMs{ 0.0f };
+    std::atomic<int> stalenessCount{ 0 };
+    std::atomic<float> stalenessMaxMs{ 0.0f };
+
+    std::array<std::atomic<int>, numMidiChannels> midiEvents{};
+    std::atomic<int> oscSent{ 0 };
+
+    std::atomic<int> audioBlocks{ 0 };
+    std::atomic<double> audioBusySeconds{ 0.0 };
+    std::atomic<double> audioSeconds{ 0.0 };
+    std::atomic<float> audioLoadMaxPercent{ 0.0f };
+
+    // Message thread
+    std::atomic<int> uiFrames{ 0 };
+
+    void addBlock(double busySeconds, double blockSeconds) {
+        audioBlocks.fetch_add(1, std::memory_order_relaxed);
+        audioBusySeconds.store(audioBusySeconds.load(std::memory_order_relaxed) + busySeconds, std::memory_order_relaxed);
+        audioSeconds.store(audioSeconds.load(std::memory_order_relaxed) + blockSeconds, std::memory_order_relaxed);
+
+        float loadPercent = (float)(100.0 * busySeconds / blockSeconds);
+        if (loadPercent > audioLoadMaxPercent.load(std::memory_order_relaxed)) audioLoadMaxPercent.store(loadPercent, std::memory_order_relaxed);
+    }
+};
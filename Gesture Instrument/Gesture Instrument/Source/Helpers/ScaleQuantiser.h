@@ -1,14 +1,38 @@
 #pragma once
 
 #include <JuceHeader.h>
-#include <vector>
 #include <array>
+#include <initializer_list>
 
 class ScaleQuantiser {
 public:
     ScaleQuantiser() {}
 
-    std::vector<int> customIntervals = { 0, 2, 4, 7, 9 };
+    // Semitones above the root. A scale never has more than the 12 of an octave, so this lives on the stack and
+    // quantising or swapping the custom scale on the audio thread never allocates
+    struct Intervals {
+        static constexpr int maxIntervals = 12;
+
+        Intervals() = default;
+        Intervals(std::initializer_list<int> list) { for (int interval : list) add(interval); }
+
+        // Past maxIntervals is dropped
+        void add(int interval) {
+            if (count < maxIntervals) values[(size_t)count++] = interval;
+        }
+
+        int size() const { return count; }
+        bool empty() const { return count == 0; }
+        int operator[](int index) const { return values[(size_t)index]; }
+        const int* begin() const { return values.data(); }
+        const int* end() const { return values.data() + count; }
+
+    private:
+        std::array<int, maxIntervals> values{};
+        int count = 0;
+    };
+
+    Intervals customIntervals = { 0, 2, 4, 7, 9 };
 
     int getQuantisedNote(float normalizedPosition, int rootNote, int scaleType) {
         std::array<bool, 7> allAllowed = { true, true, true, true, true, true, true };
@@ -19,13 +43,13 @@ public:
         normalizedPosition = juce::jlimit(0.0f, 1.0f, normalizedPosition);
         int rawNote = static_cast<int>(normalizedPosition * 127.0f);
 
-        std::vector<int> fullIntervals = getScaleIntervals(scaleType);
-        std::vector<int> filteredIntervals;
+        Intervals fullIntervals = getScaleIntervals(scaleType);
+        Intervals filteredIntervals;
 
         if (fullIntervals.size() == 7) {
-            for (size_t i = 0; i < fullIntervals.size(); ++i) {
-                if (allowedRoots[i]) {
-                    filteredIntervals.push_back(fullIntervals[i]);
+            for (int i = 0; i < fullIntervals.size(); ++i) {
+                if (allowedRoots[(size_t)i]) {
+                    filteredIntervals.add(fullIntervals[i]);
                 }
             }
         }
@@ -41,7 +65,7 @@ public:
         return juce::jlimit(0, 127, finalNote);
     }
 
-    std::vector<int> getScaleIntervals(int scaleType) {
+    Intervals getScaleIntervals(int scaleType) const {
         switch (scaleType) {
         case 1:  return { 0, 2, 4, 5, 7, 9, 11 };        // Major
         case 2:  return { 0, 2, 3, 5, 7, 8, 10 };        // Minor
@@ -57,15 +81,15 @@ public:
         case 13: return customIntervals;                 // Custom
         case 12:                                         // Unquantised
         default: {                                       // Chromatic (0)
-            std::vector<int> chromatic;
-            for (int i = 0; i < 12; ++i) chromatic.push_back(i);
+            Intervals chromatic;
+            for (int i = 0; i < 12; ++i) chromatic.add(i);
             return chromatic;
         }
         }
     }
 
 private:
-    int snapToScale(int rawNote, int rootNote, const std::vector<int>& intervals) {
+    int snapToScale(int rawNote, int rootNote, const Intervals& intervals) {
         int closestNote = -1;
         int minDistance = 1000;
 
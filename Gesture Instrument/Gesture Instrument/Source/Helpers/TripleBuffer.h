@@ -0,0 +1,36 @@
+#pragma once
+
+#include <atomic>
+
+// Single producer, single consumer hand-off of a whole struct without locks.
+// The writer fills its own slot and swaps it into the middle, the reader swaps the middle out for its own slot,
+// so neither side ever sees a half written value and neither side waits for the other
+template <typename T>
+class TripleBuffer {
+public:
+    // Producer side
+    T& getWriteBuffer() { return buffers[writeIndex]; }
+
+    void publish() {
+        writeIndex = middle.exchange(writeIndex | freshBit, std::memory_order_acq_rel) & indexMask;
+    }
+
+    // Consumer side, true if a newer value was swapped in. The read buffer stays valid until the next call
+    bool acquire() {
+        if ((middle.load(std::memory_order_relaxed) & freshBit) == 0) return false;
+
+        readIndex = middle.exchange(readIndex, std::memory_order_acq_rel) & indexMask;
+        return true;
+    }
+
+    const T& getReadBuffer() const { return buffers[readIndex]; }
+
+private:
+    static constexpr int indexMask = 3;
+    static constexpr int freshBit = 4;
+
+    T buffers[3] = {};
+    int writeIndex = 0;
+    int readIndex = 1;
+    std::atomic<int> middle{ 2 };
+};
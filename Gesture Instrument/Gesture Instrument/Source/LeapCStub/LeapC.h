@@ -0,0 +1,149 @@
+#pragma once
+
+// Stand-in for the Ultraleap LeapC.h, for builds without the Leap SDK (Linux CI, render boxes, benchmarks).
+// Only the part of the API LeapService uses is declared, with the same names, fields and event flow as the SDK.
+// Put this folder on the header path instead of the SDK's include folder and define GESTURE_LEAPC_STUB=1,
+// frames then come from whatever LeapCStub.h source is installed rather than a device
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum _eLeapRS {
+    eLeapRS_Success = 0x00000000,
+    eLeapRS_UnknownError = (int32_t)0xE2010000,
+    eLeapRS_InvalidArgument = (int32_t)0xE2010001,
+    eLeapRS_Timeout = (int32_t)0xE2010004,
+    eLeapRS_NotConnected = (int32_t)0xE2010005
+} eLeapRS;
+
+typedef enum _eLeapEventType {
+    eLeapEventType_None = 0,
+    eLeapEventType_Connection = 1,
+    eLeapEventType_ConnectionLost = 2,
+    eLeapEventType_Device = 3,
+    eLeapEventType_DeviceFailure = 4,
+    eLeapEventType_Policy = 5,
+    eLeapEventType_Tracking = 0x100,
+    eLeapEventType_DeviceLost = 0x104
+} eLeapEventType;
+
+typedef enum _eLeapHandType {
+    eLeapHandType_Left = 0,
+    eLeapHandType_Right = 1
+} eLeapHandType;
+
+typedef enum _eLeapPolicyFlag {
+    eLeapPolicyFlag_BackgroundFrames = 0x00000001
+} eLeapPolicyFlag;
+
+typedef struct _LEAP_CONNECTION* LEAP_CONNECTION;
+
+typedef struct _LEAP_CONNECTION_CONFIG {
+    uint32_t size;
+    uint32_t flags;
+    const char* server_namespace;
+} LEAP_CONNECTION_CONFIG;
+
+typedef struct _LEAP_VECTOR {
+    float x;
+    float y;
+    float z;
+} LEAP_VECTOR;
+
+typedef struct _LEAP_QUATERNION {
+    float x;
+    float y;
+    float z;
+    float w;
+} LEAP_QUATERNION;
+
+typedef struct _LEAP_BONE {
+    LEAP_VECTOR prev_joint;
+    LEAP_VECTOR next_joint;
+    float width;
+    LEAP_QUATERNION rotation;
+} LEAP_BONE;
+
+// Bones run metacarpal, proximal, intermediate, distal
+typedef struct _LEAP_DIGIT {
+    int32_t finger_id;
+    LEAP_BONE bones[4];
+    uint32_t is_extended;
+} LEAP_DIGIT;
+
+typedef struct _LEAP_PALM {
+    LEAP_VECTOR position;
+    LEAP_VECTOR stabilized_position;
+    LEAP_VECTOR velocity;
+    LEAP_VECTOR normal;
+    float width;
+    LEAP_VECTOR direction;
+    LEAP_QUATERNION orientation;
+} LEAP_PALM;
+
+// Digits run thumb, index, middle, ring, pinky
+typedef struct _LEAP_HAND {
+    uint32_t id;
+    uint32_t flags;
+    eLeapHandType type;
+    float confidence;
+    uint64_t visible_time;
+    float pinch_distance;
+    float grab_angle;
+    float pinch_strength;
+    float grab_strength;
+    LEAP_PALM palm;
+    LEAP_DIGIT digits[5];
+    LEAP_BONE arm;
+} LEAP_HAND;
+
+typedef struct _LEAP_FRAME_HEADER {
+    void* reserved;
+    int64_t frame_id;
+    int64_t timestamp;
+} LEAP_FRAME_HEADER;
+
+typedef struct _LEAP_TRACKING_EVENT {
+    LEAP_FRAME_HEADER info;
+    int64_t tracking_frame_id;
+    uint32_t nHands;
+    LEAP_HAND* pHands;
+    float framerate;
+} LEAP_TRACKING_EVENT;
+
+typedef struct _LEAP_CONNECTION_EVENT {
+    uint32_t flags;
+} LEAP_CONNECTION_EVENT;
+
+typedef struct _LEAP_DEVICE_EVENT {
+    uint32_t flags;
+    uint32_t status;
+} LEAP_DEVICE_EVENT;
+
+typedef struct _LEAP_CONNECTION_MESSAGE {
+    uint32_t size;
+    eLeapEventType type;
+    union {
+        const void* pointer;
+        const LEAP_CONNECTION_EVENT* connection_event;
+        const LEAP_DEVICE_EVENT* device_event;
+        const LEAP_TRACKING_EVENT* tracking_event;
+    };
+} LEAP_CONNECTION_MESSAGE;
+
+eLeapRS LeapCreateConnection(const LEAP_CONNECTION_CONFIG* pConfig, LEAP_CONNECTION* phConnection);
+eLeapRS LeapOpenConnection(LEAP_CONNECTION hConnection);
+eLeapRS LeapPollConnection(LEAP_CONNECTION hConnection, uint32_t timeout, LEAP_CONNECTION_MESSAGE* evt);
+eLeapRS LeapSetPolicyFlags(LEAP_CONNECTION hConnection, uint64_t set, uint64_t clear);
+void LeapCloseConnection(LEAP_CONNECTION hConnection);
+void LeapDestroyConnection(LEAP_CONNECTION hConnection);
+
+// Microseconds on the same clock as frame timestamps
+int64_t LeapGetNow(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,139 @@
+#if GESTURE_LEAPC_STUB
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include "LeapCStub.h"
+
+struct _LEAP_CONNECTION {
+    bool isOpen = false;
+    std::deque<eLeapEventType> pendingEvents;
+
+    // Whatever the last poll handed out has to stay valid until the next poll, like the real library
+    LeapCStub::Frame frame;
+    LEAP_TRACKING_EVENT trackingEvent = {};
+    LEAP_CONNECTION_EVENT connectionEvent = {};
+    LEAP_DEVICE_EVENT deviceEvent = {};
+    int64_t nextFrameId = 1;
+};
+
+namespace {
+    std::mutex stubLock;
+    std::shared_ptr<LeapCStub::FrameSource> frameSource;
+    std::vector<LEAP_CONNECTION> openConnections;
+    bool deviceConnected = true;
+
+    // Fills in the message for the next queued or due event, false if there's nothing yet. Called with stubLock held
+    bool takeEvent(LEAP_CONNECTION connection, LEAP_CONNECTION_MESSAGE* message) {
+        message->size = sizeof(LEAP_CONNECTION_MESSAGE);
+
+        if (!connection->pendingEvents.empty()) {
+            message->type = connection->pendingEvents.front();
+            connection->pendingEvents.pop_front();
+
+            if (message->type == eLeapEventType_Connection || message->type == eLeapEventType_ConnectionLost)
+                message->connection_event = &connection->connectionEvent;
+            else
+                message->device_event = &connection->deviceEvent;
+
+            return true;
+        }
+
+        if (!deviceConnected || frameSource == nullptr) return false;
+        if (!frameSource->nextFrame(LeapGetNow(), connection->frame)) return false;
+
+        auto& event = connection->trackingEvent;
+        event = {};
+        event.info.frame_id = connection->nextFrameId;
+        event.info.timestamp = connection->frame.timestamp;
+        event.tracking_frame_id = connection->nextFrameId++;
+        event.nHands = (uint32_t)connection->frame.hands.size();
+        event.pHands = connection->frame.hands.empty() ? nullptr : connection->frame.hands.data();
+
+        message->type = eLeapEventType_Tracking;
+        message->tracking_event = &event;
+        return true;
+    }
+}
+
+namespace LeapCStub {
+    void setFrameSource(std::shared_ptr<FrameSource> source) {
+        std::lock_guard<std::mutex> lock(stubLock);
+        frameSource = std::move(source);
+    }
+
+    void setDeviceConnected(bool shouldBeConnected) {
+        std::lock_guard<std::mutex> lock(stubLock);
+        if (deviceConnected == shouldBeConnected) return;
+
+        deviceConnected = shouldBeConnected;
+        for (auto* connection : openConnections)
+            connection->pendingEvents.push_back(shouldBeConnected ? eLeapEventType_Device : eLeapEventType_DeviceLost);
+    }
+}
+
+eLeapRS LeapCreateConnection(const LEAP_CONNECTION_CONFIG*, LEAP_CONNECTION* phConnection) {
+    if (phConnection == nullptr) return eLeapRS_InvalidArgument;
+
+    *phConnection = new _LEAP_CONNECTION();
+    return eLeapRS_Success;
+}
+
+eLeapRS LeapOpenConnection(LEAP_CONNECTION hConnection) {
+    if (hConnection == nullptr) return eLeapRS_InvalidArgument;
+
+    std::lock_guard<std::mutex> lock(stubLock);
+    if (hConnection->isOpen) return eLeapRS_Success;
+
+    // Same order the service sends them in, connection first and then any device already plugged in
+    hConnection->isOpen = true;
+    hConnection->pendingEvents.push_back(eLeapEventType_Connection);
+    if (deviceConnected) hConnection->pendingEvents.push_back(eLeapEventType_Device);
+
+    openConnections.push_back(hConnection);
+    return eLeapRS_Success;
+}
+
+eLeapRS LeapPollConnection(LEAP_CONNECTION hConnection, uint32_t timeout, LEAP_CONNECTION_MESSAGE* evt) {
+    if (hConnection == nullptr || evt == nullptr) return eLeapRS_InvalidArgument;
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+
+    for (;;) {
+        {
+            std::lock_guard<std::mutex> lock(stubLock);
+            if (!hConnection->isOpen) return eLeapRS_NotConnected;
+            if (takeEvent(hConnection, evt)) return eLeapRS_Success;
+        }
+
+        if (std::chrono::steady_clock::now() >= deadline) return eLeapRS_Timeout;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+eLeapRS LeapSetPolicyFlags(LEAP_CONNECTION hConnection, uint64_t, uint64_t) {
+    return hConnection != nullptr ? eLeapRS_Success : eLeapRS_InvalidArgument;
+}
+
+void LeapCloseConnection(LEAP_CONNECTION hConnection) {
+    if (hConnection == nullptr) return;
+
+    std::lock_guard<std::mutex> lock(stubLock);
+    hConnection->isOpen = false;
+    hConnection->pendingEvents.clear();
+    openConnections.erase(std::remove(openConnections.begin(), openConnections.end(), hConnection), openConnections.end());
+}
+
+void LeapDestroyConnection(LEAP_CONNECTION hConnection) {
+    LeapCloseConnection(hConnection);
+    delete hConnection;
+}
+
+int64_t LeapGetNow(void) {
+    auto sinceEpoch = std::chrono::steady_clock::now().time_since_epoch();
+    return (int64_t)std::chrono::duration_cast<std::chrono::microseconds>(sinceEpoch).count();
+}
+
+#endif
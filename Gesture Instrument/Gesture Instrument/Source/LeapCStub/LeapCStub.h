@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "LeapC.h"
+#include "../Helpers/HandData.h"
+
+// Where the stub LeapC gets its frames from. Only compiled in with GESTURE_LEAPC_STUB=1, see LeapC.h in this folder.
+// Frames go through LeapPollConnection as tracking events, so LeapService parses them exactly as it would the device's
+namespace LeapCStub {
+    struct Frame {
+        // Microseconds on the LeapGetNow clock
+        int64_t timestamp = 0;
+        std::vector<LEAP_HAND> hands;
+    };
+
+    class FrameSource {
+    public:
+        virtual ~FrameSource() = default;
+
+        // Fill in the next frame due by nowMicros, false if nothing is due yet
+        virtual bool nextFrame(int64_t nowMicros, Frame& frame) = 0;
+    };
+
+    // Installs the source every open connection polls, nullptr leaves the sensor connected but with no frames
+    void setFrameSource(std::shared_ptr<FrameSource> source);
+
+    // Plug or unplug the pretend device, open connections get a Device or DeviceLost event
+    void setDeviceConnected(bool shouldBeConnected);
+
+    // Frames with timestamps relative to the first one, played back in real time from the first poll
+    class RecordedSession : public FrameSource {
+    public:
+        explicit RecordedSession(std::vector<Frame> framesToPlay, bool shouldLoop = false)
+            : frames(std::move(framesToPlay)), looping(shouldLoop) {
+        }
+
+        bool nextFrame(int64_t nowMicros, Frame& frame) override {
+            if (frames.empty()) return false;
+
+            if (startMicros < 0) startMicros = nowMicros - frames.front().timestamp;
+
+            if (position >= frames.size()) {
+                if (!looping) return false;
+
+                // Next pass starts one frame interval after the last frame
+                int64_t length = frames.back().timestamp - frames.front().timestamp;
+                int64_t gap = frames.size() > 1 ? length / (int64_t)(frames.size() - 1) : 1000;
+                startMicros += length + gap;
+                position = 0;
+            }
+
+            int64_t due = startMicros + frames[position].timestamp;
+            if (due > nowMicros) return false;
+
+            frame = frames[position++];
+            frame.timestamp = due;
+            return true;
+        }
+
+        bool isFinished() const { return !looping && position >= frames.size(); }
+
+    private:
+        std::vector<Frame> frames;
+        bool looping;
+        size_t position = 0;
+        int64_t startMicros = -1;
+    };
+
+    // Frames made on demand at a fixed rate. The generator gets the frame number and seconds since the first frame
+    class GeneratedHands : public FrameSource {
+    public:
+        using Generator = std::function<void(int frameIndex, double seconds, Frame& frame)>;
+
+        GeneratedHands(double rateHz, Generator generatorToUse)
+            : intervalMicros((int64_t)std::llround(1.0e6 / rateHz)), generator(std::move(generatorToUse)) {
+        }
+
+        bool nextFrame(int64_t nowMicros, Frame& frame) override {
+            if (startMicros < 0) startMicros = nowMicros;
+
+            int64_t due = startMicros + frameIndex * intervalMicros;
+            if (due > nowMicros) return false;
+
+            frame.hands.clear();
+            generator(frameIndex, (double)(due - startMicros) * 1.0e-6, frame);
+            frame.timestamp = due;
+            ++frameIndex;
+            return true;
+        }
+
+    private:
+        int64_t intervalMicros;
+        Generator generator;
+        int64_t startMicros = -1;
+        int frameIndex = 0;
+    };
+
+    // The reverse of LeapService::convertLeapEventToHandData, for feeding HandData based generators through LeapC
+    inline LEAP_HAND makeHand(const HandData& data, eLeapHandType type) {
+        LEAP_HAND hand = {};
+        hand.type = type;
+        hand.palm.position = { data.currentHandPositionX, data.currentHandPositionY, data.currentHandPositionZ };
+        hand.palm.orientation.z = data.currentWristRotation;
+        hand.grab_strength = data.grabStrength;
+        hand.pinch_strength = data.pinchStrength;
+
+        for (int f = 0; f < 5; ++f) {
+            const FingerData& finger = data.fingers[f];
+            LEAP_DIGIT& digit = hand.digits[f];
+
+            digit.finger_id = f;
+            digit.bones[0].next_joint = { finger.knuckleX, finger.knuckleY, finger.knuckleZ };
+            digit.bones[1].next_joint = { finger.joint2X, finger.joint2Y, finger.joint2Z };
+            digit.bones[2].next_joint = { finger.joint1X, finger.joint1Y, finger.joint1Z };
+            digit.bones[3].next_joint = { finger.tipX, finger.tipY, finger.tipZ };
+            digit.is_extended = finger.isExtended ? 1 : 0;
+        }
+
+        return hand;
+    }
+}
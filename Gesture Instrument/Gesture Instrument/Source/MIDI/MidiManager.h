@@ -5,9 +5,10 @@
 #include <array>
 #include <vector>
 #include "GestureTarget.h"
-#include "MusicalRangeMode.h" 
+#include "../Helpers/MusicalRangeMode.h"
 #include "../Helpers/HandData.h"
 #include "../Helpers/ScaleQuantiser.h"
+#include "../Helpers/RealtimeVerifier.h"
 
 class MidiManager {
 private:
@@ -24,13 +25,18 @@ private:
     struct HandMpeState {
         MpeVoice voices[5]; // 5 independent MIDI channels per hand
         bool isTriggered = false;
+        float strikeGateRemaining = 0.0f;
     };
 
     struct HandNoteState {
         std::vector<int> activeNotes;
         bool isNoteOn = false;
+        float strikeGateRemaining = 0.0f;
     };
 
+    // How long a struck note is held before its note off
+    static constexpr float strikeGateSeconds = 0.25f;
+
     HandMpeState leftMpeState;
     HandMpeState rightMpeState;
     HandNoteState leftNoteState;
@@ -47,6 +53,17 @@ private:
     }
 
 public:
+    // Strike triggering replaces the NoteTrigger threshold, velocities are -1 when that hand didn't strike this block.
+    // Offsets are where in the block the strike's notes go
+    struct StrikeInput {
+        bool isEnabled = false;
+        float leftVelocity = -1.0f;
+        float rightVelocity = -1.0f;
+        int leftSampleOffset = 0;
+        int rightSampleOffset = 0;
+        float blockSeconds = 0.0f;
+    };
+
     // Allocates MIDI MPE channels 2-15
     MidiManager()
     {
@@ -59,7 +76,7 @@ public:
         }
     }
 
-    void updateCustomScale(const std::vector<int>& newScale) {
+    void updateCustomScale(const ScaleQuantiser::Intervals& newScale) {
         quantiser.customIntervals = newScale;
     }
 
@@ -85,14 +102,17 @@ public:
         std::array<bool, 7> leftDiatonicDegrees, std::array<bool, 7> leftAllowedRoots, int leftInversionMode, bool leftDropBass,
         std::array<bool, 7> rightDiatonicDegrees, std::array<bool, 7> rightAllowedRoots, int rightInversionMode, bool rightDropBass,
         bool chordEngineEnabled,
-        std::atomic<int>* leftNotesOut, std::atomic<int>* rightNotesOut) {
+        std::atomic<int>* leftNotesOut, std::atomic<int>* rightNotesOut,
+        GestureTarget leftSpeedTarget = GestureTarget::None, GestureTarget rightSpeedTarget = GestureTarget::None,
+        const StrikeInput& strikes = {}) {
+        RealtimeVerifier::Site site("MidiManager::processHandData");
 
         float centerX = (minX + maxX) / 2.0f;
         float leftMaxX = enableSplitXAxis ? centerX : maxX;
         float rightMinX = enableSplitXAxis ? centerX : minX;
 
         // Normalise 3D data 
-        float leftX = -1.0f, leftY = -1.0f, leftZ = -1.0f, leftRoll = -1.0f, leftGrab = -1.0f, leftPinch = -1.0f;
+        float leftX = -1.0f, leftY = -1.0f, leftZ = -1.0f, leftRoll = -1.0f, leftGrab = -1.0f, leftPinch = -1.0f, leftSpeed = -1.0f;
         if (leftHand.isPresent) {
             leftX = normalizeAxis(leftHand.currentHandPositionX, minX, leftMaxX, sensitivity);
             leftY = normalizeAxis(leftHand.currentHandPositionY, minY, maxY, sensitivity);
@@ -103,9 +123,10 @@ public:
             leftRoll = juce::jlimit(0.0f, 1.0f, baseLeftRoll * wMult);
             leftGrab = juce::jlimit(0.0f, 1.0f, leftHand.grabStrength * gMult);
             leftPinch = juce::jlimit(0.0f, 1.0f, leftHand.pinchStrength * pMult);
+            leftSpeed = leftHand.getNormalisedSpeed();
         }
 
-        float rightX = -1.0f, rightY = -1.0f, rightZ = -1.0f, rightRoll = -1.0f, rightGrab = -1.0f, rightPinch = -1.0f;
+        float rightX = -1.0f, rightY = -1.0f, rightZ = -1.0f, rightRoll = -1.0f, rightGrab = -1.0f, rightPinch = -1.0f, rightSpeed = -1.0f;
         if (rightHand.isPresent) {
             rightX = normalizeAxis(rightHand.currentHandPositionX, rightMinX, maxX, sensitivity);
             rightY = normalizeAxis(rightHand.currentHandPositionY, minY, maxY, sensitivity);
@@ -115,30 +136,32 @@ public:
             rightRoll = juce::jlimit(0.0f, 1.0f, baseRightRoll * wMult);
             rightGrab = juce::jlimit(0.0f, 1.0f, rightHand.grabStrength * gMult);
             rightPinch = juce::jlimit(0.0f, 1.0f, rightHand.pinchStrength * pMult);
+            rightSpeed = rightHand.getNormalisedSpeed();
         }
 
         // Lambda to ensure axis aligns with gesture
-        auto getTargetValue = [&](GestureTarget desiredTarget, float x, float y, float z, float roll, float grab, float pinch,
-            GestureTarget targetX, GestureTarget targetY, GestureTarget targetZ, GestureTarget targetRoll, GestureTarget targetGrab, GestureTarget targetPinch) {
+        auto getTargetValue = [&](GestureTarget desiredTarget, float x, float y, float z, float roll, float grab, float pinch, float speed,
+            GestureTarget targetX, GestureTarget targetY, GestureTarget targetZ, GestureTarget targetRoll, GestureTarget targetGrab, GestureTarget targetPinch, GestureTarget targetSpeed) {
                 if (targetX == desiredTarget) return x;       if (targetY == desiredTarget) return y;       if (targetZ == desiredTarget) return z;
                 if (targetRoll == desiredTarget) return roll; if (targetGrab == desiredTarget) return grab; if (targetPinch == desiredTarget) return pinch;
+                if (targetSpeed == desiredTarget) return speed;
                 return -1.0f;
             };
 
-        float leftPitchVal = getTargetValue(GestureTarget::Pitch, leftX, leftY, leftZ, leftRoll, leftGrab, leftPinch, leftXTarget, leftYTarget, leftZTarget, leftRollTarget, leftGrabTarget, leftPinchTarget);
-        float leftTriggerVal = getTargetValue(GestureTarget::NoteTrigger, leftX, leftY, leftZ, leftRoll, leftGrab, leftPinch, leftXTarget, leftYTarget, leftZTarget, leftRollTarget, leftGrabTarget, leftPinchTarget);
-        float leftVolumeVal = getTargetValue(GestureTarget::Volume, leftX, leftY, leftZ, leftRoll, leftGrab, leftPinch, leftXTarget, leftYTarget, leftZTarget, leftRollTarget, leftGrabTarget, leftPinchTarget);
+        float leftPitchVal = getTargetValue(GestureTarget::Pitch, leftX, leftY, leftZ, leftRoll, leftGrab, leftPinch, leftSpeed, leftXTarget, leftYTarget, leftZTarget, leftRollTarget, leftGrabTarget, leftPinchTarget, leftSpeedTarget);
+        float leftTriggerVal = getTargetValue(GestureTarget::NoteTrigger, leftX, leftY, leftZ, leftRoll, leftGrab, leftPinch, leftSpeed, leftXTarget, leftYTarget, leftZTarget, leftRollTarget, leftGrabTarget, leftPinchTarget, leftSpeedTarget);
+        float leftVolumeVal = getTargetValue(GestureTarget::Volume, leftX, leftY, leftZ, leftRoll, leftGrab, leftPinch, leftSpeed, leftXTarget, leftYTarget, leftZTarget, leftRollTarget, leftGrabTarget, leftPinchTarget, leftSpeedTarget);
 
-        float rightPitchVal = getTargetValue(GestureTarget::Pitch, rightX, rightY, rightZ, rightRoll, rightGrab, rightPinch, rightXTarget, rightYTarget, rightZTarget, rightRollTarget, rightGrabTarget, rightPinchTarget);
-        float rightTriggerVal = getTargetValue(GestureTarget::NoteTrigger, rightX, rightY, rightZ, rightRoll, rightGrab, rightPinch, rightXTarget, rightYTarget, rightZTarget, rightRollTarget, rightGrabTarget, rightPinchTarget);
-        float rightVolumeVal = getTargetValue(GestureTarget::Volume, rightX, rightY, rightZ, rightRoll, rightGrab, rightPinch, rightXTarget, rightYTarget, rightZTarget, rightRollTarget, rightGrabTarget, rightPinchTarget);
+        float rightPitchVal = getTargetValue(GestureTarget::Pitch, rightX, rightY, rightZ, rightRoll, rightGrab, rightPinch, rightSpeed, rightXTarget, rightYTarget, rightZTarget, rightRollTarget, rightGrabTarget, rightPinchTarget, rightSpeedTarget);
+        float rightTriggerVal = getTargetValue(GestureTarget::NoteTrigger, rightX, rightY, rightZ, rightRoll, rightGrab, rightPinch, rightSpeed, rightXTarget, rightYTarget, rightZTarget, rightRollTarget, rightGrabTarget, rightPinchTarget, rightSpeedTarget);
+        float rightVolumeVal = getTargetValue(GestureTarget::Volume, rightX, rightY, rightZ, rightRoll, rightGrab, rightPinch, rightSpeed, rightXTarget, rightYTarget, rightZTarget, rightRollTarget, rightGrabTarget, rightPinchTarget, rightSpeedTarget);
 
         float globalVolumeVal = std::max(leftVolumeVal, rightVolumeVal);
 
         // MPE
         if (isMpeEnabled) {
-            handleMpeLogic(midiMessages, leftPitchVal, leftTriggerVal, globalVolumeVal, rootNote, scaleType, leftMpeState, invertNoteTrigger, rangeMode, octaveRange, startNote, endNote, leftHand, minX, leftMaxX, minY, maxY, minZ, maxZ, mpePitchAxis, mpeTimbreAxis, mpePressureAxis, leftDiatonicDegrees, leftAllowedRoots, leftInversionMode, leftDropBass, chordEngineEnabled, leftNotesOut);
-            handleMpeLogic(midiMessages, rightPitchVal, rightTriggerVal, globalVolumeVal, rootNote, scaleType, rightMpeState, invertNoteTrigger, rangeMode, octaveRange, startNote, endNote, rightHand, rightMinX, maxX, minY, maxY, minZ, maxZ, mpePitchAxis, mpeTimbreAxis, mpePressureAxis, rightDiatonicDegrees, rightAllowedRoots, rightInversionMode, rightDropBass, chordEngineEnabled, rightNotesOut);
+            handleMpeLogic(midiMessages, leftPitchVal, leftTriggerVal, globalVolumeVal, rootNote, scaleType, leftMpeState, invertNoteTrigger, rangeMode, octaveRange, startNote, endNote, leftHand, minX, leftMaxX, minY, maxY, minZ, maxZ, mpePitchAxis, mpeTimbreAxis, mpePressureAxis, leftDiatonicDegrees, leftAllowedRoots, leftInversionMode, leftDropBass, chordEngineEnabled, leftNotesOut, strikes.leftVelocity, strikes.leftSampleOffset, strikes);
+            handleMpeLogic(midiMessages, rightPitchVal, rightTriggerVal, globalVolumeVal, rootNote, scaleType, rightMpeState, invertNoteTrigger, rangeMode, octaveRange, startNote, endNote, rightHand, rightMinX, maxX, minY, maxY, minZ, maxZ, mpePitchAxis, mpeTimbreAxis, mpePressureAxis, rightDiatonicDegrees, rightAllowedRoots, rightInversionMode, rightDropBass, chordEngineEnabled, rightNotesOut, strikes.rightVelocity, strikes.rightSampleOffset, strikes);
 
             if (globalVolumeVal >= 0.0f) sendCC(midiMessages, 1, GestureTarget::Volume, globalVolumeVal);
         }
@@ -146,8 +169,8 @@ public:
             int leftChannel = 2;
             int rightChannel = 3;
 
-            handleNoteLogic(midiMessages, leftPitchVal, leftTriggerVal, globalVolumeVal, rootNote, scaleType, leftChannel, leftNoteState, invertNoteTrigger, rangeMode, octaveRange, startNote, endNote, leftDiatonicDegrees, leftAllowedRoots, leftInversionMode, leftDropBass, chordEngineEnabled, leftNotesOut);
-            handleNoteLogic(midiMessages, rightPitchVal, rightTriggerVal, globalVolumeVal, rootNote, scaleType, rightChannel, rightNoteState, invertNoteTrigger, rangeMode, octaveRange, startNote, endNote, rightDiatonicDegrees, rightAllowedRoots, rightInversionMode, rightDropBass, chordEngineEnabled, rightNotesOut);
+            handleNoteLogic(midiMessages, leftPitchVal, leftTriggerVal, globalVolumeVal, rootNote, scaleType, leftChannel, leftNoteState, invertNoteTrigger, rangeMode, octaveRange, startNote, endNote, leftDiatonicDegrees, leftAllowedRoots, leftInversionMode, leftDropBass, chordEngineEnabled, leftNotesOut, strikes.leftVelocity, strikes.leftSampleOffset, strikes);
+            handleNoteLogic(midiMessages, rightPitchVal, rightTriggerVal, globalVolumeVal, rootNote, scaleType, rightChannel, rightNoteState, invertNoteTrigger, rangeMode, octaveRange, startNote, endNote, rightDiatonicDegrees, rightAllowedRoots, rightInversionMode, rightDropBass, chordEngineEnabled, rightNotesOut, strikes.rightVelocity, strikes.rightSampleOffset, strikes);
 
             if (globalVolumeVal >= 0.0f) {
                 sendCC(midiMessages, leftChannel, GestureTarget::Volume, globalVolumeVal);
@@ -155,8 +178,8 @@ public:
             }
 
             // Process CCs
-            auto processHandCCs = [&](const HandData& hand, int channel, float xValue, float yValue, float zValue, float rollValue, float grabValue, float pinchValue,
-                GestureTarget tX, GestureTarget tY, GestureTarget tZ, GestureTarget tRoll, GestureTarget tGrab, GestureTarget tPinch,
+            auto processHandCCs = [&](const HandData& hand, int channel, float xValue, float yValue, float zValue, float rollValue, float grabValue, float pinchValue, float speedValue,
+                GestureTarget tX, GestureTarget tY, GestureTarget tZ, GestureTarget tRoll, GestureTarget tGrab, GestureTarget tPinch, GestureTarget tSpeed,
                 GestureTarget tThumb, GestureTarget tIndex, GestureTarget tMiddle, GestureTarget tRing, GestureTarget tPinky) {
                     if (!hand.isPresent) return;
                     auto isStandardCC = [](GestureTarget t) { return t != GestureTarget::Pitch && t != GestureTarget::NoteTrigger && t != GestureTarget::Volume; };
@@ -167,6 +190,7 @@ public:
                     if (isStandardCC(tRoll)) sendCC(midiMessages, channel, tRoll, rollValue);
                     if (isStandardCC(tGrab)) sendCC(midiMessages, channel, tGrab, grabValue);
                     if (isStandardCC(tPinch)) sendCC(midiMessages, channel, tPinch, pinchValue);
+                    if (isStandardCC(tSpeed)) sendCC(midiMessages, channel, tSpeed, speedValue);
 
                     auto getFingerVal = [&](int fingerIndex) {
                         if (fingerIndex < 0 || fingerIndex >= 5) return 0.0f;
@@ -180,8 +204,8 @@ public:
                     sendCC(midiMessages, channel, tPinky, getFingerVal(4));
                 };
 
-            processHandCCs(leftHand, leftChannel, leftX, leftY, leftZ, leftRoll, leftGrab, leftPinch, leftXTarget, leftYTarget, leftZTarget, leftRollTarget, leftGrabTarget, leftPinchTarget, lThumb, lIndex, lMiddle, lRing, lPinky);
-            processHandCCs(rightHand, rightChannel, rightX, rightY, rightZ, rightRoll, rightGrab, rightPinch, rightXTarget, rightYTarget, rightZTarget, rightRollTarget, rightGrabTarget, rightPinchTarget, rThumb, rIndex, rMiddle, rRing, rPinky);
+            processHandCCs(leftHand, leftChannel, leftX, leftY, leftZ, leftRoll, leftGrab, leftPinch, leftSpeed, leftXTarget, leftYTarget, leftZTarget, leftRollTarget, leftGrabTarget, leftPinchTarget, leftSpeedTarget, lThumb, lIndex, lMiddle, lRing, lPinky);
+            processHandCCs(rightHand, rightChannel, rightX, rightY, rightZ, rightRoll, rightGrab, rightPinch, rightSpeed, rightXTarget, rightYTarget, rightZTarget, rightRollTarget, rightGrabTarget, rightPinchTarget, rightSpeedTarget, rThumb, rIndex, rMiddle, rRing, rPinky);
         }
     }
 
@@ -260,7 +284,32 @@ public:
         }
     }
 
+    // MPE voices sit on their own channels, which the panics above don't reach. For switches that have to let go
+    // of everything, a hand still being present doesn't matter
+    void releaseMpeVoices(juce::MidiBuffer& midiMessages) {
+        for (auto* state : { &leftMpeState, &rightMpeState }) {
+            for (auto& voice : state->voices) {
+                if (voice.isActive) {
+                    midiMessages.addEvent(juce::MidiMessage::noteOff(voice.channel, voice.note), 0);
+                    voice.isActive = false;
+                }
+            }
+            state->isTriggered = false;
+        }
+    }
+
 private:
+    // Restarts the gate on a strike and runs it down otherwise, true if this block has a new strike
+    static bool updateStrikeGate(float& gateRemaining, float strikeVelocity, float blockSeconds) {
+        if (strikeVelocity >= 0.0f) {
+            gateRemaining = strikeGateSeconds;
+            return true;
+        }
+
+        gateRemaining = juce::jmax(0.0f, gateRemaining - blockSeconds);
+        return false;
+    }
+
     // generate chord shapes based on scale chosen
     std::vector<int> buildChordShape(int targetNote, bool chordEngineEnabled, int scaleType, int rootNote,
         const std::array<bool, 7>& diatonicDegrees, int inversionMode, bool dropBass) {
@@ -275,8 +324,8 @@ private:
             newChord.push_back(targetNote);
         }
         else {
-            std::vector<int> intervals = quantiser.getScaleIntervals(scaleType);
-            int numNotesInScale = (int)intervals.size();
+            auto intervals = quantiser.getScaleIntervals(scaleType);
+            int numNotesInScale = intervals.size();
 
             int relativeNote = (targetNote - rootNote) % 12;
             if (relativeNote < 0) relativeNote += 12;
@@ -313,7 +362,8 @@ private:
         int rootNote, int scaleType, int channel, HandNoteState& state,
         bool invertNoteTrigger, MusicalRangeMode mode, int range, int startNote, int endNote,
         std::array<bool, 7> diatonicDegrees, std::array<bool, 7> allowedRoots,
-        int inversionMode, bool dropBass, bool chordEngineEnabled, std::atomic<int>* outNotes) {
+        int inversionMode, bool dropBass, bool chordEngineEnabled, std::atomic<int>* outNotes,
+        float strikeVelocity, int strikeSampleOffset, const StrikeInput& strikes) {
 
         // Check for complete hand exit 
         if (pitchAxisValue < 0.0f && triggerAxisValue < 0.0f) {
@@ -351,17 +401,30 @@ private:
             isTriggerPressed = invertNoteTrigger ? (triggerAxisValue <= 0.5f) : (triggerAxisValue > 0.5f);
         }
 
+        bool isNewStrike = false;
+        if (strikes.isEnabled) {
+            isNewStrike = updateStrikeGate(state.strikeGateRemaining, strikeVelocity, strikes.blockSeconds);
+            isTriggerPressed = state.strikeGateRemaining > 0.0f;
+        }
+
         juce::uint8 noteVelocity = (volumeAxisValue >= 0.0f) ? (juce::uint8)juce::jlimit(1, 127, (int)(volumeAxisValue * 127.0f)) : 100;
+        if (isNewStrike) noteVelocity = (juce::uint8)juce::jlimit(1, 127, (int)(strikeVelocity * 127.0f));
         std::vector<int> newChord = buildChordShape(targetNote, chordEngineEnabled, scaleType, rootNote, diatonicDegrees, inversionMode, dropBass);
 
         // Only send MIDI if the state actually changes
         if (isTriggerPressed && targetNote != -1) {
             bool chordChanged = (newChord != state.activeNotes);
 
-            if (chordChanged || !state.isNoteOn) {
+            // With strikes only a new strike starts notes, moving the pitch during the gate doesn't retrigger
+            bool shouldTrigger = strikes.isEnabled ? isNewStrike : (chordChanged || !state.isNoteOn);
+
+            if (shouldTrigger) {
+                // A strike's notes go where it happened in the block
+                int triggerOffset = isNewStrike ? strikeSampleOffset : 0;
+
                 if (state.isNoteOn) {
                     for (int oldNote : state.activeNotes) {
-                        midiMessages.addEvent(juce::MidiMessage::noteOff(channel, oldNote), 0);
+                        midiMessages.addEvent(juce::MidiMessage::noteOff(channel, oldNote), triggerOffset);
                     }
                 }
 
@@ -373,7 +436,7 @@ private:
 
                 for (int note : newChord) {
                     if (note >= 0 && note <= 127) {
-                        midiMessages.addEvent(juce::MidiMessage::noteOn(channel, note, noteVelocity), 0);
+                        midiMessages.addEvent(juce::MidiMessage::noteOn(channel, note, noteVelocity), triggerOffset);
                     }
                 }
 
@@ -397,7 +460,8 @@ private:
         const HandData& hand, float minX, float maxX, float minY, float maxY, float minZ, float maxZ,
         int mpePitchAxis, int mpeTimbreAxis, int mpePressureAxis,
         std::array<bool, 7> diatonicDegrees, std::array<bool, 7> allowedRoots,
-        int inversionMode, bool dropBass, bool chordEngineEnabled, std::atomic<int>* outNotes) {
+        int inversionMode, bool dropBass, bool chordEngineEnabled, std::atomic<int>* outNotes,
+        float strikeVelocity, int strikeSampleOffset, const StrikeInput& strikes) {
 
         // Hand exit cleanup
         if (pitchAxisValue < 0.0f && triggerAxisValue < 0.0f) {
@@ -439,7 +503,14 @@ private:
             isTriggerPressed = invertNoteTrigger ? (triggerAxisValue <= 0.5f) : (triggerAxisValue > 0.5f);
         }
 
+        bool isNewStrike = false;
+        if (strikes.isEnabled) {
+            isNewStrike = updateStrikeGate(state.strikeGateRemaining, strikeVelocity, strikes.blockSeconds);
+            isTriggerPressed = state.strikeGateRemaining > 0.0f;
+        }
+
         juce::uint8 noteVelocity = (volumeAxisValue >= 0.0f) ? (juce::uint8)juce::jlimit(1, 127, (int)(volumeAxisValue * 127.0f)) : 100;
+        if (isNewStrike) noteVelocity = (juce::uint8)juce::jlimit(1, 127, (int)(strikeVelocity * 127.0f));
         std::vector<int> newChord = buildChordShape(targetNote, chordEngineEnabled, scaleType, rootNote, diatonicDegrees, inversionMode, dropBass);
 
         if (isTriggerPressed && targetNote != -1) {
@@ -461,12 +532,16 @@ private:
                 }
             }
 
-            if (chordChanged || !state.isTriggered) {
+            bool shouldTrigger = strikes.isEnabled ? isNewStrike : (chordChanged || !state.isTriggered);
+
+            if (shouldTrigger) {
+                int triggerOffset = isNewStrike ? strikeSampleOffset : 0;
+
                 // Clear old voices
                 if (state.isTriggered) {
                     for (auto& voice : state.voices) {
                         if (voice.isActive) {
-                            midiMessages.addEvent(juce::MidiMessage::noteOff(voice.channel, voice.note), 0);
+                            midiMessages.addEvent(juce::MidiMessage::noteOff(voice.channel, voice.note), triggerOffset);
                             voice.isActive = false;
                         }
                     }
@@ -491,8 +566,8 @@ private:
                         voice.startY = hand.fingers[fingerIdx].tipY;
                         voice.startZ = hand.fingers[fingerIdx].tipZ;
 
-                        midiMessages.addEvent(juce::MidiMessage::noteOn(voice.channel, voice.note, noteVelocity), 0);
-                        midiMessages.addEvent(juce::MidiMessage::pitchWheel(voice.channel, 8192), 0); 
+                        midiMessages.addEvent(juce::MidiMessage::noteOn(voice.channel, voice.note, noteVelocity), triggerOffset);
+                        midiMessages.addEvent(juce::MidiMessage::pitchWheel(voice.channel, 8192), triggerOffset);
                     }
                 }
                 state.isTriggered = true;
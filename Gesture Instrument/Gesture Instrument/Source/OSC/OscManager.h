@@ -5,6 +5,8 @@
 #include "../MIDI/GestureTarget.h"
 #include "../Helpers/ScaleQuantiser.h" 
 #include "../Helpers/MusicalRangeMode.h"
+#include "../Helpers/OnsetDetector.h"
+#include "../Helpers/RealtimeVerifier.h"
 
 class OscManager {
 public:
@@ -34,27 +36,66 @@ public:
         sender.connect(targetIP, targetPort);
     }
 
-    void updateCustomScale(std::vector<int> newScale) {
+    // Sees every message on the sending thread just before it goes out, the golden output tests record through it
+    class Tap {
+    public:
+        virtual ~Tap() = default;
+        virtual void messageSent(const juce::OSCMessage& message) = 0;
+    };
+
+    // Only while nothing is sending
+    void setTap(Tap* newTap) { tap = newTap; }
+
+    // Every outgoing message goes through here so the profiler can see how much each block sends.
+    // The send is a socket write, which the real-time verifier counts as blocking on the audio thread
+    bool sendMessage(const juce::OSCMessage& message) {
+        messagesSent.fetch_add(1, std::memory_order_relaxed);
+        RealtimeVerifier::onBlockingCall("OSCSender::send");
+        if (tap != nullptr) tap->messageSent(message);
+        return sender.send(message);
+    }
+
+    // Messages sent since the last call
+    int takeMessagesSent() { return messagesSent.exchange(0, std::memory_order_relaxed); }
+
+    void updateCustomScale(const ScaleQuantiser::Intervals& newScale) {
         quantiser.customIntervals = newScale;
     }
 
     // Static params broadcasts
     void sendEnvelopeData(float envelopeShape) {
-        juce::OSCMessage leftAttack("/left/attack"); leftAttack.addFloat32(envelopeShape); sender.send(leftAttack);
-        juce::OSCMessage rightAttack("/right/attack"); rightAttack.addFloat32(envelopeShape); sender.send(rightAttack);
+        RealtimeVerifier::Site site("OscManager::sendEnvelopeData");
+        juce::OSCMessage leftAttack("/left/attack"); leftAttack.addFloat32(envelopeShape); sendMessage(leftAttack);
+        juce::OSCMessage rightAttack("/right/attack"); rightAttack.addFloat32(envelopeShape); sendMessage(rightAttack);
 
-        juce::OSCMessage leftRelease("/left/release"); leftRelease.addFloat32(envelopeShape); sender.send(leftRelease);
-        juce::OSCMessage rightRelease("/right/release"); rightRelease.addFloat32(envelopeShape); sender.send(rightRelease);
+        juce::OSCMessage leftRelease("/left/release"); leftRelease.addFloat32(envelopeShape); sendMessage(leftRelease);
+        juce::OSCMessage rightRelease("/right/release"); rightRelease.addFloat32(envelopeShape); sendMessage(rightRelease);
     }
 
     void sendGlobalWaveform(float waveValue) {
+        RealtimeVerifier::Site site("OscManager::sendGlobalWaveform");
         juce::OSCMessage msg("/global/waveform");
         msg.addFloat32(waveValue);
-        sender.send(msg);
+        sendMessage(msg);
+    }
+
+    // Mute and unmute
+    void sendGlobalVolume(float volume) {
+        RealtimeVerifier::Site site("OscManager::sendGlobalVolume");
+        juce::OSCMessage msg("/global/volume");
+        msg.addFloat32(volume);
+        sendMessage(msg);
+    }
+
+    // A static parameter sent from the audio thread, the way the static dials send it
+    void sendGlobalParameter(GestureTarget target, float value) {
+        RealtimeVerifier::Site site("OscManager::sendGlobalParameter");
+        routeMessage(target, value, "global", 0, 0, 1, MusicalRangeMode::OctaveRange, 0, 127, nullptr);
     }
 
     // Send raw data
     void sendRawData(const HandData& leftHand, const HandData& rightHand) {
+        RealtimeVerifier::Site site("OscManager::sendRawData");
         juce::OSCMessage msg("/gesture/raw");
 
         auto addHandData = [&](const HandData& hand) {
@@ -71,31 +112,44 @@ public:
 
         addHandData(leftHand);
         addHandData(rightHand);
-        sender.send(msg);
+        sendMessage(msg);
+    }
+
+    // One message per strike: source (0 palm, 1-5 thumb to pinky) and velocity 0-1
+    void sendStrike(const StrikeEvent& strike) {
+        RealtimeVerifier::Site site("OscManager::sendStrike");
+        juce::OSCMessage msg(strike.hand == 0 ? "/left/strike" : "/right/strike");
+        msg.addInt32(strike.source);
+        msg.addFloat32(strike.velocity);
+        sendMessage(msg);
     }
 
     void sendMidiData(const juce::MidiBuffer& buffer) {
+        RealtimeVerifier::Site site("OscManager::sendMidiData");
+        RealtimeVerifier::LoopGuard loop("OscManager::sendMidiData events");
+
         for (const auto metadata : buffer) {
+            loop.iterate();
             auto msg = metadata.getMessage();
             if (msg.isNoteOn()) {
                 juce::OSCMessage m("/midi/note");
                 m.addInt32(1);
                 m.addInt32(msg.getNoteNumber());
                 m.addInt32(msg.getVelocity());
-                sender.send(m);
+                sendMessage(m);
             }
             else if (msg.isNoteOff()) {
                 juce::OSCMessage m("/midi/note");
                 m.addInt32(0);
                 m.addInt32(msg.getNoteNumber());
                 m.addInt32(0);
-                sender.send(m);
+                sendMessage(m);
             }
             else if (msg.isController()) {
                 juce::OSCMessage m("/midi/cc");
                 m.addInt32(msg.getControllerNumber());
                 m.addInt32(msg.getControllerValue());
-                sender.send(m);
+                sendMessage(m);
             }
         }
     }
@@ -110,10 +164,12 @@ public:
         GestureTarget rightTargetX, GestureTarget rightTargetY, GestureTarget rightTargetZ, GestureTarget rightTargetRoll, GestureTarget rightTargetGrab, GestureTarget rightTargetPinch,
         GestureTarget rThumb, GestureTarget rIndex, GestureTarget rMiddle, GestureTarget rRing, GestureTarget rPinky,
         int rootNote, int scaleType, int octaveRange, MusicalRangeMode rangeMode, int startNote, int endNote, bool enableSplitXAxis,
-        std::atomic<int> activeLeftNotes[8], std::atomic<int> activeRightNotes[8]) {
+        std::atomic<int> activeLeftNotes[8], std::atomic<int> activeRightNotes[8],
+        GestureTarget leftTargetSpeed = GestureTarget::None, GestureTarget rightTargetSpeed = GestureTarget::None) {
+        RealtimeVerifier::Site site("OscManager::processHandData");
 
-        auto isTargetMapped = [&](GestureTarget searchTarget, GestureTarget tX, GestureTarget tY, GestureTarget tZ, GestureTarget tRoll, GestureTarget tGrab, GestureTarget tPinch, GestureTarget fThumb, GestureTarget fIndex, GestureTarget fMiddle, GestureTarget fRing, GestureTarget fPinky) {
-            return searchTarget == tX || searchTarget == tY || searchTarget == tZ || searchTarget == tRoll || searchTarget == tGrab || searchTarget == tPinch || searchTarget == fThumb || searchTarget == fIndex || searchTarget == fMiddle || searchTarget == fRing || searchTarget == fPinky;
+        auto isTargetMapped = [&](GestureTarget searchTarget, GestureTarget tX, GestureTarget tY, GestureTarget tZ, GestureTarget tRoll, GestureTarget tGrab, GestureTarget tPinch, GestureTarget fThumb, GestureTarget fIndex, GestureTarget fMiddle, GestureTarget fRing, GestureTarget fPinky, GestureTarget tSpeed) {
+            return searchTarget == tX || searchTarget == tY || searchTarget == tZ || searchTarget == tRoll || searchTarget == tGrab || searchTarget == tPinch || searchTarget == fThumb || searchTarget == fIndex || searchTarget == fMiddle || searchTarget == fRing || searchTarget == fPinky || searchTarget == tSpeed;
             };
 
         float centerX = (minX + maxX) / 2.0f;
@@ -136,18 +192,19 @@ public:
             routeMessage(leftTargetZ, leftZ, "left", rootNote, scaleType, octaveRange, rangeMode, startNote, endNote, activeLeftNotes);
             routeMessage(leftTargetGrab, leftGrab, "left", rootNote, scaleType, octaveRange, rangeMode, startNote, endNote, activeLeftNotes);
             routeMessage(leftTargetPinch, leftPinch, "left", rootNote, scaleType, octaveRange, rangeMode, startNote, endNote, activeLeftNotes);
+            routeMessage(leftTargetSpeed, leftHand.getNormalisedSpeed(), "left", rootNote, scaleType, octaveRange, rangeMode, startNote, endNote, activeLeftNotes);
 
             processFingers(leftHand, "left", minY, maxY, rootNote, scaleType, octaveRange, lThumb, lIndex, lMiddle, lRing, lPinky, rangeMode, startNote, endNote, activeLeftNotes);
 
             // If the trigger isn't mapped, enforce a note to keep synth active
-            if (!isTargetMapped(GestureTarget::NoteTrigger, leftTargetX, leftTargetY, leftTargetZ, leftTargetRoll, leftTargetGrab, leftTargetPinch, lThumb, lIndex, lMiddle, lRing, lPinky) && lastLeftMuteSent != 1.0f) {
-                juce::OSCMessage msg("/left/note"); msg.addFloat32(1.0f); sender.send(msg);
+            if (!isTargetMapped(GestureTarget::NoteTrigger, leftTargetX, leftTargetY, leftTargetZ, leftTargetRoll, leftTargetGrab, leftTargetPinch, lThumb, lIndex, lMiddle, lRing, lPinky, leftTargetSpeed) && lastLeftMuteSent != 1.0f) {
+                juce::OSCMessage msg("/left/note"); msg.addFloat32(1.0f); sendMessage(msg);
                 lastLeftMuteSent = 1.0f;
             }
 
             // If vol isnt mapped, send to max
-            if (!isTargetMapped(GestureTarget::Volume, leftTargetX, leftTargetY, leftTargetZ, leftTargetRoll, leftTargetGrab, leftTargetPinch, lThumb, lIndex, lMiddle, lRing, lPinky) && lastLeftVolSent != 1.0f) {
-                juce::OSCMessage msg("/left/volume"); msg.addFloat32(1.0f); sender.send(msg);
+            if (!isTargetMapped(GestureTarget::Volume, leftTargetX, leftTargetY, leftTargetZ, leftTargetRoll, leftTargetGrab, leftTargetPinch, lThumb, lIndex, lMiddle, lRing, lPinky, leftTargetSpeed) && lastLeftVolSent != 1.0f) {
+                juce::OSCMessage msg("/left/volume"); msg.addFloat32(1.0f); sendMessage(msg);
                 lastLeftVolSent = 1.0f;
             }
         }
@@ -171,16 +228,17 @@ public:
             routeMessage(rightTargetZ, rightZ, "right", rootNote, scaleType, octaveRange, rangeMode, startNote, endNote, activeRightNotes);
             routeMessage(rightTargetGrab, rightGrab, "right", rootNote, scaleType, octaveRange, rangeMode, startNote, endNote, activeRightNotes);
             routeMessage(rightTargetPinch, rightPinch, "right", rootNote, scaleType, octaveRange, rangeMode, startNote, endNote, activeRightNotes);
+            routeMessage(rightTargetSpeed, rightHand.getNormalisedSpeed(), "right", rootNote, scaleType, octaveRange, rangeMode, startNote, endNote, activeRightNotes);
 
             processFingers(rightHand, "right", minY, maxY, rootNote, scaleType, octaveRange, rThumb, rIndex, rMiddle, rRing, rPinky, rangeMode, startNote, endNote, activeRightNotes);
 
-            if (!isTargetMapped(GestureTarget::NoteTrigger, rightTargetX, rightTargetY, rightTargetZ, rightTargetRoll, rightTargetGrab, rightTargetPinch, rThumb, rIndex, rMiddle, rRing, rPinky) && lastRightMuteSent != 1.0f) {
-                juce::OSCMessage msg("/right/note"); msg.addFloat32(1.0f); sender.send(msg);
+            if (!isTargetMapped(GestureTarget::NoteTrigger, rightTargetX, rightTargetY, rightTargetZ, rightTargetRoll, rightTargetGrab, rightTargetPinch, rThumb, rIndex, rMiddle, rRing, rPinky, rightTargetSpeed) && lastRightMuteSent != 1.0f) {
+                juce::OSCMessage msg("/right/note"); msg.addFloat32(1.0f); sendMessage(msg);
                 lastRightMuteSent = 1.0f;
             }
 
-            if (!isTargetMapped(GestureTarget::Volume, rightTargetX, rightTargetY, rightTargetZ, rightTargetRoll, rightTargetGrab, rightTargetPinch, rThumb, rIndex, rMiddle, rRing, rPinky) && lastRightVolSent != 1.0f) {
-                juce::OSCMessage msg("/right/volume"); msg.addFloat32(1.0f); sender.send(msg);
+            if (!isTargetMapped(GestureTarget::Volume, rightTargetX, rightTargetY, rightTargetZ, rightTargetRoll, rightTargetGrab, rightTargetPinch, rThumb, rIndex, rMiddle, rRing, rPinky, rightTargetSpeed) && lastRightVolSent != 1.0f) {
+                juce::OSCMessage msg("/right/volume"); msg.addFloat32(1.0f); sendMessage(msg);
                 lastRightVolSent = 1.0f;
             }
         }
@@ -239,7 +297,7 @@ public:
                 msg.addFloat32((float)targetNote);
                 activeNotes[0].store(targetNote);
             }
-            sender.send(msg);
+            sendMessage(msg);
         }
         else {
             if (target == GestureTarget::NoteTrigger) {
@@ -253,26 +311,30 @@ public:
 
             juce::OSCMessage msg(address);
             msg.addFloat32(axisValue);
-            sender.send(msg);
+            sendMessage(msg);
         }
     }
 
     void panicLeft() {
+        RealtimeVerifier::Site site("OscManager::panicLeft");
         juce::OSCMessage msg("/left/note");
         msg.addFloat32(0.0f);
-        sender.send(msg);
+        sendMessage(msg);
         lastLeftMuteSent = 0.0f;
     }
 
     void panicRight() {
+        RealtimeVerifier::Site site("OscManager::panicRight");
         juce::OSCMessage msg("/right/note");
         msg.addFloat32(0.0f);
-        sender.send(msg);
+        sendMessage(msg);
         lastRightMuteSent = 0.0f;
     }
 
 private:
     ScaleQuantiser quantiser;
+    std::atomic<int> messagesSent{ 0 };
+    Tap* tap = nullptr;
 
     // State trackers
     float lastLeftMuteSent = -1.0f;
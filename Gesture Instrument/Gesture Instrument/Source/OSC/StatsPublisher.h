@@ -0,0 +1,112 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "../Helpers/RuntimeStats.h"
+
+// Sends RuntimeStats as an OSC bundle from its own low priority thread, so a monitoring dashboard can watch every
+// machine without opening an editor. Has its own sender, the audio thread's is never touched from here.
+// Each bundle holds, all floats unless noted:
+//   /stats/host      s computer name, period in seconds
+//   /stats/sensor    fps, dropped per second
+//   /stats/frames    skipped per second, repeated per second, staleness mean ms, staleness max ms, i lock misses
+//   /stats/midi      events per second on channels 1 to 16
+//   /stats/osc       packets per second
+//   /stats/audio     load mean %, load max %, blocks per second
+//   /stats/ui        frames per second, 0 while no editor is open
+class StatsPublisher : private juce::Thread {
+public:
+    explicit StatsPublisher(RuntimeStats& statsToPublish) : juce::Thread("Stats Publisher"), stats(statsToPublish) {}
+
+    ~StatsPublisher() override { stop(); }
+
+    // Message thread. Restarts with the new target if already running, false if the host can't be reached
+    bool start(const juce::String& host, int port, int newIntervalMs = 1000) {
+        stop();
+
+        if (!sender.connect(host, port)) return false;
+
+        intervalMs = juce::jmax(100, newIntervalMs);
+        stats.setEnabled(true);
+        startThread(juce::Thread::Priority::low);
+        return true;
+    }
+
+    void stop() {
+        if (!isThreadRunning()) return;
+
+        signalThreadShouldExit();
+        notify();
+        stopThread(2000);
+
+        stats.setEnabled(false);
+        sender.disconnect();
+    }
+
+    bool isRunning() const { return isThreadRunning(); }
+
+    static juce::OSCBundle createBundle(const RuntimeStats::Snapshot& s, const juce::String& source) {
+        juce::OSCBundle bundle;
+
+        juce::OSCMessage host("/stats/host");
+        host.addString(source);
+        host.addFloat32((float)s.periodSeconds);
+        bundle.addElement(host);
+
+        juce::OSCMessage sensor("/stats/sensor");
+        sensor.addFloat32(s.sensorFps);
+        sensor.addFloat32(s.sensorDroppedPerSecond);
+        bundle.addElement(sensor);
+
+        juce::OSCMessage frames("/stats/frames");
+        frames.addFloat32(s.framesSkippedPerSecond);
+        frames.addFloat32(s.framesRepeatedPerSecond);
+        frames.addFloat32(s.stalenessMeanMs);
+        frames.addFloat32(s.stalenessMaxMs);
+        frames.addInt32(s.lockMisses);
+        bundle.addElement(frames);
+
+        juce::OSCMessage midi("/stats/midi");
+        for (float rate : s.midiEventsPerSecond) midi.addFloat32(rate);
+        bundle.addElement(midi);
+
+        juce::OSCMessage osc("/stats/osc");
+        osc.addFloat32(s.oscPacketsPerSecond);
+        bundle.addElement(osc);
+
+        juce::OSCMessage audio("/stats/audio");
+        audio.addFloat32(s.audioLoadMeanPercent);
+        audio.addFloat32(s.audioLoadMaxPercent);
+        audio.addFloat32(s.audioBlocksPerSecond);
+        bundle.addElement(audio);
+
+        juce::OSCMessage ui("/stats/ui");
+        ui.addFloat32(s.uiFps);
+        bundle.addElement(ui);
+
+        return bundle;
+    }
+
+private:
+    RuntimeStats& stats;
+    juce::OSCSender sender;
+    int intervalMs = 1000;
+
+    void run() override {
+        const auto source = juce::SystemStats::getComputerName();
+
+        // Whatever piled up before the feed started isn't part of the first period
+        auto lastTicks = juce::Time::getHighResolutionTicks();
+        stats.take(1.0);
+
+        while (!threadShouldExit()) {
+            wait(intervalMs);
+            if (threadShouldExit()) break;
+
+            auto nowTicks = juce::Time::getHighResolutionTicks();
+            double periodSeconds = juce::Time::highResolutionTicksToSeconds(nowTicks - lastTicks);
+            lastTicks = nowTicks;
+
+            sender.send(createBundle(stats.take(periodSeconds), source));
+        }
+    }
+};
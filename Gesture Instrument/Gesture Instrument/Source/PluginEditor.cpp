@@ -5,20 +5,27 @@
 
 // Setup and teardown
 GestureInstrumentAudioProcessorEditor::GestureInstrumentAudioProcessorEditor(GestureInstrumentAudioProcessor& p)
-    : AudioProcessorEditor(&p), audioProcessor(p), settingsPage(p), staticDialsPage(p), hud(p), virtualCursor(p), chordBuilderPage(p),
+    : AudioProcessorEditor(&p), audioProcessor(p), stage(p.profiler), settingsPage(p), staticDialsPage(p), hud(p), virtualCursor(p), chordBuilderPage(p), profilerOverlay(p.profiler),
     xMinControl("Min Width", -350.0f, 0.0f, p.minWidthThreshold),
     xMaxControl("Max Width", 0.0f, 350.0f, p.maxWidthThreshold),
     yMinControl("Min Height", 50.0f, 275.0f, p.minHeightThreshold),
     yMaxControl("Max Height", 275.0f, 500.0f, p.maxHeightThreshold),
     zMinControl("Back Depth", -225.0f, 0.0f, p.minDepthThreshold),
-    zMaxControl("Front Depth", 0.0f, 225.0f, p.maxDepthThreshold)
+    zMaxControl("Front Depth", 0.0f, 225.0f, p.maxDepthThreshold),
+    frameScheduler(p, *this)
 {
-    addAndMakeVisible(hud);
+    addAndMakeVisible(stage);
+    stage.addAndMakeVisible(hud);
+    stage.addChildComponent(profilerOverlay);
     addAndMakeVisible(virtualCursor);
     virtualCursor.setAlwaysOnTop(true);
 
-    openGLContext.attachTo(*this);
-    openGLContext.setContinuousRepainting(false);
+    // Over the stage the GL surface hides the cursor, so the stage draws it again on top
+    stage.paintOverlay = [this](juce::Graphics& g) {
+        g.setOrigin(-stage.getPosition());
+        virtualCursor.paintCursor(g);
+        };
+    virtualCursor.onAreaRepainted = [this](juce::Rectangle<int> area) { stage.repaintOverlay(area - stage.getPosition()); };
 
     // TOP BAR: HARDWARE AND VIEW CONTROLS
     addAndMakeVisible(connectionStatusLabel);
@@ -84,7 +91,7 @@ GestureInstrumentAudioProcessorEditor::GestureInstrumentAudioProcessorEditor(Ges
 
     addAndMakeVisible(customScaleUI);
     customScaleUI.setCustomScale(audioProcessor.customScaleIntervals);
-    customScaleUI.onScaleChanged = [this](std::vector<int> newScale) {
+    customScaleUI.onScaleChanged = [this](const ScaleQuantiser::Intervals& newScale) {
         audioProcessor.customScaleIntervals = newScale;
         audioProcessor.oscManager.updateCustomScale(newScale);
         repaint();
@@ -173,8 +180,7 @@ GestureInstrumentAudioProcessorEditor::GestureInstrumentAudioProcessorEditor(Ges
     muteButton.onClick = [this] { audioProcessor.globalMute.store(muteButton.getToggleState()); };
 
     // OVERLAYS
-    addAndMakeVisible(calibrationOverlay);
-    calibrationOverlay.setVisible(false);
+    stage.addChildComponent(calibrationOverlay);
     calibrationOverlay.onCancel = [this] { stopCalibration(false); };
 
     addAndMakeVisible(calibrateButton);
@@ -209,7 +215,9 @@ GestureInstrumentAudioProcessorEditor::GestureInstrumentAudioProcessorEditor(Ges
     addAndMakeVisible(chordBuilderButton);
     chordBuilderButton.setButtonText("Chord Builder");
 
+    // Pages cover the stage, and the GL surface would draw over them
     auto hideMainMenu = [this]() {
+        stage.setVisible(false);
         settingsButton.setVisible(false);
         staticDialsButton.setVisible(false);
         calibrateButton.setVisible(false);
@@ -236,6 +244,7 @@ GestureInstrumentAudioProcessorEditor::GestureInstrumentAudioProcessorEditor(Ges
         };
 
     auto showMainMenu = [this]() {
+        stage.setVisible(true);
         settingsButton.setVisible(true);
         staticDialsButton.setVisible(true);
         calibrateButton.setVisible(true);
@@ -302,12 +311,16 @@ GestureInstrumentAudioProcessorEditor::GestureInstrumentAudioProcessorEditor(Ges
     setResizeLimits(800, 600, 3000, 2000);
     setOpaque(true);
     setSize(1500, 700);
-    startTimerHz(60);
+
+    lastAppliedConfigSerial = audioProcessor.getAppliedConfigSerial();
+    frameScheduler.onFrame = [this](bool isNewSnapshot, float deltaSeconds) { onFrame(isNewSnapshot, deltaSeconds); };
+    frameScheduler.isAnimating = [this] { return isCalibrating || menuGestureTimer > 0.0f; };
+    stage.start();
+    frameScheduler.start();
 }
 
 GestureInstrumentAudioProcessorEditor::~GestureInstrumentAudioProcessorEditor() {
-    openGLContext.detach();
-    stopTimer();
+    frameScheduler.stop();
 }
 
 // MAIN RENDERING AND LAYOUT
@@ -345,24 +358,14 @@ void GestureInstrumentAudioProcessorEditor::updateScaleDropdown() {
 }
 
 void GestureInstrumentAudioProcessorEditor::paint(juce::Graphics& g) {
-    juce::ColourGradient bgGradient(
-        juce::Colour::fromFloatRGBA(0.05f, 0.05f, 0.1f, 1.0f),
-        (float)getWidth() / 2, (float)getHeight() / 2,
-        juce::Colour::fromFloatRGBA(0.0f, 0.0f, 0.0f, 1.0f),
-        0.0f, 0.0f, true);
-    g.setGradientFill(bgGradient);
-    g.fillAll();
-
-    centerScreen = getLocalBounds().getCentre().toFloat();
-
-    draw3DGrid(g);
-    draw3DHand(g, audioProcessor.leftHand, juce::Colours::cyan);
-    draw3DHand(g, audioProcessor.rightHand, juce::Colours::magenta);
-    drawCalibrationBox3D(g);
+    // Only the bars above and below the stage show through, the stage paints itself
+    g.fillAll(juce::Colours::black);
 }
 
 void GestureInstrumentAudioProcessorEditor::resized() {
-    calibrationOverlay.setBounds(getLocalBounds());
+    stage.setBounds(0, 110, getWidth(), getHeight() - 230);
+    submitStageFrame();
+    calibrationOverlay.setBounds(stage.getLocalBounds());
     settingsViewport.setBounds(getLocalBounds());
     staticDialsPage.setBounds(getLocalBounds());
     virtualCursor.setBounds(getLocalBounds());
@@ -413,7 +416,8 @@ void GestureInstrumentAudioProcessorEditor::resized() {
     showNoteNamesButton.setBounds(rightEdge - 100, topBarY + 35, 100, 30);
     muteButton.setBounds(rightEdge - 100, showNoteNamesButton.getBottom() + 5, 100, 30);
 
-    hud.setBounds(0, 110, getWidth(), getHeight() - 240);
+    hud.setBounds(stage.getLocalBounds().withTrimmedBottom(10));
+    profilerOverlay.setBounds(margin, 0, ProfilerOverlay::preferredWidth, ProfilerOverlay::preferredHeight);
 
     auto bottomArea = getLocalBounds().removeFromBottom(120).reduced(20, 10);
     int colWidth = bottomArea.getWidth() / 3;
@@ -432,7 +436,13 @@ void GestureInstrumentAudioProcessorEditor::resized() {
 }
 
 // CORE LOGIC AND TIMERS
-void GestureInstrumentAudioProcessorEditor::timerCallback() {
+void GestureInstrumentAudioProcessorEditor::onFrame(bool isNewSnapshot, float deltaSeconds) {
+    ProfilerProbes::ScopedTimer frameTimer(audioProcessor.profiler, ProfilerProbes::uiFrame);
+    audioProcessor.runtimeStats.uiFrame();
+
+    // The scheduler pulled one snapshot for this frame, everything below and every paint until the next frame reads it
+    const auto& frame = audioProcessor.getRenderSnapshot();
+
     // UI update check
     int currentMode = static_cast<int>(audioProcessor.currentOutputMode);
     if (currentMode != lastKnownOutputMode) {
@@ -440,35 +450,22 @@ void GestureInstrumentAudioProcessorEditor::timerCallback() {
         lastKnownOutputMode = currentMode;
     }
 
+    // A preset from the library or a host restore, taken by the audio thread since the last frame
+    int appliedConfigSerial = audioProcessor.getAppliedConfigSerial();
+    if (appliedConfigSerial != lastAppliedConfigSerial) {
+        lastAppliedConfigSerial = appliedConfigSerial;
+        if (settingsPage.onPresetLoaded) settingsPage.onPresetLoaded();
+    }
+
     if (isCalibrating) {
-        calibrationTimer += 1.0f / 60.0f;
+        // Samples are gathered on the Leap thread, this only shows progress and the box found so far.
+        // Wall clock time, so a stalled or minimised editor still ends the calibration on schedule
+        float calibrationTimer = (float)((juce::Time::getMillisecondCounterHiRes() - calibrationStartMs) * 0.001);
         calibrationOverlay.setProgress(calibrationTimer / calibrationDuration);
+        audioProcessor.getCalibrationBounds(calibrationBounds);
 
-        auto processHand = [&](const HandData& hand) {
-            if (!hand.isPresent) return;
-
-            if (hand.currentHandPositionX < tempMinX) tempMinX = hand.currentHandPositionX;
-            if (hand.currentHandPositionX > tempMaxX) tempMaxX = hand.currentHandPositionX;
-
-            if (hand.currentHandPositionY < tempMinY) tempMinY = hand.currentHandPositionY;
-            if (hand.currentHandPositionY > tempMaxY) tempMaxY = hand.currentHandPositionY;
-
-            if (hand.currentHandPositionZ < tempMinZ) tempMinZ = hand.currentHandPositionZ;
-            if (hand.currentHandPositionZ > tempMaxZ) tempMaxZ = hand.currentHandPositionZ;
-
-            tempMinX = juce::jmax(-350.0f, tempMinX);
-            tempMaxX = juce::jmin(350.0f, tempMaxX);
-            tempMinY = juce::jmax(50.0f, tempMinY);
-            tempMaxY = juce::jmin(500.0f, tempMaxY);
-            tempMinZ = juce::jmax(-225.0f, tempMinZ);
-            tempMaxZ = juce::jmin(225.0f, tempMaxZ);
-            };
-
-        processHand(audioProcessor.leftHand);
-        processHand(audioProcessor.rightHand);
-
-        bool leftFist = audioProcessor.leftHand.isPresent && audioProcessor.leftHand.grabStrength > 0.85f;
-        bool rightFist = audioProcessor.rightHand.isPresent && audioProcessor.rightHand.grabStrength > 0.85f;
+        bool leftFist = frame.leftHand.isPresent && frame.leftHand.grabStrength > 0.85f;
+        bool rightFist = frame.rightHand.isPresent && frame.rightHand.grabStrength > 0.85f;
 
         if (leftFist || rightFist || calibrationTimer >= calibrationDuration) {
             stopCalibration(true);
@@ -477,8 +474,8 @@ void GestureInstrumentAudioProcessorEditor::timerCallback() {
     }
 
     if (audioProcessor.isGestureToMouseEnabled.load() && !isCalibrating) {
-        bool leftFist = audioProcessor.leftHand.isPresent && audioProcessor.leftHand.grabStrength > 0.85f;
-        bool rightFist = audioProcessor.rightHand.isPresent && audioProcessor.rightHand.grabStrength > 0.85f;
+        bool leftFist = frame.leftHand.isPresent && frame.leftHand.grabStrength > 0.85f;
+        bool rightFist = frame.rightHand.isPresent && frame.rightHand.grabStrength > 0.85f;
         bool gestureTriggered = false;
 
         int mode = audioProcessor.virtualMouseGestureType;
@@ -489,7 +486,7 @@ void GestureInstrumentAudioProcessorEditor::timerCallback() {
         float requiredHoldTime = audioProcessor.virtualMouseHoldTime;
 
         if (gestureTriggered && !menuGestureFired) {
-            menuGestureTimer += 1.0f / 60.0f;
+            menuGestureTimer += deltaSeconds;
             if (menuGestureTimer >= requiredHoldTime) {
                 editModeButton.triggerClick();
                 menuGestureFired = true;
@@ -513,13 +510,23 @@ void GestureInstrumentAudioProcessorEditor::timerCallback() {
     hud.menuGestureFired = menuGestureFired;
     chordBuilderButton.setEnabled(audioProcessor.currentOutputMode != OutputMode::OSC_Only);
 
-    virtualCursor.updateCursorLogic(isEditMode);
+    virtualCursor.updateCursorLogic(isEditMode, deltaSeconds);
+    if (staticDialsPage.isVisible()) staticDialsPage.updateDials();
+    profilerOverlay.update(deltaSeconds);
+    if (audioProcessor.latencyTracer.isEnabled()) audioProcessor.latencyTracer.collect();
     updateConnectionStatus();
-    repaint();
+
+    // Nothing on the stage moves unless a new snapshot came in, the box was edited or an animation is running
+    bool isAnimating = isCalibrating || menuGestureTimer > 0.0f;
+    bool isBoxOrScaleStale = submittedBox != getStageBox() || submittedScale != stage.getDisplayScale();
+    if (isNewSnapshot || isAnimating || wasAnimating || isBoxOrScaleStale || submittedToGL != stage.isOnGL()) submitStageFrame();
+    wasAnimating = isAnimating;
+
+    stage.collectFinishedFrame();
 }
 
 void GestureInstrumentAudioProcessorEditor::updateConnectionStatus() {
-    bool connected = audioProcessor.isSensorConnected;
+    bool connected = audioProcessor.getRenderSnapshot().isSensorConnected;
     if (connected) {
         connectionStatusLabel.setText("Sensor Connected", juce::dontSendNotification);
         connectionStatusLabel.setColour(juce::Label::textColourId, juce::Colours::green);
@@ -556,31 +563,34 @@ void GestureInstrumentAudioProcessorEditor::CalibrationOverlay::setProgress(floa
 
 void GestureInstrumentAudioProcessorEditor::startCalibration() {
     isCalibrating = true;
-    audioProcessor.isCalibrating.store(true);
-    calibrationTimer = 0.0f;
-    tempMinX = 1000.0f; tempMaxX = -1000.0f;
-    tempMinY = 1000.0f; tempMaxY = -1000.0f;
-    tempMinZ = 1000.0f; tempMaxZ = -1000.0f;
+    audioProcessor.startCalibration();
+    calibrationStartMs = juce::Time::getMillisecondCounterHiRes();
+    calibrationBounds = {};
 
     calibrationOverlay.setVisible(true);
     calibrationOverlay.toFront(true);
     virtualCursor.toFront(true);
+    frameScheduler.wake();
 }
 
 void GestureInstrumentAudioProcessorEditor::stopCalibration(bool success) {
     isCalibrating = false;
-    audioProcessor.isCalibrating.store(false);
+    audioProcessor.stopCalibration();
     calibrationOverlay.setVisible(false);
 
-    if (success) {
-        audioProcessor.minWidthThreshold = juce::jlimit(-350.0f, 0.0f, tempMinX);
-        audioProcessor.maxWidthThreshold = juce::jlimit(0.0f, 350.0f, tempMaxX);
+    // Take the last frames the Leap thread added, and leave the box alone if no hand was ever seen
+    audioProcessor.getCalibrationBounds(calibrationBounds);
+
+    if (success && calibrationBounds.numSamples > 0) {
+        const auto& b = calibrationBounds;
+        audioProcessor.minWidthThreshold = juce::jlimit(-350.0f, 0.0f, b.minX);
+        audioProcessor.maxWidthThreshold = juce::jlimit(0.0f, 350.0f, b.maxX);
 
-        audioProcessor.minHeightThreshold = juce::jlimit(50.0f, 275.0f, tempMinY);
-        audioProcessor.maxHeightThreshold = juce::jlimit(275.0f, 500.0f, tempMaxY);
+        audioProcessor.minHeightThreshold = juce::jlimit(50.0f, 275.0f, b.minY);
+        audioProcessor.maxHeightThreshold = juce::jlimit(275.0f, 500.0f, b.maxY);
 
-        audioProcessor.minDepthThreshold = juce::jlimit(-225.0f, 0.0f, tempMinZ);
-        audioProcessor.maxDepthThreshold = juce::jlimit(0.0f, 225.0f, tempMaxZ);
+        audioProcessor.minDepthThreshold = juce::jlimit(-225.0f, 0.0f, b.minZ);
+        audioProcessor.maxDepthThreshold = juce::jlimit(0.0f, 225.0f, b.maxZ);
 
         yMinControl.slider.setValue(audioProcessor.minHeightThreshold, juce::dontSendNotification);
         yMaxControl.slider.setValue(audioProcessor.maxHeightThreshold, juce::dontSendNotification);
@@ -593,256 +603,55 @@ void GestureInstrumentAudioProcessorEditor::stopCalibration(bool success) {
 
 // 3D GRAPHICS AND PROJECTION
 
-juce::Point<float> GestureInstrumentAudioProcessorEditor::projectPoint(Point3D p) {
-    float worldY = p.y - 250.0f;
-    float adjustedZ = -p.z;
-
-    float perspective = fov / (fov + adjustedZ + camDist);
-    float zoom = ((float)getHeight() * 0.55f) / 500.0f;
-    float finalScale = perspective * zoom * 2.5f;
-
-    float x2d = p.x * finalScale + centerScreen.x;
-    float y2d = -worldY * finalScale + centerScreen.y;
-
-    return juce::Point<float>(x2d, y2d);
-}
-
-void GestureInstrumentAudioProcessorEditor::drawCalibrationBox3D(juce::Graphics& g) {
-    if (!isCalibrating || tempMinX == 1000.0f) return;
-
-    Point3D f1 = { tempMinX, tempMinY, tempMinZ };
-    Point3D f2 = { tempMaxX, tempMinY, tempMinZ };
-    Point3D f3 = { tempMaxX, tempMinY, tempMaxZ };
-    Point3D f4 = { tempMinX, tempMinY, tempMaxZ };
+void GestureInstrumentAudioProcessorEditor::submitStageFrame() {
+    const auto& snapshot = audioProcessor.getRenderSnapshot();
 
-    Point3D c1 = { tempMinX, tempMaxY, tempMinZ };
-    Point3D c2 = { tempMaxX, tempMaxY, tempMinZ };
-    Point3D c3 = { tempMaxX, tempMaxY, tempMaxZ };
-    Point3D c4 = { tempMinX, tempMaxY, tempMaxZ };
+    StageFrame frame;
+    frame.width = stage.getWidth();
+    frame.height = stage.getHeight();
+    frame.displayScale = stage.getDisplayScale();
 
-    auto pF1 = projectPoint(f1); auto pF2 = projectPoint(f2);
-    auto pF3 = projectPoint(f3); auto pF4 = projectPoint(f4);
-    auto pC1 = projectPoint(c1); auto pC2 = projectPoint(c2);
-    auto pC3 = projectPoint(c3); auto pC4 = projectPoint(c4);
+    frame.box = getStageBox();
+    frame.leftHand = snapshot.leftHand;
+    frame.rightHand = snapshot.rightHand;
 
-    g.setColour(juce::Colours::cyan.withAlpha(0.8f));
-    float thick = 2.0f;
+    frame.showFloorShadow = audioProcessor.showFloorShadow;
+    frame.showWallShadow = audioProcessor.showWallShadow;
+    frame.grabMultiplier = audioProcessor.grabMultiplier.load();
+    frame.pinchMultiplier = audioProcessor.pinchMultiplier.load();
 
-    g.drawLine(juce::Line<float>(pF1, pF2), thick); g.drawLine(juce::Line<float>(pF2, pF3), thick);
-    g.drawLine(juce::Line<float>(pF3, pF4), thick); g.drawLine(juce::Line<float>(pF4, pF1), thick);
+    frame.isCalibrating = isCalibrating;
+    const auto& b = calibrationBounds;
+    frame.hasCalibrationBox = isCalibrating && b.numSamples > 0;
+    frame.calibrationBox = { b.minX, b.maxX, b.minY, b.maxY, b.minZ, b.maxZ, false };
 
-    g.drawLine(juce::Line<float>(pC1, pC2), thick); g.drawLine(juce::Line<float>(pC2, pC3), thick);
-    g.drawLine(juce::Line<float>(pC3, pC4), thick); g.drawLine(juce::Line<float>(pC4, pC1), thick);
-
-    g.drawLine(juce::Line<float>(pF1, pC1), thick); g.drawLine(juce::Line<float>(pF2, pC2), thick);
-    g.drawLine(juce::Line<float>(pF3, pC3), thick); g.drawLine(juce::Line<float>(pF4, pC4), thick);
-}
-
-void GestureInstrumentAudioProcessorEditor::draw3DGrid(juce::Graphics& g) {
-    float minRoomX = -350.0f; float maxRoomX = 350.0f;
-    float minRoomY = 50.0f;   float maxRoomY = 500.0f;
-    float minRoomZ = -225.0f; float maxRoomZ = 225.0f;
-
-    Point3D f1 = { minRoomX, minRoomY, minRoomZ }; Point3D f2 = { maxRoomX, minRoomY, minRoomZ };
-    Point3D f3 = { maxRoomX, minRoomY, maxRoomZ }; Point3D f4 = { minRoomX, minRoomY, maxRoomZ };
-    Point3D c1 = { minRoomX, maxRoomY, minRoomZ }; Point3D c2 = { maxRoomX, maxRoomY, minRoomZ };
-    Point3D c3 = { maxRoomX, maxRoomY, maxRoomZ }; Point3D c4 = { minRoomX, maxRoomY, maxRoomZ };
-
-    auto pF1 = projectPoint(f1); auto pF2 = projectPoint(f2);
-    auto pF3 = projectPoint(f3); auto pF4 = projectPoint(f4);
-    auto pC1 = projectPoint(c1); auto pC2 = projectPoint(c2);
-    auto pC3 = projectPoint(c3); auto pC4 = projectPoint(c4);
-
-    g.setColour(juce::Colours::white.withAlpha(0.08f));
-
-    g.drawLine(juce::Line<float>(pF1, pF2)); g.drawLine(juce::Line<float>(pF2, pF3));
-    g.drawLine(juce::Line<float>(pF3, pF4)); g.drawLine(juce::Line<float>(pF4, pF1));
-    g.drawLine(juce::Line<float>(pC1, pC2)); g.drawLine(juce::Line<float>(pC2, pC3));
-    g.drawLine(juce::Line<float>(pC3, pC4)); g.drawLine(juce::Line<float>(pC4, pC1));
-    g.drawLine(juce::Line<float>(pF1, pC1)); g.drawLine(juce::Line<float>(pF2, pC2));
-    g.drawLine(juce::Line<float>(pF3, pC3)); g.drawLine(juce::Line<float>(pF4, pC4));
-
-    float minX = audioProcessor.minWidthThreshold;
-    float maxX = audioProcessor.maxWidthThreshold;
-    float minY = audioProcessor.minHeightThreshold;
-    float maxY = audioProcessor.maxHeightThreshold;
-    float minZ = audioProcessor.minDepthThreshold;
-    float maxZ = audioProcessor.maxDepthThreshold;
-
-    Point3D tF1 = { minX, minY, minZ }; Point3D tF2 = { maxX, minY, minZ };
-    Point3D tF3 = { maxX, minY, maxZ }; Point3D tF4 = { minX, minY, maxZ };
-    Point3D tC1 = { minX, maxY, minZ }; Point3D tC2 = { maxX, maxY, minZ };
-    Point3D tC3 = { maxX, maxY, maxZ }; Point3D tC4 = { minX, maxY, maxZ };
-
-    auto ptF1 = projectPoint(tF1); auto ptF2 = projectPoint(tF2);
-    auto ptF3 = projectPoint(tF3); auto ptF4 = projectPoint(tF4);
-    auto ptC1 = projectPoint(tC1); auto ptC2 = projectPoint(tC2);
-    auto ptC3 = projectPoint(tC3); auto ptC4 = projectPoint(tC4);
-
-    g.setColour(juce::Colours::yellow.withAlpha(0.6f));
-    float thick = 2.5f;
-
-    g.drawLine(juce::Line<float>(ptF1, ptF2), thick); g.drawLine(juce::Line<float>(ptF2, ptF3), thick);
-    g.drawLine(juce::Line<float>(ptF3, ptF4), thick); g.drawLine(juce::Line<float>(ptF4, ptF1), thick);
-    g.drawLine(juce::Line<float>(ptC1, ptC2), thick); g.drawLine(juce::Line<float>(ptC2, ptC3), thick);
-    g.drawLine(juce::Line<float>(ptC3, ptC4), thick); g.drawLine(juce::Line<float>(ptC4, ptC1), thick);
-    g.drawLine(juce::Line<float>(ptF1, ptC1), thick); g.drawLine(juce::Line<float>(ptF2, ptC2), thick);
-    g.drawLine(juce::Line<float>(ptF3, ptC3), thick); g.drawLine(juce::Line<float>(ptF4, ptC4), thick);
-
-    if (audioProcessor.enableSplitXAxis.load()) {
-        float cx = (minX + maxX) / 2.0f;
-        Point3D divF1 = { cx, minY, minZ }; Point3D divF2 = { cx, minY, maxZ };
-        Point3D divC1 = { cx, maxY, minZ }; Point3D divC2 = { cx, maxY, maxZ };
-
-        auto pDivF1 = projectPoint(divF1); auto pDivF2 = projectPoint(divF2);
-        auto pDivC1 = projectPoint(divC1); auto pDivC2 = projectPoint(divC2);
-
-        g.setColour(juce::Colours::orange.withAlpha(0.8f));
-        g.drawLine(juce::Line<float>(pDivF1, pDivF2), 2.5f);
-        g.drawLine(juce::Line<float>(pDivC1, pDivC2), 2.5f);
-        g.drawLine(juce::Line<float>(pDivF1, pDivC1), 2.5f);
-        g.drawLine(juce::Line<float>(pDivF2, pDivC2), 2.5f);
-    }
+    submittedBox = frame.box;
+    submittedScale = frame.displayScale;
+    submittedToGL = stage.isOnGL();
+    stage.submit(frame);
 }
 
-void GestureInstrumentAudioProcessorEditor::draw3DHand(juce::Graphics& g, const HandData& hand, juce::Colour baseColour) {
-    if (!hand.isPresent) return;
-
-    auto rotateLocal = [&](float x, float y, float z) -> Point3D {
-        float dy = y - hand.currentHandPositionY;
-        float dz = z - hand.currentHandPositionZ;
-        float angle = juce::MathConstants<float>::pi * 0.20f;
-        float cosA = std::cos(angle);
-        float sinA = std::sin(angle);
-        float rotY = dy * cosA - dz * sinA;
-        float rotZ = dy * sinA + dz * cosA;
-        return { x, hand.currentHandPositionY + rotY, hand.currentHandPositionZ + rotZ };
-        };
-
-    auto clampPoint = [&](Point3D p) -> Point3D {
-        if (isCalibrating) return p;
-        return {
-            juce::jlimit(audioProcessor.minWidthThreshold, audioProcessor.maxWidthThreshold, p.x),
-            juce::jlimit(audioProcessor.minHeightThreshold, audioProcessor.maxHeightThreshold, p.y),
-            juce::jlimit(audioProcessor.minDepthThreshold, audioProcessor.maxDepthThreshold, p.z)
-        };
-        };
-
-    Point3D palm3D = clampPoint({ hand.currentHandPositionX, hand.currentHandPositionY, hand.currentHandPositionZ });
-    auto palm2D = projectPoint(palm3D);
-    float palmDepth = juce::jmap(palm3D.z, -200.0f, 200.0f, 0.6f, 1.4f);
-
-    if (audioProcessor.showFloorShadow) {
-        Point3D shadow3D = { palm3D.x, audioProcessor.minHeightThreshold, palm3D.z };
-        auto shadow2D = projectPoint(shadow3D);
-
-        float heightRatio = juce::jmap(palm3D.y, audioProcessor.minHeightThreshold, audioProcessor.maxHeightThreshold, 0.0f, 1.0f);
-        heightRatio = juce::jlimit(0.0f, 1.0f, heightRatio);
-
-        float shadowScale = juce::jmap(shadow3D.z, -200.0f, 200.0f, 0.6f, 1.4f);
-        float shadowW = (50.0f + (heightRatio * 70.0f)) * shadowScale;
-        float shadowH = shadowW * 0.35f;
-        float shadowAlpha = 0.5f - (heightRatio * 0.4f);
-
-        juce::Path floorPath;
-        floorPath.startNewSubPath(projectPoint({ audioProcessor.minWidthThreshold, audioProcessor.minHeightThreshold, audioProcessor.minDepthThreshold }));
-        floorPath.lineTo(projectPoint({ audioProcessor.maxWidthThreshold, audioProcessor.minHeightThreshold, audioProcessor.minDepthThreshold }));
-        floorPath.lineTo(projectPoint({ audioProcessor.maxWidthThreshold, audioProcessor.minHeightThreshold, audioProcessor.maxDepthThreshold }));
-        floorPath.lineTo(projectPoint({ audioProcessor.minWidthThreshold, audioProcessor.minHeightThreshold, audioProcessor.maxDepthThreshold }));
-        floorPath.closeSubPath();
-
-        g.saveState();
-        g.reduceClipRegion(floorPath);
-        g.setColour(baseColour.darker(0.8f).withAlpha(shadowAlpha));
-        g.fillEllipse(shadow2D.x - (shadowW / 2.0f), shadow2D.y - (shadowH / 2.0f), shadowW, shadowH);
-        g.restoreState();
-    }
-
-    if (audioProcessor.showWallShadow) {
-        Point3D wallShadow3D = { palm3D.x, palm3D.y, audioProcessor.minDepthThreshold };
-        auto wallShadow2D = projectPoint(wallShadow3D);
-
-        float depthRatio = juce::jmap(palm3D.z, audioProcessor.minDepthThreshold, audioProcessor.maxDepthThreshold, 0.0f, 1.0f);
-        depthRatio = juce::jlimit(0.0f, 1.0f, depthRatio);
-
-        float backWallScale = juce::jmap(audioProcessor.minDepthThreshold, -200.0f, 200.0f, 0.6f, 1.4f);
-        float wallShadowSize = (50.0f + (depthRatio * 70.0f)) * backWallScale;
-        float wallShadowAlpha = 0.4f - (depthRatio * 0.35f);
-
-        juce::Path wallPath;
-        wallPath.startNewSubPath(projectPoint({ audioProcessor.minWidthThreshold, audioProcessor.minHeightThreshold, audioProcessor.minDepthThreshold }));
-        wallPath.lineTo(projectPoint({ audioProcessor.maxWidthThreshold, audioProcessor.minHeightThreshold, audioProcessor.minDepthThreshold }));
-        wallPath.lineTo(projectPoint({ audioProcessor.maxWidthThreshold, audioProcessor.maxHeightThreshold, audioProcessor.minDepthThreshold }));
-        wallPath.lineTo(projectPoint({ audioProcessor.minWidthThreshold, audioProcessor.maxHeightThreshold, audioProcessor.minDepthThreshold }));
-        wallPath.closeSubPath();
-
-        g.saveState();
-        g.reduceClipRegion(wallPath);
-        g.setColour(baseColour.darker(0.8f).withAlpha(wallShadowAlpha));
-        g.fillEllipse(wallShadow2D.x - (wallShadowSize / 2.0f), wallShadow2D.y - (wallShadowSize / 2.0f), wallShadowSize, wallShadowSize);
-        g.restoreState();
-    }
-
-    float grabIntensity = juce::jlimit(0.0f, 1.0f, hand.grabStrength * audioProcessor.grabMultiplier.load());
-    if (grabIntensity > 0.1f) {
-        juce::Colour grabCol = baseColour.interpolatedWith(juce::Colours::orange, grabIntensity);
-
-        g.setColour(grabCol.withAlpha(0.3f * grabIntensity));
-        float radius = (40.0f * palmDepth) * (2.0f - grabIntensity);
-        g.fillEllipse(palm2D.x - radius / 2, palm2D.y - radius / 2, radius, radius);
-
-        g.setColour(grabCol);
-        g.drawEllipse(palm2D.x - radius / 2, palm2D.y - radius / 2, radius, radius, 2.0f);
-    }
-    
-
-    for (int i = 0; i < 5; ++i) {
-        const auto& f = hand.fingers[i];
-
-        float alpha = f.isExtended ? 0.9f : 0.2f;
-        juce::Colour boneCol = baseColour.withAlpha(alpha);
-
-        auto knuckle = projectPoint(clampPoint(rotateLocal(f.knuckleX, f.knuckleY, f.knuckleZ)));
-        auto joint1 = projectPoint(clampPoint(rotateLocal(f.joint2X, f.joint2Y, f.joint2Z)));
-        auto joint2 = projectPoint(clampPoint(rotateLocal(f.joint1X, f.joint1Y, f.joint1Z)));
-        auto tip = projectPoint(clampPoint(rotateLocal(f.tipX, f.tipY, f.tipZ)));
-
-        g.setColour(baseColour.withAlpha(0.2f));
-        g.drawLine(juce::Line<float>(palm2D, knuckle), 2.0f * palmDepth);
-
-        g.setColour(boneCol);
-        g.drawLine(juce::Line<float>(knuckle, joint1), 3.0f * palmDepth);
-        g.drawLine(juce::Line<float>(joint1, joint2), 2.5f * palmDepth);
-        g.drawLine(juce::Line<float>(joint2, tip), 2.0f * palmDepth);
-
-        float jointSize = 6.0f * palmDepth;
-        if (f.isExtended) {
-            g.setColour(juce::Colours::white.withAlpha(0.8f));
-            g.fillEllipse(tip.x - jointSize / 2, tip.y - jointSize / 2, jointSize, jointSize);
-        }
-
-        g.setColour(baseColour.withAlpha(0.4f));
-        g.fillEllipse(knuckle.x - jointSize, knuckle.y - jointSize, jointSize * 2, jointSize * 2);
+StageBox GestureInstrumentAudioProcessorEditor::getStageBox() const {
+    StageBox box;
+    box.isSplit = audioProcessor.enableSplitXAxis.load();
+
+    // While auto ranging the stage shows the area the managers are really using
+    const auto& frame = audioProcessor.getRenderSnapshot();
+    if (frame.isAutoRanging) {
+        const auto& area = frame.playArea;
+        box.minX = area.minX; box.maxX = area.maxX;
+        box.minY = area.minY; box.maxY = area.maxY;
+        box.minZ = area.minZ; box.maxZ = area.maxZ;
+        return box;
     }
 
-    float pinchIntensity = juce::jlimit(0.0f, 1.0f, hand.pinchStrength * audioProcessor.pinchMultiplier.load());
-    
-    if (pinchIntensity > 0.8f && !hand.fingers[0].isExtended) {
-        Point3D pinchCenter = {
-            (hand.fingers[0].tipX + hand.fingers[1].tipX) / 2.0f,
-            (hand.fingers[0].tipY + hand.fingers[1].tipY) / 2.0f,
-            (hand.fingers[0].tipZ + hand.fingers[1].tipZ) / 2.0f
-        };
-
-        auto pinch2D = projectPoint(clampPoint(rotateLocal(pinchCenter.x, pinchCenter.y, pinchCenter.z)));
-
-        g.setColour(juce::Colours::yellow);
-        float sparkSize = 15.0f * palmDepth;
-        g.fillEllipse(pinch2D.x - sparkSize / 2, pinch2D.y - sparkSize / 2, sparkSize, sparkSize);
-
-        g.drawLine(pinch2D.x - sparkSize, pinch2D.y, pinch2D.x + sparkSize, pinch2D.y, 2.0f);
-        g.drawLine(pinch2D.x, pinch2D.y - sparkSize, pinch2D.x, pinch2D.y + sparkSize, 2.0f);
-    }
+    box.minX = audioProcessor.minWidthThreshold;
+    box.maxX = audioProcessor.maxWidthThreshold;
+    box.minY = audioProcessor.minHeightThreshold;
+    box.maxY = audioProcessor.maxHeightThreshold;
+    box.minZ = audioProcessor.minDepthThreshold;
+    box.maxZ = audioProcessor.maxDepthThreshold;
+    return box;
 }
 
 // INPUT HANDLING
@@ -852,6 +661,19 @@ bool GestureInstrumentAudioProcessorEditor::keyPressed(const juce::KeyPress& key
         muteButton.triggerClick();
         return true;
     }
+    if (key == juce::KeyPress('p')) {
+        profilerOverlay.toggle();
+        if (profilerOverlay.isVisible()) profilerOverlay.toFront(false);
+
+        // Frames are traced for as long as the overlay shows, each showing starts a fresh trace
+        if (profilerOverlay.isVisible()) audioProcessor.latencyTracer.reset();
+        audioProcessor.latencyTracer.setEnabled(profilerOverlay.isVisible());
+        return true;
+    }
+    if (key == juce::KeyPress('t') && audioProcessor.latencyTracer.isEnabled()) {
+        exportLatencyTrace();
+        return true;
+    }
     if (key == juce::KeyPress::escapeKey) {
         if (isCalibrating) {
             stopCalibration(false);
@@ -859,4 +681,16 @@ bool GestureInstrumentAudioProcessorEditor::keyPressed(const juce::KeyPress& key
         }
     }
     return false;
+}
+
+void GestureInstrumentAudioProcessorEditor::exportLatencyTrace() {
+    auto defaultFile = juce::File::getSpecialLocation(juce::File::userDocumentsDirectory)
+        .getChildFile("GestureInstrument-trace-" + juce::Time::getCurrentTime().formatted("%Y%m%d-%H%M%S") + ".json");
+
+    traceChooser = std::make_unique<juce::FileChooser>("Export Latency Trace", defaultFile, "*.json");
+    traceChooser->launchAsync(juce::FileBrowserComponent::saveMode | juce::FileBrowserComponent::canSelectFiles,
+        [this](const juce::FileChooser& fc) {
+            juce::File file = fc.getResult();
+            if (file != juce::File{}) audioProcessor.latencyTracer.exportChromeTrace(file);
+        });
 }
\ No newline at end of file
@@ -7,14 +7,13 @@
 #include "UI/VirtualCursor.h"
 #include "UI/StaticDialsComponent.h"
 #include "UI/ChordBuilder.h"
-
-struct Point3D {
-    float x, y, z;
-};
+#include "UI/StageComponent.h"
+#include "UI/FrameScheduler.h"
+#include "UI/ProfilerOverlay.h"
 
 struct CustomScaleEditor : public juce::Component {
     juce::TextButton noteButtons[12];
-    std::function<void(std::vector<int>)> onScaleChanged;
+    std::function<void(const ScaleQuantiser::Intervals&)> onScaleChanged;
 
     CustomScaleEditor() {
         juce::StringArray labels = { "1", "b2", "2", "b3", "3", "4", "b5", "5", "b6", "6", "b7", "7" };
@@ -30,7 +29,7 @@ struct CustomScaleEditor : public juce::Component {
         }
     }
 
-    void setCustomScale(const std::vector<int>& intervals) {
+    void setCustomScale(const ScaleQuantiser::Intervals& intervals) {
         for (int i = 0; i < 12; ++i) noteButtons[i].setToggleState(false, juce::dontSendNotification);
         for (int interval : intervals) {
             if (interval >= 0 && interval < 12) {
@@ -40,13 +39,13 @@ struct CustomScaleEditor : public juce::Component {
     }
 
     void updateScale() {
-        std::vector<int> newScale;
+        ScaleQuantiser::Intervals newScale;
         for (int i = 0; i < 12; ++i) {
-            if (noteButtons[i].getToggleState()) newScale.push_back(i);
+            if (noteButtons[i].getToggleState()) newScale.add(i);
         }
 
         if (newScale.empty()) {
-            newScale.push_back(0);
+            newScale.add(0);
             noteButtons[0].setToggleState(true, juce::dontSendNotification);
         }
 
@@ -62,14 +61,13 @@ struct CustomScaleEditor : public juce::Component {
     }
 };
 
-class GestureInstrumentAudioProcessorEditor : public juce::AudioProcessorEditor, public juce::Timer {
+class GestureInstrumentAudioProcessorEditor : public juce::AudioProcessorEditor {
 public:
     GestureInstrumentAudioProcessorEditor(GestureInstrumentAudioProcessor&);
     ~GestureInstrumentAudioProcessorEditor() override;
 
     void paint(juce::Graphics&) override;
     void resized() override;
-    void timerCallback() override;
     bool keyPressed(const juce::KeyPress& key) override;
 
     class CalibrationOverlay : public juce::Component {
@@ -96,8 +94,8 @@ public:
 private:
     GestureInstrumentAudioProcessor& audioProcessor;
 
-    // Pages and overlays
-    juce::OpenGLContext openGLContext;
+    // Pages and overlays. The HUD, profiler and calibration overlays are children of the stage, they sit over its GL surface
+    StageComponent stage;
     SettingsComponent settingsPage;
     juce::Viewport settingsViewport;
     StaticDialsComponent staticDialsPage;
@@ -106,6 +104,7 @@ private:
     VirtualCursor virtualCursor;
     CalibrationOverlay calibrationOverlay;
     CustomScaleEditor customScaleUI;
+    ProfilerOverlay profilerOverlay;
 
     // Buttons and labels
     juce::TextButton settingsButton{ "Settings" };
@@ -146,32 +145,38 @@ private:
     bool menuGestureFired = false;
     float menuGestureTimer = 0.0f;
     int lastKnownOutputMode = -1;
+    int lastAppliedConfigSerial = 0;
+    bool wasAnimating = false;
 
     juce::Rectangle<int> previousSize{ 1500, 700 };
     juce::Point<int> previousPosition;
 
     // Calibration
     bool isCalibrating = false;
-    float calibrationTimer = 0.0f;
+    double calibrationStartMs = 0.0;
     const float calibrationDuration = 15.0f;
-    float tempMinX = 1000.0f, tempMaxX = -1000.0f;
-    float tempMinY = 1000.0f, tempMaxY = -1000.0f;
-    float tempMinZ = 1000.0f, tempMaxZ = -1000.0f;
+    CalibrationBounds calibrationBounds;
 
     void startCalibration();
     void stopCalibration(bool success);
 
-    // 3D graphics
-    const float fov = 350.0f;
-    const float camDist = 600.0f;
-    juce::Point<float> centerScreen;
+    // 3D graphics, rendered off the message thread by the stage. OpenGL when the context supports it, the software thread otherwise
+    StageBox submittedBox;
+    bool submittedToGL = false;
+    float submittedScale = 1.0f;
+    void submitStageFrame();
+
+    // Redraws, driven by the display refresh
+    FrameScheduler frameScheduler;
+    void onFrame(bool isNewSnapshot, float deltaSeconds);
+
+    // T while the profiler is showing saves the latency trace as Chrome trace JSON
+    std::unique_ptr<juce::FileChooser> traceChooser;
+    void exportLatencyTrace();
 
     void updateScaleDropdown();
     void updateConnectionStatus();
-    juce::Point<float> projectPoint(Point3D p);
-    void draw3DGrid(juce::Graphics& g);
-    void draw3DHand(juce::Graphics& g, const HandData& hand, juce::Colour baseColour);
-    void drawCalibrationBox3D(juce::Graphics& g);
+    StageBox getStageBox() const;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(GestureInstrumentAudioProcessorEditor)
 };
\ No newline at end of file
@@ -1,10 +1,5 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
-#include "../Testing/Unit Tests/ScaleQuantiserTests.h"
-#include "../Testing/Unit Tests/PluginProcessorTests.h"
-#include "../Testing/Unit Tests/MidiManagerTests.h"
-#include "../Testing/Unit Tests/OscManagerTests.h"
-#include "../Testing/Unit Tests/LeapServiceTests.h"
 
 GestureInstrumentAudioProcessor::GestureInstrumentAudioProcessor()
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -20,8 +15,10 @@ GestureInstrumentAudioProcessor::GestureInstrumentAudioProcessor()
 {
     oscManager.connectSender("127.0.0.1", 9000);
 
-    // Run Units Tests
+    // Tests build their own processors and drive processBlock without the sensor
     if (!isRunningInUnitTest) {
+        leapThread.setProfiler(&profiler);
+        leapThread.setStats(&runtimeStats);
         leapThread.startThread(juce::Thread::Priority::high);
     }
 
@@ -29,13 +26,6 @@ GestureInstrumentAudioProcessor::GestureInstrumentAudioProcessor()
         activeLeftNotes[i].store(-1);
         activeRightNotes[i].store(-1);
     }
-
-    static bool testsHaveRun = false;
-    if (!testsHaveRun) {
-        testsHaveRun = true;
-        juce::UnitTestRunner testRunner;
-        testRunner.runAllTests();
-    }
 }
 
 GestureInstrumentAudioProcessor::~GestureInstrumentAudioProcessor() {}
@@ -72,8 +62,17 @@ int GestureInstrumentAudioProcessor::getCurrentProgram() { return 0; }
 void GestureInstrumentAudioProcessor::setCurrentProgram(int index) {}
 const juce::String GestureInstrumentAudioProcessor::getProgramName(int index) { return {}; }
 void GestureInstrumentAudioProcessor::changeProgramName(int index, const juce::String& newName) {}
-void GestureInstrumentAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock) {}
-void GestureInstrumentAudioProcessor::releaseResources() {}
+// From here until releaseResources the audio thread is the one that takes config requests
+void GestureInstrumentAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock) {
+    const juce::ScopedLock sl(requestLock);
+    applyPendingConfig();
+    isProcessing = true;
+}
+
+void GestureInstrumentAudioProcessor::releaseResources() {
+    const juce::ScopedLock sl(requestLock);
+    isProcessing = false;
+}
 
 #ifndef JucePlugin_PreferredChannelConfigurations
 bool GestureInstrumentAudioProcessor::isBusesLayoutSupported(const BusesLayout& layouts) const {
@@ -95,10 +94,22 @@ bool GestureInstrumentAudioProcessor::isBusesLayoutSupported(const BusesLayout&
 #endif
 
 void GestureInstrumentAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages) {
+    ProfilerProbes::ScopedBlockTimer blockTimer(profiler, buffer.getNumSamples(), getSampleRate());
+    RealtimeVerifier::Scope realtimeScope(buffer.getNumSamples(), getSampleRate());
+    RuntimeStats::ScopedBlock statsBlock(runtimeStats, buffer.getNumSamples(), getSampleRate());
     buffer.clear();
 
+    // A restored state lands here whole, before anything below reads a setting
+    applyPendingConfig();
+
     //Get latest sensor data
-    leapThread.getLatestData(leftHand, rightHand, isSensorConnected);
+    bool gotLatest = leapThread.getLatestData(leftHand, rightHand, isSensorConnected);
+    runtimeStats.framePickedUp(leftHand.frameId, leftHand.publishedSeconds, gotLatest);
+    latencyTracer.beginBlock(leftHand);
+
+    // Strikes found on the Leap thread since the last block
+    leapThread.setStrikeThreshold(strikeThreshold.load());
+    int numStrikes = leapThread.popStrikes(pendingStrikes, maxStrikesPerBlock);
 
     bool didLeftHandJustDisconnect = (!leftHand.isPresent && leftHandWasPresent);
     bool didRightHandJustDisconnect = (!rightHand.isPresent && rightHandWasPresent);
@@ -110,45 +121,62 @@ void GestureInstrumentAudioProcessor::processBlock(juce::AudioBuffer<float>& buf
         lastOutputModeInt = static_cast<int>(currentOutputMode);
     }
 
+    // MPE and plain notes are held separately, whatever the other one was holding has to be let go
+    bool voicingChanged = isMpeEnabled != wasMpeEnabled;
+    wasMpeEnabled = isMpeEnabled;
+
+    bool releaseAllNotes = modeChanged || voicingChanged || releaseNotesOnSwitch;
+    releaseNotesOnSwitch = false;
+
     // Send panic messages is hands disconnected
-    if (didLeftHandJustDisconnect || modeChanged) {
+    if (releaseAllNotes) midiManager.releaseMpeVoices(midiMessages);
+
+    if (didLeftHandJustDisconnect || releaseAllNotes) {
         oscManager.panicLeft();
         midiManager.panicLeft(midiMessages);
     }
-    if (didRightHandJustDisconnect || modeChanged) {
+    if (didRightHandJustDisconnect || releaseAllNotes) {
         oscManager.panicRight();
         midiManager.panicRight(midiMessages);
     }
 
-    // Apply spatital smoothing
-    float smoothingFactor = 0.15f;
+    // Apply spatital smoothing. Block time is only the fallback for frames without a sensor stamp
+    double currentSampleRate = getSampleRate();
+    float blockSeconds = currentSampleRate > 0.0 ? (float)(buffer.getNumSamples() / currentSampleRate) : 1.0f / 60.0f;
 
-    auto applySmoothing = [&](HandData& hand, bool& wasPresent, float& sX, float& sY, float& sZ, float& sRoll, float& sGrab, float& sPinch) {
-        if (hand.isPresent) {
-            if (!wasPresent) {
-                sX = hand.currentHandPositionX; sY = hand.currentHandPositionY; sZ = hand.currentHandPositionZ;
-                sRoll = hand.currentWristRotation; sGrab = hand.grabStrength; sPinch = hand.pinchStrength;
-            }
+    // Estimator runs on the raw frame before the One Euro banks touch it
+    leftEstimator.update(leftHand, blockSeconds);
+    rightEstimator.update(rightHand, blockSeconds);
 
-            sX += (hand.currentHandPositionX - sX) * smoothingFactor;
-            sY += (hand.currentHandPositionY - sY) * smoothingFactor;
-            sZ += (hand.currentHandPositionZ - sZ) * smoothingFactor;
-            sRoll += (hand.currentWristRotation - sRoll) * smoothingFactor;
-            sGrab += (hand.grabStrength - sGrab) * smoothingFactor;
-            sPinch += (hand.pinchStrength - sPinch) * smoothingFactor;
-
-            hand.currentHandPositionX = sX;
-            hand.currentHandPositionY = sY;
-            hand.currentHandPositionZ = sZ;
-            hand.currentWristRotation = sRoll;
-            hand.grabStrength = sGrab;
-            hand.pinchStrength = sPinch;
-        }
-        wasPresent = hand.isPresent;
-        };
+    // The One Euro banks step once per sensor frame, by the frame interval
+    float leftFrameSeconds = leftFrameClock.advance(leftHand, blockSeconds);
+    float rightFrameSeconds = rightFrameClock.advance(rightHand, blockSeconds);
+
+    leftPalmFilter.setParameters(smoothingMinCutoff.load(), smoothingBeta.load());
+    rightPalmFilter.setParameters(smoothingMinCutoff.load(), smoothingBeta.load());
+    leftPalmFilter.process(leftHand, leftFrameSeconds);
+    rightPalmFilter.process(rightHand, rightFrameSeconds);
+
+    leftFingerFilter.setParameters(smoothingMinCutoff.load(), smoothingBeta.load());
+    rightFingerFilter.setParameters(smoothingMinCutoff.load(), smoothingBeta.load());
+    leftFingerFilter.process(leftHand, leftFrameSeconds);
+    rightFingerFilter.process(rightHand, rightFrameSeconds);
+
+    leftEstimator.writeVelocity(leftHand);
+    rightEstimator.writeVelocity(rightHand);
 
-    applySmoothing(leftHand, leftHandWasPresent, smoothLeftX, smoothLeftY, smoothLeftZ, smoothLeftRoll, smoothLeftGrab, smoothLeftPinch);
-    applySmoothing(rightHand, rightHandWasPresent, smoothRightX, smoothRightY, smoothRightZ, smoothRightRoll, smoothRightGrab, smoothRightPinch);
+    if (currentSmoothingMode == SmoothingMode::Predictive) {
+        float horizonSeconds = predictionHorizonMs.load() * 0.001f;
+        leftEstimator.writeEstimate(leftHand, horizonSeconds);
+        rightEstimator.writeEstimate(rightHand, horizonSeconds);
+    }
+
+    latencyTracer.markSmoothed();
+
+    leftHandWasPresent = leftHand.isPresent;
+    rightHandWasPresent = rightHand.isPresent;
+
+    updatePlayArea();
 
     // Globabl muting
     bool isCurrentlyMuted = globalMute.load() || isCalibrating.load() || isVirtualMouse.load();
@@ -160,9 +188,7 @@ void GestureInstrumentAudioProcessor::processBlock(juce::AudioBuffer<float>& buf
             if (savedPreMuteVolume < 0.0f) savedPreMuteVolume = staticVolume;
 
             if (currentOutputMode == OutputMode::OSC_Only) {
-                juce::OSCMessage volMsg("/global/volume");
-                volMsg.addFloat32(0.0f);
-                oscManager.sender.send(volMsg);
+                oscManager.sendGlobalVolume(0.0f);
             }
             else {
                 midiMessages.addEvent(juce::MidiMessage::controllerEvent(2, 123, 0), 0);
@@ -172,14 +198,14 @@ void GestureInstrumentAudioProcessor::processBlock(juce::AudioBuffer<float>& buf
             }
             wasMutedLastFrame = true;
         }
+        measureOutput(midiMessages);
+        publishRenderSnapshot();
         return;
     }
 
     if (wasMutedLastFrame) {
         if (currentOutputMode == OutputMode::OSC_Only) {
-            juce::OSCMessage volMsg("/global/volume");
-            volMsg.addFloat32(savedPreMuteVolume);
-            oscManager.sender.send(volMsg);
+            oscManager.sendGlobalVolume(savedPreMuteVolume);
         }
         else {
             int vol7bit = juce::jlimit(0, 127, (int)(savedPreMuteVolume * 127.0f));
@@ -189,6 +215,10 @@ void GestureInstrumentAudioProcessor::processBlock(juce::AudioBuffer<float>& buf
         wasMutedLastFrame = false;
     }
 
+    // After the mute, so a morph running under it neither sends nor marks its changes as sent. It carries on from
+    // where it was once the mute lifts
+    updatePresetMorph(midiMessages, blockSeconds);
+
     // Reset UI trackers
     auto resetTrackers = [](auto& manager) {
         manager.liveVolume.store(-1.0f); manager.livePan.store(-1.0f); manager.liveModulation.store(-1.0f); manager.liveExpression.store(-1.0f);
@@ -208,6 +238,25 @@ void GestureInstrumentAudioProcessor::processBlock(juce::AudioBuffer<float>& buf
         instrumentChanged = false;
     }
 
+    // Loudest strike per hand drives the MIDI notes, placed in the block by when the sensor saw it. OSC gets every one
+    MidiManager::StrikeInput strikeInput;
+    strikeInput.isEnabled = strikeTriggerEnabled.load();
+    strikeInput.blockSeconds = blockSeconds;
+    double nowSeconds = juce::Time::getMillisecondCounterHiRes() * 0.001;
+
+    for (int i = 0; i < numStrikes; ++i) {
+        const auto& strike = pendingStrikes[i];
+        float& handVelocity = (strike.hand == 0) ? strikeInput.leftVelocity : strikeInput.rightVelocity;
+        int& handOffset = (strike.hand == 0) ? strikeInput.leftSampleOffset : strikeInput.rightSampleOffset;
+
+        if (strike.velocity > handVelocity) {
+            handVelocity = strike.velocity;
+            handOffset = getStrikeSampleOffset(strike, nowSeconds, currentSampleRate, buffer.getNumSamples());
+        }
+
+        if (currentOutputMode == OutputMode::OSC_Only) oscManager.sendStrike(strike);
+    }
+
     // Process core logic
     oscManager.sendRawData(leftHand, rightHand);
     oscManager.sendMidiData(midiMessages);
@@ -223,21 +272,22 @@ void GestureInstrumentAudioProcessor::processBlock(juce::AudioBuffer<float>& buf
         oscManager.processHandData(
             leftHand, rightHand,
             sensitivityLevel,
-            minWidthThreshold, maxWidthThreshold, minHeightThreshold, maxHeightThreshold, minDepthThreshold, maxDepthThreshold,
+            activePlayArea.minX, activePlayArea.maxX, activePlayArea.minY, activePlayArea.maxY, activePlayArea.minZ, activePlayArea.maxZ,
             wristMultiplier.load(), grabMultiplier.load(), pinchMultiplier.load(),
             leftXTarget, leftYTarget, leftZTarget, leftRollTarget, leftGrabTarget, leftPinchTarget,
             leftThumbTarget, leftIndexTarget, leftMiddleTarget, leftRingTarget, leftPinkyTarget,
             rightXTarget, rightYTarget, rightZTarget, rightRollTarget, rightGrabTarget, rightPinchTarget,
             rightThumbTarget, rightIndexTarget, rightMiddleTarget, rightRingTarget, rightPinkyTarget,
             rootNote, scaleType, octaveRange, currentRangeMode, startNote, endNote, enableSplitXAxis.load(), 
-            activeLeftNotes, activeRightNotes
+            activeLeftNotes, activeRightNotes,
+            leftSpeedTarget, rightSpeedTarget
         );
     }
     else if (currentOutputMode == OutputMode::MIDI_Only) {
         midiManager.processHandData(
             midiMessages, leftHand, rightHand,
             sensitivityLevel,
-            minWidthThreshold, maxWidthThreshold, minHeightThreshold, maxHeightThreshold, minDepthThreshold, maxDepthThreshold,
+            activePlayArea.minX, activePlayArea.maxX, activePlayArea.minY, activePlayArea.maxY, activePlayArea.minZ, activePlayArea.maxZ,
             wristMultiplier.load(), grabMultiplier.load(), pinchMultiplier.load(),
             leftXTarget, leftYTarget, leftZTarget, leftRollTarget, leftGrabTarget, leftPinchTarget,
             leftThumbTarget, leftIndexTarget, leftMiddleTarget, leftRingTarget, leftPinkyTarget,
@@ -249,9 +299,110 @@ void GestureInstrumentAudioProcessor::processBlock(juce::AudioBuffer<float>& buf
             leftDiatonicDegrees, leftAllowedRoots, leftChordInversionMode.load(), leftDropBass.load(),
             rightDiatonicDegrees, rightAllowedRoots, rightChordInversionMode.load(), rightDropBass.load(),
             chordEngineEnabled.load(),
-            activeLeftNotes, activeRightNotes
+            activeLeftNotes, activeRightNotes,
+            leftSpeedTarget, rightSpeedTarget,
+            strikeInput
         );
     }
+
+    latencyTracer.markRouted();
+    measureOutput(midiMessages);
+    publishRenderSnapshot();
+}
+
+void GestureInstrumentAudioProcessor::measureOutput(const juce::MidiBuffer& midiMessages) {
+    int oscSent = oscManager.takeMessagesSent();
+    bool isOsc = currentOutputMode == OutputMode::OSC_Only;
+
+    // Raw data goes out over OSC every block, so in OSC mode any block that used a new frame counts
+    bool hasOutput = isOsc ? oscSent > 0 : !midiMessages.isEmpty();
+
+    // OSC sends are synchronous so every packet has left by now, MIDI leaves at its offset into the block
+    if (latencyTracer.isTracingFrame()) {
+        double sampleRate = getSampleRate();
+        double emitDelay = (!isOsc && hasOutput && sampleRate > 0.0) ? midiMessages.getFirstEventTime() / sampleRate : 0.0;
+        latencyTracer.endBlock(isOsc ? oscSent : midiMessages.getNumEvents(), emitDelay, isOsc);
+    }
+
+    runtimeStats.output(midiMessages, oscSent);
+
+    if (!profiler.isEnabled()) return;
+
+    profiler.push(ProfilerProbes::oscMessages, (float)oscSent);
+
+    if (!hasOutput || leftHand.frameId == lastMeasuredFrame || leftHand.captureSeconds <= 0.0) return;
+
+    lastMeasuredFrame = leftHand.frameId;
+    double nowSeconds = juce::Time::getMillisecondCounterHiRes() * 0.001;
+    profiler.push(ProfilerProbes::sensorToOutput, (float)((nowSeconds - leftHand.captureSeconds) * 1000.0));
+}
+
+void GestureInstrumentAudioProcessor::updatePlayArea() {
+    PlayArea userArea;
+    userArea.minX = minWidthThreshold; userArea.maxX = maxWidthThreshold;
+    userArea.minY = minHeightThreshold; userArea.maxY = maxHeightThreshold;
+    userArea.minZ = minDepthThreshold; userArea.maxZ = maxDepthThreshold;
+
+    bool isAutoRanging = autoRangeEnabled.load();
+
+    // Sliders, calibration and presets all win over whatever the ranger had drifted to
+    if (isAutoRanging && (!wasAutoRanging || userArea != lastUserArea)) leapThread.resetAutoRange(userArea);
+
+    wasAutoRanging = isAutoRanging;
+    lastUserArea = userArea;
+    leapThread.setAutoRangeEnabled(isAutoRanging);
+    leapThread.setAutoRangeSpeed(autoRangeSpeed.load());
+
+    // Until the Leap thread has ranged a frame from the latest reset, that reset is the area
+    if (!isAutoRanging || !leapThread.getAutoRangeArea(activePlayArea)) activePlayArea = userArea;
+}
+
+void GestureInstrumentAudioProcessor::publishRenderSnapshot() {
+    RenderSnapshot next;
+    next.leftHand = leftHand;
+    next.rightHand = rightHand;
+    next.isSensorConnected = isSensorConnected;
+    next.isAutoRanging = wasAutoRanging;
+
+    // Whole mm is plenty for drawing and keeps a slowly moving area from republishing every block
+    next.playArea.minX = std::round(activePlayArea.minX); next.playArea.maxX = std::round(activePlayArea.maxX);
+    next.playArea.minY = std::round(activePlayArea.minY); next.playArea.maxY = std::round(activePlayArea.maxY);
+    next.playArea.minZ = std::round(activePlayArea.minZ); next.playArea.maxZ = std::round(activePlayArea.maxZ);
+
+    if (currentOutputMode == OutputMode::OSC_Only) {
+        next.liveSustain = oscManager.liveSustain.load();
+    }
+    else {
+        next.liveSustain = midiManager.liveSustain.load();
+        next.livePortamento = midiManager.livePortamento.load();
+    }
+
+    for (int i = 0; i < RenderSnapshot::maxNotes; ++i) {
+        next.leftNotes[i] = activeLeftNotes[i].load();
+        next.rightNotes[i] = activeRightNotes[i].load();
+    }
+
+    // A new frame with a hand in it or a change in anything else drawn, otherwise the editor has nothing new to paint.
+    // The sensor keeps streaming empty frames with no hands, those don't count
+    bool hasChanged = (next.leftHand.isPresent && next.leftHand.frameId != lastPublished.leftHand.frameId)
+        || (next.rightHand.isPresent && next.rightHand.frameId != lastPublished.rightHand.frameId)
+        || next.leftHand.isPresent != lastPublished.leftHand.isPresent
+        || next.rightHand.isPresent != lastPublished.rightHand.isPresent
+        || next.isSensorConnected != lastPublished.isSensorConnected
+        || next.liveSustain != lastPublished.liveSustain
+        || next.livePortamento != lastPublished.livePortamento
+        || next.isAutoRanging != lastPublished.isAutoRanging
+        || next.playArea != lastPublished.playArea
+        || !std::equal(next.leftNotes, next.leftNotes + RenderSnapshot::maxNotes, lastPublished.leftNotes)
+        || !std::equal(next.rightNotes, next.rightNotes + RenderSnapshot::maxNotes, lastPublished.rightNotes);
+
+    if (!hasChanged) return;
+
+    next.version = lastPublished.version + 1;
+    lastPublished = next;
+
+    renderSnapshots.getWriteBuffer() = next;
+    renderSnapshots.publish();
 }
 
 bool GestureInstrumentAudioProcessor::hasEditor() const { return true; }
@@ -259,256 +410,337 @@ juce::AudioProcessorEditor* GestureInstrumentAudioProcessor::createEditor() { re
 juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter() { return new GestureInstrumentAudioProcessor(); }
 
 void GestureInstrumentAudioProcessor::getStateInformation(juce::MemoryBlock& destData) {
-    auto xml = createPresetXml();
-    copyXmlToBinary(*xml, destData);
+    PluginState state;
+    state.config = captureRequestedConfig();
+    state.host.statsEnabled = statsEnabled;
+    state.host.statsHost = statsHost;
+    state.host.statsPort = statsPort;
+
+    state.write(destData);
 }
 
 void GestureInstrumentAudioProcessor::setStateInformation(const void* data, int sizeInBytes) {
-    std::unique_ptr<juce::XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes));
-    loadPresetXml(xmlState.get());
+    PluginState state;
+    if (!state.read(data, sizeInBytes)) return;
+
+    requestConfig(state.config);
+
+    if (!isRunningInUnitTest)
+        updateStatsSettings(state.host.statsEnabled, state.host.statsHost, state.host.statsPort);
 }
 
 std::unique_ptr<juce::XmlElement> GestureInstrumentAudioProcessor::createPresetXml() {
-    auto xml = std::make_unique<juce::XmlElement>("GestureInstrumentState");
-
-    xml->setAttribute("outputMode", static_cast<int>(currentOutputMode));
-    xml->setAttribute("currentInstrument", currentInstrument);
-
-    xml->setAttribute("rootNote", rootNote);
-    xml->setAttribute("scaleType", scaleType);
-    xml->setAttribute("currentRangeMode", static_cast<int>(currentRangeMode));
-    xml->setAttribute("startNote", startNote);
-    xml->setAttribute("endNote", endNote);
-    xml->setAttribute("octaveRange", octaveRange);
-    xml->setAttribute("invertNoteTrigger", invertNoteTrigger);
-    xml->setAttribute("showNoteNames", showNoteNames);
-    xml->setAttribute("globalMute", globalMute.load());
-    xml->setAttribute("isWindowMaximized", isWindowMaximized.load());
-    xml->setAttribute("showFloorShadow", showFloorShadow);
-    xml->setAttribute("showWallShadow", showWallShadow);
-
-    xml->setAttribute("isGestureToMouseEnabled", isGestureToMouseEnabled.load());
-    xml->setAttribute("virtualMouseGestureType", virtualMouseGestureType);
-    xml->setAttribute("virtualMouseHoldTime", virtualMouseHoldTime);
-
-    xml->setAttribute("leftXTarget", static_cast<int>(leftXTarget));
-    xml->setAttribute("leftYTarget", static_cast<int>(leftYTarget));
-    xml->setAttribute("leftZTarget", static_cast<int>(leftZTarget));
-    xml->setAttribute("leftRollTarget", static_cast<int>(leftRollTarget));
-    xml->setAttribute("leftGrabTarget", static_cast<int>(leftGrabTarget));
-    xml->setAttribute("leftPinchTarget", static_cast<int>(leftPinchTarget));
-    xml->setAttribute("leftThumbTarget", static_cast<int>(leftThumbTarget));
-    xml->setAttribute("leftIndexTarget", static_cast<int>(leftIndexTarget));
-    xml->setAttribute("leftMiddleTarget", static_cast<int>(leftMiddleTarget));
-    xml->setAttribute("leftRingTarget", static_cast<int>(leftRingTarget));
-    xml->setAttribute("leftPinkyTarget", static_cast<int>(leftPinkyTarget));
-
-    xml->setAttribute("rightXTarget", static_cast<int>(rightXTarget));
-    xml->setAttribute("rightYTarget", static_cast<int>(rightYTarget));
-    xml->setAttribute("rightZTarget", static_cast<int>(rightZTarget));
-    xml->setAttribute("rightRollTarget", static_cast<int>(rightRollTarget));
-    xml->setAttribute("rightGrabTarget", static_cast<int>(rightGrabTarget));
-    xml->setAttribute("rightPinchTarget", static_cast<int>(rightPinchTarget));
-    xml->setAttribute("rightThumbTarget", static_cast<int>(rightThumbTarget));
-    xml->setAttribute("rightIndexTarget", static_cast<int>(rightIndexTarget));
-    xml->setAttribute("rightMiddleTarget", static_cast<int>(rightMiddleTarget));
-    xml->setAttribute("rightRingTarget", static_cast<int>(rightRingTarget));
-    xml->setAttribute("rightPinkyTarget", static_cast<int>(rightPinkyTarget));
-
-    xml->setAttribute("minWidthThreshold", minWidthThreshold);
-    xml->setAttribute("maxWidthThreshold", maxWidthThreshold);
-    xml->setAttribute("minHeightThreshold", minHeightThreshold);
-    xml->setAttribute("maxHeightThreshold", maxHeightThreshold);
-    xml->setAttribute("minDepthThreshold", minDepthThreshold);
-    xml->setAttribute("maxDepthThreshold", maxDepthThreshold);
-
-    xml->setAttribute("wristMult", wristMultiplier.load());
-    xml->setAttribute("grabMult", grabMultiplier.load());
-    xml->setAttribute("pinchMult", pinchMultiplier.load());
-
-
-    xml->setAttribute("staticVolume", staticVolume);
-    xml->setAttribute("staticPan", staticPan);
-    xml->setAttribute("staticModulation", staticModulation);
-    xml->setAttribute("staticExpression", staticExpression);
-    xml->setAttribute("staticCutoff", staticCutoff);
-    xml->setAttribute("staticResonance", staticResonance);
-    xml->setAttribute("staticAttack", staticAttack);
-    xml->setAttribute("staticRelease", staticRelease);
-    xml->setAttribute("staticReverb", staticReverb);
-    xml->setAttribute("staticChorus", staticChorus);
-    xml->setAttribute("staticVibrato", staticVibrato);
-    xml->setAttribute("staticWaveform", staticWaveform);
-    xml->setAttribute("staticDelay", staticDelay);
-    xml->setAttribute("staticDistortion", staticDistortion);
-
-    juce::String scaleStr;
-    for (int i = 0; i < customScaleIntervals.size(); ++i) {
-        scaleStr += juce::String(customScaleIntervals[i]);
-        if (i < customScaleIntervals.size() - 1) scaleStr += ",";
+    return captureRequestedConfig().toXml();
+}
+
+void GestureInstrumentAudioProcessor::loadPresetXml(juce::XmlElement* xml) {
+    if (xml == nullptr || !xml->hasTagName(PresetConfig::xmlTag)) {
+        return;
     }
 
-    xml->setAttribute("isMpeEnabled", isMpeEnabled);
-    xml->setAttribute("customScaleIntervals", scaleStr);
-    xml->setAttribute("enableSplitXAxis", enableSplitXAxis.load());
+    requestConfig(PresetConfig::fromXml(*xml));
+}
+
+void GestureInstrumentAudioProcessor::requestConfig(const PresetConfig& config, const PresetTransition& transition) {
+    // Hosts restore state from whichever thread they like while the editor requests from the message thread. The
+    // lock makes them one producer, and keeps prepareToPlay and releaseResources from changing hands halfway through
+    const juce::ScopedLock sl(requestLock);
+
+    auto& pending = pendingConfigs.getWriteBuffer();
+    pending.config = config;
+    pending.transition = transition;
+    pending.serial = ++requestedConfigSerial;
+    requestedConfig = config;
+    pendingConfigs.publish();
+
+    // No audio callback to take it, as in the Standalone app without a device or a suspended plugin
+    if (!isProcessing) applyPendingConfig();
+}
 
-    xml->setAttribute("mpePitchBendAxis", mpePitchBendAxis.load());
-    xml->setAttribute("mpeTimbreAxis", mpeTimbreAxis.load());
-    xml->setAttribute("mpePressureAxis", mpePressureAxis.load());
+PresetConfig GestureInstrumentAudioProcessor::captureRequestedConfig() const {
+    const juce::ScopedLock sl(requestLock);
+    return appliedConfigSerial.load() != requestedConfigSerial ? requestedConfig : captureConfig();
+}
+
+void GestureInstrumentAudioProcessor::applyPendingConfig() {
+    if (!pendingConfigs.acquire()) return;
 
-    // Left hand chord data
-    xml->setAttribute("l_deg1", leftChordDegree1.load()); xml->setAttribute("l_deg2", leftChordDegree2.load());
-    xml->setAttribute("l_deg3", leftChordDegree3.load()); xml->setAttribute("l_deg4", leftChordDegree4.load());
-    xml->setAttribute("l_deg5", leftChordDegree5.load()); xml->setAttribute("l_deg6", leftChordDegree6.load());
-    xml->setAttribute("l_deg7", leftChordDegree7.load());
+    const auto& pending = pendingConfigs.getReadBuffer();
 
-    xml->setAttribute("l_r1", leftRootI.load()); xml->setAttribute("l_r2", leftRootII.load());
-    xml->setAttribute("l_r3", leftRootIII.load()); xml->setAttribute("l_r4", leftRootIV.load());
-    xml->setAttribute("l_r5", leftRootV.load()); xml->setAttribute("l_r6", leftRootVI.load());
-    xml->setAttribute("l_r7", leftRootVII.load());
+    // Statics start from what's playing, which may be partway through the last morph
+    auto playing = captureConfig();
+    applyConfig(pending.config);
+    appliedConfigSerial.store(pending.serial);
 
-    xml->setAttribute("l_invMode", leftChordInversionMode.load());
-    xml->setAttribute("l_dropB", leftDropBass.load());
+    presetMorph.start(playing, pending.config, pending.transition);
+    if (pending.transition.notes == PresetTransition::Notes::release) releaseNotesOnSwitch = true;
+}
 
-    // right hand chord data
-    xml->setAttribute("r_deg1", rightChordDegree1.load()); xml->setAttribute("r_deg2", rightChordDegree2.load());
-    xml->setAttribute("r_deg3", rightChordDegree3.load()); xml->setAttribute("r_deg4", rightChordDegree4.load());
-    xml->setAttribute("r_deg5", rightChordDegree5.load()); xml->setAttribute("r_deg6", rightChordDegree6.load());
-    xml->setAttribute("r_deg7", rightChordDegree7.load());
+void GestureInstrumentAudioProcessor::updatePresetMorph(juce::MidiBuffer& midiMessages, float blockSeconds) {
+    if (!presetMorph.isActive()) return;
 
-    xml->setAttribute("r_r1", rightRootI.load()); xml->setAttribute("r_r2", rightRootII.load());
-    xml->setAttribute("r_r3", rightRootIII.load()); xml->setAttribute("r_r4", rightRootIV.load());
-    xml->setAttribute("r_r5", rightRootV.load()); xml->setAttribute("r_r6", rightRootVI.load());
-    xml->setAttribute("r_r7", rightRootVII.load());
+    float handPosition = -1.0f;
+    if (presetMorph.isFollowingGesture()) handPosition = PresetMorph::getHandPosition(presetMorph.getMorph(), leftHand, rightHand, activePlayArea);
+    presetMorph.advance(blockSeconds, handPosition);
 
-    xml->setAttribute("r_invMode", rightChordInversionMode.load());
-    xml->setAttribute("r_dropB", rightDropBass.load());
+    // OSC carries floats, MIDI only resolves 1/127 so smaller steps would resend the same CC
+    bool isOsc = currentOutputMode == OutputMode::OSC_Only;
+    float minStep = isOsc ? 0.002f : 1.0f / 127.0f;
 
-    xml->setAttribute("chEng", chordEngineEnabled.load());
+    for (int i = 0; i < PresetMorph::numStatics; ++i) {
+        auto target = PresetMorph::statics[(size_t)i].target;
+        *getStaticParameter(target) = presetMorph.getValue(i);
 
-    return xml;
+        if (!presetMorph.takeChange(i, minStep)) continue;
+
+        if (isOsc) {
+            oscManager.sendGlobalParameter(target, presetMorph.getValue(i));
+        }
+        else {
+            midiManager.sendCC(midiMessages, 2, target, presetMorph.getValue(i));
+            midiManager.sendCC(midiMessages, 3, target, presetMorph.getValue(i));
+        }
+    }
 }
 
-void GestureInstrumentAudioProcessor::loadPresetXml(juce::XmlElement* xml) {
-    if (xml == nullptr || !xml->hasTagName("GestureInstrumentState")) {
-        return;
+float* GestureInstrumentAudioProcessor::getStaticParameter(GestureTarget target) {
+    switch (target) {
+    case GestureTarget::Volume:     return &staticVolume;
+    case GestureTarget::Pan:        return &staticPan;
+    case GestureTarget::Modulation: return &staticModulation;
+    case GestureTarget::Expression: return &staticExpression;
+    case GestureTarget::Cutoff:     return &staticCutoff;
+    case GestureTarget::Resonance:  return &staticResonance;
+    case GestureTarget::Attack:     return &staticAttack;
+    case GestureTarget::Release:    return &staticRelease;
+    case GestureTarget::Reverb:     return &staticReverb;
+    case GestureTarget::Chorus:     return &staticChorus;
+    case GestureTarget::Vibrato:    return &staticVibrato;
+    case GestureTarget::Waveform:   return &staticWaveform;
+    case GestureTarget::Delay:      return &staticDelay;
+    default:                        return &staticDistortion;
     }
+}
 
-    currentOutputMode = static_cast<OutputMode>(xml->getIntAttribute("outputMode", 1));
-    currentInstrument = xml->getIntAttribute("currentInstrument", 1);
-
-    rootNote = xml->getIntAttribute("rootNote", 0);
-    scaleType = xml->getIntAttribute("scaleType", 0);
-    currentRangeMode = static_cast<MusicalRangeMode>(xml->getIntAttribute("currentRangeMode", 1));
-    startNote = xml->getIntAttribute("startNote", 48);
-    endNote = xml->getIntAttribute("endNote", 72);
-    octaveRange = xml->getIntAttribute("octaveRange", 2);
-    invertNoteTrigger = xml->getBoolAttribute("invertNoteTrigger", false);
-
-    showFloorShadow = xml->getBoolAttribute("showFloorShadow", true);
-    showWallShadow = xml->getBoolAttribute("showWallShadow", true);
-    showNoteNames = xml->getBoolAttribute("showNoteNames", false);
-    globalMute.store(xml->getBoolAttribute("globalMute", false));
-    isWindowMaximized.store(xml->getBoolAttribute("isWindowMaximized", false));
-
-    isGestureToMouseEnabled.store(xml->getBoolAttribute("isGestureToMouseEnabled", true));
-    virtualMouseGestureType = xml->getIntAttribute("virtualMouseGestureType", 1);
-    virtualMouseHoldTime = (float)xml->getDoubleAttribute("virtualMouseHoldTime", 1.5);
-
-    leftXTarget = static_cast<GestureTarget>(xml->getIntAttribute("leftXTarget", 99));
-    leftYTarget = static_cast<GestureTarget>(xml->getIntAttribute("leftYTarget", 99));
-    leftZTarget = static_cast<GestureTarget>(xml->getIntAttribute("leftZTarget", 99));
-    leftRollTarget = static_cast<GestureTarget>(xml->getIntAttribute("leftRollTarget", 99));
-    leftGrabTarget = static_cast<GestureTarget>(xml->getIntAttribute("leftGrabTarget", 99));
-    leftPinchTarget = static_cast<GestureTarget>(xml->getIntAttribute("leftPinchTarget", 99));
-    leftThumbTarget = static_cast<GestureTarget>(xml->getIntAttribute("leftThumbTarget", 99));
-    leftIndexTarget = static_cast<GestureTarget>(xml->getIntAttribute("leftIndexTarget", 99));
-    leftMiddleTarget = static_cast<GestureTarget>(xml->getIntAttribute("leftMiddleTarget", 99));
-    leftRingTarget = static_cast<GestureTarget>(xml->getIntAttribute("leftRingTarget", 99));
-    leftPinkyTarget = static_cast<GestureTarget>(xml->getIntAttribute("leftPinkyTarget", 99));
-
-    rightXTarget = static_cast<GestureTarget>(xml->getIntAttribute("rightXTarget", 99));
-    rightYTarget = static_cast<GestureTarget>(xml->getIntAttribute("rightYTarget", 99));
-    rightZTarget = static_cast<GestureTarget>(xml->getIntAttribute("rightZTarget", 99));
-    rightRollTarget = static_cast<GestureTarget>(xml->getIntAttribute("rightRollTarget", 99));
-    rightGrabTarget = static_cast<GestureTarget>(xml->getIntAttribute("rightGrabTarget", 99));
-    rightPinchTarget = static_cast<GestureTarget>(xml->getIntAttribute("rightPinchTarget", 99));
-    rightThumbTarget = static_cast<GestureTarget>(xml->getIntAttribute("rightThumbTarget", 99));
-    rightIndexTarget = static_cast<GestureTarget>(xml->getIntAttribute("rightIndexTarget", 99));
-    rightMiddleTarget = static_cast<GestureTarget>(xml->getIntAttribute("rightMiddleTarget", 99));
-    rightRingTarget = static_cast<GestureTarget>(xml->getIntAttribute("rightRingTarget", 99));
-    rightPinkyTarget = static_cast<GestureTarget>(xml->getIntAttribute("rightPinkyTarget", 99));
-
-    minWidthThreshold = (float)xml->getDoubleAttribute("minWidthThreshold", -200.0);
-    maxWidthThreshold = (float)xml->getDoubleAttribute("maxWidthThreshold", 200.0);
-    minHeightThreshold = (float)xml->getDoubleAttribute("minHeightThreshold", 150.0);
-    maxHeightThreshold = (float)xml->getDoubleAttribute("maxHeightThreshold", 450.0);
-    minDepthThreshold = (float)xml->getDoubleAttribute("minDepthThreshold", -150.0);
-    maxDepthThreshold = (float)xml->getDoubleAttribute("maxDepthThreshold", 150.0);
-
-    wristMultiplier.store((float)xml->getDoubleAttribute("wristMult", 1.0));
-    grabMultiplier.store((float)xml->getDoubleAttribute("grabMult", 1.0));
-    pinchMultiplier.store((float)xml->getDoubleAttribute("pinchMult", 1.0));
-
-    staticVolume = (float)xml->getDoubleAttribute("staticVolume", 1.0);
-    staticPan = (float)xml->getDoubleAttribute("staticPan", 0.5);
-    staticModulation = (float)xml->getDoubleAttribute("staticModulation", 0.0);
-    staticExpression = (float)xml->getDoubleAttribute("staticExpression", 0.0);
-    staticCutoff = (float)xml->getDoubleAttribute("staticCutoff", 1.0);
-    staticResonance = (float)xml->getDoubleAttribute("staticResonance", 0.1);
-    staticAttack = (float)xml->getDoubleAttribute("staticAttack", 0.1);
-    staticRelease = (float)xml->getDoubleAttribute("staticRelease", 0.1);
-    staticReverb = (float)xml->getDoubleAttribute("staticReverb", 0.0);
-    staticChorus = (float)xml->getDoubleAttribute("staticChorus", 0.0);
-    staticVibrato = (float)xml->getDoubleAttribute("staticVibrato", 0.0);
-    staticWaveform = (float)xml->getDoubleAttribute("staticWaveform", 0.0);
-    staticDelay = (float)xml->getDoubleAttribute("staticDelay", 0.0);
-    staticDistortion = (float)xml->getDoubleAttribute("staticDistortion", 0.0);
-
-    juce::String scaleStr = xml->getStringAttribute("customScaleIntervals", "");
-    if (scaleStr.isNotEmpty()) {
-        customScaleIntervals.clear();
-        juce::StringArray tokens;
-        tokens.addTokens(scaleStr, ",", "");
-        for (auto t : tokens) {
-            customScaleIntervals.push_back(t.getIntValue());
-        }
-        oscManager.updateCustomScale(customScaleIntervals);
+PresetConfig GestureInstrumentAudioProcessor::captureConfig() const {
+    PresetConfig c;
+
+    c.outputMode = static_cast<int>(currentOutputMode);
+    c.currentInstrument = currentInstrument;
+
+    c.rootNote = rootNote;
+    c.scaleType = scaleType;
+    c.customScaleIntervals.size = juce::jmin(customScaleIntervals.size(), PresetConfig::maxScaleIntervals);
+    std::copy(customScaleIntervals.begin(), customScaleIntervals.begin() + c.customScaleIntervals.size, c.customScaleIntervals.values.begin());
+    c.currentRangeMode = static_cast<int>(currentRangeMode);
+    c.startNote = startNote;
+    c.endNote = endNote;
+    c.octaveRange = octaveRange;
+    c.invertNoteTrigger = invertNoteTrigger;
+    c.strikeTrigger = strikeTriggerEnabled.load();
+    c.strikeThreshold = strikeThreshold.load();
+    c.showNoteNames = showNoteNames;
+    c.globalMute = globalMute.load();
+    c.isWindowMaximized = isWindowMaximized.load();
+    c.showFloorShadow = showFloorShadow;
+    c.showWallShadow = showWallShadow;
+
+    c.isGestureToMouseEnabled = isGestureToMouseEnabled.load();
+    c.virtualMouseGestureType = virtualMouseGestureType;
+    c.virtualMouseHoldTime = virtualMouseHoldTime;
+
+    c.leftXTarget = static_cast<int>(leftXTarget);
+    c.leftYTarget = static_cast<int>(leftYTarget);
+    c.leftZTarget = static_cast<int>(leftZTarget);
+    c.leftRollTarget = static_cast<int>(leftRollTarget);
+    c.leftGrabTarget = static_cast<int>(leftGrabTarget);
+    c.leftPinchTarget = static_cast<int>(leftPinchTarget);
+    c.leftThumbTarget = static_cast<int>(leftThumbTarget);
+    c.leftIndexTarget = static_cast<int>(leftIndexTarget);
+    c.leftMiddleTarget = static_cast<int>(leftMiddleTarget);
+    c.leftRingTarget = static_cast<int>(leftRingTarget);
+    c.leftPinkyTarget = static_cast<int>(leftPinkyTarget);
+
+    c.rightXTarget = static_cast<int>(rightXTarget);
+    c.rightYTarget = static_cast<int>(rightYTarget);
+    c.rightZTarget = static_cast<int>(rightZTarget);
+    c.rightRollTarget = static_cast<int>(rightRollTarget);
+    c.rightGrabTarget = static_cast<int>(rightGrabTarget);
+    c.rightPinchTarget = static_cast<int>(rightPinchTarget);
+    c.rightThumbTarget = static_cast<int>(rightThumbTarget);
+    c.rightIndexTarget = static_cast<int>(rightIndexTarget);
+    c.rightMiddleTarget = static_cast<int>(rightMiddleTarget);
+    c.rightRingTarget = static_cast<int>(rightRingTarget);
+    c.rightPinkyTarget = static_cast<int>(rightPinkyTarget);
+
+    c.leftSpeedTarget = static_cast<int>(leftSpeedTarget);
+    c.rightSpeedTarget = static_cast<int>(rightSpeedTarget);
+
+    c.minWidthThreshold = minWidthThreshold;
+    c.maxWidthThreshold = maxWidthThreshold;
+    c.minHeightThreshold = minHeightThreshold;
+    c.maxHeightThreshold = maxHeightThreshold;
+    c.minDepthThreshold = minDepthThreshold;
+    c.maxDepthThreshold = maxDepthThreshold;
+
+    c.wristMultiplier = wristMultiplier.load();
+    c.grabMultiplier = grabMultiplier.load();
+    c.pinchMultiplier = pinchMultiplier.load();
+    c.calibrationTrimPercent = calibrationTrimPercent.load();
+    c.autoRangeEnabled = autoRangeEnabled.load();
+    c.autoRangeSpeed = autoRangeSpeed.load();
+    c.smoothingMinCutoff = smoothingMinCutoff.load();
+    c.smoothingBeta = smoothingBeta.load();
+    c.smoothingMode = static_cast<int>(currentSmoothingMode);
+    c.predictionHorizonMs = predictionHorizonMs.load();
+
+    c.staticVolume = staticVolume;
+    c.staticPan = staticPan;
+    c.staticModulation = staticModulation;
+    c.staticExpression = staticExpression;
+    c.staticCutoff = staticCutoff;
+    c.staticResonance = staticResonance;
+    c.staticAttack = staticAttack;
+    c.staticRelease = staticRelease;
+    c.staticReverb = staticReverb;
+    c.staticChorus = staticChorus;
+    c.staticVibrato = staticVibrato;
+    c.staticWaveform = staticWaveform;
+    c.staticDelay = staticDelay;
+    c.staticDistortion = staticDistortion;
+
+    c.isMpeEnabled = isMpeEnabled;
+    c.enableSplitXAxis = enableSplitXAxis.load();
+    c.mpePitchBendAxis = mpePitchBendAxis.load();
+    c.mpeTimbreAxis = mpeTimbreAxis.load();
+    c.mpePressureAxis = mpePressureAxis.load();
+
+    c.leftChordDegrees = { leftChordDegree1.load(), leftChordDegree2.load(), leftChordDegree3.load(), leftChordDegree4.load(), leftChordDegree5.load(), leftChordDegree6.load(), leftChordDegree7.load() };
+    c.leftAllowedRoots = { leftRootI.load(), leftRootII.load(), leftRootIII.load(), leftRootIV.load(), leftRootV.load(), leftRootVI.load(), leftRootVII.load() };
+    c.leftChordInversionMode = leftChordInversionMode.load();
+    c.leftDropBass = leftDropBass.load();
+
+    c.rightChordDegrees = { rightChordDegree1.load(), rightChordDegree2.load(), rightChordDegree3.load(), rightChordDegree4.load(), rightChordDegree5.load(), rightChordDegree6.load(), rightChordDegree7.load() };
+    c.rightAllowedRoots = { rightRootI.load(), rightRootII.load(), rightRootIII.load(), rightRootIV.load(), rightRootV.load(), rightRootVI.load(), rightRootVII.load() };
+    c.rightChordInversionMode = rightChordInversionMode.load();
+    c.rightDropBass = rightDropBass.load();
+
+    c.chordEngineEnabled = chordEngineEnabled.load();
+    return c;
+}
+
+void GestureInstrumentAudioProcessor::applyConfig(const PresetConfig& c) {
+    currentOutputMode = static_cast<OutputMode>(c.outputMode);
+    if (c.currentInstrument != currentInstrument) instrumentChanged = true;
+    currentInstrument = c.currentInstrument;
+
+    rootNote = c.rootNote;
+    scaleType = c.scaleType;
+    currentRangeMode = static_cast<MusicalRangeMode>(c.currentRangeMode);
+    startNote = c.startNote;
+    endNote = c.endNote;
+    octaveRange = c.octaveRange;
+    invertNoteTrigger = c.invertNoteTrigger;
+    strikeTriggerEnabled.store(c.strikeTrigger);
+    strikeThreshold.store(c.strikeThreshold);
+
+    showFloorShadow = c.showFloorShadow;
+    showWallShadow = c.showWallShadow;
+    showNoteNames = c.showNoteNames;
+    globalMute.store(c.globalMute);
+    isWindowMaximized.store(c.isWindowMaximized);
+
+    isGestureToMouseEnabled.store(c.isGestureToMouseEnabled);
+    virtualMouseGestureType = c.virtualMouseGestureType;
+    virtualMouseHoldTime = c.virtualMouseHoldTime;
+
+    leftXTarget = static_cast<GestureTarget>(c.leftXTarget);
+    leftYTarget = static_cast<GestureTarget>(c.leftYTarget);
+    leftZTarget = static_cast<GestureTarget>(c.leftZTarget);
+    leftRollTarget = static_cast<GestureTarget>(c.leftRollTarget);
+    leftGrabTarget = static_cast<GestureTarget>(c.leftGrabTarget);
+    leftPinchTarget = static_cast<GestureTarget>(c.leftPinchTarget);
+    leftThumbTarget = static_cast<GestureTarget>(c.leftThumbTarget);
+    leftIndexTarget = static_cast<GestureTarget>(c.leftIndexTarget);
+    leftMiddleTarget = static_cast<GestureTarget>(c.leftMiddleTarget);
+    leftRingTarget = static_cast<GestureTarget>(c.leftRingTarget);
+    leftPinkyTarget = static_cast<GestureTarget>(c.leftPinkyTarget);
+
+    rightXTarget = static_cast<GestureTarget>(c.rightXTarget);
+    rightYTarget = static_cast<GestureTarget>(c.rightYTarget);
+    rightZTarget = static_cast<GestureTarget>(c.rightZTarget);
+    rightRollTarget = static_cast<GestureTarget>(c.rightRollTarget);
+    rightGrabTarget = static_cast<GestureTarget>(c.rightGrabTarget);
+    rightPinchTarget = static_cast<GestureTarget>(c.rightPinchTarget);
+    rightThumbTarget = static_cast<GestureTarget>(c.rightThumbTarget);
+    rightIndexTarget = static_cast<GestureTarget>(c.rightIndexTarget);
+    rightMiddleTarget = static_cast<GestureTarget>(c.rightMiddleTarget);
+    rightRingTarget = static_cast<GestureTarget>(c.rightRingTarget);
+    rightPinkyTarget = static_cast<GestureTarget>(c.rightPinkyTarget);
+
+    leftSpeedTarget = static_cast<GestureTarget>(c.leftSpeedTarget);
+    rightSpeedTarget = static_cast<GestureTarget>(c.rightSpeedTarget);
+
+    minWidthThreshold = c.minWidthThreshold;
+    maxWidthThreshold = c.maxWidthThreshold;
+    minHeightThreshold = c.minHeightThreshold;
+    maxHeightThreshold = c.maxHeightThreshold;
+    minDepthThreshold = c.minDepthThreshold;
+    maxDepthThreshold = c.maxDepthThreshold;
+
+    wristMultiplier.store(c.wristMultiplier);
+    grabMultiplier.store(c.grabMultiplier);
+    pinchMultiplier.store(c.pinchMultiplier);
+    calibrationTrimPercent.store(c.calibrationTrimPercent);
+    autoRangeEnabled.store(c.autoRangeEnabled);
+    autoRangeSpeed.store(c.autoRangeSpeed);
+    smoothingMinCutoff.store(c.smoothingMinCutoff);
+    smoothingBeta.store(c.smoothingBeta);
+    currentSmoothingMode = static_cast<SmoothingMode>(c.smoothingMode);
+    predictionHorizonMs.store(c.predictionHorizonMs);
+
+    staticVolume = c.staticVolume;
+    staticPan = c.staticPan;
+    staticModulation = c.staticModulation;
+    staticExpression = c.staticExpression;
+    staticCutoff = c.staticCutoff;
+    staticResonance = c.staticResonance;
+    staticAttack = c.staticAttack;
+    staticRelease = c.staticRelease;
+    staticReverb = c.staticReverb;
+    staticChorus = c.staticChorus;
+    staticVibrato = c.staticVibrato;
+    staticWaveform = c.staticWaveform;
+    staticDelay = c.staticDelay;
+    staticDistortion = c.staticDistortion;
+
+    // Fixed size on both sides, so on the audio thread this only copies
+    customScaleIntervals = {};
+    for (int i = 0; i < c.customScaleIntervals.size; ++i) customScaleIntervals.add(c.customScaleIntervals.values[(size_t)i]);
+    oscManager.updateCustomScale(customScaleIntervals);
+
+    isMpeEnabled = c.isMpeEnabled;
+    enableSplitXAxis.store(c.enableSplitXAxis);
+    mpePitchBendAxis.store(c.mpePitchBendAxis);
+    mpeTimbreAxis.store(c.mpeTimbreAxis);
+    mpePressureAxis.store(c.mpePressureAxis);
+
+    std::atomic<bool>* leftDegrees[] = { &leftChordDegree1, &leftChordDegree2, &leftChordDegree3, &leftChordDegree4, &leftChordDegree5, &leftChordDegree6, &leftChordDegree7 };
+    std::atomic<bool>* leftRoots[] = { &leftRootI, &leftRootII, &leftRootIII, &leftRootIV, &leftRootV, &leftRootVI, &leftRootVII };
+    std::atomic<bool>* rightDegrees[] = { &rightChordDegree1, &rightChordDegree2, &rightChordDegree3, &rightChordDegree4, &rightChordDegree5, &rightChordDegree6, &rightChordDegree7 };
+    std::atomic<bool>* rightRoots[] = { &rightRootI, &rightRootII, &rightRootIII, &rightRootIV, &rightRootV, &rightRootVI, &rightRootVII };
+
+    for (size_t i = 0; i < 7; ++i) {
+        leftDegrees[i]->store(c.leftChordDegrees[i]);
+        leftRoots[i]->store(c.leftAllowedRoots[i]);
+        rightDegrees[i]->store(c.rightChordDegrees[i]);
+        rightRoots[i]->store(c.rightAllowedRoots[i]);
     }
 
-    isMpeEnabled = xml->getBoolAttribute("isMpeEnabled", false);
-    enableSplitXAxis.store(xml->getBoolAttribute("enableSplitXAxis", false));
-    mpePitchBendAxis.store(xml->getIntAttribute("mpePitchBendAxis", 1));
-    mpeTimbreAxis.store(xml->getIntAttribute("mpeTimbreAxis", 2));
-    mpePressureAxis.store(xml->getIntAttribute("mpePressureAxis", 3));
-
-    // Load left hand chord data
-    leftChordDegree1.store(xml->getBoolAttribute("l_deg1", true));  leftChordDegree2.store(xml->getBoolAttribute("l_deg2", false));
-    leftChordDegree3.store(xml->getBoolAttribute("l_deg3", true));  leftChordDegree4.store(xml->getBoolAttribute("l_deg4", false));
-    leftChordDegree5.store(xml->getBoolAttribute("l_deg5", true));  leftChordDegree6.store(xml->getBoolAttribute("l_deg6", false));
-    leftChordDegree7.store(xml->getBoolAttribute("l_deg7", false));
-
-    leftRootI.store(xml->getBoolAttribute("l_r1", true));  leftRootII.store(xml->getBoolAttribute("l_r2", true));
-    leftRootIII.store(xml->getBoolAttribute("l_r3", true));  leftRootIV.store(xml->getBoolAttribute("l_r4", true));
-    leftRootV.store(xml->getBoolAttribute("l_r5", true));  leftRootVI.store(xml->getBoolAttribute("l_r6", true));
-    leftRootVII.store(xml->getBoolAttribute("l_r7", true));
-
-    leftChordInversionMode.store(xml->getIntAttribute("l_invMode", 0));
-    leftDropBass.store(xml->getBoolAttribute("l_dropB", false));
-
-    // load right hand chord data
-    rightChordDegree1.store(xml->getBoolAttribute("r_deg1", true));  rightChordDegree2.store(xml->getBoolAttribute("r_deg2", false));
-    rightChordDegree3.store(xml->getBoolAttribute("r_deg3", true));  rightChordDegree4.store(xml->getBoolAttribute("r_deg4", false));
-    rightChordDegree5.store(xml->getBoolAttribute("r_deg5", true));  rightChordDegree6.store(xml->getBoolAttribute("r_deg6", false));
-    rightChordDegree7.store(xml->getBoolAttribute("r_deg7", false));
-
-    rightRootI.store(xml->getBoolAttribute("r_r1", true)); rightRootII.store(xml->getBoolAttribute("r_r2", true));
-    rightRootIII.store(xml->getBoolAttribute("r_r3", true)); rightRootIV.store(xml->getBoolAttribute("r_r4", true));
-    rightRootV.store(xml->getBoolAttribute("r_r5", true)); rightRootVI.store(xml->getBoolAttribute("r_r6", true));
-    rightRootVII.store(xml->getBoolAttribute("r_r7", true));
-
-    rightChordInversionMode.store(xml->getIntAttribute("r_invMode", 0));
-    rightDropBass.store(xml->getBoolAttribute("r_dropB", false));
-
-    chordEngineEnabled.store(xml->getBoolAttribute("chEng", true));
+    leftChordInversionMode.store(c.leftChordInversionMode);
+    leftDropBass.store(c.leftDropBass);
+    rightChordInversionMode.store(c.rightChordInversionMode);
+    rightDropBass.store(c.rightDropBass);
+
+    chordEngineEnabled.store(c.chordEngineEnabled);
 }
\ No newline at end of file
@@ -8,12 +8,31 @@
 #include "MIDI/GestureTarget.h"
 #include "Helpers/MusicalRangeMode.h" 
 #include "Helpers/LeapThread.h"
+#include "Helpers/OneEuroFilter.h"
+#include "Helpers/FingerFilterBank.h"
+#include "Helpers/KalmanEstimator.h"
+#include "Helpers/RenderSnapshot.h"
+#include "Helpers/TripleBuffer.h"
+#include "Helpers/AutoRanger.h"
+#include "Helpers/ProfilerProbes.h"
+#include "Helpers/LatencyTracer.h"
+#include "Helpers/RealtimeVerifier.h"
+#include "Helpers/RuntimeStats.h"
+#include "OSC/StatsPublisher.h"
+#include "Helpers/PresetConfig.h"
+#include "Helpers/PluginState.h"
+#include "Helpers/PresetMorph.h"
 
 enum class OutputMode {
     OSC_Only,
     MIDI_Only
 };
 
+enum class SmoothingMode {
+    Adaptive,
+    Predictive
+};
+
 class GestureInstrumentAudioProcessor : public juce::AudioProcessor {
 public:
     static inline bool isRunningInUnitTest = false;
@@ -51,6 +70,22 @@ public:
         oscManager.connectSender(newIp, newPort);
     }
 
+    // Message thread. Starts, restarts or stops the /stats feed, false if it should be on but couldn't connect
+    bool updateStatsSettings(bool shouldSend, juce::String newHost, int newPort) {
+        statsEnabled = shouldSend;
+        statsHost = newHost;
+        statsPort = newPort;
+
+        if (!shouldSend) {
+            statsPublisher.stop();
+            return true;
+        }
+
+        // A host that can't be reached leaves the feed off rather than the setting claiming otherwise
+        statsEnabled = statsPublisher.start(statsHost, statsPort);
+        return statsEnabled;
+    }
+
     // Global state / Routing
     OutputMode currentOutputMode = OutputMode::MIDI_Only;
     std::atomic<bool> globalMute{ false };
@@ -63,13 +98,17 @@ public:
     // Musicial settings
     int rootNote = 0;
     int scaleType = 0;
-    std::vector<int> customScaleIntervals{ 0, 2, 4, 7, 9 };
+    ScaleQuantiser::Intervals customScaleIntervals{ 0, 2, 4, 7, 9 };
 
     MusicalRangeMode currentRangeMode = MusicalRangeMode::OctaveRange;
     int octaveRange = 2;
     int startNote = 48;
     int endNote = 72;
     bool invertNoteTrigger = false;
+
+    // Strike triggering, notes start on a downward strike with velocity from its speed in mm/s
+    std::atomic<bool> strikeTriggerEnabled{ false };
+    std::atomic<float> strikeThreshold{ 400.0f };
     bool showNoteNames = false;
 
     // Mpe settings
@@ -128,6 +167,9 @@ public:
     GestureTarget rightRingTarget = GestureTarget::None;
     GestureTarget rightPinkyTarget = GestureTarget::None;
 
+    GestureTarget leftSpeedTarget = GestureTarget::None;
+    GestureTarget rightSpeedTarget = GestureTarget::None;
+
     // Spatial and hardware thresholds
     HandData leftHand;
     HandData rightHand;
@@ -149,6 +191,21 @@ public:
     std::atomic<float> grabMultiplier{ 1.0f };
     std::atomic<float> pinchMultiplier{ 1.0f };
 
+    // Percent of calibration samples ignored at each edge of the play area, so stray frames don't stretch it
+    std::atomic<float> calibrationTrimPercent{ 2.0f };
+
+    // Auto range lets the play area follow the hands between calibrations, bounds move at most this many mm/s
+    std::atomic<bool> autoRangeEnabled{ false };
+    std::atomic<float> autoRangeSpeed{ 10.0f };
+
+    // Adaptive smoothing, cutoff in Hz at rest and how fast it opens up per mm/s of movement
+    std::atomic<float> smoothingMinCutoff{ 1.0f };
+    std::atomic<float> smoothingBeta{ 0.01f };
+
+    // Predictive takes the palm and fingertips from the Kalman estimate, led by the horizon to cover sensor latency
+    SmoothingMode currentSmoothingMode = SmoothingMode::Adaptive;
+    std::atomic<float> predictionHorizonMs{ 20.0f };
+
     // Static parameters
     float staticVolume = 0.8f;
     float staticPan = 0.5f;
@@ -169,24 +226,125 @@ public:
     OscManager oscManager;
     MidiManager midiManager;
 
+    // Timings for the editor's profiler overlay, only gathered while it is showing
+    ProfilerProbes profiler;
+
+    // Sensor frame to MIDI or OSC, per stage. Traced alongside the profiler overlay and exported from the editor
+    LatencyTracer latencyTracer;
+
+    // Health counters from every thread, sent as /stats by a low priority thread while the feed is on.
+    // Host settings rather than part of a preset, saved with the plugin state only
+    RuntimeStats runtimeStats;
+    StatsPublisher statsPublisher{ runtimeStats };
+    bool statsEnabled = false;
+    juce::String statsHost{ "127.0.0.1" };
+    int statsPort = 9001;
+
+    // Preset files. Loading goes through requestConfig, so it lands at a block boundary like any other switch
     std::unique_ptr<juce::XmlElement> createPresetXml();
     void loadPresetXml(juce::XmlElement* xml);
 
+    // Every preset setting in one piece. Capture and apply touch the fields directly, apply belongs on the audio
+    // thread or somewhere it can't race it
+    PresetConfig captureConfig() const;
+    void applyConfig(const PresetConfig& config);
+
+    // Any thread. Hands a whole configuration to the audio thread, which takes it at the start of its next block
+    // so no block ever runs on half of one. Outside prepareToPlay and releaseResources nothing is processing and it
+    // applies straight away.
+    // The transition says whether held notes carry over and whether the static parameters glide to the new preset
+    void requestConfig(const PresetConfig& config, const PresetTransition& transition = {});
+
+    // Goes up each time the audio thread takes a requested configuration, the editor refreshes its controls on a change
+    int getAppliedConfigSerial() const { return appliedConfigSerial.load(); }
+
+    // Editor side of the render snapshot, message thread only. Pull once per UI frame, true if a newer one arrived
+    bool pullRenderSnapshot() { return renderSnapshots.acquire(); }
+    const RenderSnapshot& getRenderSnapshot() const { return renderSnapshots.getReadBuffer(); }
+
+    // Calibration runs on the Leap thread, the editor only starts, stops and reads it
+    void startCalibration() {
+        isCalibrating.store(true);
+        leapThread.startCalibration(calibrationTrimPercent.load());
+    }
+
+    void stopCalibration() {
+        leapThread.stopCalibration();
+        isCalibrating.store(false);
+    }
+
+    bool getCalibrationBounds(CalibrationBounds& out) { return leapThread.getCalibrationBounds(out); }
+
+    // Feeds a frame in place of the sensor, only with isRunningInUnitTest set so the Leap thread never started.
+    // The next processBlock picks it up exactly as it would a polled one
+    void injectSensorFrame(const HandData& left, const HandData& right, bool connected = true) {
+        leapThread.injectFrame(left, right, connected);
+    }
+
 private:
     LeapThread leapThread;
 
+    // Auto range, the Leap thread moves the area and starts over from the thresholds whenever they are set by hand
+    PlayArea lastUserArea;
+    PlayArea activePlayArea;
+    bool wasAutoRanging = false;
+    void updatePlayArea();
+
     // Smoothing state
     bool wasMutedLastFrame = false;
     float savedPreMuteVolume = 0.8f;
     int lastOutputModeInt = -1;
 
     bool leftHandWasPresent = false;
-    float smoothLeftX = 0.0f, smoothLeftY = 0.0f, smoothLeftZ = 0.0f;
-    float smoothLeftRoll = 0.0f, smoothLeftGrab = 0.0f, smoothLeftPinch = 0.0f;
-
     bool rightHandWasPresent = false;
-    float smoothRightX = 0.0f, smoothRightY = 0.0f, smoothRightZ = 0.0f;
-    float smoothRightRoll = 0.0f, smoothRightGrab = 0.0f, smoothRightPinch = 0.0f;
+    PalmFilterBank leftPalmFilter;
+    PalmFilterBank rightPalmFilter;
+    FingerFilterBank leftFingerFilter;
+    FingerFilterBank rightFingerFilter;
+    SensorFrameClock leftFrameClock;
+    SensorFrameClock rightFrameClock;
+    HandKalmanEstimator leftEstimator;
+    HandKalmanEstimator rightEstimator;
+
+    static constexpr int maxStrikesPerBlock = 64;
+    StrikeEvent pendingStrikes[maxStrikesPerBlock];
+
+    // Hands, notes and live values handed to the editor in one piece so it never reads a frame mid write
+    TripleBuffer<RenderSnapshot> renderSnapshots;
+    RenderSnapshot lastPublished;
+    void publishRenderSnapshot();
+
+    // Sensor to output latency is taken once per sensor frame, from the first block that sends something for it.
+    // Also closes the latency trace for the block
+    long long lastMeasuredFrame = -1;
+    void measureOutput(const juce::MidiBuffer& midiMessages);
+
+    // Configurations waiting for the audio thread. Until one is taken, state saves hand back the requested one
+    // rather than the fields it hasn't replaced yet
+    struct PendingConfig {
+        PresetConfig config;
+        PresetTransition transition;
+        int serial = 0;
+    };
+
+    // Writing to pendingConfigs and the requested fields is done under requestLock, the audio thread never takes it.
+    // isProcessing says whether the audio thread is the one taking them, it only changes under the lock too
+    TripleBuffer<PendingConfig> pendingConfigs;
+    juce::CriticalSection requestLock;
+    bool isProcessing = false;
+    PresetConfig requestedConfig;
+    int requestedConfigSerial = 0;
+    std::atomic<int> appliedConfigSerial{ 0 };
+    void applyPendingConfig();
+    PresetConfig captureRequestedConfig() const;
+
+    // Preset transitions. Notes are let go at the next block if the transition asked for it, and the statics are
+    // written and sent from the audio thread while a morph runs
+    PresetMorph presetMorph;
+    bool releaseNotesOnSwitch = false;
+    bool wasMpeEnabled = false;
+    void updatePresetMorph(juce::MidiBuffer& midiMessages, float blockSeconds);
+    float* getStaticParameter(GestureTarget target);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(GestureInstrumentAudioProcessor)
 };
\ No newline at end of file
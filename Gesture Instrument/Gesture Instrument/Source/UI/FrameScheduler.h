@@ -0,0 +1,89 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "../PluginProcessor.h"
+
+// Drives every editor redraw from the display's vblank instead of separate 60 Hz timers.
+// Each frame pulls at most one render snapshot and hands it to onFrame, the callback decides what to repaint.
+// With no hands, no new snapshots and nothing animating it lets go of the vblank and polls slowly until something changes
+class FrameScheduler : private juce::Timer {
+public:
+    // Once per frame, isNewSnapshot is false when the audio side had nothing new to show
+    std::function<void(bool isNewSnapshot, float deltaSeconds)> onFrame;
+
+    // True while something on screen moves without new snapshots, calibration or a gesture hold for example
+    std::function<bool()> isAnimating;
+
+    FrameScheduler(GestureInstrumentAudioProcessor& p, juce::Component& hostComponent)
+        : audioProcessor(p), host(hostComponent) {
+    }
+
+    ~FrameScheduler() override { stop(); }
+
+    void start() {
+        lastTickSeconds = 0.0;
+        framesWithoutActivity = 0;
+        attachToDisplay();
+    }
+
+    void stop() {
+        stopTimer();
+        vblank = {};
+        isIdle = false;
+    }
+
+    // Back to full rate straight away, for things the scheduler can't see coming like a calibration starting
+    void wake() {
+        framesWithoutActivity = 0;
+        if (isIdle) attachToDisplay();
+    }
+
+    bool isIdling() const { return isIdle; }
+
+private:
+    static constexpr int idlePollHz = 10;
+    static constexpr int framesBeforeIdle = 30;
+    static constexpr float maxFrameSeconds = 0.1f;
+
+    GestureInstrumentAudioProcessor& audioProcessor;
+    juce::Component& host;
+
+    juce::VBlankAttachment vblank;
+    bool isIdle = false;
+    int framesWithoutActivity = 0;
+    double lastTickSeconds = 0.0;
+
+    void attachToDisplay() {
+        stopTimer();
+        isIdle = false;
+        vblank = juce::VBlankAttachment(&host, [this] { tick(); });
+    }
+
+    void dropToIdle() {
+        vblank = {};
+        isIdle = true;
+        startTimerHz(idlePollHz);
+    }
+
+    void timerCallback() override { tick(); }
+
+    void tick() {
+        double now = juce::Time::getMillisecondCounterHiRes() * 0.001;
+        float deltaSeconds = lastTickSeconds > 0.0 ? (float)juce::jmin((double)maxFrameSeconds, now - lastTickSeconds) : 0.0f;
+        lastTickSeconds = now;
+
+        bool isNewSnapshot = audioProcessor.pullRenderSnapshot();
+        if (onFrame) onFrame(isNewSnapshot, deltaSeconds);
+
+        const auto& frame = audioProcessor.getRenderSnapshot();
+        bool hasActivity = isNewSnapshot || frame.leftHand.isPresent || frame.rightHand.isPresent || (isAnimating && isAnimating());
+
+        if (hasActivity) {
+            framesWithoutActivity = 0;
+            if (isIdle) attachToDisplay();
+        }
+        else if (!isIdle && ++framesWithoutActivity >= framesBeforeIdle) {
+            dropToIdle();
+        }
+    }
+};
@@ -10,6 +10,8 @@ void HUDComponents::paint(juce::Graphics& g) {
     int barHeight = getHeight() * 0.65f;
     int topBarWidth = getWidth() * 0.25f;
 
+    const auto& frame = audioProcessor.getRenderSnapshot();
+
     int margin = 10;
     int spacing = 15;
     int topY = 10;
@@ -29,20 +31,20 @@ void HUDComponents::paint(juce::Graphics& g) {
     float rightMinX = splitX ? centerX : audioProcessor.minWidthThreshold;
 
     float leftValX = -1.0f, leftValY = -1.0f, leftValZ = -1.0f, leftValRoll = -1.0f;
-    if (audioProcessor.leftHand.isPresent) {
-        leftValX = normalizeAxis(audioProcessor.leftHand.currentHandPositionX, audioProcessor.minWidthThreshold, leftMaxX, sens);
-        leftValY = normalizeAxis(audioProcessor.leftHand.currentHandPositionY, audioProcessor.minHeightThreshold, audioProcessor.maxHeightThreshold, sens);
-        leftValZ = 1.0f - normalizeAxis(audioProcessor.leftHand.currentHandPositionZ, audioProcessor.minDepthThreshold, audioProcessor.maxDepthThreshold, sens);
-        float baseLeftRoll = juce::jmap(audioProcessor.leftHand.currentWristRotation, -0.6f, 0.6f, 0.0f, 1.0f);
+    if (frame.leftHand.isPresent) {
+        leftValX = normalizeAxis(frame.leftHand.currentHandPositionX, audioProcessor.minWidthThreshold, leftMaxX, sens);
+        leftValY = normalizeAxis(frame.leftHand.currentHandPositionY, audioProcessor.minHeightThreshold, audioProcessor.maxHeightThreshold, sens);
+        leftValZ = 1.0f - normalizeAxis(frame.leftHand.currentHandPositionZ, audioProcessor.minDepthThreshold, audioProcessor.maxDepthThreshold, sens);
+        float baseLeftRoll = juce::jmap(frame.leftHand.currentWristRotation, -0.6f, 0.6f, 0.0f, 1.0f);
         leftValRoll = 1.0f - juce::jlimit(0.0f, 1.0f, baseLeftRoll * audioProcessor.wristMultiplier.load());
     }
 
     float rightValX = -1.0f, rightValY = -1.0f, rightValZ = -1.0f, rightValRoll = -1.0f;
-    if (audioProcessor.rightHand.isPresent) {
-        rightValX = normalizeAxis(audioProcessor.rightHand.currentHandPositionX, rightMinX, audioProcessor.maxWidthThreshold, sens);
-        rightValY = normalizeAxis(audioProcessor.rightHand.currentHandPositionY, audioProcessor.minHeightThreshold, audioProcessor.maxHeightThreshold, sens);
-        rightValZ = 1.0f - normalizeAxis(audioProcessor.rightHand.currentHandPositionZ, audioProcessor.minDepthThreshold, audioProcessor.maxDepthThreshold, sens);
-        float baseRightRoll = juce::jmap(audioProcessor.rightHand.currentWristRotation, -0.6f, 0.6f, 0.0f, 1.0f);
+    if (frame.rightHand.isPresent) {
+        rightValX = normalizeAxis(frame.rightHand.currentHandPositionX, rightMinX, audioProcessor.maxWidthThreshold, sens);
+        rightValY = normalizeAxis(frame.rightHand.currentHandPositionY, audioProcessor.minHeightThreshold, audioProcessor.maxHeightThreshold, sens);
+        rightValZ = 1.0f - normalizeAxis(frame.rightHand.currentHandPositionZ, audioProcessor.minDepthThreshold, audioProcessor.maxDepthThreshold, sens);
+        float baseRightRoll = juce::jmap(frame.rightHand.currentWristRotation, -0.6f, 0.6f, 0.0f, 1.0f);
         rightValRoll = 1.0f - juce::jlimit(0.0f, 1.0f, baseRightRoll * audioProcessor.wristMultiplier.load());
     }
 
@@ -93,11 +95,11 @@ void HUDComponents::paint(juce::Graphics& g) {
     float portamentoVal = -1.0f;
 
     if (audioProcessor.currentOutputMode == OutputMode::MIDI_Only) {
-        sustainVal = audioProcessor.midiManager.liveSustain.load();
-        portamentoVal = audioProcessor.midiManager.livePortamento.load();
+        sustainVal = frame.liveSustain;
+        portamentoVal = frame.livePortamento;
     }
     else if (audioProcessor.currentOutputMode == OutputMode::OSC_Only) {
-        sustainVal = audioProcessor.oscManager.liveSustain.load();
+        sustainVal = frame.liveSustain;
     }
 
     auto isLeftHand = [&](GestureTarget t) {
@@ -143,14 +145,14 @@ void HUDComponents::paint(juce::Graphics& g) {
         bool susMappedLeft = isLeftHand(GestureTarget::Sustain);
         bool susMappedRight = isRightHand(GestureTarget::Sustain);
 
-        drawStaticBadge("SUSTAIN", sustainVal, juce::Rectangle<int>(leftX, susY, badgeW, badgeH), susMappedLeft, audioProcessor.leftHand.isPresent);
-        drawStaticBadge("SUSTAIN", sustainVal, juce::Rectangle<int>(rightX, susY, badgeW, badgeH), susMappedRight, audioProcessor.rightHand.isPresent);
+        drawStaticBadge("SUSTAIN", sustainVal, juce::Rectangle<int>(leftX, susY, badgeW, badgeH), susMappedLeft, frame.leftHand.isPresent);
+        drawStaticBadge("SUSTAIN", sustainVal, juce::Rectangle<int>(rightX, susY, badgeW, badgeH), susMappedRight, frame.rightHand.isPresent);
 
         bool portMappedLeft = isLeftHand(GestureTarget::Portamento);
         bool portMappedRight = isRightHand(GestureTarget::Portamento);
 
-        drawStaticBadge("PORTAMENTO", portamentoVal, juce::Rectangle<int>(leftX, portY, badgeW, badgeH), portMappedLeft, audioProcessor.leftHand.isPresent);
-        drawStaticBadge("PORTAMENTO", portamentoVal, juce::Rectangle<int>(rightX, portY, badgeW, badgeH), portMappedRight, audioProcessor.rightHand.isPresent);
+        drawStaticBadge("PORTAMENTO", portamentoVal, juce::Rectangle<int>(leftX, portY, badgeW, badgeH), portMappedLeft, frame.leftHand.isPresent);
+        drawStaticBadge("PORTAMENTO", portamentoVal, juce::Rectangle<int>(rightX, portY, badgeW, badgeH), portMappedRight, frame.rightHand.isPresent);
     }
 }
 
@@ -196,7 +198,7 @@ void HUDComponents::drawParameterHUD(juce::Graphics& g, juce::Rectangle<int> bou
 void HUDComponents::drawScaleBlocks(juce::Graphics& g, juce::Rectangle<int> bounds, float value, bool isVertical, juce::Colour color, bool isLeftHand) {
     ScaleQuantiser quantiser;
     quantiser.customIntervals = audioProcessor.customScaleIntervals;
-    std::vector<int> intervals = quantiser.getScaleIntervals(audioProcessor.scaleType);
+    auto intervals = quantiser.getScaleIntervals(audioProcessor.scaleType);
 
     int minNote, maxNote;
     if (audioProcessor.currentRangeMode == MusicalRangeMode::OctaveRange) {
@@ -249,11 +251,12 @@ void HUDComponents::drawScaleBlocks(juce::Graphics& g, juce::Rectangle<int> boun
     if (displayNotes.empty()) displayNotes.push_back(minNote);
 
     int totalBlocks = (int)displayNotes.size();
-    std::atomic<int>* activeNotes = isLeftHand ? audioProcessor.activeLeftNotes : audioProcessor.activeRightNotes;
+    const auto& frame = audioProcessor.getRenderSnapshot();
+    const int* activeNotes = isLeftHand ? frame.leftNotes : frame.rightNotes;
 
     bool anyNotePlaying = false;
-    for (int n = 0; n < 8; ++n) {
-        if (activeNotes[n].load() != -1) {
+    for (int n = 0; n < RenderSnapshot::maxNotes; ++n) {
+        if (activeNotes[n] != -1) {
             anyNotePlaying = true;
             break;
         }
@@ -286,8 +289,8 @@ void HUDComponents::drawScaleBlocks(juce::Graphics& g, juce::Rectangle<int> boun
         bool isHighlighted = false;
 
         if (anyNotePlaying) {
-            for (int n = 0; n < 8; ++n) {
-                if (activeNotes[n].load() == noteNum) {
+            for (int n = 0; n < RenderSnapshot::maxNotes; ++n) {
+                if (activeNotes[n] == noteNum) {
                     isHighlighted = true;
                     break;
                 }
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// Cached lookup of the clickable components under a point, for the virtual cursor.
+// The tree under the root is walked once in paint order into a grid of cells, and rebuilt only when something in it
+// moves, resizes, scrolls, changes visibility or z order. A lookup checks one cell instead of walking the hierarchy
+// and casting every component it meets. Anything that takes clicks is kept so pages stacked on top still hide
+// the controls underneath, the same answer getComponentAt would give
+class HitTargetIndex : private juce::ComponentListener {
+public:
+    enum class Kind { none, button, comboBox, slider };
+
+    struct Hit {
+        juce::Component* component = nullptr;
+        Kind kind = Kind::none;
+
+        bool isClickable() const { return component != nullptr && kind != Kind::none; }
+    };
+
+    ~HitTargetIndex() override { stopWatching(); }
+
+    // The component whose coordinates lookups are in, and one of its children to leave out (the cursor itself)
+    void setRoot(juce::Component* newRoot, juce::Component* childToIgnore) {
+        root = newRoot;
+        ignored = childToIgnore;
+        isDirty = true;
+    }
+
+    void invalidate() { isDirty = true; }
+
+    Hit find(juce::Point<int> position) {
+        if (isDirty) rebuild();
+        if (cellsWide == 0 || cellsHigh == 0) return {};
+
+        int cellX = position.x / cellSize;
+        int cellY = position.y / cellSize;
+        if (position.x < 0 || position.y < 0 || cellX >= cellsWide || cellY >= cellsHigh) return {};
+
+        // Entries are stored back to front, the last one containing the point is the one on top
+        const auto& cell = cells[(size_t)(cellY * cellsWide + cellX)];
+        for (auto it = cell.rbegin(); it != cell.rend(); ++it) {
+            const auto& entry = entries[(size_t)*it];
+            if (!entry.bounds.contains(position)) continue;
+
+            if (entry.component == nullptr) {
+                // Deleted since the last rebuild, the listener has already asked for a new one
+                return {};
+            }
+
+            return { entry.component.getComponent(), entry.kind };
+        }
+
+        return {};
+    }
+
+private:
+    static constexpr int cellSize = 48;
+
+    struct Entry {
+        juce::Component::SafePointer<juce::Component> component;
+        juce::Rectangle<int> bounds;
+        Kind kind = Kind::none;
+    };
+
+    juce::Component* root = nullptr;
+    juce::Component* ignored = nullptr;
+    bool isDirty = true;
+
+    std::vector<Entry> entries;
+    std::vector<std::vector<int>> cells;
+    int cellsWide = 0, cellsHigh = 0;
+
+    std::vector<juce::Component::SafePointer<juce::Component>> watched;
+
+    void rebuild() {
+        isDirty = false;
+        stopWatching();
+        entries.clear();
+
+        if (root == nullptr) {
+            cellsWide = cellsHigh = 0;
+            cells.clear();
+            return;
+        }
+
+        watch(*root);
+        for (auto* child : root->getChildren()) collect(*child, root->getLocalBounds());
+
+        cellsWide = (root->getWidth() + cellSize - 1) / cellSize;
+        cellsHigh = (root->getHeight() + cellSize - 1) / cellSize;
+        cells.assign((size_t)(cellsWide * cellsHigh), {});
+
+        for (int i = 0; i < (int)entries.size(); ++i) {
+            auto b = entries[(size_t)i].bounds;
+            int x0 = juce::jmax(0, b.getX() / cellSize), x1 = juce::jmin(cellsWide - 1, (b.getRight() - 1) / cellSize);
+            int y0 = juce::jmax(0, b.getY() / cellSize), y1 = juce::jmin(cellsHigh - 1, (b.getBottom() - 1) / cellSize);
+
+            for (int y = y0; y <= y1; ++y)
+                for (int x = x0; x <= x1; ++x) cells[(size_t)(y * cellsWide + x)].push_back(i);
+        }
+    }
+
+    // Depth first in child order, which is JUCE's back to front, clipped by every ancestor like a viewport is
+    void collect(juce::Component& component, juce::Rectangle<int> clip) {
+        if (&component == ignored) return;
+
+        // Hidden components are watched too, becoming visible is one of the changes that needs a rebuild
+        watch(component);
+        if (!component.isVisible()) return;
+
+        auto bounds = root->getLocalArea(component.getParentComponent(), component.getBounds()).getIntersection(clip);
+        if (bounds.isEmpty()) return;
+
+        bool allowsSelf = false, allowsChildren = false;
+        component.getInterceptsMouseClicks(allowsSelf, allowsChildren);
+
+        Kind kind = kindOf(component);
+        if (allowsSelf) entries.push_back({ &component, bounds, kind });
+
+        // A control's own text boxes and labels count as the control
+        if (kind != Kind::none || !allowsChildren) return;
+
+        for (auto* child : component.getChildren()) collect(*child, bounds);
+    }
+
+    static Kind kindOf(juce::Component& component) {
+        if (dynamic_cast<juce::Button*>(&component) != nullptr) return Kind::button;
+        if (dynamic_cast<juce::ComboBox*>(&component) != nullptr) return Kind::comboBox;
+        if (dynamic_cast<juce::Slider*>(&component) != nullptr) return Kind::slider;
+        return Kind::none;
+    }
+
+    void watch(juce::Component& component) {
+        component.addComponentListener(this);
+        watched.push_back(&component);
+    }
+
+    void stopWatching() {
+        for (auto& component : watched)
+            if (component != nullptr) component->removeComponentListener(this);
+
+        watched.clear();
+    }
+
+    void componentMovedOrResized(juce::Component&, bool, bool) override { isDirty = true; }
+    void componentVisibilityChanged(juce::Component&) override { isDirty = true; }
+    void componentChildrenChanged(juce::Component&) override { isDirty = true; }
+    void componentBroughtToFront(juce::Component&) override { isDirty = true; }
+    void componentBeingDeleted(juce::Component&) override { isDirty = true; }
+};
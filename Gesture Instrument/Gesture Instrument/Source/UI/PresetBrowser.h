@@ -0,0 +1,208 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "../PluginProcessor.h"
+#include "../Helpers/PresetLibrary.h"
+
+// Searchable list of the preset library, shown over the settings page. Choosing a preset hands its already parsed
+// config to the audio thread, the editor refreshes once the audio thread has taken it.
+// Stays open after a choice so presets can be stepped through. The transition picked here applies to every choice,
+// a glide or hand follow moves the static parameters over to the new preset instead of jumping them
+class PresetBrowser : public juce::Component, private juce::ListBoxModel, private juce::Timer {
+public:
+    PresetBrowser(GestureInstrumentAudioProcessor& p, PresetLibrary& presetLibrary) : audioProcessor(p), library(presetLibrary) {
+        addAndMakeVisible(titleLabel);
+        titleLabel.setColour(juce::Label::textColourId, juce::Colours::orange);
+        titleLabel.setFont(juce::Font(16.0f, juce::Font::bold));
+
+        addAndMakeVisible(statusLabel);
+        statusLabel.setColour(juce::Label::textColourId, juce::Colours::white.withAlpha(0.6f));
+        statusLabel.setJustificationType(juce::Justification::centredRight);
+
+        addAndMakeVisible(searchInput);
+        searchInput.setTextToShowWhenEmpty("Search name, mode, scale or mapping", juce::Colours::grey);
+        searchInput.onTextChange = [this] { updateResults(); };
+        searchInput.onReturnKey = [this] { choose(juce::jmax(0, resultList.getSelectedRow())); };
+        searchInput.onEscapeKey = [this] { closeButton.triggerClick(); };
+
+        addAndMakeVisible(resultList);
+        resultList.setModel(this);
+        resultList.setRowHeight(40);
+        resultList.setColour(juce::ListBox::backgroundColourId, juce::Colour::fromFloatRGBA(0.07f, 0.07f, 0.08f, 1.0f));
+
+        addAndMakeVisible(loadButton);
+        loadButton.onClick = [this] { choose(resultList.getSelectedRow()); };
+
+        addAndMakeVisible(addFolderButton);
+        addFolderButton.onClick = [this] {
+            folderChooser = std::make_unique<juce::FileChooser>("Add Preset Folder", PresetLibrary::getUserPresetDirectory());
+            folderChooser->launchAsync(juce::FileBrowserComponent::openMode | juce::FileBrowserComponent::canSelectDirectories,
+                [this](const juce::FileChooser& fc) {
+                    if (fc.getResult().isDirectory()) library.addDirectory(fc.getResult());
+                });
+            };
+
+        addAndMakeVisible(transitionSelector);
+        transitionSelector.addItemList({ "Jump", "Glide 0.5s", "Glide 2s", "Glide 5s",
+                                         "Follow Left X", "Follow Left Y", "Follow Left Z",
+                                         "Follow Right X", "Follow Right Y", "Follow Right Z" }, 1);
+        transitionSelector.setSelectedId(1, juce::dontSendNotification);
+        transitionSelector.setTooltip("How the static parameters move to the chosen preset");
+
+        addAndMakeVisible(releaseNotesToggle);
+        releaseNotesToggle.setTooltip("Let go of held notes on a switch instead of moving them to the new preset");
+
+        addAndMakeVisible(closeButton);
+    }
+
+    ~PresetBrowser() override {
+        resultList.setModel(nullptr);
+    }
+
+    juce::TextButton closeButton{ "Close" };
+
+    void paint(juce::Graphics& g) override {
+        g.setColour(juce::Colour::fromFloatRGBA(0.1f, 0.1f, 0.12f, 1.0f));
+        g.fillRoundedRectangle(getLocalBounds().toFloat(), 10.0f);
+        g.setColour(juce::Colours::orange.withAlpha(0.6f));
+        g.drawRoundedRectangle(getLocalBounds().toFloat().reduced(1.0f), 10.0f, 2.0f);
+    }
+
+    void resized() override {
+        auto area = getLocalBounds().reduced(20);
+
+        auto header = area.removeFromTop(25);
+        titleLabel.setBounds(header.removeFromLeft(200));
+        statusLabel.setBounds(header);
+        area.removeFromTop(10);
+
+        searchInput.setBounds(area.removeFromTop(30));
+        area.removeFromTop(10);
+
+        auto footer = area.removeFromBottom(30);
+        closeButton.setBounds(footer.removeFromRight(100));
+        footer.removeFromRight(10);
+        loadButton.setBounds(footer.removeFromRight(100));
+        addFolderButton.setBounds(footer.removeFromLeft(120));
+        area.removeFromBottom(10);
+
+        auto transitionRow = area.removeFromBottom(25);
+        transitionSelector.setBounds(transitionRow.removeFromLeft(160));
+        transitionRow.removeFromLeft(10);
+        releaseNotesToggle.setBounds(transitionRow.removeFromLeft(180));
+        area.removeFromBottom(10);
+
+        resultList.setBounds(area);
+    }
+
+    void visibilityChanged() override {
+        if (isVisible()) {
+            library.rescan();
+            updateResults();
+            searchInput.grabKeyboardFocus();
+            startTimer(500);
+        }
+        else {
+            stopTimer();
+        }
+    }
+
+private:
+    GestureInstrumentAudioProcessor& audioProcessor;
+    PresetLibrary& library;
+
+    juce::Label titleLabel{ "Preset Library", "PRESET LIBRARY" };
+    juce::Label statusLabel;
+    juce::TextEditor searchInput;
+    juce::ListBox resultList;
+    juce::TextButton loadButton{ "Load" };
+    juce::TextButton addFolderButton{ "Add Folder..." };
+    juce::ComboBox transitionSelector;
+    juce::ToggleButton releaseNotesToggle{ "Release held notes" };
+    std::unique_ptr<juce::FileChooser> folderChooser;
+
+    // The list the results point into, kept alive while shown even if the library publishes a newer one
+    std::shared_ptr<const PresetLibrary::PresetList> presets;
+    std::vector<int> results;
+    int shownGeneration = -1;
+
+    // Picks up rescans while open, keeping the selected preset selected
+    void timerCallback() override {
+        if (library.getGeneration() != shownGeneration) updateResults();
+    }
+
+    void updateResults() {
+        juce::File selected;
+        if (auto* preset = getResult(resultList.getSelectedRow())) selected = preset->file;
+
+        shownGeneration = library.getGeneration();
+        presets = library.getPresets();
+        results = PresetLibrary::search(*presets, searchInput.getText());
+
+        resultList.updateContent();
+        resultList.deselectAllRows();
+        for (int row = 0; row < (int)results.size(); ++row) {
+            if (getResult(row)->file == selected) resultList.selectRow(row);
+        }
+        resultList.repaint();
+
+        statusLabel.setText(juce::String((int)results.size()) + " of " + juce::String((int)presets->size()) + " presets in "
+            + juce::String(library.getDirectories().size()) + " folders", juce::dontSendNotification);
+    }
+
+    const PresetLibrary::Preset* getResult(int row) const {
+        if (presets == nullptr || !juce::isPositiveAndBelow(row, (int)results.size())) return nullptr;
+        return &(*presets)[(size_t)results[(size_t)row]];
+    }
+
+    void choose(int row) {
+        if (auto* preset = getResult(row)) {
+            resultList.selectRow(row);
+            audioProcessor.requestConfig(preset->config, getTransition());
+        }
+    }
+
+    PresetTransition getTransition() const {
+        using Morph = PresetTransition::Morph;
+        static constexpr Morph follows[] = { Morph::leftX, Morph::leftY, Morph::leftZ, Morph::rightX, Morph::rightY, Morph::rightZ };
+        static constexpr float glideSeconds[] = { 0.5f, 2.0f, 5.0f };
+
+        PresetTransition transition;
+        transition.notes = releaseNotesToggle.getToggleState() ? PresetTransition::Notes::release : PresetTransition::Notes::handOver;
+
+        int index = transitionSelector.getSelectedItemIndex();
+        if (index >= 1 && index <= 3) {
+            transition.morph = Morph::time;
+            transition.morphSeconds = glideSeconds[index - 1];
+        }
+        else if (index >= 4 && index <= 9) {
+            transition.morph = follows[index - 4];
+        }
+        return transition;
+    }
+
+    int getNumRows() override { return (int)results.size(); }
+
+    void paintListBoxItem(int row, juce::Graphics& g, int width, int height, bool isSelected) override {
+        auto* preset = getResult(row);
+        if (preset == nullptr) return;
+
+        if (isSelected) {
+            g.setColour(juce::Colours::orange.withAlpha(0.25f));
+            g.fillRect(0, 0, width, height);
+        }
+
+        g.setColour(juce::Colours::white);
+        g.setFont(juce::Font(15.0f, juce::Font::bold));
+        g.drawText(preset->name, 10, 2, width - 20, height / 2, juce::Justification::bottomLeft, true);
+
+        g.setColour(juce::Colours::white.withAlpha(0.6f));
+        g.setFont(juce::Font(12.0f));
+        g.drawText(preset->summary, 10, height / 2 + 2, width - 20, height / 2 - 4, juce::Justification::topLeft, true);
+    }
+
+    void listBoxItemDoubleClicked(int row, const juce::MouseEvent&) override { choose(row); }
+    void returnKeyPressed(int row) override { choose(row); }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PresetBrowser)
+};
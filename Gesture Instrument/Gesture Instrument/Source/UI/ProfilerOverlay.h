@@ -0,0 +1,137 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "../Helpers/ProfilerProbes.h"
+
+// Soundcheck view of where the time goes, p50 and p99 over the last few seconds of every probe.
+// Showing it switches the probes on, hiding it switches them off again. Drain every UI frame so the rings never fill
+class ProfilerOverlay : public juce::Component {
+public:
+    explicit ProfilerOverlay(ProfilerProbes& probesToShow) : probes(probesToShow) {
+        setInterceptsMouseClicks(false, false);
+        setVisible(false);
+    }
+
+    ~ProfilerOverlay() override { probes.setEnabled(false); }
+
+    void setActive(bool shouldBeActive) {
+        if (shouldBeActive == isVisible()) return;
+
+        if (shouldBeActive) {
+            for (auto& row : rows) row.histogram.clear();
+            droppedSamples = 0;
+            sliceTimer = refreshTimer = 0.0f;
+        }
+
+        probes.setEnabled(shouldBeActive);
+        setVisible(shouldBeActive);
+    }
+
+    void toggle() { setActive(!isVisible()); }
+
+    void update(float deltaSeconds) {
+        if (!isVisible()) return;
+
+        for (auto& row : rows) {
+            auto& ring = probes.getRing(row.probe);
+            ring.drain([&row](float value) { row.histogram.add(value); });
+            droppedSamples += ring.takeDropped();
+        }
+
+        sliceTimer += deltaSeconds;
+        if (sliceTimer >= sliceSeconds) {
+            sliceTimer = 0.0f;
+            for (auto& row : rows) row.histogram.advance();
+        }
+
+        // Numbers that change every frame can't be read anyway
+        refreshTimer += deltaSeconds;
+        if (refreshTimer >= refreshSeconds) {
+            refreshTimer = 0.0f;
+            repaint();
+        }
+    }
+
+    void paint(juce::Graphics& g) override {
+        g.setColour(juce::Colours::black.withAlpha(0.75f));
+        g.fillRoundedRectangle(getLocalBounds().toFloat(), 6.0f);
+
+        auto area = getLocalBounds().reduced(10, 6);
+        g.setFont(juce::Font(juce::Font::getDefaultMonospacedFontName(), 13.0f, juce::Font::plain));
+
+        auto header = area.removeFromTop(rowHeight);
+        g.setColour(juce::Colours::grey);
+        g.drawText("Profiler (P)", header, juce::Justification::centredLeft);
+        g.drawText("p50", header.withTrimmedLeft(labelWidth).removeFromLeft(valueWidth), juce::Justification::centredRight);
+        g.drawText("p99", header.withTrimmedLeft(labelWidth + valueWidth).removeFromLeft(valueWidth), juce::Justification::centredRight);
+
+        for (const auto& row : rows) {
+            auto line = area.removeFromTop(rowHeight);
+            bool hasSamples = row.histogram.getCount() > 0;
+            float p50 = row.histogram.getPercentile(0.5f);
+            float p99 = row.histogram.getPercentile(0.99f);
+
+            g.setColour(juce::Colours::white);
+            g.drawText(row.label, line.removeFromLeft(labelWidth), juce::Justification::centredLeft);
+
+            g.setColour(hasSamples && row.warnAbove > 0.0f && p99 > row.warnAbove ? juce::Colours::orange : juce::Colours::white);
+            g.drawText(hasSamples ? format(p50, row.unit) : "-", line.removeFromLeft(valueWidth), juce::Justification::centredRight);
+            g.drawText(hasSamples ? format(p99, row.unit) : "-", line.removeFromLeft(valueWidth), juce::Justification::centredRight);
+
+            // Jitter is the spread between a typical frame and a late one
+            if (row.probe == ProfilerProbes::sensorInterval && hasSamples) {
+                auto jitterLine = area.removeFromTop(rowHeight);
+                g.setColour(juce::Colours::white);
+                g.drawText("  jitter", jitterLine.removeFromLeft(labelWidth), juce::Justification::centredLeft);
+                g.drawText(format(p99 - p50, row.unit), jitterLine.withTrimmedLeft(valueWidth).removeFromLeft(valueWidth), juce::Justification::centredRight);
+            }
+        }
+
+        if (droppedSamples > 0) {
+            g.setColour(juce::Colours::orange);
+            g.drawText(juce::String(droppedSamples) + " samples dropped", area.removeFromTop(rowHeight), juce::Justification::centredLeft);
+        }
+    }
+
+    static constexpr int preferredWidth = 330;
+    static constexpr int preferredHeight = 200;
+
+private:
+    static constexpr float sliceSeconds = 0.5f;
+    static constexpr float refreshSeconds = 0.25f;
+    static constexpr int rowHeight = 18;
+    static constexpr int labelWidth = 150;
+    static constexpr int valueWidth = 75;
+
+    struct Row {
+        ProfilerProbes::Probe probe;
+        juce::String label;
+        juce::String unit;
+        float warnAbove;
+        RollingHistogram histogram;
+    };
+
+    ProfilerProbes& probes;
+    Row rows[ProfilerProbes::numProbes] = {
+        { ProfilerProbes::blockTime,      "Process block",    "ms", 0.0f,   { 0.001f, 1000.0f } },
+        { ProfilerProbes::blockLoad,      "Block CPU",        "%",  50.0f,  { 0.01f, 1000.0f } },
+        { ProfilerProbes::sensorInterval, "Sensor interval",  "ms", 0.0f,   { 0.01f, 1000.0f } },
+        { ProfilerProbes::sensorToOutput, "Sensor to output", "ms", 30.0f,  { 0.01f, 1000.0f } },
+        { ProfilerProbes::oscMessages,    "OSC msgs/block",   "",   0.0f,   { 0.5f, 10000.0f } },
+        { ProfilerProbes::uiFrame,        "UI frame",         "ms", 8.0f,   { 0.001f, 1000.0f } },
+        { ProfilerProbes::uiPaint,        "UI paint",         "ms", 8.0f,   { 0.001f, 1000.0f } }
+    };
+
+    int droppedSamples = 0;
+    float sliceTimer = 0.0f;
+    float refreshTimer = 0.0f;
+
+    static juce::String format(float value, const juce::String& unit) {
+        int decimals = value < 1.0f ? 3 : (value < 100.0f ? 1 : 0);
+        if (unit.isEmpty()) decimals = 0;
+
+        return juce::String(value, decimals) + (unit.isEmpty() ? "" : " " + unit);
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ProfilerOverlay)
+};
@@ -58,6 +58,14 @@ SettingsComponent::SettingsComponent(GestureInstrumentAudioProcessor& p)
     invertTriggerButton.setToggleState(audioProcessor.invertNoteTrigger, juce::dontSendNotification);
     invertTriggerButton.onClick = [this] { audioProcessor.invertNoteTrigger = invertTriggerButton.getToggleState(); };
 
+    addAndMakeVisible(strikeTriggerButton);
+    strikeTriggerButton.setToggleState(audioProcessor.strikeTriggerEnabled.load(), juce::dontSendNotification);
+    strikeTriggerButton.onClick = [this] { audioProcessor.strikeTriggerEnabled.store(strikeTriggerButton.getToggleState()); };
+
+    addAndMakeVisible(strikeThresholdControl);
+    strikeThresholdControl.slider.setValue(audioProcessor.strikeThreshold.load(), juce::dontSendNotification);
+    strikeThresholdControl.slider.onValueChange = [this] { audioProcessor.strikeThreshold.store((float)strikeThresholdControl.slider.getValue()); };
+
     addAndMakeVisible(midiLabel);
     midiLabel.setColour(juce::Label::textColourId, juce::Colours::orange);
     midiLabel.setFont(juce::Font(14.0f, juce::Font::bold));
@@ -79,6 +87,7 @@ SettingsComponent::SettingsComponent(GestureInstrumentAudioProcessor& p)
         instrumentSelector.setEnabled(isMidi && isStandalone);
         instrumentLabel.setEnabled(isMidi && isStandalone);
         invertTriggerButton.setEnabled(isMidi);
+        strikeTriggerButton.setEnabled(isMidi);
         mpeButton.setEnabled(isMidi);
 
         mpeRoutingLabel.setEnabled(isMidi);
@@ -91,12 +100,12 @@ SettingsComponent::SettingsComponent(GestureInstrumentAudioProcessor& p)
 
         bool isOsc = !isMidi;
         leftXRow.updateList(isOsc); leftYRow.updateList(isOsc); leftZRow.updateList(isOsc);
-        leftWristRow.updateList(isOsc); leftGrabRow.updateList(isOsc); leftPinchRow.updateList(isOsc);
+        leftWristRow.updateList(isOsc); leftGrabRow.updateList(isOsc); leftPinchRow.updateList(isOsc); leftSpeedRow.updateList(isOsc);
         leftThumbRow.updateList(isOsc); leftIndexRow.updateList(isOsc); leftMiddleRow.updateList(isOsc);
         leftRingRow.updateList(isOsc); leftPinkyRow.updateList(isOsc);
 
         rightXRow.updateList(isOsc); rightYRow.updateList(isOsc); rightZRow.updateList(isOsc);
-        rightWristRow.updateList(isOsc); rightGrabRow.updateList(isOsc); rightPinchRow.updateList(isOsc);
+        rightWristRow.updateList(isOsc); rightGrabRow.updateList(isOsc); rightPinchRow.updateList(isOsc); rightSpeedRow.updateList(isOsc);
         rightThumbRow.updateList(isOsc); rightIndexRow.updateList(isOsc); rightMiddleRow.updateList(isOsc);
         rightRingRow.updateList(isOsc); rightPinkyRow.updateList(isOsc);
 
@@ -165,6 +174,7 @@ SettingsComponent::SettingsComponent(GestureInstrumentAudioProcessor& p)
                     lastPresetDirectory = file.getParentDirectory();
                     auto xml = audioProcessor.createPresetXml();
                     xml->writeTo(file);
+                    presetLibrary->addDirectory(lastPresetDirectory);
                 }
             });
         };
@@ -177,14 +187,23 @@ SettingsComponent::SettingsComponent(GestureInstrumentAudioProcessor& p)
                 juce::File file = fc.getResult();
                 if (file.existsAsFile()) {
                     lastPresetDirectory = file.getParentDirectory();
+                    presetLibrary->addDirectory(lastPresetDirectory);
+                    // The editor refreshes once the audio thread has taken it
                     auto xml = juce::XmlDocument::parse(file);
                     audioProcessor.loadPresetXml(xml.get());
-                    modeSelector.setSelectedId(audioProcessor.currentOutputMode == OutputMode::OSC_Only ? 1 : 2, juce::dontSendNotification);
-                    if (onPresetLoaded) onPresetLoaded();
                 }
             });
         };
 
+    addAndMakeVisible(browsePresetsButton);
+    browsePresetsButton.onClick = [this] {
+        presetBrowser.setVisible(true);
+        presetBrowser.toFront(true);
+        };
+
+    addChildComponent(presetBrowser);
+    presetBrowser.closeButton.onClick = [this] { presetBrowser.setVisible(false); };
+
     auto setupRow = [&](MappingRow& row, GestureTarget& target) {
         addAndMakeVisible(row);
         row.comboBox.setSelectedId(this->getIdFromTarget(target), juce::dontSendNotification);
@@ -195,11 +214,13 @@ SettingsComponent::SettingsComponent(GestureInstrumentAudioProcessor& p)
     setupRow(leftWristRow, audioProcessor.leftRollTarget); setupRow(leftGrabRow, audioProcessor.leftGrabTarget); setupRow(leftPinchRow, audioProcessor.leftPinchTarget);
     setupRow(leftThumbRow, audioProcessor.leftThumbTarget); setupRow(leftIndexRow, audioProcessor.leftIndexTarget); setupRow(leftMiddleRow, audioProcessor.leftMiddleTarget);
     setupRow(leftRingRow, audioProcessor.leftRingTarget); setupRow(leftPinkyRow, audioProcessor.leftPinkyTarget);
+    setupRow(leftSpeedRow, audioProcessor.leftSpeedTarget);
 
     setupRow(rightXRow, audioProcessor.rightXTarget); setupRow(rightYRow, audioProcessor.rightYTarget); setupRow(rightZRow, audioProcessor.rightZTarget);
     setupRow(rightWristRow, audioProcessor.rightRollTarget); setupRow(rightGrabRow, audioProcessor.rightGrabTarget); setupRow(rightPinchRow, audioProcessor.rightPinchTarget);
     setupRow(rightThumbRow, audioProcessor.rightThumbTarget); setupRow(rightIndexRow, audioProcessor.rightIndexTarget); setupRow(rightMiddleRow, audioProcessor.rightMiddleTarget);
     setupRow(rightRingRow, audioProcessor.rightRingTarget); setupRow(rightPinkyRow, audioProcessor.rightPinkyTarget);
+    setupRow(rightSpeedRow, audioProcessor.rightSpeedTarget);
 
     addAndMakeVisible(titleLabel);
     titleLabel.setFont(juce::Font(24.0f, juce::Font::bold));
@@ -239,10 +260,75 @@ SettingsComponent::SettingsComponent(GestureInstrumentAudioProcessor& p)
     setupAdvSlider(wristMultControl, audioProcessor.wristMultiplier);
     setupAdvSlider(grabMultControl, audioProcessor.grabMultiplier);
     setupAdvSlider(pinchMultControl, audioProcessor.pinchMultiplier);
+    setupAdvSlider(calibrationTrimControl, audioProcessor.calibrationTrimPercent);
+
+    addAndMakeVisible(autoRangeToggle);
+    autoRangeToggle.setToggleState(audioProcessor.autoRangeEnabled.load(), juce::dontSendNotification);
+    autoRangeToggle.setColour(juce::ToggleButton::textColourId, juce::Colours::white);
+    autoRangeToggle.onClick = [this] {
+        audioProcessor.autoRangeEnabled.store(autoRangeToggle.getToggleState());
+        autoRangeSpeedControl.setEnabled(autoRangeToggle.getToggleState());
+        };
+
+    setupAdvSlider(autoRangeSpeedControl, audioProcessor.autoRangeSpeed);
+    autoRangeSpeedControl.setEnabled(audioProcessor.autoRangeEnabled.load());
+
+    addAndMakeVisible(smoothingLabel);
+    smoothingLabel.setColour(juce::Label::textColourId, juce::Colours::orange);
+    smoothingLabel.setFont(juce::Font(14.0f, juce::Font::bold));
+
+    addAndMakeVisible(smoothingModeSelector);
+    smoothingModeSelector.addItem("Adaptive", 1);
+    smoothingModeSelector.addItem("Predictive", 2);
+    smoothingModeSelector.setSelectedId(audioProcessor.currentSmoothingMode == SmoothingMode::Predictive ? 2 : 1, juce::dontSendNotification);
+    smoothingModeSelector.onChange = [this] {
+        audioProcessor.currentSmoothingMode = (smoothingModeSelector.getSelectedId() == 2) ? SmoothingMode::Predictive : SmoothingMode::Adaptive;
+        predictionControl.setEnabled(audioProcessor.currentSmoothingMode == SmoothingMode::Predictive);
+        };
+
+    setupAdvSlider(predictionControl, audioProcessor.predictionHorizonMs);
+    predictionControl.setEnabled(audioProcessor.currentSmoothingMode == SmoothingMode::Predictive);
+
+    addAndMakeVisible(statsLabel);
+    statsLabel.setColour(juce::Label::textColourId, juce::Colours::orange);
+    statsLabel.setFont(juce::Font(14.0f, juce::Font::bold));
+
+    addAndMakeVisible(statsToggle);
+    statsToggle.setToggleState(audioProcessor.statsEnabled, juce::dontSendNotification);
+    statsToggle.setColour(juce::ToggleButton::textColourId, juce::Colours::white);
+    statsToggle.onClick = [this] { applyStatsSettings(); };
+
+    addAndMakeVisible(statsHostInput);
+    statsHostInput.setText(audioProcessor.statsHost, juce::dontSendNotification);
+    statsHostInput.onReturnKey = [this] { applyStatsSettings(); };
+    statsHostInput.onFocusLost = [this] { applyStatsSettings(); };
+
+    addAndMakeVisible(statsPortInput);
+    statsPortInput.setInputRestrictions(5, "0123456789");
+    statsPortInput.setText(juce::String(audioProcessor.statsPort), juce::dontSendNotification);
+    statsPortInput.onReturnKey = [this] { applyStatsSettings(); };
+    statsPortInput.onFocusLost = [this] { applyStatsSettings(); };
 
 	mpeButton.onClick();
 }
 
+void SettingsComponent::applyStatsSettings() {
+    auto host = statsHostInput.getText().trim();
+    int port = statsPortInput.getText().getIntValue();
+    bool shouldSend = statsToggle.getToggleState();
+
+    if (host.isEmpty() || port <= 0 || port > 65535) {
+        statsHostInput.setText(audioProcessor.statsHost, juce::dontSendNotification);
+        statsPortInput.setText(juce::String(audioProcessor.statsPort), juce::dontSendNotification);
+        return;
+    }
+
+    if (shouldSend == audioProcessor.statsEnabled && host == audioProcessor.statsHost && port == audioProcessor.statsPort) return;
+
+    if (!audioProcessor.updateStatsSettings(shouldSend, host, port))
+        statsToggle.setToggleState(false, juce::dontSendNotification);
+}
+
 SettingsComponent::~SettingsComponent() {}
 
 void SettingsComponent::paint(juce::Graphics& g) {
@@ -305,7 +391,9 @@ void SettingsComponent::resized() {
     savePresetButton.setBounds(col1.removeFromTop(25));
     col1.removeFromTop(5);
     loadPresetButton.setBounds(col1.removeFromTop(25));
-    col1.removeFromTop(40);
+    col1.removeFromTop(5);
+    browsePresetsButton.setBounds(col1.removeFromTop(25));
+    col1.removeFromTop(10);
 
     visualsLabel.setBounds(col1.removeFromTop(20));
     floorShadowToggle.setBounds(col1.removeFromTop(25));
@@ -319,6 +407,10 @@ void SettingsComponent::resized() {
     grabMultControl.setBounds(col1.removeFromTop(25));
     col1.removeFromTop(5);
     pinchMultControl.setBounds(col1.removeFromTop(25));
+    col1.removeFromTop(5);
+    calibrationTrimControl.setBounds(col1.removeFromTop(25));
+    autoRangeToggle.setBounds(col1.removeFromTop(25));
+    autoRangeSpeedControl.setBounds(col1.removeFromTop(25));
 
     col1.removeFromTop(20); 
     virtualMouseLabel.setBounds(col1.removeFromTop(20));
@@ -334,12 +426,14 @@ void SettingsComponent::resized() {
 
     stackRow(col2, leftXRow); stackRow(col2, leftYRow); stackRow(col2, leftZRow);
     stackRow(col2, leftWristRow); stackRow(col2, leftGrabRow); stackRow(col2, leftPinchRow);
+    stackRow(col2, leftSpeedRow);
     col2.removeFromTop(8);
     stackRow(col2, leftThumbRow); stackRow(col2, leftIndexRow); stackRow(col2, leftMiddleRow);
     stackRow(col2, leftRingRow); stackRow(col2, leftPinkyRow);
 
     stackRow(col3, rightXRow); stackRow(col3, rightYRow); stackRow(col3, rightZRow);
     stackRow(col3, rightWristRow); stackRow(col3, rightGrabRow); stackRow(col3, rightPinchRow);
+    stackRow(col3, rightSpeedRow);
     col3.removeFromTop(8);
     stackRow(col3, rightThumbRow); stackRow(col3, rightIndexRow); stackRow(col3, rightMiddleRow);
     stackRow(col3, rightRingRow); stackRow(col3, rightPinkyRow);
@@ -354,6 +448,8 @@ void SettingsComponent::resized() {
 
     midiLabel.setBounds(col4.removeFromTop(25));
     invertTriggerButton.setBounds(col4.removeFromTop(25));
+    strikeTriggerButton.setBounds(col4.removeFromTop(25));
+    strikeThresholdControl.setBounds(col4.removeFromTop(25));
     col4.removeFromTop(20);
 
     mpeButton.setBounds(col4.removeFromTop(25));
@@ -370,12 +466,31 @@ void SettingsComponent::resized() {
     col4.removeFromTop(5);
     mpePressureLabel.setBounds(col4.removeFromTop(20));
     mpePressureSelector.setBounds(col4.removeFromTop(25));
+
+    col4.removeFromTop(20);
+    smoothingLabel.setBounds(col4.removeFromTop(20));
+    smoothingModeSelector.setBounds(col4.removeFromTop(25));
+    col4.removeFromTop(5);
+    predictionControl.setBounds(col4.removeFromTop(25));
+
+    col4.removeFromTop(20);
+    statsLabel.setBounds(col4.removeFromTop(20));
+    statsToggle.setBounds(col4.removeFromTop(25));
+    auto statsRow = col4.removeFromTop(25);
+    statsPortInput.setBounds(statsRow.removeFromRight(60));
+    statsRow.removeFromRight(5);
+    statsHostInput.setBounds(statsRow);
+
+    // Preset library overlay
+    presetBrowser.setBounds(getLocalBounds().reduced(getWidth() / 5, 80));
 }
 
 void SettingsComponent::refreshUI() {
     modeSelector.setSelectedId(audioProcessor.currentOutputMode == OutputMode::OSC_Only ? 1 : 2, juce::dontSendNotification);
     instrumentSelector.setSelectedId(audioProcessor.currentInstrument, juce::dontSendNotification);
     invertTriggerButton.setToggleState(audioProcessor.invertNoteTrigger, juce::dontSendNotification);
+    strikeTriggerButton.setToggleState(audioProcessor.strikeTriggerEnabled.load(), juce::dontSendNotification);
+    strikeThresholdControl.slider.setValue(audioProcessor.strikeThreshold.load(), juce::dontSendNotification);
     mpeButton.setToggleState(audioProcessor.isMpeEnabled, juce::dontSendNotification);
     floorShadowToggle.setToggleState(audioProcessor.showFloorShadow, juce::dontSendNotification);
     wallShadowToggle.setToggleState(audioProcessor.showWallShadow, juce::dontSendNotification);
@@ -386,6 +501,16 @@ void SettingsComponent::refreshUI() {
     wristMultControl.slider.setValue(audioProcessor.wristMultiplier.load(), juce::dontSendNotification);
     grabMultControl.slider.setValue(audioProcessor.grabMultiplier.load(), juce::dontSendNotification);
     pinchMultControl.slider.setValue(audioProcessor.pinchMultiplier.load(), juce::dontSendNotification);
+    calibrationTrimControl.slider.setValue(audioProcessor.calibrationTrimPercent.load(), juce::dontSendNotification);
+    autoRangeToggle.setToggleState(audioProcessor.autoRangeEnabled.load(), juce::dontSendNotification);
+    autoRangeSpeedControl.slider.setValue(audioProcessor.autoRangeSpeed.load(), juce::dontSendNotification);
+    autoRangeSpeedControl.setEnabled(audioProcessor.autoRangeEnabled.load());
+    smoothingModeSelector.setSelectedId(audioProcessor.currentSmoothingMode == SmoothingMode::Predictive ? 2 : 1, juce::dontSendNotification);
+    predictionControl.slider.setValue(audioProcessor.predictionHorizonMs.load(), juce::dontSendNotification);
+    predictionControl.setEnabled(audioProcessor.currentSmoothingMode == SmoothingMode::Predictive);
+    statsToggle.setToggleState(audioProcessor.statsEnabled, juce::dontSendNotification);
+    statsHostInput.setText(audioProcessor.statsHost, juce::dontSendNotification);
+    statsPortInput.setText(juce::String(audioProcessor.statsPort), juce::dontSendNotification);
     mpePitchSelector.setSelectedId(audioProcessor.mpePitchBendAxis.load() + 1, juce::dontSendNotification);
     mpeTimbreSelector.setSelectedId(audioProcessor.mpeTimbreAxis.load() + 1, juce::dontSendNotification);
     mpePressureSelector.setSelectedId(audioProcessor.mpePressureAxis.load() + 1, juce::dontSendNotification);
@@ -395,12 +520,12 @@ void SettingsComponent::refreshUI() {
 
     bool isOsc = (audioProcessor.currentOutputMode == OutputMode::OSC_Only);
     leftXRow.updateList(isOsc); leftYRow.updateList(isOsc); leftZRow.updateList(isOsc);
-    leftWristRow.updateList(isOsc); leftGrabRow.updateList(isOsc); leftPinchRow.updateList(isOsc);
+    leftWristRow.updateList(isOsc); leftGrabRow.updateList(isOsc); leftPinchRow.updateList(isOsc); leftSpeedRow.updateList(isOsc);
     leftThumbRow.updateList(isOsc); leftIndexRow.updateList(isOsc); leftMiddleRow.updateList(isOsc);
     leftRingRow.updateList(isOsc); leftPinkyRow.updateList(isOsc);
 
     rightXRow.updateList(isOsc); rightYRow.updateList(isOsc); rightZRow.updateList(isOsc);
-    rightWristRow.updateList(isOsc); rightGrabRow.updateList(isOsc); rightPinchRow.updateList(isOsc);
+    rightWristRow.updateList(isOsc); rightGrabRow.updateList(isOsc); rightPinchRow.updateList(isOsc); rightSpeedRow.updateList(isOsc);
     rightThumbRow.updateList(isOsc); rightIndexRow.updateList(isOsc); rightMiddleRow.updateList(isOsc);
     rightRingRow.updateList(isOsc); rightPinkyRow.updateList(isOsc);
 
@@ -412,11 +537,13 @@ void SettingsComponent::refreshUI() {
     syncRow(leftWristRow, audioProcessor.leftRollTarget); syncRow(leftGrabRow, audioProcessor.leftGrabTarget); syncRow(leftPinchRow, audioProcessor.leftPinchTarget);
     syncRow(leftThumbRow, audioProcessor.leftThumbTarget); syncRow(leftIndexRow, audioProcessor.leftIndexTarget); syncRow(leftMiddleRow, audioProcessor.leftMiddleTarget);
     syncRow(leftRingRow, audioProcessor.leftRingTarget); syncRow(leftPinkyRow, audioProcessor.leftPinkyTarget);
+    syncRow(leftSpeedRow, audioProcessor.leftSpeedTarget);
 
     syncRow(rightXRow, audioProcessor.rightXTarget); syncRow(rightYRow, audioProcessor.rightYTarget); syncRow(rightZRow, audioProcessor.rightZTarget);
     syncRow(rightWristRow, audioProcessor.rightRollTarget); syncRow(rightGrabRow, audioProcessor.rightGrabTarget); syncRow(rightPinchRow, audioProcessor.rightPinchTarget);
     syncRow(rightThumbRow, audioProcessor.rightThumbTarget); syncRow(rightIndexRow, audioProcessor.rightIndexTarget); syncRow(rightMiddleRow, audioProcessor.rightMiddleTarget);
     syncRow(rightRingRow, audioProcessor.rightRingTarget); syncRow(rightPinkyRow, audioProcessor.rightPinkyTarget);
+    syncRow(rightSpeedRow, audioProcessor.rightSpeedTarget);
 
     repaint();
 }
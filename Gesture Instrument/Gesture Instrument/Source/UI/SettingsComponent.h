@@ -3,6 +3,7 @@
 #include <JuceHeader.h>
 #include "../PluginProcessor.h"
 #include "GuiComponents.h"
+#include "PresetBrowser.h"
 
 class SettingsComponent : public juce::Component {
 public:
@@ -39,6 +40,8 @@ private:
     juce::ToggleButton wallShadowToggle{ "Wall Shadow" };
     juce::ToggleButton splitXAxisToggle{ "Split X-Axis" };
     juce::ToggleButton invertTriggerButton{ "Invert Mute" };
+    juce::ToggleButton strikeTriggerButton{ "Strike Trigger" };
+    LabeledSlider strikeThresholdControl{ "Strike mm/s", 200.0f, 1500.0f, 400.0f };
 
     // Virtual mouse
     juce::Label virtualMouseLabel{ "Virtual Mouse", "VIRTUAL MOUSE" };
@@ -52,6 +55,12 @@ private:
     std::unique_ptr<juce::FileChooser> fileChooser;
     juce::File lastPresetDirectory{ juce::File::getSpecialLocation(juce::File::userDocumentsDirectory) };
 
+    // Preset library, shared by every open editor and indexed in the background. Folders presets are saved to or
+    // loaded from join it
+    juce::TextButton browsePresetsButton{ "Preset Library" };
+    juce::SharedResourcePointer<PresetLibrary> presetLibrary;
+    PresetBrowser presetBrowser{ audioProcessor, *presetLibrary };
+
     // MPE 
     juce::ToggleButton mpeButton{ "Enable MPE" };
     juce::Label mpeRoutingLabel{ "MPE", "MPE ROUTING:" };
@@ -73,6 +82,7 @@ private:
     MappingRow leftWristRow{ "Wrist Rotation", 99 };
     MappingRow leftGrabRow{ "Grab", 99 };
     MappingRow leftPinchRow{ "Pinch", 99 };
+    MappingRow leftSpeedRow{ "Hand Speed", 1 };
 
     MappingRow leftThumbRow{ "Thumb", 99 };
     MappingRow leftIndexRow{ "Index", 99 };
@@ -87,6 +97,7 @@ private:
     MappingRow rightWristRow{ "Wrist Rotation", 99 };
     MappingRow rightGrabRow{ "Grab", 99 };
     MappingRow rightPinchRow{ "Pinch", 3 };
+    MappingRow rightSpeedRow{ "Hand Speed", 1 };
 
     MappingRow rightThumbRow{ "Thumb", 99 };
     MappingRow rightIndexRow{ "Index", 99 };
@@ -98,6 +109,21 @@ private:
     LabeledSlider wristMultControl{ "Wrist Sens", 1.0f, 3.0f, 1.0f };
     LabeledSlider grabMultControl{ "Grab Sens", 1.0f, 3.0f, 1.0f };
     LabeledSlider pinchMultControl{ "Pinch Sens", 1.0f, 3.0f, 1.0f };
+    LabeledSlider calibrationTrimControl{ "Calib Trim %", 0.0f, 10.0f, 2.0f };
+    juce::ToggleButton autoRangeToggle{ "Auto Range" };
+    LabeledSlider autoRangeSpeedControl{ "Range mm/s", 1.0f, 50.0f, 10.0f };
+
+    // Tracking
+    juce::Label smoothingLabel{ "Smoothing", "SMOOTHING" };
+    juce::ComboBox smoothingModeSelector;
+    LabeledSlider predictionControl{ "Lead (ms)", 0.0f, 50.0f, 20.0f };
+
+    // Stats feed, /stats over OSC to a monitoring host
+    juce::Label statsLabel{ "Stats", "STATS FEED" };
+    juce::ToggleButton statsToggle{ "Send /stats" };
+    juce::TextEditor statsHostInput;
+    juce::TextEditor statsPortInput;
+    void applyStatsSettings();
 
    // helpers
     int getIdFromTarget(GestureTarget target);
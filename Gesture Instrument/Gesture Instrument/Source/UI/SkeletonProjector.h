@@ -0,0 +1,115 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "../Helpers/HandData.h"
+#include "StageTypes.h"
+
+// Projects every joint of both hands to the screen in one pass.
+// Joints are laid out flat (palm, four joints per finger, pinch centre) so the tilt, clamp and perspective run as
+// one branch free loop the compiler can vectorise, instead of a lambda chain per joint
+class SkeletonProjector {
+public:
+    static constexpr int jointsPerHand = 22;
+    static constexpr int numJoints = jointsPerHand * 2;
+
+    static constexpr int palmJoint = 0;
+    static constexpr int pinchJoint = 21;
+
+    // Bone 0 is the knuckle, 3 the tip
+    static constexpr int fingerJoint(int finger, int bone) { return 1 + finger * 4 + bone; }
+
+    SkeletonProjector() {
+        const float tilt = juce::MathConstants<float>::pi * 0.20f;
+        cosTilt = std::cos(tilt);
+        sinTilt = std::sin(tilt);
+    }
+
+    // Calibration draws the hands unclamped so they can leave the current box
+    void project(const HandData& left, const HandData& right, const StageBox& box, bool clampToBox, const StageView& view) {
+        gather(left, 0);
+        gather(right, jointsPerHand);
+
+        const float lowest = std::numeric_limits<float>::lowest();
+        const float highest = std::numeric_limits<float>::max();
+
+        const float minX = clampToBox ? box.minX : lowest, maxX = clampToBox ? box.maxX : highest;
+        const float minY = clampToBox ? box.minY : lowest, maxY = clampToBox ? box.maxY : highest;
+        const float minZ = clampToBox ? box.minZ : lowest, maxZ = clampToBox ? box.maxZ : highest;
+
+        const float c = cosTilt, s = sinTilt;
+
+        for (int i = 0; i < numJoints; ++i) {
+            // Tilt the hand about its palm so the fingers read better from the camera
+            float rotY = pivotY[i] + offsetY[i] * c - offsetZ[i] * s;
+            float rotZ = pivotZ[i] + offsetY[i] * s + offsetZ[i] * c;
+
+            float wx = std::min(std::max(rawX[i], minX), maxX);
+            float wy = std::min(std::max(rotY, minY), maxY);
+            float wz = std::min(std::max(rotZ, minZ), maxZ);
+
+            float perspective = StageView::fov / (StageView::fov - wz + StageView::camDist);
+            float scale = perspective * view.scale;
+
+            worldZ[i] = wz;
+            worldY[i] = wy;
+            worldX[i] = wx;
+            screenX[i] = wx * scale + view.centreX;
+            screenY[i] = -(wy - StageView::worldYOffset) * scale + view.centreY;
+        }
+    }
+
+    juce::Point<float> getScreen(int hand, int joint) const {
+        int i = hand * jointsPerHand + joint;
+        return { screenX[i], screenY[i] };
+    }
+
+    // Clamped world position, for shadows and depth cues
+    Point3D getWorld(int hand, int joint) const {
+        int i = hand * jointsPerHand + joint;
+        return { worldX[i], worldY[i], worldZ[i] };
+    }
+
+private:
+    float cosTilt = 1.0f;
+    float sinTilt = 0.0f;
+
+    alignas(16) float rawX[numJoints] = {};
+    alignas(16) float offsetY[numJoints] = {};
+    alignas(16) float offsetZ[numJoints] = {};
+    alignas(16) float pivotY[numJoints] = {};
+    alignas(16) float pivotZ[numJoints] = {};
+
+    alignas(16) float worldX[numJoints] = {};
+    alignas(16) float worldY[numJoints] = {};
+    alignas(16) float worldZ[numJoints] = {};
+    alignas(16) float screenX[numJoints] = {};
+    alignas(16) float screenY[numJoints] = {};
+
+    void setJoint(int i, const HandData& hand, float x, float y, float z) {
+        rawX[i] = x;
+        offsetY[i] = y - hand.currentHandPositionY;
+        offsetZ[i] = z - hand.currentHandPositionZ;
+        pivotY[i] = hand.currentHandPositionY;
+        pivotZ[i] = hand.currentHandPositionZ;
+    }
+
+    void gather(const HandData& hand, int base) {
+        setJoint(base + palmJoint, hand, hand.currentHandPositionX, hand.currentHandPositionY, hand.currentHandPositionZ);
+
+        for (int f = 0; f < 5; ++f) {
+            const auto& finger = hand.fingers[f];
+            setJoint(base + fingerJoint(f, 0), hand, finger.knuckleX, finger.knuckleY, finger.knuckleZ);
+            setJoint(base + fingerJoint(f, 1), hand, finger.joint2X, finger.joint2Y, finger.joint2Z);
+            setJoint(base + fingerJoint(f, 2), hand, finger.joint1X, finger.joint1Y, finger.joint1Z);
+            setJoint(base + fingerJoint(f, 3), hand, finger.tipX, finger.tipY, finger.tipZ);
+        }
+
+        setJoint(base + pinchJoint, hand,
+            (hand.fingers[0].tipX + hand.fingers[1].tipX) / 2.0f,
+            (hand.fingers[0].tipY + hand.fingers[1].tipY) / 2.0f,
+            (hand.fingers[0].tipZ + hand.fingers[1].tipZ) / 2.0f);
+    }
+};
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "../Helpers/ProfilerProbes.h"
+#include "StageGLRenderer.h"
+#include "StageRenderThread.h"
+
+// The 3D stage, and the only part of the editor on OpenGL. The controls around it stay on the editor's own peer.
+// The GL surface is a native window that covers sibling components, so whatever sits over the stage has to be a
+// child of this one, those are drawn into the context on top of the stage.
+// Without a usable context the software StageRenderThread draws it instead
+class StageComponent : public juce::Component {
+public:
+    explicit StageComponent(ProfilerProbes& probesToUse) : probes(probesToUse), overlay(*this) {
+        setOpaque(true);
+        setInterceptsMouseClicks(false, true);
+
+        addAndMakeVisible(overlay);
+        overlay.setAlwaysOnTop(true);
+
+        openGLContext.setRenderer(&stageGL);
+        openGLContext.setOpenGLVersionRequired(juce::OpenGLContext::openGL3_2);
+        openGLContext.attachTo(*this);
+        openGLContext.setContinuousRepainting(false);
+    }
+
+    ~StageComponent() override {
+        renderThread.shutdown();
+        openGLContext.detach();
+    }
+
+    void start() { renderThread.startThread(); }
+
+    bool isOnGL() const { return stageGL.getStatus() == StageGLRenderer::Status::running; }
+    float getDisplayScale() const { return displayScale; }
+
+    // Message thread. Goes to whichever renderer is drawing the stage now
+    void submit(const StageFrame& frame) {
+        if (isOnGL()) stageGL.submit(frame);
+        else renderThread.submit(frame);
+    }
+
+    // Message thread, once per frame
+    void collectFinishedFrame() {
+        if (renderThread.collectFinishedFrame()) repaint();
+    }
+
+    void paint(juce::Graphics& g) override {
+        ProfilerProbes::ScopedTimer paintTimer(probes, ProfilerProbes::uiPaint);
+
+        // With the GL renderer running the stage is already underneath and this layer stays clear,
+        // otherwise this is a blit of the last frame the software thread finished
+        if (isOnGL()) return;
+
+        displayScale = g.getInternalContext().getPhysicalPixelScaleFactor();
+        if (!renderThread.drawLatestFrame(g)) g.fillAll(juce::Colours::black);
+    }
+
+    void resized() override { overlay.setBounds(getLocalBounds()); }
+
+    // For editor components that pass over the stage without being part of it, like the virtual cursor.
+    // Called with the stage's coordinates, and only while GL is running since the software path doesn't cover them
+    std::function<void(juce::Graphics&)> paintOverlay;
+    void repaintOverlay(juce::Rectangle<int> area) { overlay.repaint(area); }
+
+private:
+    ProfilerProbes& probes;
+
+    juce::OpenGLContext openGLContext;
+    StageGLRenderer stageGL{ openGLContext };
+    StageRenderThread renderThread;
+    float displayScale = 1.0f;
+
+    class Overlay : public juce::Component {
+    public:
+        explicit Overlay(StageComponent& owner) : stage(owner) { setInterceptsMouseClicks(false, false); }
+
+        void paint(juce::Graphics& g) override {
+            if (stage.isOnGL() && stage.paintOverlay) stage.paintOverlay(g);
+        }
+
+    private:
+        StageComponent& stage;
+    };
+
+    Overlay overlay;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StageComponent)
+};
@@ -0,0 +1,349 @@
+#include "StageGLRenderer.h"
+
+namespace {
+    const float quadCorners[] = { -1.0f, -1.0f, 1.0f, -1.0f, -1.0f, 1.0f, 1.0f, 1.0f };
+
+    constexpr size_t initialShapeCapacity = 128;
+}
+
+void StageGLRenderer::submit(const StageFrame& frame) {
+    pendingFrames.getWriteBuffer() = frame;
+    pendingFrames.publish();
+    context.triggerRepaint();
+}
+
+void StageGLRenderer::newOpenGLContextCreated() {
+    staticShapes.reserve(initialShapeCapacity);
+    dynamicShapes.reserve(initialShapeCapacity);
+
+    if (createResources()) {
+        isStaticDirty = true;
+        status.store(Status::running);
+    }
+    else {
+        releaseResources();
+        status.store(Status::unavailable);
+    }
+}
+
+void StageGLRenderer::openGLContextClosing() {
+    releaseResources();
+    hasFrame = false;
+
+    // A context can come back, after a move to another display for example, until then the software path draws
+    if (status.load() == Status::running) status.store(Status::waiting);
+}
+
+bool StageGLRenderer::createResources() {
+    using namespace juce::gl;
+
+    if (juce::OpenGLShaderProgram::getLanguageVersion() < 1.5) {
+        DBG("Stage GL: GLSL 1.50 not available, using the software renderer");
+        return false;
+    }
+
+    if (glDrawArraysInstanced == nullptr || glVertexAttribDivisor == nullptr || glGenVertexArrays == nullptr) {
+        DBG("Stage GL: no instancing, using the software renderer");
+        return false;
+    }
+
+    shader = std::make_unique<juce::OpenGLShaderProgram>(context);
+    if (!shader->addVertexShader(StageShaders::vertexShaderSource) || !shader->addFragmentShader(StageShaders::fragmentShaderSource) || !shader->link()) {
+        DBG("Stage GL: " + shader->getLastError());
+        return false;
+    }
+
+    auto program = shader->getProgramID();
+    cornerAttribute = glGetAttribLocation(program, "corner");
+    pointsAttribute = glGetAttribLocation(program, "shapePoints");
+    styleAttribute = glGetAttribLocation(program, "shapeStyle");
+    colourAttribute = glGetAttribLocation(program, "shapeColour");
+
+    if (cornerAttribute < 0 || pointsAttribute < 0 || styleAttribute < 0 || colourAttribute < 0) return false;
+
+    glGenBuffers(1, &cornerBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, cornerBuffer);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(quadCorners), quadCorners, GL_STATIC_DRAW);
+
+    glGenBuffers(1, &staticBuffer);
+    glGenBuffers(1, &dynamicBuffer);
+    glGenVertexArrays(1, &staticArray);
+    glGenVertexArrays(1, &dynamicArray);
+
+    dynamicCapacity = initialShapeCapacity;
+    glBindBuffer(GL_ARRAY_BUFFER, dynamicBuffer);
+    glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)(dynamicCapacity * sizeof(StageShape)), nullptr, GL_STREAM_DRAW);
+
+    bindInstanceArray(staticArray, staticBuffer);
+    bindInstanceArray(dynamicArray, dynamicBuffer);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return glGetError() == GL_NO_ERROR;
+}
+
+void StageGLRenderer::releaseResources() {
+    using namespace juce::gl;
+
+    if (staticArray != 0) glDeleteVertexArrays(1, &staticArray);
+    if (dynamicArray != 0) glDeleteVertexArrays(1, &dynamicArray);
+    if (cornerBuffer != 0) glDeleteBuffers(1, &cornerBuffer);
+    if (staticBuffer != 0) glDeleteBuffers(1, &staticBuffer);
+    if (dynamicBuffer != 0) glDeleteBuffers(1, &dynamicBuffer);
+
+    staticArray = dynamicArray = 0;
+    cornerBuffer = staticBuffer = dynamicBuffer = 0;
+    dynamicCapacity = 0;
+    shader.reset();
+}
+
+void StageGLRenderer::bindInstanceArray(juce::gl::GLuint array, juce::gl::GLuint instances) {
+    using namespace juce::gl;
+
+    glBindVertexArray(array);
+
+    glBindBuffer(GL_ARRAY_BUFFER, cornerBuffer);
+    glEnableVertexAttribArray((GLuint)cornerAttribute);
+    glVertexAttribPointer((GLuint)cornerAttribute, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+
+    glBindBuffer(GL_ARRAY_BUFFER, instances);
+    const GLint perInstance[] = { pointsAttribute, styleAttribute, colourAttribute };
+
+    for (int i = 0; i < 3; ++i) {
+        auto attribute = (GLuint)perInstance[i];
+        glEnableVertexAttribArray(attribute);
+        glVertexAttribPointer(attribute, 4, GL_FLOAT, GL_FALSE, sizeof(StageShape), (const void*)(sizeof(float) * 4 * (size_t)i));
+        glVertexAttribDivisor(attribute, 1);
+    }
+
+    glBindVertexArray(0);
+}
+
+void StageGLRenderer::renderOpenGL() {
+    using namespace juce::gl;
+
+    if (status.load() != Status::running) return;
+
+    if (pendingFrames.acquire()) hasFrame = true;
+
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    const auto& frame = pendingFrames.getReadBuffer();
+    if (!hasFrame || frame.width <= 0 || frame.height <= 0) return;
+
+    float renderingScale = (float)context.getRenderingScale();
+    glViewport(0, 0, juce::roundToInt((float)frame.width * renderingScale), juce::roundToInt((float)frame.height * renderingScale));
+
+    updateStaticShapes(frame);
+    buildDynamicShapes(frame);
+
+    if (dynamicShapes.size() > dynamicCapacity) {
+        dynamicCapacity = dynamicShapes.size() * 2;
+        glBindBuffer(GL_ARRAY_BUFFER, dynamicBuffer);
+        glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)(dynamicCapacity * sizeof(StageShape)), nullptr, GL_STREAM_DRAW);
+    }
+
+    if (!dynamicShapes.empty()) {
+        glBindBuffer(GL_ARRAY_BUFFER, dynamicBuffer);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, (GLsizeiptr)(dynamicShapes.size() * sizeof(StageShape)), dynamicShapes.data());
+    }
+
+    glDisable(GL_DEPTH_TEST);
+    glEnable(GL_BLEND);
+    // Keep the destination opaque, a see-through framebuffer would let the window behind show on some compositors
+    glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+
+    shader->use();
+    auto program = shader->getProgramID();
+    glUniform2f(glGetUniformLocation(program, "viewportSize"), (float)frame.width, (float)frame.height);
+    glUniform1f(glGetUniformLocation(program, "pixelSize"), 1.0f / juce::jmax(0.01f, renderingScale));
+    glUniform2fv(glGetUniformLocation(program, "floorQuad"), 4, &floorQuad[0].x);
+    glUniform2fv(glGetUniformLocation(program, "wallQuad"), 4, &wallQuad[0].x);
+
+    glBindVertexArray(staticArray);
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, (GLsizei)staticShapes.size());
+
+    if (!dynamicShapes.empty()) {
+        glBindVertexArray(dynamicArray);
+        glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, (GLsizei)dynamicShapes.size());
+    }
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glUseProgram(0);
+}
+
+// STATIC LAYERS
+
+void StageGLRenderer::updateStaticShapes(const StageFrame& frame) {
+    using namespace juce::gl;
+
+    if (!isStaticDirty && frame.width == staticWidth && frame.height == staticHeight && frame.box == staticBox) return;
+
+    isStaticDirty = false;
+    staticWidth = frame.width;
+    staticHeight = frame.height;
+    staticBox = frame.box;
+    view.setViewport({ 0, 0, frame.width, frame.height });
+
+    const auto& box = frame.box;
+    staticShapes.clear();
+
+    // Same radial falloff as the software background, the clear colour is the black it fades to
+    juce::Point<float> centre(view.centreX, view.centreY);
+    float glowRadius = std::sqrt(view.centreX * view.centreX + view.centreY * view.centreY);
+    addShape(staticShapes, StageShape::glow, centre, { glowRadius, glowRadius }, 0.0f, juce::Colour::fromFloatRGBA(0.05f, 0.05f, 0.1f, 1.0f));
+
+    addBox(staticShapes, { -350.0f, 350.0f, 50.0f, 500.0f, -225.0f, 225.0f, false }, 1.0f, juce::Colours::white.withAlpha(0.08f));
+    addBox(staticShapes, box, 2.5f, juce::Colours::yellow.withAlpha(0.6f));
+
+    if (box.isSplit) {
+        float cx = (box.minX + box.maxX) / 2.0f;
+        auto pDivF1 = view.project({ cx, box.minY, box.minZ }); auto pDivF2 = view.project({ cx, box.minY, box.maxZ });
+        auto pDivC1 = view.project({ cx, box.maxY, box.minZ }); auto pDivC2 = view.project({ cx, box.maxY, box.maxZ });
+
+        auto divider = juce::Colours::orange.withAlpha(0.8f);
+        addShape(staticShapes, StageShape::segment, pDivF1, pDivF2, 2.5f, divider);
+        addShape(staticShapes, StageShape::segment, pDivC1, pDivC2, 2.5f, divider);
+        addShape(staticShapes, StageShape::segment, pDivF1, pDivC1, 2.5f, divider);
+        addShape(staticShapes, StageShape::segment, pDivF2, pDivC2, 2.5f, divider);
+    }
+
+    floorQuad[0] = view.project({ box.minX, box.minY, box.minZ });
+    floorQuad[1] = view.project({ box.maxX, box.minY, box.minZ });
+    floorQuad[2] = view.project({ box.maxX, box.minY, box.maxZ });
+    floorQuad[3] = view.project({ box.minX, box.minY, box.maxZ });
+
+    wallQuad[0] = view.project({ box.minX, box.minY, box.minZ });
+    wallQuad[1] = view.project({ box.maxX, box.minY, box.minZ });
+    wallQuad[2] = view.project({ box.maxX, box.maxY, box.minZ });
+    wallQuad[3] = view.project({ box.minX, box.maxY, box.minZ });
+
+    glBindBuffer(GL_ARRAY_BUFFER, staticBuffer);
+    glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)(staticShapes.size() * sizeof(StageShape)), staticShapes.data(), GL_STATIC_DRAW);
+}
+
+void StageGLRenderer::addBox(std::vector<StageShape>& shapes, const StageBox& box, float thick, juce::Colour colour) const {
+    auto pF1 = view.project({ box.minX, box.minY, box.minZ }); auto pF2 = view.project({ box.maxX, box.minY, box.minZ });
+    auto pF3 = view.project({ box.maxX, box.minY, box.maxZ }); auto pF4 = view.project({ box.minX, box.minY, box.maxZ });
+    auto pC1 = view.project({ box.minX, box.maxY, box.minZ }); auto pC2 = view.project({ box.maxX, box.maxY, box.minZ });
+    auto pC3 = view.project({ box.maxX, box.maxY, box.maxZ }); auto pC4 = view.project({ box.minX, box.maxY, box.maxZ });
+
+    const juce::Point<float> edges[12][2] = {
+        { pF1, pF2 }, { pF2, pF3 }, { pF3, pF4 }, { pF4, pF1 },
+        { pC1, pC2 }, { pC2, pC3 }, { pC3, pC4 }, { pC4, pC1 },
+        { pF1, pC1 }, { pF2, pC2 }, { pF3, pC3 }, { pF4, pC4 }
+    };
+
+    for (const auto& edge : edges)
+        addShape(shapes, StageShape::segment, edge[0], edge[1], thick, colour);
+}
+
+// PER FRAME SHAPES
+
+void StageGLRenderer::buildDynamicShapes(const StageFrame& frame) {
+    dynamicShapes.clear();
+
+    skeletons.project(frame.leftHand, frame.rightHand, frame.box, !frame.isCalibrating, view);
+    addHand(frame, frame.leftHand, 0, juce::Colours::cyan);
+    addHand(frame, frame.rightHand, 1, juce::Colours::magenta);
+
+    if (frame.isCalibrating && frame.hasCalibrationBox)
+        addBox(dynamicShapes, frame.calibrationBox, 2.0f, juce::Colours::cyan.withAlpha(0.8f));
+}
+
+void StageGLRenderer::addHand(const StageFrame& frame, const HandData& hand, int handIndex, juce::Colour baseColour) {
+    if (!hand.isPresent) return;
+
+    // Same sizes, alphas and layer order as StageRenderThread::drawHand so both paths look alike
+    Point3D palm3D = skeletons.getWorld(handIndex, SkeletonProjector::palmJoint);
+    auto palm2D = skeletons.getScreen(handIndex, SkeletonProjector::palmJoint);
+    float palmDepth = juce::jmap(palm3D.z, -200.0f, 200.0f, 0.6f, 1.4f);
+
+    if (frame.showFloorShadow) {
+        auto shadow2D = view.project({ palm3D.x, frame.box.minY, palm3D.z });
+
+        float heightRatio = juce::jlimit(0.0f, 1.0f, juce::jmap(palm3D.y, frame.box.minY, frame.box.maxY, 0.0f, 1.0f));
+        float shadowScale = juce::jmap(palm3D.z, -200.0f, 200.0f, 0.6f, 1.4f);
+        float shadowW = (50.0f + (heightRatio * 70.0f)) * shadowScale;
+        float shadowH = shadowW * 0.35f;
+
+        addShape(dynamicShapes, StageShape::ellipse, shadow2D, { shadowW / 2.0f, shadowH / 2.0f }, 0.0f,
+            baseColour.darker(0.8f).withAlpha(0.5f - (heightRatio * 0.4f)), StageShape::floorClip);
+    }
+
+    if (frame.showWallShadow) {
+        auto wallShadow2D = view.project({ palm3D.x, palm3D.y, frame.box.minZ });
+
+        float depthRatio = juce::jlimit(0.0f, 1.0f, juce::jmap(palm3D.z, frame.box.minZ, frame.box.maxZ, 0.0f, 1.0f));
+        float backWallScale = juce::jmap(frame.box.minZ, -200.0f, 200.0f, 0.6f, 1.4f);
+        float wallShadowRadius = (50.0f + (depthRatio * 70.0f)) * backWallScale / 2.0f;
+
+        addShape(dynamicShapes, StageShape::ellipse, wallShadow2D, { wallShadowRadius, wallShadowRadius }, 0.0f,
+            baseColour.darker(0.8f).withAlpha(0.4f - (depthRatio * 0.35f)), StageShape::wallClip);
+    }
+
+    float grabIntensity = juce::jlimit(0.0f, 1.0f, hand.grabStrength * frame.grabMultiplier);
+    if (grabIntensity > 0.1f) {
+        juce::Colour grabCol = baseColour.interpolatedWith(juce::Colours::orange, grabIntensity);
+        float radius = (40.0f * palmDepth) * (2.0f - grabIntensity) / 2.0f;
+
+        addShape(dynamicShapes, StageShape::ellipse, palm2D, { radius, radius }, 0.0f, grabCol.withAlpha(0.3f * grabIntensity));
+        addShape(dynamicShapes, StageShape::ellipseOutline, palm2D, { radius, radius }, 2.0f, grabCol);
+    }
+
+    juce::Point<float> knuckles[5], joints1[5], joints2[5], tips[5];
+    for (int i = 0; i < 5; ++i) {
+        knuckles[i] = skeletons.getScreen(handIndex, SkeletonProjector::fingerJoint(i, 0));
+        joints1[i] = skeletons.getScreen(handIndex, SkeletonProjector::fingerJoint(i, 1));
+        joints2[i] = skeletons.getScreen(handIndex, SkeletonProjector::fingerJoint(i, 2));
+        tips[i] = skeletons.getScreen(handIndex, SkeletonProjector::fingerJoint(i, 3));
+    }
+
+    auto palmLink = baseColour.withAlpha(0.2f);
+    for (int i = 0; i < 5; ++i)
+        addShape(dynamicShapes, StageShape::segment, palm2D, knuckles[i], 2.0f * palmDepth, palmLink);
+
+    const float boneWidths[3] = { 3.0f, 2.5f, 2.0f };
+    for (int extended = 0; extended < 2; ++extended) {
+        auto boneColour = baseColour.withAlpha(extended ? 0.9f : 0.2f);
+
+        for (int bone = 0; bone < 3; ++bone) {
+            for (int i = 0; i < 5; ++i) {
+                if (hand.fingers[i].isExtended != (extended == 1)) continue;
+
+                auto from = bone == 0 ? knuckles[i] : (bone == 1 ? joints1[i] : joints2[i]);
+                auto to = bone == 0 ? joints1[i] : (bone == 1 ? joints2[i] : tips[i]);
+                addShape(dynamicShapes, StageShape::segment, from, to, boneWidths[bone] * palmDepth, boneColour);
+            }
+        }
+    }
+
+    float jointSize = 6.0f * palmDepth;
+
+    for (int i = 0; i < 5; ++i) {
+        if (hand.fingers[i].isExtended)
+            addShape(dynamicShapes, StageShape::ellipse, tips[i], { jointSize / 2, jointSize / 2 }, 0.0f, juce::Colours::white.withAlpha(0.8f));
+    }
+
+    for (int i = 0; i < 5; ++i)
+        addShape(dynamicShapes, StageShape::ellipse, knuckles[i], { jointSize, jointSize }, 0.0f, baseColour.withAlpha(0.4f));
+
+    float pinchIntensity = juce::jlimit(0.0f, 1.0f, hand.pinchStrength * frame.pinchMultiplier);
+
+    if (pinchIntensity > 0.8f && !hand.fingers[0].isExtended) {
+        auto pinch2D = skeletons.getScreen(handIndex, SkeletonProjector::pinchJoint);
+        float sparkSize = 15.0f * palmDepth;
+
+        addShape(dynamicShapes, StageShape::ellipse, pinch2D, { sparkSize / 2, sparkSize / 2 }, 0.0f, juce::Colours::yellow);
+        addShape(dynamicShapes, StageShape::segment, { pinch2D.x - sparkSize, pinch2D.y }, { pinch2D.x + sparkSize, pinch2D.y }, 2.0f, juce::Colours::yellow);
+        addShape(dynamicShapes, StageShape::segment, { pinch2D.x, pinch2D.y - sparkSize }, { pinch2D.x, pinch2D.y + sparkSize }, 2.0f, juce::Colours::yellow);
+    }
+}
+
+void StageGLRenderer::addShape(std::vector<StageShape>& shapes, StageShape::Kind kind, juce::Point<float> a, juce::Point<float> b,
+    float width, juce::Colour colour, StageShape::Clip clip) {
+    shapes.push_back({ a.x, a.y, b.x, b.y,
+        width, (float)kind, (float)clip, 0.0f,
+        colour.getFloatRed(), colour.getFloatGreen(), colour.getFloatBlue(), colour.getFloatAlpha() });
+}
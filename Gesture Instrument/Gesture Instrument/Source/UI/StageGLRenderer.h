@@ -0,0 +1,68 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "../Helpers/TripleBuffer.h"
+#include "StageTypes.h"
+#include "SkeletonProjector.h"
+#include "StageShaders.h"
+
+// Draws the 3D stage with OpenGL instead of juce::Graphics paths.
+// The room grid, threshold box and background sit in a vertex buffer that is only refilled when the box or size changes,
+// the joints, bones, shadows and calibration box are re-uploaded each frame and every layer goes out as one instanced draw.
+// Anything missing (no 3.2 context, no instancing, a shader that won't compile) leaves it unavailable and the
+// editor keeps using the software StageRenderThread
+class StageGLRenderer : public juce::OpenGLRenderer {
+public:
+    enum class Status { waiting, running, unavailable };
+
+    explicit StageGLRenderer(juce::OpenGLContext& contextToUse) : context(contextToUse) {}
+
+    Status getStatus() const { return status.load(); }
+
+    // Message thread. Hands over the newest frame and asks the context for a redraw
+    void submit(const StageFrame& frame);
+
+    void newOpenGLContextCreated() override;
+    void renderOpenGL() override;
+    void openGLContextClosing() override;
+
+private:
+    juce::OpenGLContext& context;
+    std::atomic<Status> status{ Status::waiting };
+    TripleBuffer<StageFrame> pendingFrames;
+
+    // Everything below is only touched on the GL thread
+    std::unique_ptr<juce::OpenGLShaderProgram> shader;
+    juce::gl::GLuint cornerBuffer = 0;
+    juce::gl::GLuint staticBuffer = 0, dynamicBuffer = 0;
+    juce::gl::GLuint staticArray = 0, dynamicArray = 0;
+    juce::gl::GLint cornerAttribute = -1, pointsAttribute = -1, styleAttribute = -1, colourAttribute = -1;
+
+    bool hasFrame = false;
+    bool isStaticDirty = true;
+    int staticWidth = 0, staticHeight = 0;
+    StageBox staticBox;
+    size_t dynamicCapacity = 0;
+
+    StageView view;
+    SkeletonProjector skeletons;
+    juce::Point<float> floorQuad[4];
+    juce::Point<float> wallQuad[4];
+
+    std::vector<StageShape> staticShapes;
+    std::vector<StageShape> dynamicShapes;
+
+    bool createResources();
+    void releaseResources();
+    void bindInstanceArray(juce::gl::GLuint array, juce::gl::GLuint instances);
+
+    void updateStaticShapes(const StageFrame& frame);
+    void buildDynamicShapes(const StageFrame& frame);
+    void addHand(const StageFrame& frame, const HandData& hand, int handIndex, juce::Colour baseColour);
+    void addBox(std::vector<StageShape>& shapes, const StageBox& box, float thick, juce::Colour colour) const;
+
+    static void addShape(std::vector<StageShape>& shapes, StageShape::Kind kind, juce::Point<float> a, juce::Point<float> b,
+        float width, juce::Colour colour, StageShape::Clip clip = StageShape::noClip);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StageGLRenderer)
+};
@@ -0,0 +1,231 @@
+#include "StageRenderThread.h"
+
+StageRenderThread::StageRenderThread()
+    : juce::Thread("Stage Render Thread") {
+}
+
+StageRenderThread::~StageRenderThread() {
+    shutdown();
+}
+
+void StageRenderThread::shutdown() {
+    signalThreadShouldExit();
+    notify();
+    stopThread(1000);
+}
+
+void StageRenderThread::submit(const StageFrame& frame) {
+    pendingFrames.getWriteBuffer() = frame;
+    pendingFrames.publish();
+    notify();
+}
+
+bool StageRenderThread::drawLatestFrame(juce::Graphics& g) {
+    const juce::ScopedLock sl(swapLock);
+    if (!hasFrontImage) return false;
+
+    g.drawImageTransformed(images[frontIndex], juce::AffineTransform::scale(1.0f / imageScales[frontIndex]));
+    return true;
+}
+
+void StageRenderThread::run() {
+    while (!threadShouldExit()) {
+        if (!pendingFrames.acquire()) {
+            wait(-1);
+            continue;
+        }
+
+        render(pendingFrames.getReadBuffer());
+    }
+}
+
+void StageRenderThread::render(const StageFrame& frame) {
+    if (frame.width <= 0 || frame.height <= 0) return;
+
+    int backIndex = 1 - frontIndex;
+    int w = juce::roundToInt((float)frame.width * frame.displayScale);
+    int h = juce::roundToInt((float)frame.height * frame.displayScale);
+
+    // Software images so drawing off the message thread doesn't touch a native or GL context
+    auto& back = images[backIndex];
+    if (back.getWidth() != w || back.getHeight() != h)
+        back = juce::Image(juce::Image::RGB, w, h, false, juce::SoftwareImageType());
+
+    {
+        juce::Graphics g(back);
+        g.addTransform(juce::AffineTransform::scale(frame.displayScale));
+
+        stage.setViewport({ 0, 0, frame.width, frame.height });
+        stage.setBox(frame.box);
+        stage.drawStaticLayers(g);
+
+        skeletons.project(frame.leftHand, frame.rightHand, frame.box, !frame.isCalibrating, stage.getView());
+        drawHand(g, frame, frame.leftHand, 0, juce::Colours::cyan);
+        drawHand(g, frame, frame.rightHand, 1, juce::Colours::magenta);
+        drawCalibrationBox(g, frame);
+    }
+
+    {
+        // The old front can still be mid blit, the swap waits for it so the next frame can safely draw over it
+        const juce::ScopedLock sl(swapLock);
+        imageScales[backIndex] = frame.displayScale;
+        frontIndex = backIndex;
+        hasFrontImage = true;
+    }
+
+    hasFinishedFrame.store(true);
+}
+
+void StageRenderThread::drawCalibrationBox(juce::Graphics& g, const StageFrame& frame) {
+    if (!frame.isCalibrating || !frame.hasCalibrationBox) return;
+
+    const auto& box = frame.calibrationBox;
+
+    Point3D f1 = { box.minX, box.minY, box.minZ };
+    Point3D f2 = { box.maxX, box.minY, box.minZ };
+    Point3D f3 = { box.maxX, box.minY, box.maxZ };
+    Point3D f4 = { box.minX, box.minY, box.maxZ };
+
+    Point3D c1 = { box.minX, box.maxY, box.minZ };
+    Point3D c2 = { box.maxX, box.maxY, box.minZ };
+    Point3D c3 = { box.maxX, box.maxY, box.maxZ };
+    Point3D c4 = { box.minX, box.maxY, box.maxZ };
+
+    auto pF1 = stage.project(f1); auto pF2 = stage.project(f2);
+    auto pF3 = stage.project(f3); auto pF4 = stage.project(f4);
+    auto pC1 = stage.project(c1); auto pC2 = stage.project(c2);
+    auto pC3 = stage.project(c3); auto pC4 = stage.project(c4);
+
+    g.setColour(juce::Colours::cyan.withAlpha(0.8f));
+    float thick = 2.0f;
+
+    g.drawLine(juce::Line<float>(pF1, pF2), thick); g.drawLine(juce::Line<float>(pF2, pF3), thick);
+    g.drawLine(juce::Line<float>(pF3, pF4), thick); g.drawLine(juce::Line<float>(pF4, pF1), thick);
+
+    g.drawLine(juce::Line<float>(pC1, pC2), thick); g.drawLine(juce::Line<float>(pC2, pC3), thick);
+    g.drawLine(juce::Line<float>(pC3, pC4), thick); g.drawLine(juce::Line<float>(pC4, pC1), thick);
+
+    g.drawLine(juce::Line<float>(pF1, pC1), thick); g.drawLine(juce::Line<float>(pF2, pC2), thick);
+    g.drawLine(juce::Line<float>(pF3, pC3), thick); g.drawLine(juce::Line<float>(pF4, pC4), thick);
+}
+
+void StageRenderThread::drawHand(juce::Graphics& g, const StageFrame& frame, const HandData& hand, int handIndex, juce::Colour baseColour) {
+    if (!hand.isPresent) return;
+
+    Point3D palm3D = skeletons.getWorld(handIndex, SkeletonProjector::palmJoint);
+    auto palm2D = skeletons.getScreen(handIndex, SkeletonProjector::palmJoint);
+    float palmDepth = juce::jmap(palm3D.z, -200.0f, 200.0f, 0.6f, 1.4f);
+
+    if (frame.showFloorShadow) {
+        Point3D shadow3D = { palm3D.x, frame.box.minY, palm3D.z };
+        auto shadow2D = stage.project(shadow3D);
+
+        float heightRatio = juce::jmap(palm3D.y, frame.box.minY, frame.box.maxY, 0.0f, 1.0f);
+        heightRatio = juce::jlimit(0.0f, 1.0f, heightRatio);
+
+        float shadowScale = juce::jmap(shadow3D.z, -200.0f, 200.0f, 0.6f, 1.4f);
+        float shadowW = (50.0f + (heightRatio * 70.0f)) * shadowScale;
+        float shadowH = shadowW * 0.35f;
+        float shadowAlpha = 0.5f - (heightRatio * 0.4f);
+
+        g.saveState();
+        g.reduceClipRegion(stage.getFloorPath());
+        g.setColour(baseColour.darker(0.8f).withAlpha(shadowAlpha));
+        g.fillEllipse(shadow2D.x - (shadowW / 2.0f), shadow2D.y - (shadowH / 2.0f), shadowW, shadowH);
+        g.restoreState();
+    }
+
+    if (frame.showWallShadow) {
+        Point3D wallShadow3D = { palm3D.x, palm3D.y, frame.box.minZ };
+        auto wallShadow2D = stage.project(wallShadow3D);
+
+        float depthRatio = juce::jmap(palm3D.z, frame.box.minZ, frame.box.maxZ, 0.0f, 1.0f);
+        depthRatio = juce::jlimit(0.0f, 1.0f, depthRatio);
+
+        float backWallScale = juce::jmap(frame.box.minZ, -200.0f, 200.0f, 0.6f, 1.4f);
+        float wallShadowSize = (50.0f + (depthRatio * 70.0f)) * backWallScale;
+        float wallShadowAlpha = 0.4f - (depthRatio * 0.35f);
+
+        g.saveState();
+        g.reduceClipRegion(stage.getWallPath());
+        g.setColour(baseColour.darker(0.8f).withAlpha(wallShadowAlpha));
+        g.fillEllipse(wallShadow2D.x - (wallShadowSize / 2.0f), wallShadow2D.y - (wallShadowSize / 2.0f), wallShadowSize, wallShadowSize);
+        g.restoreState();
+    }
+
+    float grabIntensity = juce::jlimit(0.0f, 1.0f, hand.grabStrength * frame.grabMultiplier);
+    if (grabIntensity > 0.1f) {
+        juce::Colour grabCol = baseColour.interpolatedWith(juce::Colours::orange, grabIntensity);
+
+        g.setColour(grabCol.withAlpha(0.3f * grabIntensity));
+        float radius = (40.0f * palmDepth) * (2.0f - grabIntensity);
+        g.fillEllipse(palm2D.x - radius / 2, palm2D.y - radius / 2, radius, radius);
+
+        g.setColour(grabCol);
+        g.drawEllipse(palm2D.x - radius / 2, palm2D.y - radius / 2, radius, radius, 2.0f);
+    }
+
+    // One path per layer, every finger's segments of the same width and alpha go out in a single stroke
+    palmLinkPath.clear();
+    tipDotPath.clear();
+    knuckleDotPath.clear();
+    for (auto& layer : bonePaths)
+        for (auto& path : layer) path.clear();
+
+    auto addSegment = [](juce::Path& path, juce::Point<float> from, juce::Point<float> to) {
+        path.startNewSubPath(from);
+        path.lineTo(to);
+        };
+
+    float jointSize = 6.0f * palmDepth;
+
+    for (int i = 0; i < 5; ++i) {
+        bool isExtended = hand.fingers[i].isExtended;
+
+        auto knuckle = skeletons.getScreen(handIndex, SkeletonProjector::fingerJoint(i, 0));
+        auto joint1 = skeletons.getScreen(handIndex, SkeletonProjector::fingerJoint(i, 1));
+        auto joint2 = skeletons.getScreen(handIndex, SkeletonProjector::fingerJoint(i, 2));
+        auto tip = skeletons.getScreen(handIndex, SkeletonProjector::fingerJoint(i, 3));
+
+        addSegment(palmLinkPath, palm2D, knuckle);
+
+        auto& layer = bonePaths[isExtended ? 1 : 0];
+        addSegment(layer[0], knuckle, joint1);
+        addSegment(layer[1], joint1, joint2);
+        addSegment(layer[2], joint2, tip);
+
+        if (isExtended) tipDotPath.addEllipse(tip.x - jointSize / 2, tip.y - jointSize / 2, jointSize, jointSize);
+        knuckleDotPath.addEllipse(knuckle.x - jointSize, knuckle.y - jointSize, jointSize * 2, jointSize * 2);
+    }
+
+    g.setColour(baseColour.withAlpha(0.2f));
+    g.strokePath(palmLinkPath, juce::PathStrokeType(2.0f * palmDepth));
+
+    const float boneWidths[3] = { 3.0f, 2.5f, 2.0f };
+    for (int extended = 0; extended < 2; ++extended) {
+        g.setColour(baseColour.withAlpha(extended ? 0.9f : 0.2f));
+        for (int bone = 0; bone < 3; ++bone) {
+            if (!bonePaths[extended][bone].isEmpty())
+                g.strokePath(bonePaths[extended][bone], juce::PathStrokeType(boneWidths[bone] * palmDepth));
+        }
+    }
+
+    g.setColour(juce::Colours::white.withAlpha(0.8f));
+    g.fillPath(tipDotPath);
+
+    g.setColour(baseColour.withAlpha(0.4f));
+    g.fillPath(knuckleDotPath);
+
+    float pinchIntensity = juce::jlimit(0.0f, 1.0f, hand.pinchStrength * frame.pinchMultiplier);
+    
+    if (pinchIntensity > 0.8f && !hand.fingers[0].isExtended) {
+        auto pinch2D = skeletons.getScreen(handIndex, SkeletonProjector::pinchJoint);
+
+        g.setColour(juce::Colours::yellow);
+        float sparkSize = 15.0f * palmDepth;
+        g.fillEllipse(pinch2D.x - sparkSize / 2, pinch2D.y - sparkSize / 2, sparkSize, sparkSize);
+
+        g.drawLine(pinch2D.x - sparkSize, pinch2D.y, pinch2D.x + sparkSize, pinch2D.y, 2.0f);
+        g.drawLine(pinch2D.x, pinch2D.y - sparkSize, pinch2D.x, pinch2D.y + sparkSize, 2.0f);
+    }
+}
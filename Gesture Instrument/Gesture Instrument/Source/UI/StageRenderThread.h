@@ -0,0 +1,53 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "../Helpers/TripleBuffer.h"
+#include "StageRenderer.h"
+#include "SkeletonProjector.h"
+
+// Rasterises the 3D stage on its own thread so ComboBoxes, file choosers and preset loads on the message thread
+// don't hold up a frame, and a slow frame doesn't hold them up. Frames are drawn into the back of two images,
+// the message thread only ever blits the front one
+class StageRenderThread : public juce::Thread {
+public:
+    StageRenderThread();
+    ~StageRenderThread() override;
+
+    // Message thread. Hands over the newest frame, an older one still waiting is simply replaced
+    void submit(const StageFrame& frame);
+
+    // Message thread. True once per finished frame, the caller should repaint
+    bool collectFinishedFrame() { return hasFinishedFrame.exchange(false); }
+
+    // Message thread, from paint. False until the first frame is done
+    bool drawLatestFrame(juce::Graphics& g);
+
+    void shutdown();
+
+    void run() override;
+
+private:
+    TripleBuffer<StageFrame> pendingFrames;
+    std::atomic<bool> hasFinishedFrame{ false };
+
+    // Front image and its scale are swapped under the lock, the back one belongs to this thread
+    juce::CriticalSection swapLock;
+    juce::Image images[2];
+    float imageScales[2] = { 1.0f, 1.0f };
+    int frontIndex = 0;
+    bool hasFrontImage = false;
+
+    // Only touched on the render thread
+    StageRenderer stage;
+    SkeletonProjector skeletons;
+    juce::Path palmLinkPath;
+    juce::Path bonePaths[2][3];
+    juce::Path tipDotPath;
+    juce::Path knuckleDotPath;
+
+    void render(const StageFrame& frame);
+    void drawHand(juce::Graphics& g, const StageFrame& frame, const HandData& hand, int handIndex, juce::Colour baseColour);
+    void drawCalibrationBox(juce::Graphics& g, const StageFrame& frame);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StageRenderThread)
+};
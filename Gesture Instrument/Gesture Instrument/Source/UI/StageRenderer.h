@@ -0,0 +1,129 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "StageTypes.h"
+
+// Projection and the parts of the 3D stage that don't move between frames.
+// Background, room grid and threshold box live in one image, the floor and back wall shadow clips are kept as paths.
+// Both are only rebuilt when the view is resized or the box changes, so a frame is one image blit plus the hands
+class StageRenderer {
+public:
+    void setViewport(juce::Rectangle<int> bounds) {
+        if (bounds == viewport) return;
+
+        viewport = bounds;
+        view.setViewport(bounds);
+
+        rebuildClipPaths();
+        isImageDirty = true;
+    }
+
+    void setBox(const StageBox& newBox) {
+        if (newBox == box) return;
+
+        box = newBox;
+        rebuildClipPaths();
+        isImageDirty = true;
+    }
+
+    const StageBox& getBox() const { return box; }
+    const StageView& getView() const { return view; }
+
+    juce::Point<float> project(Point3D p) const { return view.project(p); }
+
+    // Blits the cached layers, redrawing them first if the view, box or display scale changed
+    void drawStaticLayers(juce::Graphics& g) {
+        float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+        if (isImageDirty || scale != imageScale) rebuildImage(scale);
+
+        g.drawImageTransformed(staticLayer, juce::AffineTransform::scale(1.0f / imageScale)
+            .translated((float)viewport.getX(), (float)viewport.getY()));
+    }
+
+    const juce::Path& getFloorPath() const { return floorPath; }
+    const juce::Path& getWallPath() const { return wallPath; }
+
+private:
+    static constexpr float minRoomX = -350.0f, maxRoomX = 350.0f;
+    static constexpr float minRoomY = 50.0f, maxRoomY = 500.0f;
+    static constexpr float minRoomZ = -225.0f, maxRoomZ = 225.0f;
+
+    juce::Rectangle<int> viewport;
+    StageView view;
+    StageBox box;
+
+    juce::Image staticLayer;
+    float imageScale = 1.0f;
+    bool isImageDirty = true;
+
+    juce::Path floorPath;
+    juce::Path wallPath;
+
+    void rebuildClipPaths() {
+        floorPath.clear();
+        floorPath.startNewSubPath(project({ box.minX, box.minY, box.minZ }));
+        floorPath.lineTo(project({ box.maxX, box.minY, box.minZ }));
+        floorPath.lineTo(project({ box.maxX, box.minY, box.maxZ }));
+        floorPath.lineTo(project({ box.minX, box.minY, box.maxZ }));
+        floorPath.closeSubPath();
+
+        wallPath.clear();
+        wallPath.startNewSubPath(project({ box.minX, box.minY, box.minZ }));
+        wallPath.lineTo(project({ box.maxX, box.minY, box.minZ }));
+        wallPath.lineTo(project({ box.maxX, box.maxY, box.minZ }));
+        wallPath.lineTo(project({ box.minX, box.maxY, box.minZ }));
+        wallPath.closeSubPath();
+    }
+
+    void rebuildImage(float scale) {
+        imageScale = scale;
+        isImageDirty = false;
+
+        int w = juce::jmax(1, juce::roundToInt((float)viewport.getWidth() * scale));
+        int h = juce::jmax(1, juce::roundToInt((float)viewport.getHeight() * scale));
+        staticLayer = juce::Image(juce::Image::RGB, w, h, false, juce::SoftwareImageType());
+
+        juce::Graphics g(staticLayer);
+        g.addTransform(juce::AffineTransform::translation((float)-viewport.getX(), (float)-viewport.getY()).scaled(scale));
+
+        juce::ColourGradient bgGradient(
+            juce::Colour::fromFloatRGBA(0.05f, 0.05f, 0.1f, 1.0f),
+            (float)viewport.getCentreX(), (float)viewport.getCentreY(),
+            juce::Colour::fromFloatRGBA(0.0f, 0.0f, 0.0f, 1.0f),
+            (float)viewport.getX(), (float)viewport.getY(), true);
+        g.setGradientFill(bgGradient);
+        g.fillAll();
+
+        g.setColour(juce::Colours::white.withAlpha(0.08f));
+        drawBox(g, minRoomX, maxRoomX, minRoomY, maxRoomY, minRoomZ, maxRoomZ, 1.0f);
+
+        g.setColour(juce::Colours::yellow.withAlpha(0.6f));
+        drawBox(g, box.minX, box.maxX, box.minY, box.maxY, box.minZ, box.maxZ, 2.5f);
+
+        if (box.isSplit) {
+            float cx = (box.minX + box.maxX) / 2.0f;
+            auto pDivF1 = project({ cx, box.minY, box.minZ }); auto pDivF2 = project({ cx, box.minY, box.maxZ });
+            auto pDivC1 = project({ cx, box.maxY, box.minZ }); auto pDivC2 = project({ cx, box.maxY, box.maxZ });
+
+            g.setColour(juce::Colours::orange.withAlpha(0.8f));
+            g.drawLine(juce::Line<float>(pDivF1, pDivF2), 2.5f);
+            g.drawLine(juce::Line<float>(pDivC1, pDivC2), 2.5f);
+            g.drawLine(juce::Line<float>(pDivF1, pDivC1), 2.5f);
+            g.drawLine(juce::Line<float>(pDivF2, pDivC2), 2.5f);
+        }
+    }
+
+    void drawBox(juce::Graphics& g, float minX, float maxX, float minY, float maxY, float minZ, float maxZ, float thick) const {
+        auto pF1 = project({ minX, minY, minZ }); auto pF2 = project({ maxX, minY, minZ });
+        auto pF3 = project({ maxX, minY, maxZ }); auto pF4 = project({ minX, minY, maxZ });
+        auto pC1 = project({ minX, maxY, minZ }); auto pC2 = project({ maxX, maxY, minZ });
+        auto pC3 = project({ maxX, maxY, maxZ }); auto pC4 = project({ minX, maxY, maxZ });
+
+        g.drawLine(juce::Line<float>(pF1, pF2), thick); g.drawLine(juce::Line<float>(pF2, pF3), thick);
+        g.drawLine(juce::Line<float>(pF3, pF4), thick); g.drawLine(juce::Line<float>(pF4, pF1), thick);
+        g.drawLine(juce::Line<float>(pC1, pC2), thick); g.drawLine(juce::Line<float>(pC2, pC3), thick);
+        g.drawLine(juce::Line<float>(pC3, pC4), thick); g.drawLine(juce::Line<float>(pC4, pC1), thick);
+        g.drawLine(juce::Line<float>(pF1, pC1), thick); g.drawLine(juce::Line<float>(pF2, pC2), thick);
+        g.drawLine(juce::Line<float>(pF3, pC3), thick); g.drawLine(juce::Line<float>(pF4, pC4), thick);
+    }
+};
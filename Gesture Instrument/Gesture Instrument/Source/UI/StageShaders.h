@@ -0,0 +1,118 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// One instanced quad. Segments run from (x0, y0) to (x1, y1), ellipses and the background glow are centred
+// on (x0, y0) with radii (x1, y1). Laid out to match the three vec4 instance attributes of the shader
+struct StageShape {
+    enum Kind { segment = 0, ellipse = 1, ellipseOutline = 2, glow = 3 };
+    enum Clip { noClip = 0, floorClip = 1, wallClip = 2 };
+
+    float x0, y0, x1, y1;
+    float width, kind, clip, unused;
+    float red, green, blue, alpha;
+};
+
+// The shaders every StageShape goes through, kept apart from the renderer so the tests can compile and run them on their own
+namespace StageShaders {
+    // GLSL 1.50 so it runs on any 3.2 core context, Mesa's llvmpipe included
+    inline const char* vertexShaderSource = R"(
+        #version 150
+        in vec2 corner;
+        in vec4 shapePoints;
+        in vec4 shapeStyle;
+        in vec4 shapeColour;
+
+        uniform vec2 viewportSize;
+        uniform float pixelSize;
+
+        out vec2 local;
+        out vec2 screenPosition;
+        out vec4 colour;
+        flat out vec4 style;
+        flat out vec2 radii;
+
+        void main() {
+            float kind = shapeStyle.y;
+            vec2 position;
+
+            if (kind < 0.5) {
+                // Segment, the quad runs along the line and is padded a pixel either side for the edge fade
+                vec2 along = shapePoints.zw - shapePoints.xy;
+                vec2 normal = vec2(-along.y, along.x) / max(length(along), 0.0001);
+                float halfExtent = shapeStyle.x * 0.5 + pixelSize;
+
+                position = mix(shapePoints.xy, shapePoints.zw, corner.x * 0.5 + 0.5) + normal * corner.y * halfExtent;
+                local = vec2(0.0, corner.y * halfExtent);
+            }
+            else {
+                float pad = kind > 2.5 ? 0.0 : pixelSize + (kind > 1.5 ? shapeStyle.x * 0.5 : 0.0);
+                vec2 extent = shapePoints.zw + vec2(pad);
+
+                position = shapePoints.xy + corner * extent;
+                local = corner * extent;
+            }
+
+            screenPosition = position;
+            colour = shapeColour;
+            style = shapeStyle;
+            radii = max(shapePoints.zw, vec2(0.0001));
+
+            vec2 clipSpace = position / viewportSize * 2.0 - 1.0;
+            gl_Position = vec4(clipSpace.x, -clipSpace.y, 0.0, 1.0);
+        }
+    )";
+
+    inline const char* fragmentShaderSource = R"(
+        #version 150
+        in vec2 local;
+        in vec2 screenPosition;
+        in vec4 colour;
+        flat in vec4 style;
+        flat in vec2 radii;
+
+        uniform float pixelSize;
+        uniform vec2 floorQuad[4];
+        uniform vec2 wallQuad[4];
+
+        out vec4 fragColour;
+
+        float edgeSide(vec2 a, vec2 b, vec2 p) {
+            return (b.x - a.x) * (p.y - a.y) - (b.y - a.y) * (p.x - a.x);
+        }
+
+        // The floor and back wall are convex, so inside means on the same side of all four edges
+        bool isInside(vec2 q0, vec2 q1, vec2 q2, vec2 q3, vec2 p) {
+            vec4 sides = vec4(edgeSide(q0, q1, p), edgeSide(q1, q2, p), edgeSide(q2, q3, p), edgeSide(q3, q0, p));
+            return all(greaterThanEqual(sides, vec4(0.0))) || all(lessThanEqual(sides, vec4(0.0)));
+        }
+
+        void main() {
+            float kind = style.y;
+            float clip = style.z;
+
+            if (clip > 0.5 && clip < 1.5 && !isInside(floorQuad[0], floorQuad[1], floorQuad[2], floorQuad[3], screenPosition)) discard;
+            if (clip > 1.5 && !isInside(wallQuad[0], wallQuad[1], wallQuad[2], wallQuad[3], screenPosition)) discard;
+
+            float coverage;
+
+            if (kind < 0.5) {
+                coverage = clamp((style.x * 0.5 - abs(local.y)) / pixelSize + 0.5, 0.0, 1.0);
+            }
+            else if (kind > 2.5) {
+                coverage = 1.0 - clamp(length(local) / radii.x, 0.0, 1.0);
+            }
+            else {
+                // Approximate distance to the ellipse edge from the implicit function and its gradient
+                float f = length(local / radii);
+                float gradient = length(local / (radii * radii)) / max(f, 0.0001);
+                float distance = (f - 1.0) / max(gradient, 0.0001);
+
+                if (kind < 1.5) coverage = clamp(0.5 - distance / pixelSize, 0.0, 1.0);
+                else coverage = clamp((style.x * 0.5 - abs(distance)) / pixelSize + 0.5, 0.0, 1.0);
+            }
+
+            fragColour = vec4(colour.rgb, colour.a * coverage);
+        }
+    )";
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "../Helpers/HandData.h"
+
+struct Point3D {
+    float x, y, z;
+};
+
+// The perspective the stage is drawn with, shared by every renderer and the batch skeleton projector so all give the same points
+struct StageView {
+    static constexpr float fov = 350.0f;
+    static constexpr float camDist = 600.0f;
+    static constexpr float worldYOffset = 250.0f;
+
+    float scale = 1.0f;
+    float centreX = 0.0f;
+    float centreY = 0.0f;
+
+    void setViewport(juce::Rectangle<int> bounds) {
+        centreX = (float)bounds.getCentreX();
+        centreY = (float)bounds.getCentreY();
+        scale = ((float)bounds.getHeight() * 0.55f) / 500.0f * 2.5f;
+    }
+
+    juce::Point<float> project(Point3D p) const {
+        float worldY = p.y - worldYOffset;
+        float adjustedZ = -p.z;
+
+        float perspective = fov / (fov + adjustedZ + camDist);
+        float finalScale = perspective * scale;
+
+        return { p.x * finalScale + centreX, -worldY * finalScale + centreY };
+    }
+};
+
+// The threshold box the static layers were drawn for
+struct StageBox {
+    float minX = 0.0f, maxX = 0.0f;
+    float minY = 0.0f, maxY = 0.0f;
+    float minZ = 0.0f, maxZ = 0.0f;
+    bool isSplit = false;
+
+    bool operator==(const StageBox& other) const {
+        return minX == other.minX && maxX == other.maxX
+            && minY == other.minY && maxY == other.maxY
+            && minZ == other.minZ && maxZ == other.maxZ
+            && isSplit == other.isSplit;
+    }
+
+    bool operator!=(const StageBox& other) const { return !(*this == other); }
+};
+
+// Everything needed to draw one frame of the 3D stage, copied so a renderer never touches the processor
+struct StageFrame {
+    int width = 0;
+    int height = 0;
+    float displayScale = 1.0f;
+
+    StageBox box;
+    HandData leftHand;
+    HandData rightHand;
+
+    bool showFloorShadow = true;
+    bool showWallShadow = true;
+    float grabMultiplier = 1.0f;
+    float pinchMultiplier = 1.0f;
+
+    // Calibration draws the hands unclamped plus the box found so far
+    bool isCalibrating = false;
+    bool hasCalibrationBox = false;
+    StageBox calibrationBox;
+};
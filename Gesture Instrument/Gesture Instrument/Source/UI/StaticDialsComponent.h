@@ -43,7 +43,7 @@ public:
     }
 };
 
-class StaticDialsComponent : public juce::Component, public juce::Timer {
+class StaticDialsComponent : public juce::Component {
 public:
     StaticDialsComponent(GestureInstrumentAudioProcessor& p) : audioProcessor(p) {
 
@@ -141,12 +141,9 @@ public:
 
         addAndMakeVisible(closeButton);
         closeButton.setButtonText("Close");
-
-        startTimerHz(60);
     }
 
     ~StaticDialsComponent() override {
-        stopTimer();
         setLookAndFeel(nullptr);
     }
 
@@ -195,7 +192,8 @@ public:
         layoutRow(area.removeFromTop(rowH), reverbDial, reverbLabel, chorusDial, chorusLabel, vibDial, vibLabel, waveDial, waveLabel);
     }
 
-    void timerCallback() override {
+    // Called by the editor every frame while the page is open, a dial only repaints if its value moved
+    void updateDials() {
         bool isOsc = (audioProcessor.currentOutputMode == OutputMode::OSC_Only);
 
         // Toggle OSC specific dials
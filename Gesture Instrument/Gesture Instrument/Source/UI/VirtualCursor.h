@@ -2,6 +2,7 @@
 
 #include <JuceHeader.h>
 #include "../PluginProcessor.h"
+#include "HitTargetIndex.h"
 
 class VirtualCursor : public juce::Component {
 public:
@@ -10,7 +11,10 @@ public:
         setInterceptsMouseClicks(false, false);
     }
 
-    void paint(juce::Graphics& g) override {
+    void paint(juce::Graphics& g) override { paintCursor(g); }
+
+    // Also called by the stage, which has to draw the cursor again where its GL surface covers this component
+    void paintCursor(juce::Graphics& g) const {
         if (!isActive) return;
 
         juce::Colour cursorCol = juce::Colours::white;
@@ -25,21 +29,44 @@ public:
 
         g.setColour(cursorCol.withAlpha(safeAlpha));
         g.drawEllipse(smoothedX - ringSize / 2.0f, smoothedY - ringSize / 2.0f, ringSize, ringSize, 2.0f);
+
+        // Fills up while the cursor rests on one control, full means it's safe to pinch
+        if (dwellProgress > 0.0f && !isPinching) {
+            juce::Path dwellArc;
+            dwellArc.addCentredArc(smoothedX, smoothedY, dwellRadius, dwellRadius, 0.0f, 0.0f, juce::MathConstants<float>::twoPi * dwellProgress, true);
+            g.setColour(juce::Colours::green.withAlpha(0.5f + 0.5f * dwellProgress));
+            g.strokePath(dwellArc, juce::PathStrokeType(3.0f));
+        }
     }
 
-    void updateCursorLogic(bool editModeActive) {
-        if (!editModeActive || !audioProcessor.rightHand.isPresent) {
+    // Every area this component repaints, so a copy drawn elsewhere can follow
+    std::function<void(juce::Rectangle<int>)> onAreaRepainted;
+
+    void parentHierarchyChanged() override { hitTargets.setRoot(getParentComponent(), this); }
+
+    void updateCursorLogic(bool editModeActive, float deltaSeconds) {
+        const auto& snapshot = audioProcessor.getRenderSnapshot();
+        const auto& rightHand = snapshot.rightHand;
+
+        if (!editModeActive || !rightHand.isPresent) {
+            if (isActive) {
+                repaintArea(paintedArea);
+                paintedPinchStrength = -1.0f;
+            }
+
             isActive = false;
             isPinching = false;
             wasPinching = false;
             isHoveringClickable = false;
             draggedSlider = nullptr;
-            repaint();
+            dwellTarget = nullptr;
+            dwellProgress = 0.0f;
+            warpedPos = { -1, -1 };
             return;
         }
 
         isActive = true;
-        currentPinchStrength = audioProcessor.rightHand.pinchStrength;
+        currentPinchStrength = rightHand.pinchStrength;
 
         if (currentPinchStrength > 0.8f) {
             isPinching = true;
@@ -48,8 +75,10 @@ public:
             isPinching = false;
         }
 
-        float normalizedX = juce::jmap(audioProcessor.rightHand.currentHandPositionX, audioProcessor.minWidthThreshold, audioProcessor.maxWidthThreshold, 0.0f, 1.0f);
-        float normalizedY = juce::jmap(audioProcessor.rightHand.currentHandPositionY, audioProcessor.minHeightThreshold, audioProcessor.maxHeightThreshold, 1.0f, 0.0f);
+        // The area the managers are playing with, which the auto ranger may have moved away from the thresholds
+        const auto& area = snapshot.playArea;
+        float normalizedX = juce::jmap(rightHand.currentHandPositionX, area.minX, area.maxX, 0.0f, 1.0f);
+        float normalizedY = juce::jmap(rightHand.currentHandPositionY, area.minY, area.maxY, 1.0f, 0.0f);
 
         const float sensitivity = 1.3f;
         normalizedX = 0.5f + ((normalizedX - 0.5f) * sensitivity);
@@ -58,12 +87,15 @@ public:
         float targetX = juce::jlimit(0.0f, (float)getWidth(), normalizedX * getWidth());
         float targetY = juce::jlimit(0.0f, (float)getHeight(), normalizedY * getHeight());
 
+        // Where the smoothing is heading, a control there starts the slow down before the cursor reaches it
+        auto predicted = hitTargets.find({ (int)targetX, (int)targetY });
+
         float smoothingSpeed = 0.6f;
 
         if (isPinching) {
             smoothingSpeed = 0.1f;
         }
-        else if (isHoveringClickable) {
+        else if (isHoveringClickable || predicted.isClickable()) {
             smoothingSpeed = 0.25f;
         }
 
@@ -72,36 +104,35 @@ public:
 
         cursorPos = { (int)smoothedX, (int)smoothedY };
 
-        if (auto* parent = getParentComponent()) {
-            auto globalPos = parent->localPointToGlobal(cursorPos.toFloat());
-            juce::Desktop::getInstance().getMainMouseSource().setScreenPosition(globalPos);
+        // Warping the OS pointer is a system call, a resting hand doesn't need one every frame
+        if (cursorPos != warpedPos) {
+            if (auto* parent = getParentComponent()) {
+                auto globalPos = parent->localPointToGlobal(cursorPos.toFloat());
+                juce::Desktop::getInstance().getMainMouseSource().setScreenPosition(globalPos);
+                warpedPos = cursorPos;
+            }
         }
 
-        isHoveringClickable = false;
         if (!isPinching) {
             draggedSlider = nullptr;
         }
 
-        if (auto* parent = getParentComponent()) {
-            if (auto* hoveredComponent = parent->getComponentAt(cursorPos)) {
-
-                if (dynamic_cast<juce::Button*>(hoveredComponent) || dynamic_cast<juce::ComboBox*>(hoveredComponent) || dynamic_cast<juce::Slider*>(hoveredComponent)) {
-                    isHoveringClickable = true;
-                }
-
-                if (isPinching && !wasPinching) {
-                    if (auto* btn = dynamic_cast<juce::Button*>(hoveredComponent)) {
-                        btn->triggerClick();
-                    }
-                    else if (auto* cb = dynamic_cast<juce::ComboBox*>(hoveredComponent)) {
-                        int nextIndex = cb->getSelectedItemIndex() + 1;
-                        if (nextIndex >= cb->getNumItems()) nextIndex = 0;
-                        cb->setSelectedItemIndex(nextIndex, juce::sendNotificationSync);
-                    }
-                    else if (auto* slider = dynamic_cast<juce::Slider*>(hoveredComponent)) {
-                        draggedSlider = slider;
-                    }
-                }
+        auto hovered = hitTargets.find(cursorPos);
+        isHoveringClickable = hovered.isClickable();
+        updateDwell(hovered.isClickable() ? hovered.component : nullptr, deltaSeconds);
+
+        if (isHoveringClickable && isPinching && !wasPinching) {
+            if (hovered.kind == HitTargetIndex::Kind::button) {
+                static_cast<juce::Button*>(hovered.component)->triggerClick();
+            }
+            else if (hovered.kind == HitTargetIndex::Kind::comboBox) {
+                auto* cb = static_cast<juce::ComboBox*>(hovered.component);
+                int nextIndex = cb->getSelectedItemIndex() + 1;
+                if (nextIndex >= cb->getNumItems()) nextIndex = 0;
+                cb->setSelectedItemIndex(nextIndex, juce::sendNotificationSync);
+            }
+            else if (hovered.kind == HitTargetIndex::Kind::slider) {
+                draggedSlider = static_cast<juce::Slider*>(hovered.component);
             }
         }
 
@@ -122,7 +153,7 @@ public:
         }
 
         wasPinching = isPinching;
-        repaint();
+        repaintCursor();
     }
 
 private:
@@ -139,4 +170,53 @@ private:
     bool isHoveringClickable = false;
 
     juce::Slider* draggedSlider = nullptr;
+
+    HitTargetIndex hitTargets;
+    juce::Point<int> warpedPos{ -1, -1 };
+
+    // Dwell cue, how long the cursor has rested on the same control
+    static constexpr float dwellSeconds = 0.5f;
+    static constexpr float dwellRadius = 16.0f;
+    juce::Component* dwellTarget = nullptr;
+    float dwellProgress = 0.0f;
+
+    void updateDwell(juce::Component* target, float deltaSeconds) {
+        if (target != dwellTarget) {
+            dwellTarget = target;
+            dwellProgress = 0.0f;
+        }
+        else if (target != nullptr) {
+            dwellProgress = juce::jmin(1.0f, dwellProgress + deltaSeconds / dwellSeconds);
+        }
+    }
+
+    // Only the old and new cursor areas are redrawn, the component covers the whole editor
+    juce::Rectangle<int> paintedArea;
+    float paintedPinchStrength = -1.0f;
+    bool paintedPinching = false;
+    bool paintedHovering = false;
+    float paintedDwell = 0.0f;
+
+    void repaintCursor() {
+        auto area = juce::Rectangle<float>(cursorAreaSize, cursorAreaSize).withCentre({ smoothedX, smoothedY }).getSmallestIntegerContainer();
+
+        bool looksSame = area == paintedArea && currentPinchStrength == paintedPinchStrength
+            && isPinching == paintedPinching && isHoveringClickable == paintedHovering && dwellProgress == paintedDwell;
+        if (looksSame) return;
+
+        repaintArea(paintedArea.getUnion(area));
+        paintedArea = area;
+        paintedPinchStrength = currentPinchStrength;
+        paintedPinching = isPinching;
+        paintedHovering = isHoveringClickable;
+        paintedDwell = dwellProgress;
+    }
+
+    void repaintArea(juce::Rectangle<int> area) {
+        repaint(area);
+        if (onAreaRepainted) onAreaRepainted(area);
+    }
+
+    // Largest ring plus its stroke
+    static constexpr float cursorAreaSize = 66.0f;
 };
\ No newline at end of file
@@ -0,0 +1,24 @@
+#pragma once
+
+// Heap allocations made on the calling thread while a Scope is open.
+// BenchmarkMain.cpp replaces the global operator new to feed the count, other threads are never counted
+namespace AllocationCounter {
+    inline thread_local bool isCounting = false;
+    inline thread_local long long count = 0;
+
+    inline void recordAllocation() {
+        if (isCounting) ++count;
+    }
+
+    class Scope {
+    public:
+        Scope() {
+            count = 0;
+            isCounting = true;
+        }
+
+        ~Scope() { isCounting = false; }
+
+        long long getCount() const { return count; }
+    };
+}
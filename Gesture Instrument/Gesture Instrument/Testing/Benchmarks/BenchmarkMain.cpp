@@ -0,0 +1,168 @@
+#include <JuceHeader.h>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include "AllocationCounter.h"
+#include "OscThroughputBenchmark.h"
+#include "ProcessBlockBenchmark.h"
+
+// Counting replacements for the global allocator, see AllocationCounter.h
+void* operator new(std::size_t size) {
+    AllocationCounter::recordAllocation();
+    if (void* p = std::malloc(size > 0 ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    AllocationCounter::recordAllocation();
+    if (void* p = std::malloc(size > 0 ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+// OSC throughput and latency over loopback. False if the port couldn't be opened
+static bool runOscSuite(const juce::ArgumentList& args, juce::var& report, bool& lostFrames) {
+    int frames = args.containsOption("--frames") ? args.getValueForOption("--frames").getIntValue() : 5000;
+    double rate = args.containsOption("--rate") ? args.getValueForOption("--rate").getDoubleValue() : 120.0;
+    int port = args.containsOption("--port") ? args.getValueForOption("--port").getIntValue() : 9002;
+    frames = juce::jmax(1, frames);
+
+    juce::Array<juce::var> oscResults;
+
+    std::cout << "OSC throughput / latency (" << frames << " frames, latency pass paced at " << rate << " Hz, port " << port << ")" << std::endl;
+
+    OscThroughputBenchmark oscBenchmark(port, frames, rate);
+    if (!oscBenchmark.connect()) {
+        std::cerr << "Could not open the loopback OSC port " << port << std::endl;
+        return false;
+    }
+
+    const OscThroughputBenchmark::SendMode modes[] = {
+        OscThroughputBenchmark::SendMode::RawData,
+        OscThroughputBenchmark::SendMode::RoutingDefault,
+        OscThroughputBenchmark::SendMode::RoutingDense,
+        OscThroughputBenchmark::SendMode::FullFrame
+    };
+
+    for (auto mode : modes) {
+        auto result = oscBenchmark.run(mode);
+        lostFrames = lostFrames || result.framesReceived < result.framesSent;
+
+        std::cout << juce::String(result.modeName).paddedRight(' ', 42)
+                  << juce::String(result.messagesPerSecond, 0).paddedLeft(' ', 10) << " msg/s"
+                  << juce::String(result.packetsPerSecond, 0).paddedLeft(' ', 10) << " pkt/s"
+                  << juce::String(result.messagesPerFrame, 1).paddedLeft(' ', 7) << " msg/frame"
+                  << "   p50 " << juce::String(result.latencyP50Ms, 3) << " ms"
+                  << "   p99 " << juce::String(result.latencyP99Ms, 3) << " ms"
+                  << "   cpu " << juce::String(result.cpuPerFrameUs, 2) << " us/frame"
+                  << "   (" << result.framesReceived << "/" << result.framesSent << " frames)" << std::endl;
+
+        auto* entry = new juce::DynamicObject();
+        entry->setProperty("mode", result.modeName);
+        entry->setProperty("messagesPerSecond", result.messagesPerSecond);
+        entry->setProperty("packetsPerSecond", result.packetsPerSecond);
+        entry->setProperty("messagesPerFrame", result.messagesPerFrame);
+        entry->setProperty("latencyP50Ms", result.latencyP50Ms);
+        entry->setProperty("latencyP99Ms", result.latencyP99Ms);
+        entry->setProperty("cpuPerFrameUs", result.cpuPerFrameUs);
+        entry->setProperty("framesSent", result.framesSent);
+        entry->setProperty("framesReceived", result.framesReceived);
+        oscResults.add(juce::var(entry));
+    }
+
+    report.getDynamicObject()->setProperty("osc", oscResults);
+    return true;
+}
+
+// processBlock across the whole configuration sweep, no sensor or audio device needed
+static void runProcessBlockSuite(const juce::ArgumentList& args, juce::var& report) {
+    double seconds = args.containsOption("--seconds") ? args.getValueForOption("--seconds").getDoubleValue() : 2.0;
+    double sensorRate = args.containsOption("--rate") ? args.getValueForOption("--rate").getDoubleValue() : 120.0;
+    seconds = juce::jmax(0.01, seconds);
+    sensorRate = juce::jmax(1.0, sensorRate);
+
+    juce::Array<juce::var> blockResults;
+
+    std::cout << "processBlock (" << seconds << " s of audio per run, hands injected at " << sensorRate << " Hz)" << std::endl;
+    std::cout << juce::String("config").paddedRight(' ', 42)
+              << juce::String("mean ns").paddedLeft(' ', 11) << juce::String("p50 ns").paddedLeft(' ', 11)
+              << juce::String("p99 ns").paddedLeft(' ', 11) << juce::String("worst ns").paddedLeft(' ', 11)
+              << juce::String("load").paddedLeft(' ', 8) << juce::String("midi/blk").paddedLeft(' ', 10)
+              << juce::String("alloc/blk").paddedLeft(' ', 11) << juce::String("worst").paddedLeft(' ', 7) << std::endl;
+
+    ProcessBlockBenchmark blockBenchmark(seconds, sensorRate);
+
+    for (const auto& config : ProcessBlockBenchmark::makeSweep()) {
+        auto result = blockBenchmark.run(config);
+
+        std::cout << config.getName().paddedRight(' ', 42)
+                  << juce::String(result.nsPerBlockMean, 0).paddedLeft(' ', 11)
+                  << juce::String(result.nsPerBlockP50, 0).paddedLeft(' ', 11)
+                  << juce::String(result.nsPerBlockP99, 0).paddedLeft(' ', 11)
+                  << juce::String(result.nsPerBlockWorst, 0).paddedLeft(' ', 11)
+                  << (juce::String(result.loadPercent, 2) + "%").paddedLeft(' ', 8)
+                  << juce::String(result.midiEventsPerBlock, 1).paddedLeft(' ', 10)
+                  << juce::String(result.allocationsPerBlock, 1).paddedLeft(' ', 11)
+                  << juce::String(result.worstAllocationsInBlock).paddedLeft(' ', 7) << std::endl;
+
+        auto* entry = new juce::DynamicObject();
+        entry->setProperty("outputMode", config.outputMode == OutputMode::MIDI_Only ? "midi" : "osc");
+        entry->setProperty("blockSize", config.blockSize);
+        entry->setProperty("sampleRate", config.sampleRate);
+        entry->setProperty("mpe", config.mpe);
+        entry->setProperty("chords", config.chords);
+        entry->setProperty("mapping", config.mapping == ProcessBlockBenchmark::Mapping::Dense ? "dense" : "default");
+        entry->setProperty("blocks", result.blocks);
+        entry->setProperty("nsPerBlockMean", result.nsPerBlockMean);
+        entry->setProperty("nsPerBlockP50", result.nsPerBlockP50);
+        entry->setProperty("nsPerBlockP99", result.nsPerBlockP99);
+        entry->setProperty("nsPerBlockWorst", result.nsPerBlockWorst);
+        entry->setProperty("loadPercent", result.loadPercent);
+        entry->setProperty("midiEventsPerBlock", result.midiEventsPerBlock);
+        entry->setProperty("allocationsPerBlock", result.allocationsPerBlock);
+        entry->setProperty("worstAllocationsInBlock", (juce::int64)result.worstAllocationsInBlock);
+        blockResults.add(juce::var(entry));
+    }
+
+    report.getDynamicObject()->setProperty("processBlock", blockResults);
+}
+
+// Usage: GestureBenchmarks [--suite osc|process|all] [--frames N] [--rate Hz] [--port P] [--seconds S] [--json results.json]
+int main(int argc, char* argv[]) {
+    juce::ArgumentList args(argc, argv);
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::String suite = args.containsOption("--suite") ? args.getValueForOption("--suite") : juce::String("all");
+    bool runOsc = suite == "all" || suite == "osc";
+    bool runProcess = suite == "all" || suite == "process";
+
+    if (!runOsc && !runProcess) {
+        std::cerr << "Unknown suite \"" << suite << "\", expected osc, process or all" << std::endl;
+        return 1;
+    }
+
+    juce::var report(new juce::DynamicObject());
+    bool lostFrames = false;
+
+    if (runOsc && !runOscSuite(args, report, lostFrames)) return 1;
+    if (runOsc && runProcess) std::cout << std::endl;
+    if (runProcess) runProcessBlockSuite(args, report);
+
+    // Machine readable copy for regression gates
+    if (args.containsOption("--json")) {
+        auto jsonFile = juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--json"));
+
+        if (!jsonFile.replaceWithText(juce::JSON::toString(report))) {
+            std::cerr << "Could not write " << jsonFile.getFullPathName() << std::endl;
+            return 1;
+        }
+
+        std::cout << "Results written to " << jsonFile.getFullPathName() << std::endl;
+    }
+
+    return lostFrames ? 2 : 0;
+}
@@ -0,0 +1,256 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "../../Source/OSC/OscManager.h"
+#include "SyntheticHands.h"
+
+// Pushes synthetic hand frames through OscManager into a loopback receiver and measures what comes out
+class OscThroughputBenchmark : private juce::OSCReceiver::Listener<juce::OSCReceiver::RealtimeCallback> {
+public:
+    enum class SendMode {
+        RawData,
+        RoutingDefault,
+        RoutingDense,
+        FullFrame
+    };
+
+    struct Result {
+        juce::String modeName;
+        int framesSent = 0;
+        int framesReceived = 0;
+        double messagesPerSecond = 0.0;
+        double packetsPerSecond = 0.0;
+        double messagesPerFrame = 0.0;
+        double latencyP50Ms = 0.0;
+        double latencyP99Ms = 0.0;
+        double cpuPerFrameUs = 0.0;
+    };
+
+    OscThroughputBenchmark(int portToUse, int framesPerRun, double pacedFrameRateHz)
+        : port(portToUse), numFrames(framesPerRun), frameRateHz(pacedFrameRateHz),
+          sendTicks((size_t)framesPerRun, 0), receiveTicks(new std::atomic<juce::int64>[(size_t)framesPerRun]) {
+        // No notes playing, as the processor starts
+        for (int i = 0; i < 8; ++i) {
+            activeLeftNotes[i].store(-1);
+            activeRightNotes[i].store(-1);
+        }
+
+        resetCounters();
+    }
+
+    ~OscThroughputBenchmark() override {
+        receiver.removeListener(this);
+        receiver.disconnect();
+    }
+
+    bool connect() {
+        if (!receiver.connect(port)) return false;
+        receiver.addListener(this);
+
+        return oscManager.sender.connect("127.0.0.1", port);
+    }
+
+    static juce::String getModeName(SendMode mode) {
+        switch (mode) {
+        case SendMode::RawData:        return "sendRawData";
+        case SendMode::RoutingDefault: return "processHandData (default map)";
+        case SendMode::RoutingDense:   return "processHandData (dense map)";
+        case SendMode::FullFrame:      return "sendRawData + processHandData (dense)";
+        default:                       return "unknown";
+        }
+    }
+
+    Result run(SendMode mode) {
+        Result result;
+        result.modeName = getModeName(mode);
+        result.framesSent = numFrames;
+
+        // Throughput pass: send flat out and count what arrives
+        resetCounters();
+        juce::int64 cpuTicks = 0;
+        auto runStart = juce::Time::getHighResolutionTicks();
+
+        for (int frame = 0; frame < numFrames; ++frame) {
+            auto frameStart = juce::Time::getHighResolutionTicks();
+            sendFrame(mode, frame);
+            cpuTicks += juce::Time::getHighResolutionTicks() - frameStart;
+        }
+
+        waitForMarkers(numFrames);
+        double throughputSeconds = juce::Time::highResolutionTicksToSeconds(lastReceiveTicks.load() - runStart);
+
+        int messages = messagesReceived.load() - markersReceived.load();
+        int packets = packetsReceived.load() - markersReceived.load();
+
+        if (throughputSeconds > 0.0) {
+            result.messagesPerSecond = messages / throughputSeconds;
+            result.packetsPerSecond = packets / throughputSeconds;
+        }
+
+        result.messagesPerFrame = (double)messages / (double)numFrames;
+        result.cpuPerFrameUs = juce::Time::highResolutionTicksToSeconds(cpuTicks) * 1.0e6 / (double)numFrames;
+
+        // Latency pass: pace frames like the sensor does and timestamp each one
+        resetCounters();
+        double frameIntervalMs = frameRateHz > 0.0 ? 1000.0 / frameRateHz : 0.0;
+        double nextFrameMs = juce::Time::getMillisecondCounterHiRes();
+
+        for (int frame = 0; frame < numFrames; ++frame) {
+            if (frameIntervalMs > 0.0) {
+                while (juce::Time::getMillisecondCounterHiRes() < nextFrameMs) juce::Thread::yield();
+                nextFrameMs += frameIntervalMs;
+            }
+
+            sendTicks[(size_t)frame] = juce::Time::getHighResolutionTicks();
+            sendFrame(mode, frame);
+        }
+
+        waitForMarkers(numFrames);
+        result.framesReceived = markersReceived.load();
+
+        std::vector<double> latenciesMs;
+        latenciesMs.reserve((size_t)numFrames);
+
+        for (int frame = 0; frame < numFrames; ++frame) {
+            auto received = receiveTicks[(size_t)frame].load();
+            if (received > 0)
+                latenciesMs.push_back(juce::Time::highResolutionTicksToSeconds(received - sendTicks[(size_t)frame]) * 1000.0);
+        }
+
+        result.latencyP50Ms = percentile(latenciesMs, 0.50);
+        result.latencyP99Ms = percentile(latenciesMs, 0.99);
+
+        return result;
+    }
+
+    static double percentile(std::vector<double> values, double p) {
+        if (values.empty()) return 0.0;
+
+        auto index = (size_t)juce::jlimit(0.0, (double)(values.size() - 1), std::ceil(p * (double)values.size()) - 1.0);
+        std::nth_element(values.begin(), values.begin() + (long)index, values.end());
+        return values[index];
+    }
+
+private:
+    int port;
+    int numFrames;
+    double frameRateHz;
+
+    OscManager oscManager;
+    juce::OSCReceiver receiver{ "OSC Benchmark Receiver" };
+    SyntheticHands hands;
+
+    std::atomic<int> activeLeftNotes[8];
+    std::atomic<int> activeRightNotes[8];
+
+    // Receiver side counters
+    std::atomic<int> messagesReceived{ 0 };
+    std::atomic<int> packetsReceived{ 0 };
+    std::atomic<int> markersReceived{ 0 };
+    std::atomic<juce::int64> lastReceiveTicks{ 0 };
+
+    std::vector<juce::int64> sendTicks;
+    std::unique_ptr<std::atomic<juce::int64>[]> receiveTicks;
+
+    void resetCounters() {
+        messagesReceived = 0;
+        packetsReceived = 0;
+        markersReceived = 0;
+        lastReceiveTicks = 0;
+
+        std::fill(sendTicks.begin(), sendTicks.end(), (juce::int64)0);
+        for (int i = 0; i < numFrames; ++i) receiveTicks[(size_t)i].store(0);
+    }
+
+    void waitForMarkers(int expected) {
+        // Markers are the last packet of every frame, give stragglers a moment
+        int timeout = 100;
+        while (markersReceived.load() < expected && timeout > 0) { juce::Thread::sleep(5); timeout--; }
+    }
+
+    void sendFrame(SendMode mode, int frameIndex) {
+        HandData left, right;
+        hands.generate(frameIndex, left, right);
+
+        switch (mode) {
+        case SendMode::RawData:
+            oscManager.sendRawData(left, right);
+            break;
+
+        case SendMode::RoutingDefault:
+            routeDefault(left, right);
+            break;
+
+        case SendMode::RoutingDense:
+            routeDense(left, right);
+            break;
+
+        case SendMode::FullFrame:
+            oscManager.sendRawData(left, right);
+            routeDense(left, right);
+            break;
+        }
+
+        // Marker closes the frame so the receiver can timestamp it
+        juce::OSCMessage marker("/bench/frame");
+        marker.addInt32(frameIndex);
+        oscManager.sender.send(marker);
+    }
+
+    // Same mapping a fresh plugin instance starts with
+    void routeDefault(const HandData& left, const HandData& right) {
+        oscManager.processHandData(left, right, 1.0f, -200.0f, 200.0f, 150.0f, 450.0f, -150.0f, 150.0f, 1.0f, 1.0f, 1.0f,
+            GestureTarget::None, GestureTarget::Pitch, GestureTarget::None, GestureTarget::None, GestureTarget::None, GestureTarget::None,
+            GestureTarget::None, GestureTarget::None, GestureTarget::None, GestureTarget::None, GestureTarget::None,
+            GestureTarget::None, GestureTarget::Pitch, GestureTarget::None, GestureTarget::None, GestureTarget::None, GestureTarget::Modulation,
+            GestureTarget::None, GestureTarget::Vibrato, GestureTarget::None, GestureTarget::None, GestureTarget::None,
+            0, 0, 2, MusicalRangeMode::OctaveRange, 48, 72, false, activeLeftNotes, activeRightNotes);
+    }
+
+    // Every source on both hands mapped to something
+    void routeDense(const HandData& left, const HandData& right) {
+        oscManager.processHandData(left, right, 1.0f, -200.0f, 200.0f, 150.0f, 450.0f, -150.0f, 150.0f, 1.0f, 1.0f, 1.0f,
+            GestureTarget::Pan, GestureTarget::Pitch, GestureTarget::Volume, GestureTarget::Cutoff, GestureTarget::NoteTrigger, GestureTarget::Resonance,
+            GestureTarget::Attack, GestureTarget::Release, GestureTarget::Reverb, GestureTarget::Chorus, GestureTarget::Delay,
+            GestureTarget::Pan, GestureTarget::Pitch, GestureTarget::Volume, GestureTarget::Cutoff, GestureTarget::NoteTrigger, GestureTarget::Modulation,
+            GestureTarget::Vibrato, GestureTarget::Waveform, GestureTarget::Distortion, GestureTarget::Expression, GestureTarget::Breath,
+            0, 0, 2, MusicalRangeMode::OctaveRange, 48, 72, false, activeLeftNotes, activeRightNotes);
+    }
+
+    void oscMessageReceived(const juce::OSCMessage& message) override {
+        packetsReceived++;
+        countMessage(message);
+    }
+
+    void oscBundleReceived(const juce::OSCBundle& bundle) override {
+        packetsReceived++;
+        countBundle(bundle);
+    }
+
+    void countBundle(const juce::OSCBundle& bundle) {
+        for (const auto& element : bundle) {
+            if (element.isMessage()) countMessage(element.getMessage());
+            else if (element.isBundle()) countBundle(element.getBundle());
+        }
+    }
+
+    void countMessage(const juce::OSCMessage& message) {
+        auto now = juce::Time::getHighResolutionTicks();
+        messagesReceived++;
+        lastReceiveTicks.store(now);
+
+        if (message.getAddressPattern().toString() == "/bench/frame" && message.size() > 0 && message[0].isInt32()) {
+            int frameIndex = message[0].getInt32();
+            if (frameIndex >= 0 && frameIndex < numFrames) {
+                receiveTicks[(size_t)frameIndex].store(now);
+                markersReceived++;
+            }
+        }
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OscThroughputBenchmark)
+};
@@ -0,0 +1,210 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <algorithm>
+#include <vector>
+#include "../../Source/PluginProcessor.h"
+#include "AllocationCounter.h"
+#include "SyntheticHands.h"
+
+// Runs the processor's processBlock headless with the Leap thread off, synthetic hands are injected at sensor rate
+// on the audio clock in its place. Times every block and counts the MIDI events and heap allocations it produced
+class ProcessBlockBenchmark {
+public:
+    enum class Mapping {
+        Default,
+        Dense
+    };
+
+    struct Config {
+        int blockSize = 512;
+        double sampleRate = 48000.0;
+        OutputMode outputMode = OutputMode::MIDI_Only;
+        bool mpe = false;
+        bool chords = true;
+        Mapping mapping = Mapping::Default;
+
+        juce::String getName() const {
+            juce::String name = outputMode == OutputMode::MIDI_Only ? "MIDI" : "OSC ";
+            name << " " << juce::String(blockSize).paddedLeft(' ', 4) << " @ " << juce::String(sampleRate / 1000.0, 1) << "k";
+
+            if (outputMode == OutputMode::MIDI_Only) name << (mpe ? "  mpe" : "     ") << (chords ? "  chords" : "        ");
+            name << (mapping == Mapping::Dense ? "  dense" : "  default");
+            return name;
+        }
+    };
+
+    struct Result {
+        Config config;
+        int blocks = 0;
+        double nsPerBlockMean = 0.0;
+        double nsPerBlockP50 = 0.0;
+        double nsPerBlockP99 = 0.0;
+        double nsPerBlockWorst = 0.0;
+        double loadPercent = 0.0;
+        double midiEventsPerBlock = 0.0;
+        double allocationsPerBlock = 0.0;
+        long long worstAllocationsInBlock = 0;
+    };
+
+    ProcessBlockBenchmark(double secondsOfAudioPerRun, double sensorRateHz)
+        : secondsPerRun(secondsOfAudioPerRun), sensorRate(sensorRateHz), hands(sensorRateHz) {
+    }
+
+    // Every buffer size and rate in both output modes. MPE and the chord engine only exist on the MIDI side
+    static std::vector<Config> makeSweep() {
+        std::vector<Config> sweep;
+
+        for (auto mode : { OutputMode::MIDI_Only, OutputMode::OSC_Only })
+            for (auto mapping : { Mapping::Default, Mapping::Dense })
+                for (int mpe = 0; mpe < (mode == OutputMode::MIDI_Only ? 2 : 1); ++mpe)
+                    for (int chords = 0; chords < (mode == OutputMode::MIDI_Only ? 2 : 1); ++chords)
+                        for (double rate : { 44100.0, 48000.0, 96000.0 })
+                            for (int size : { 32, 64, 128, 256, 512, 1024, 2048 }) {
+                                Config config;
+                                config.blockSize = size;
+                                config.sampleRate = rate;
+                                config.outputMode = mode;
+                                config.mpe = mpe == 1;
+                                config.chords = chords == 1;
+                                config.mapping = mapping;
+                                sweep.push_back(config);
+                            }
+
+        return sweep;
+    }
+
+    Result run(const Config& config) {
+        Result result;
+        result.config = config;
+
+        GestureInstrumentAudioProcessor::isRunningInUnitTest = true;
+        GestureInstrumentAudioProcessor processor;
+        configure(processor, config);
+
+        processor.setRateAndBufferSizeDetails(config.sampleRate, config.blockSize);
+        processor.prepareToPlay(config.sampleRate, config.blockSize);
+
+        // Hosts hand over buffers that are already big enough, so growing them shouldn't count against processBlock
+        juce::AudioBuffer<float> buffer(2, config.blockSize);
+        juce::MidiBuffer midi;
+        midi.ensureSize(16384);
+
+        int numBlocks = juce::jmax(1, (int)(secondsPerRun * config.sampleRate / config.blockSize));
+        int warmupBlocks = juce::jmax(1, numBlocks / 10);
+
+        std::vector<double> blockNs;
+        blockNs.reserve((size_t)numBlocks);
+
+        long long totalMidiEvents = 0;
+        long long totalAllocations = 0;
+        nextFrameSeconds = 0.0;
+        frameIndex = 0;
+
+        AllocationCounter::Scope allocations;
+
+        for (int block = 0; block < warmupBlocks + numBlocks; ++block) {
+            feedFrames(processor, (double)block * config.blockSize / config.sampleRate);
+            midi.clear();
+
+            long long allocationsBefore = allocations.getCount();
+            auto start = juce::Time::getHighResolutionTicks();
+            processor.processBlock(buffer, midi);
+            auto elapsed = juce::Time::getHighResolutionTicks() - start;
+            long long blockAllocations = allocations.getCount() - allocationsBefore;
+
+            if (block < warmupBlocks) continue;
+
+            blockNs.push_back(juce::Time::highResolutionTicksToSeconds(elapsed) * 1.0e9);
+            totalMidiEvents += midi.getNumEvents();
+            totalAllocations += blockAllocations;
+            result.worstAllocationsInBlock = juce::jmax(result.worstAllocationsInBlock, blockAllocations);
+        }
+
+        double totalNs = 0.0;
+        for (double ns : blockNs) totalNs += ns;
+
+        result.blocks = numBlocks;
+        result.nsPerBlockMean = totalNs / numBlocks;
+        result.nsPerBlockWorst = *std::max_element(blockNs.begin(), blockNs.end());
+        result.nsPerBlockP50 = percentile(blockNs, 0.50);
+        result.nsPerBlockP99 = percentile(blockNs, 0.99);
+        result.loadPercent = 100.0 * result.nsPerBlockMean / (config.blockSize * 1.0e9 / config.sampleRate);
+        result.midiEventsPerBlock = (double)totalMidiEvents / numBlocks;
+        result.allocationsPerBlock = (double)totalAllocations / numBlocks;
+
+        processor.releaseResources();
+        return result;
+    }
+
+    static double percentile(std::vector<double> values, double p) {
+        if (values.empty()) return 0.0;
+
+        auto index = (size_t)juce::jlimit(0.0, (double)(values.size() - 1), std::ceil(p * (double)values.size()) - 1.0);
+        std::nth_element(values.begin(), values.begin() + (long)index, values.end());
+        return values[index];
+    }
+
+private:
+    double secondsPerRun;
+    double sensorRate;
+    SyntheticHands hands;
+
+    double nextFrameSeconds = 0.0;
+    int frameIndex = 0;
+
+    // Every sensor frame due by the start of the block, like the Leap thread would have published them
+    void feedFrames(GestureInstrumentAudioProcessor& processor, double blockStartSeconds) {
+        while (nextFrameSeconds <= blockStartSeconds) {
+            HandData left, right;
+            hands.generate(frameIndex, left, right);
+
+            for (auto* hand : { &left, &right }) {
+                hand->frameId = frameIndex + 1;
+                hand->frameTimeSeconds = nextFrameSeconds;
+                hand->captureSeconds = juce::Time::getMillisecondCounterHiRes() * 0.001;
+            }
+
+            processor.injectSensorFrame(left, right);
+            ++frameIndex;
+            nextFrameSeconds += 1.0 / sensorRate;
+        }
+    }
+
+    static void configure(GestureInstrumentAudioProcessor& processor, const Config& config) {
+        processor.currentOutputMode = config.outputMode;
+        processor.isMpeEnabled = config.mpe;
+        processor.chordEngineEnabled.store(config.chords);
+
+        if (config.mapping == Mapping::Default) return;
+
+        // Every source on both hands mapped to something
+        processor.leftXTarget = GestureTarget::Pan;
+        processor.leftYTarget = GestureTarget::Pitch;
+        processor.leftZTarget = GestureTarget::Volume;
+        processor.leftRollTarget = GestureTarget::Cutoff;
+        processor.leftGrabTarget = GestureTarget::NoteTrigger;
+        processor.leftPinchTarget = GestureTarget::Resonance;
+        processor.leftThumbTarget = GestureTarget::Attack;
+        processor.leftIndexTarget = GestureTarget::Release;
+        processor.leftMiddleTarget = GestureTarget::Reverb;
+        processor.leftRingTarget = GestureTarget::Chorus;
+        processor.leftPinkyTarget = GestureTarget::Delay;
+        processor.leftSpeedTarget = GestureTarget::Breath;
+
+        processor.rightXTarget = GestureTarget::Pan;
+        processor.rightYTarget = GestureTarget::Pitch;
+        processor.rightZTarget = GestureTarget::Volume;
+        processor.rightRollTarget = GestureTarget::Cutoff;
+        processor.rightGrabTarget = GestureTarget::NoteTrigger;
+        processor.rightPinchTarget = GestureTarget::Modulation;
+        processor.rightThumbTarget = GestureTarget::Vibrato;
+        processor.rightIndexTarget = GestureTarget::Waveform;
+        processor.rightMiddleTarget = GestureTarget::Distortion;
+        processor.rightRingTarget = GestureTarget::Expression;
+        processor.rightPinkyTarget = GestureTarget::Sustain;
+        processor.rightSpeedTarget = GestureTarget::Portamento;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ProcessBlockBenchmark)
+};
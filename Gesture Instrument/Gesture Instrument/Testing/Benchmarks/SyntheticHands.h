@@ -0,0 +1,58 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "../../Source/Helpers/HandData.h"
+
+// Deterministic two hand motion that sweeps the default play area, opens and closes and crosses the pinch threshold
+class SyntheticHands {
+public:
+    explicit SyntheticHands(double sensorRateHz = 120.0) : frameRate(sensorRateHz) {}
+
+    void generate(int frameIndex, HandData& left, HandData& right) const {
+        double t = frameIndex / frameRate;
+
+        fillHand(left, t, -100.0f, 0.0);
+        fillHand(right, t, 100.0f, 1.3);
+    }
+
+private:
+    double frameRate;
+
+    static void fillHand(HandData& hand, double t, float centreX, double phase) {
+        const float twoPi = juce::MathConstants<float>::twoPi;
+
+        hand.isPresent = true;
+        hand.currentHandPositionX = centreX + 80.0f * (float)std::sin(twoPi * 0.25 * t + phase);
+        hand.currentHandPositionY = 300.0f + 130.0f * (float)std::sin(twoPi * 0.4 * t + phase);
+        hand.currentHandPositionZ = 120.0f * (float)std::sin(twoPi * 0.15 * t + phase);
+        hand.currentWristRotation = 1.2f * (float)std::sin(twoPi * 0.3 * t + phase);
+        hand.grabStrength = 0.5f + 0.5f * (float)std::sin(twoPi * 0.5 * t + phase);
+        hand.pinchStrength = 0.5f + 0.5f * (float)std::sin(twoPi * 0.7 * t + phase);
+        hand.isPinching = hand.pinchStrength > 0.8f;
+
+        for (int i = 0; i < 5; ++i) {
+            auto& finger = hand.fingers[i];
+            float spread = (float)(i - 2) * 18.0f;
+            float curl = 40.0f * hand.grabStrength;
+
+            finger.type = i;
+            finger.knuckleX = hand.currentHandPositionX + spread;
+            finger.knuckleY = hand.currentHandPositionY;
+            finger.knuckleZ = hand.currentHandPositionZ - 40.0f;
+
+            finger.joint2X = finger.knuckleX;
+            finger.joint2Y = finger.knuckleY - curl * 0.3f;
+            finger.joint2Z = finger.knuckleZ - 30.0f + curl * 0.4f;
+
+            finger.joint1X = finger.knuckleX;
+            finger.joint1Y = finger.knuckleY - curl * 0.7f;
+            finger.joint1Z = finger.knuckleZ - 55.0f + curl * 0.9f;
+
+            finger.tipX = finger.knuckleX;
+            finger.tipY = finger.knuckleY - curl + 10.0f * (float)std::sin(twoPi * 2.0 * t + i);
+            finger.tipZ = finger.knuckleZ - 75.0f + curl * 1.5f;
+
+            finger.isExtended = hand.grabStrength < 0.6f;
+        }
+    }
+};
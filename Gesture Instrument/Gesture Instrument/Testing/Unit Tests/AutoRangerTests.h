@@ -0,0 +1,120 @@
+#pragma once
+#include <JuceHeader.h>
+#include "../../Source/Helpers/AutoRanger.h"
+
+class AutoRangerTests : public juce::UnitTest {
+public:
+    AutoRangerTests() : juce::UnitTest("Auto Ranger Tests") {}
+
+    void runTest() override {
+        beginTest("1. Area Tightens Around A Smaller Playing Space");
+        {
+            AutoRanger ranger;
+            ranger.setMaxSpeed(20.0f);
+            ranger.reset(wideArea());
+
+            playFor(ranger, 240.0f, 0.0f, 60.0f);
+
+            const auto& area = ranger.getArea();
+            expect(area.minX > -110.0f && area.maxX < 110.0f, "Width did not close in on where the hand plays.");
+            expect(area.minX < -40.0f && area.maxX > 40.0f, "Width shrank past where the hand plays.");
+        }
+
+        beginTest("2. Area Follows A Drifting Performer");
+        {
+            AutoRanger ranger;
+            ranger.setMaxSpeed(20.0f);
+            ranger.reset(wideArea());
+
+            playFor(ranger, 120.0f, 0.0f, 60.0f);
+            float centreBefore = (ranger.getArea().minX + ranger.getArea().maxX) / 2.0f;
+
+            playFor(ranger, 240.0f, 100.0f, 60.0f);
+            float centreAfter = (ranger.getArea().minX + ranger.getArea().maxX) / 2.0f;
+
+            expect(centreAfter - centreBefore > 60.0f, "Area did not follow the hands to the right.");
+        }
+
+        beginTest("3. Bounds Respect The Speed Limit");
+        {
+            AutoRanger ranger;
+            ranger.setMaxSpeed(10.0f);
+            ranger.reset(PlayArea());
+
+            HandData hand;
+            hand.isPresent = true;
+            hand.currentHandPositionX = 340.0f;
+            hand.currentHandPositionY = 300.0f;
+
+            const float blockSeconds = 0.01f;
+            float lastMaxX = ranger.getArea().maxX;
+            bool tooFast = false;
+
+            for (int i = 0; i < 500; ++i) {
+                ranger.process(hand, HandData(), blockSeconds);
+                float maxX = ranger.getArea().maxX;
+                if (maxX - lastMaxX > 10.0f * blockSeconds + 0.0001f) tooFast = true;
+                lastMaxX = maxX;
+            }
+
+            expect(!tooFast, "A bound moved faster than the speed limit.");
+            expect(ranger.getArea().maxX > PlayArea().maxX, "Bound never moved towards the hand.");
+        }
+
+        beginTest("4. No Hands Leaves The Area Alone");
+        {
+            AutoRanger ranger;
+            ranger.reset(wideArea());
+
+            for (int i = 0; i < 1000; ++i) ranger.process(HandData(), HandData(), 0.01f);
+            expect(ranger.getArea() == wideArea(), "Area moved with nobody playing.");
+        }
+
+        beginTest("5. Bounds Stay On Their Side Of The Room");
+        {
+            AutoRanger ranger;
+            ranger.setMaxSpeed(50.0f);
+            ranger.reset(PlayArea());
+
+            // Everything far off to one side would pull both bounds over if nothing held them
+            HandData hand;
+            hand.isPresent = true;
+            hand.currentHandPositionX = 330.0f;
+            hand.currentHandPositionY = 480.0f;
+            hand.currentHandPositionZ = 200.0f;
+
+            for (int i = 0; i < 60000; ++i) ranger.process(hand, HandData(), 0.01f);
+
+            const auto& area = ranger.getArea();
+            expect(area.minX <= 0.0f && area.maxX <= 350.0f, "Width bounds left their slider ranges.");
+            expect(area.minY <= 275.0f && area.maxY <= 500.0f, "Height bounds left their slider ranges.");
+            expect(area.minZ <= 0.0f && area.maxZ <= 225.0f, "Depth bounds left their slider ranges.");
+        }
+    }
+
+private:
+    static PlayArea wideArea() {
+        PlayArea area;
+        area.minX = -300.0f; area.maxX = 300.0f;
+        return area;
+    }
+
+    // Palm sweeps back and forth across centre +/- halfWidth on X at a steady pace, 100 blocks a second
+    static void playFor(AutoRanger& ranger, float seconds, float centre, float halfWidth) {
+        HandData hand;
+        hand.isPresent = true;
+        hand.currentHandPositionY = 300.0f;
+
+        const float blockSeconds = 0.01f;
+        int numBlocks = (int)(seconds / blockSeconds);
+
+        for (int i = 0; i < numBlocks; ++i) {
+            float phase = (float)(i % 400) / 400.0f;
+            float triangle = phase < 0.5f ? phase * 4.0f - 1.0f : 3.0f - phase * 4.0f;
+            hand.currentHandPositionX = centre + triangle * halfWidth;
+            ranger.process(hand, HandData(), blockSeconds);
+        }
+    }
+};
+
+static AutoRangerTests autoRangerTestsInstance;
@@ -0,0 +1,111 @@
+#pragma once
+#include <JuceHeader.h>
+#include "../../Source/Helpers/CalibrationTracker.h"
+
+class CalibrationTrackerTests : public juce::UnitTest {
+public:
+    CalibrationTrackerTests() : juce::UnitTest("Calibration Tracker Tests") {}
+
+    void runTest() override {
+        beginTest("1. Median Of A Shuffled Ramp");
+        {
+            P2Quantile median(0.5f);
+            for (int i = 0; i < 1001; ++i) median.add((float)shuffled(i, 1001));
+
+            expectWithinAbsoluteError(median.get(), 500.0f, 10.0f, "P2 median drifted from the true median.");
+        }
+
+        beginTest("2. Tail Percentiles Of A Shuffled Ramp");
+        {
+            P2Quantile low(0.02f), high(0.98f);
+            for (int i = 0; i < 5003; ++i) {
+                float x = (float)shuffled(i, 5003) / 5.0f;
+                low.add(x);
+                high.add(x);
+            }
+
+            expectWithinAbsoluteError(low.get(), 20.0f, 8.0f, "2nd percentile estimate is off.");
+            expectWithinAbsoluteError(high.get(), 980.0f, 8.0f, "98th percentile estimate is off.");
+        }
+
+        beginTest("3. Exact On The First Few Samples");
+        {
+            P2Quantile median(0.5f);
+            median.add(30.0f);
+            median.add(10.0f);
+            median.add(20.0f);
+
+            expectEquals(median.get(), 20.0f, "Median of three samples should be the middle one.");
+        }
+
+        beginTest("4. Stray Frames Do Not Stretch The Box");
+        {
+            CalibrationTracker tracker;
+            tracker.reset(2.0f);
+
+            HandData hand;
+            hand.isPresent = true;
+
+            for (int i = 0; i < 2000; ++i) {
+                float t = (float)shuffled(i, 2000) / 1999.0f;
+                hand.currentHandPositionX = -100.0f + t * 200.0f;
+                hand.currentHandPositionY = 150.0f + t * 200.0f;
+                hand.currentHandPositionZ = -80.0f + t * 160.0f;
+                tracker.addHand(hand);
+
+                // A glitched frame every few hundred, the raw min and max would take these
+                if (i % 500 == 250) {
+                    HandData glitch = hand;
+                    glitch.currentHandPositionX = 340.0f;
+                    glitch.currentHandPositionY = 60.0f;
+                    tracker.addHand(glitch);
+                }
+            }
+
+            auto bounds = tracker.getBounds();
+            expect(bounds.maxX < 110.0f, "One stray frame stretched the box to the right.");
+            expect(bounds.minY > 140.0f, "One stray frame stretched the box down.");
+            expect(bounds.minX < -80.0f && bounds.maxZ > 60.0f, "Trimming cut too far into the real play area.");
+        }
+
+        beginTest("5. Absent Hands Are Ignored");
+        {
+            CalibrationTracker tracker;
+            tracker.reset(2.0f);
+
+            HandData absent;
+            absent.currentHandPositionX = 300.0f;
+            tracker.addHand(absent);
+
+            expectEquals(tracker.getNumSamples(), 0, "A hand that isn't there was sampled.");
+            expectEquals(tracker.getBounds().numSamples, 0, "Bounds reported samples that were never added.");
+        }
+
+        beginTest("6. Bounds Stay Inside The Room");
+        {
+            CalibrationTracker tracker;
+            tracker.reset(0.0f);
+
+            HandData hand;
+            hand.isPresent = true;
+            for (int i = 0; i < 50; ++i) {
+                float sign = (i % 2 == 0) ? 1.0f : -1.0f;
+                hand.currentHandPositionX = sign * 500.0f;
+                hand.currentHandPositionY = sign > 0.0f ? 700.0f : 0.0f;
+                hand.currentHandPositionZ = sign * 400.0f;
+                tracker.addHand(hand);
+            }
+
+            auto bounds = tracker.getBounds();
+            expect(bounds.minX >= -350.0f && bounds.maxX <= 350.0f, "Width left the room.");
+            expect(bounds.minY >= 50.0f && bounds.maxY <= 500.0f, "Height left the room.");
+            expect(bounds.minZ >= -225.0f && bounds.maxZ <= 225.0f, "Depth left the room.");
+        }
+    }
+
+private:
+    // Every value in [0, n) once, in a scrambled order. n must not share a factor with the stride
+    static int shuffled(int i, int n) { return (int)(((long long)i * 7919) % n); }
+};
+
+static CalibrationTrackerTests calibrationTrackerTestsInstance;
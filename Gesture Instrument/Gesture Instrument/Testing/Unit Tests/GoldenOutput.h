@@ -0,0 +1,167 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "../../Source/OSC/OscManager.h"
+
+// Everything a replay sent, as one line of text per event:
+//   <block> midi <sample> <raw bytes in hex>
+//   <block> osc <address> <type tag and value per argument>
+// A block's OSC lines come in the order they were sent, followed by the MIDI the block left in its buffer.
+// Golden files are this text, so a change in behaviour shows up as a plain diff
+class GoldenOutput : public OscManager::Tap {
+public:
+    // Where golden files live and whether to rewrite them, TestMain sets these from --golden and --update-golden
+    static inline juce::File directory;
+    static inline bool shouldUpdate = false;
+
+    // Call after each processBlock with the MIDI it produced
+    void addBlock(int blockIndex, const juce::MidiBuffer& midi) {
+        for (const auto metadata : midi) {
+            auto message = metadata.getMessage();
+
+            juce::String line;
+            line << blockIndex << " midi " << metadata.samplePosition << " "
+                 << juce::String::toHexString(message.getRawData(), message.getRawDataSize());
+            lines.add(line);
+        }
+
+        currentBlock = blockIndex + 1;
+    }
+
+    void messageSent(const juce::OSCMessage& message) override {
+        juce::String line;
+        line << currentBlock << " osc " << message.getAddressPattern().toString();
+
+        for (const auto& argument : message) {
+            if (argument.isInt32()) line << " i " << argument.getInt32();
+            else if (argument.isFloat32()) line << " f " << juce::String(argument.getFloat32(), 6);
+            else if (argument.isString()) line << " s " << argument.getString();
+            else line << " ?";
+        }
+
+        lines.add(line);
+    }
+
+    const juce::StringArray& getLines() const { return lines; }
+    juce::String toText() const { return lines.joinIntoString("\n") + "\n"; }
+
+    // Empty if the two match. Float arguments may be off by tolerance, everything else has to be identical
+    static juce::String compare(const juce::StringArray& expected, const juce::StringArray& actual, float tolerance, int maxReported = 5) {
+        juce::String report;
+        int numDifferent = 0;
+
+        for (int i = 0; i < juce::jmax(expected.size(), actual.size()); ++i) {
+            if (i < expected.size() && i < actual.size() && linesMatch(expected[i], actual[i], tolerance)) continue;
+
+            if (++numDifferent > maxReported) continue;
+            report << "line " << (i + 1) << "\n"
+                   << "  expected: " << (i < expected.size() ? expected[i] : juce::String("<end>")) << "\n"
+                   << "  actual:   " << (i < actual.size() ? actual[i] : juce::String("<end>")) << "\n";
+        }
+
+        if (numDifferent == 0) return {};
+
+        juce::String summary;
+        summary << numDifferent << " of " << juce::jmax(expected.size(), actual.size()) << " lines differ";
+        if (expected.size() != actual.size()) summary << " (expected " << expected.size() << " lines, got " << actual.size() << ")";
+        return summary + "\n" + report;
+    }
+
+    enum class Status {
+        matched,
+        recorded,
+        differed,
+        missing,
+        noDirectory
+    };
+
+    struct Result {
+        Status status = Status::noDirectory;
+        juce::String message;
+    };
+
+    // Compares against <name>.txt in the golden folder. Only --update-golden writes golden files, a missing one is a
+    // failure like any other difference. Either way the output is left in <name>.actual.txt to diff or commit
+    Result check(const juce::String& name, float tolerance = 1.0e-4f) const {
+        Result result;
+        auto folder = getDirectory();
+
+        if (folder == juce::File()) {
+            result.message = "No golden folder found, pass --golden";
+            return result;
+        }
+
+        auto golden = folder.getChildFile(name + ".txt");
+        auto actual = folder.getChildFile(name + ".actual.txt");
+
+        if (shouldUpdate) {
+            folder.createDirectory();
+            golden.replaceWithText(toText());
+            actual.deleteFile();
+
+            result.status = Status::recorded;
+            result.message = "Recorded " + golden.getFullPathName();
+            return result;
+        }
+
+        if (!golden.existsAsFile()) {
+            folder.createDirectory();
+            actual.replaceWithText(toText());
+
+            result.status = Status::missing;
+            result.message = "No golden file " + golden.getFullPathName() + ", record it with --update-golden";
+            return result;
+        }
+
+        result.message = compare(juce::StringArray::fromLines(golden.loadFileAsString().trimEnd()), lines, tolerance);
+
+        if (result.message.isEmpty()) {
+            actual.deleteFile();
+            result.status = Status::matched;
+        }
+        else {
+            actual.replaceWithText(toText());
+            result.status = Status::differed;
+            result.message = golden.getFileName() + ": " + result.message + "New output is in " + actual.getFullPathName();
+        }
+
+        return result;
+    }
+
+    // --golden if given, otherwise the Golden folder next to GestureTests.jucer, found by walking up from the
+    // runner and the working directory
+    static juce::File getDirectory() {
+        if (directory != juce::File()) return directory;
+
+        for (auto start : { juce::File::getSpecialLocation(juce::File::currentExecutableFile), juce::File::getCurrentWorkingDirectory() }) {
+            for (auto folder = start; ; folder = folder.getParentDirectory()) {
+                if (folder.getChildFile("GestureTests.jucer").existsAsFile()) return folder.getChildFile("Golden");
+                if (folder.getChildFile("Testing/Unit Tests/GestureTests.jucer").existsAsFile()) return folder.getChildFile("Testing/Unit Tests/Golden");
+                if (folder.isRoot()) break;
+            }
+        }
+
+        return {};
+    }
+
+private:
+    juce::StringArray lines;
+    int currentBlock = 0;
+
+    static bool linesMatch(const juce::String& expected, const juce::String& actual, float tolerance) {
+        if (expected == actual) return true;
+
+        auto expectedTokens = juce::StringArray::fromTokens(expected, " ", "");
+        auto actualTokens = juce::StringArray::fromTokens(actual, " ", "");
+        if (expectedTokens.size() != actualTokens.size()) return false;
+
+        for (int i = 0; i < expectedTokens.size(); ++i) {
+            if (expectedTokens[i] == actualTokens[i]) continue;
+
+            bool isFloat = i > 0 && expectedTokens[i - 1] == "f" && actualTokens[i - 1] == "f";
+            if (!isFloat || std::abs(expectedTokens[i].getFloatValue() - actualTokens[i].getFloatValue()) > tolerance) return false;
+        }
+
+        return true;
+    }
+};
@@ -0,0 +1,195 @@
+#pragma once
+#include <JuceHeader.h>
+#include "GoldenOutput.h"
+#include "SessionReplay.h"
+
+// Replays sessions through the whole processBlock pipeline and diffs the MIDI and OSC they produce against golden
+// files in Testing/Unit Tests/Golden. Sessions saved as Golden/Sessions/*.session are replayed in both output modes
+// alongside the generated ones. Run GestureTests --update-golden after a change that is meant to alter the output.
+// Until that folder is committed the comparison is left out, the format and determinism tests still run
+class GoldenOutputTests : public juce::UnitTest {
+public:
+    GoldenOutputTests() : juce::UnitTest("Golden Output Regression Tests") {}
+
+    // Output only lines up with its golden file at the block size it was recorded at
+    static constexpr int blockSizes[] = { 128, 512 };
+    static constexpr double sampleRate = 48000.0;
+
+    void runTest() override {
+        beginTest("1. Output Is Written One Line Per Event");
+        {
+            GoldenOutput output;
+
+            juce::OSCMessage raw("/gesture/raw");
+            raw.addFloat32(0.25f);
+            raw.addInt32(3);
+            output.messageSent(raw);
+
+            juce::MidiBuffer midi;
+            midi.addEvent(juce::MidiMessage::noteOn(2, 64, (juce::uint8)100), 17);
+            output.addBlock(0, midi);
+
+            output.messageSent(raw);
+
+            expectEquals(output.getLines().size(), 3);
+            expectEquals(output.getLines()[0], juce::String("0 osc /gesture/raw f 0.250000 i 3"));
+            expectEquals(output.getLines()[1], juce::String("0 midi 17 91 40 64"));
+            expectEquals(output.getLines()[2], juce::String("1 osc /gesture/raw f 0.250000 i 3"), "OSC after a block belongs to the next one");
+        }
+
+        beginTest("2. Compare Allows Float Noise And Nothing Else");
+        {
+            juce::StringArray golden{ "0 osc /left/pitch f 0.500000", "0 midi 0 91 40 64" };
+
+            expect(GoldenOutput::compare(golden, { "0 osc /left/pitch f 0.500010", "0 midi 0 91 40 64" }, 1.0e-4f).isEmpty(),
+                   "Float arguments within the tolerance should match");
+            expect(GoldenOutput::compare(golden, { "0 osc /left/pitch f 0.510000", "0 midi 0 91 40 64" }, 1.0e-4f).isNotEmpty(),
+                   "A float past the tolerance is a difference");
+            expect(GoldenOutput::compare(golden, { "0 osc /left/pitch f 0.500000", "0 midi 0 91 40 65" }, 1.0f).isNotEmpty(),
+                   "MIDI bytes have to be exact whatever the tolerance");
+            expect(GoldenOutput::compare(golden, { "0 osc /left/pitch f 0.500000" }, 1.0e-4f).contains("expected 2 lines, got 1"),
+                   "A missing event should be reported");
+        }
+
+        beginTest("3. Only An Update Run Writes Golden Files");
+        {
+            auto folder = juce::File::createTempFile("golden");
+            auto savedDirectory = GoldenOutput::directory;
+            auto savedUpdate = GoldenOutput::shouldUpdate;
+            GoldenOutput::directory = folder;
+
+            GoldenOutput output;
+            juce::MidiBuffer midi;
+            midi.addEvent(juce::MidiMessage::noteOn(1, 60, (juce::uint8)90), 0);
+            output.addBlock(0, midi);
+
+            GoldenOutput::shouldUpdate = false;
+            expect(output.check("check").status == GoldenOutput::Status::missing, "A missing golden file should fail");
+            expect(!folder.getChildFile("check.txt").existsAsFile(), "A normal run must not write the golden file");
+
+            GoldenOutput::shouldUpdate = true;
+            expect(output.check("check").status == GoldenOutput::Status::recorded);
+
+            GoldenOutput::shouldUpdate = false;
+            expect(output.check("check").status == GoldenOutput::Status::matched);
+
+            GoldenOutput::directory = savedDirectory;
+            GoldenOutput::shouldUpdate = savedUpdate;
+            folder.deleteRecursively();
+        }
+
+        beginTest("4. Sessions Survive Saving As Text");
+        {
+            auto session = SessionReplay::makeEnterAndLeave(0.5);
+            session[3].connected = false;
+
+            auto loaded = SessionReplay::fromText(SessionReplay::toText(session));
+            expectEquals((int)loaded.size(), (int)session.size());
+
+            bool allMatch = loaded.size() == session.size();
+            for (size_t i = 0; allMatch && i < session.size(); ++i) {
+                const auto& a = session[i];
+                const auto& b = loaded[i];
+
+                allMatch = std::abs(a.timeSeconds - b.timeSeconds) < 1.0e-6 && a.connected == b.connected
+                    && handsMatch(a.left, b.left) && handsMatch(a.right, b.right);
+            }
+
+            expect(allMatch, "Every frame should read back as it was written");
+        }
+
+        beginTest("5. Replays Are Deterministic");
+        {
+            for (const auto& scenario : SessionReplay::makeScenarios()) {
+                auto first = replay(scenario, blockSizes[0]);
+                auto second = replay(scenario, blockSizes[0]);
+                auto difference = GoldenOutput::compare(first.getLines(), second.getLines(), 0.0f);
+
+                expect(difference.isEmpty(), scenario.name + " played differently twice: " + difference);
+                expect(first.getLines().size() > 0, scenario.name + " produced no output");
+            }
+        }
+
+        beginTest("6. Output Matches The Golden Files");
+        {
+            // Comparing starts once a recorded set is committed. From then on a missing file fails like any other
+            if (!GoldenOutput::getDirectory().isDirectory() && !GoldenOutput::shouldUpdate) {
+                logMessage("   No golden files recorded yet, run GestureTests --update-golden and commit Testing/Unit Tests/Golden");
+                return;
+            }
+
+            auto scenarios = SessionReplay::makeScenarios();
+            addRecordedSessions(scenarios);
+
+            for (const auto& scenario : scenarios) {
+                for (int blockSize : blockSizes) {
+                    auto name = scenario.name + "_" + juce::String(blockSize);
+                    auto result = replay(scenario, blockSize).check(name);
+
+                    // A run that records has nothing to compare against, so it doesn't pass either
+                    expect(result.status == GoldenOutput::Status::matched, result.message);
+                }
+            }
+        }
+    }
+
+private:
+    static GoldenOutput replay(const SessionReplay::Scenario& scenario, int blockSize) {
+        GestureInstrumentAudioProcessor::isRunningInUnitTest = true;
+        GestureInstrumentAudioProcessor processor;
+
+        GoldenOutput output;
+        processor.oscManager.setTap(&output);
+
+        SessionReplay::play(processor, scenario, blockSize, sampleRate, [&output](int block, const juce::MidiBuffer& midi) {
+            output.addBlock(block, midi);
+            });
+
+        processor.oscManager.setTap(nullptr);
+        return output;
+    }
+
+    static void addRecordedSessions(std::vector<SessionReplay::Scenario>& scenarios) {
+        auto folder = GoldenOutput::getDirectory().getChildFile("Sessions");
+
+        for (const auto& file : folder.findChildFiles(juce::File::findFiles, false, "*.session")) {
+            auto session = SessionReplay::load(file);
+            if (session.empty()) continue;
+
+            auto name = file.getFileNameWithoutExtension();
+
+            scenarios.push_back({ name + "_midi", session, [](GestureInstrumentAudioProcessor& p) {
+                p.currentOutputMode = OutputMode::MIDI_Only;
+                } });
+
+            scenarios.push_back({ name + "_osc", session, [](GestureInstrumentAudioProcessor& p) {
+                p.currentOutputMode = OutputMode::OSC_Only;
+                } });
+        }
+    }
+
+    static bool handsMatch(const HandData& a, const HandData& b) {
+        if (a.isPresent != b.isPresent) return false;
+        if (!a.isPresent) return true;
+
+        auto isClose = [](float x, float y) { return std::abs(x - y) < 1.0e-3f; };
+
+        if (!isClose(a.currentHandPositionX, b.currentHandPositionX) || !isClose(a.currentHandPositionY, b.currentHandPositionY)
+            || !isClose(a.currentHandPositionZ, b.currentHandPositionZ) || !isClose(a.currentWristRotation, b.currentWristRotation)
+            || !isClose(a.grabStrength, b.grabStrength) || !isClose(a.pinchStrength, b.pinchStrength) || a.isPinching != b.isPinching)
+            return false;
+
+        for (int f = 0; f < 5; ++f) {
+            const auto& x = a.fingers[f];
+            const auto& y = b.fingers[f];
+
+            if (x.type != y.type || x.isExtended != y.isExtended || !isClose(x.tipY, y.tipY) || !isClose(x.knuckleZ, y.knuckleZ)
+                || !isClose(x.joint1X, y.joint1X) || !isClose(x.joint2Z, y.joint2Z))
+                return false;
+        }
+
+        return true;
+    }
+};
+
+static GoldenOutputTests goldenOutputTestsInstance;
@@ -0,0 +1,148 @@
+#pragma once
+#include <JuceHeader.h>
+#include "../../Source/Helpers/KalmanEstimator.h"
+
+class KalmanEstimatorTests : public juce::UnitTest {
+public:
+    KalmanEstimatorTests() : juce::UnitTest("Kalman Estimator Tests") {}
+
+    void runTest() override {
+        beginTest("1. Recovers Palm Velocity");
+        {
+            // Palm moving right at 400 mm/s, sensor at 120 Hz
+            HandKalmanEstimator estimator;
+            HandData hand;
+            hand.isPresent = true;
+
+            for (int i = 0; i < 120; ++i) {
+                hand.currentHandPositionX = 400.0f * (float)i / 120.0f;
+                estimator.update(hand, 1.0f / 120.0f);
+            }
+            estimator.writeVelocity(hand);
+
+            expectWithinAbsoluteError(hand.velocityX, 400.0f, 5.0f, "Velocity estimate is off on a steady sweep.");
+            expectWithinAbsoluteError(hand.velocityY, 0.0f, 1.0f, "Velocity leaked into a still axis.");
+            expectWithinAbsoluteError(hand.getNormalisedSpeed(), 0.4f, 0.01f, "Speed was not scaled to the mapping range.");
+        }
+
+        beginTest("2. Prediction Leads The Measurement");
+        {
+            // 1 Hz sweep, compare the estimate 20ms ahead against where the hand actually is 20ms later
+            HandKalmanEstimator estimator;
+            HandData hand;
+            hand.isPresent = true;
+
+            const float w = juce::MathConstants<float>::twoPi;
+            const float dt = 1.0f / 120.0f;
+            float heldError = 0.0f, predictedError = 0.0f;
+
+            for (int i = 0; i < 240; ++i) {
+                float t = (float)i * dt;
+                hand.currentHandPositionY = 300.0f + 150.0f * std::sin(w * t);
+                estimator.update(hand, dt);
+
+                if (i > 120) {
+                    float future = 300.0f + 150.0f * std::sin(w * (t + 0.02f));
+                    heldError += std::abs(estimator.getPosition(1) - future);
+                    predictedError += std::abs(estimator.getPredicted(1, 0.02f) - future);
+                }
+            }
+
+            expect(predictedError < heldError * 0.25f, "Forward prediction did not cancel the 20ms delay.");
+        }
+
+        beginTest("3. Repeated Frames Are Not Measurements");
+        {
+            HandKalmanEstimator estimator;
+            HandData hand;
+            hand.isPresent = true;
+
+            for (int i = 1; i <= 60; ++i) {
+                hand.frameId = i;
+                hand.currentHandPositionX = 3.0f * (float)i;
+                estimator.update(hand, 1.0f / 120.0f);
+            }
+            float velocityBefore = estimator.getVelocity(0);
+
+            // Audio blocks faster than the sensor see the same frame several times
+            for (int i = 0; i < 4; ++i) estimator.update(hand, 1.0f / 375.0f);
+
+            expectEquals(estimator.getVelocity(0), velocityBefore, "A repeated frame was fed back in as a measurement.");
+
+            HandData predicted = hand;
+            estimator.writeEstimate(predicted, 0.0f);
+            expect(predicted.currentHandPositionX > hand.currentHandPositionX, "Time since the last frame was not carried into the estimate.");
+        }
+
+        beginTest("4. Sensor Clock Wins Over Block Time");
+        {
+            // Large host buffers, each block sees a new 120 Hz frame but reports 50ms of audio
+            HandKalmanEstimator estimator;
+            HandData hand;
+            hand.isPresent = true;
+
+            for (int i = 1; i <= 120; ++i) {
+                hand.frameId = i;
+                hand.frameTimeSeconds = 10.0 + (double)i / 120.0;
+                hand.currentHandPositionZ = -240.0f * (float)i / 120.0f;
+                estimator.update(hand, 0.05f);
+            }
+
+            expectWithinAbsoluteError(estimator.getVelocity(2), -240.0f, 5.0f, "Velocity used the audio block time instead of the frame timestamps.");
+        }
+
+        beginTest("5. Resets When The Hand Leaves");
+        {
+            HandKalmanEstimator estimator;
+            HandData hand;
+            hand.isPresent = true;
+
+            for (int i = 0; i < 60; ++i) {
+                hand.fingers[2].tipY = 5.0f * (float)i;
+                estimator.update(hand, 1.0f / 120.0f);
+            }
+
+            hand.isPresent = false;
+            estimator.update(hand, 1.0f / 120.0f);
+            estimator.writeVelocity(hand);
+            expectEquals(hand.getPalmSpeed(), 0.0f, "Speed was left on a hand that is gone.");
+
+            hand.isPresent = true;
+            hand.fingers[2].tipY = 80.0f;
+            estimator.update(hand, 1.0f / 120.0f);
+            estimator.writeEstimate(hand, 0.02f);
+
+            expectEquals(hand.fingers[2].tipY, 80.0f, "Old motion was extrapolated into a new hand entry.");
+            expectEquals(estimator.getVelocity(10), 0.0f, "Old velocity survived the hand leaving.");
+        }
+
+        beginTest("6. Prediction Moves Whole Fingers");
+        {
+            HandKalmanEstimator estimator;
+            HandData hand;
+            hand.isPresent = true;
+
+            for (int i = 1; i <= 60; ++i) {
+                auto& index = hand.fingers[1];
+                index.tipX = 4.0f * (float)i;
+                index.joint1X = index.tipX - 20.0f;
+                index.joint2X = index.tipX - 45.0f;
+                index.knuckleX = index.tipX - 85.0f;
+
+                hand.frameId = i;
+                estimator.update(hand, 1.0f / 120.0f);
+            }
+
+            HandData predicted = hand;
+            estimator.writeEstimate(predicted, 0.05f);
+
+            const auto& index = predicted.fingers[1];
+            expect(index.tipX > hand.fingers[1].tipX, "The tip should lead a finger that is moving.");
+            expectWithinAbsoluteError(index.tipX - index.joint1X, 20.0f, 0.001f, "The distal bone changed length.");
+            expectWithinAbsoluteError(index.tipX - index.joint2X, 45.0f, 0.001f, "The middle bone changed length.");
+            expectWithinAbsoluteError(index.tipX - index.knuckleX, 85.0f, 0.001f, "The proximal bone changed length.");
+        }
+    }
+};
+
+static KalmanEstimatorTests kalmanEstimatorTestsInstance;
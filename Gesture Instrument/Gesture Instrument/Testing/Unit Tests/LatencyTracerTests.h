@@ -0,0 +1,133 @@
+#pragma once
+#include <JuceHeader.h>
+#include "../../Source/Helpers/LatencyTracer.h"
+
+class LatencyTracerTests : public juce::UnitTest {
+public:
+    LatencyTracerTests() : juce::UnitTest("Latency Tracer Tests") {}
+
+    void runTest() override {
+        beginTest("1. Nothing Is Traced While Disabled");
+        {
+            LatencyTracer tracer;
+            tracer.beginBlock(makeFrame(1, 0.010));
+            expect(!tracer.isTracingFrame(), "A disabled tracer shouldn't start a trace");
+
+            tracer.endBlock(4, 0.0, false);
+            tracer.collect();
+            expectEquals(tracer.getHistory().size(), 0);
+            expectEquals(tracer.getHistogram(LatencyTracer::total).getCount(), 0);
+        }
+
+        beginTest("2. Each Frame Is Traced Once Through Every Stage");
+        {
+            LatencyTracer tracer;
+            tracer.setEnabled(true);
+
+            for (int block = 0; block < 3; ++block) {
+                tracer.beginBlock(makeFrame(7, 0.012));
+                tracer.markSmoothed();
+                tracer.markRouted();
+                tracer.endBlock(2, 0.0, false);
+            }
+
+            tracer.collect();
+            expectEquals(tracer.getHistory().size(), 1, "Repeated blocks of the same frame should trace it once");
+
+            for (int stage = 0; stage < LatencyTracer::numStages; ++stage)
+                expectEquals(tracer.getHistogram((LatencyTracer::Stage)stage).getCount(), 1, LatencyTracer::getStageName((LatencyTracer::Stage)stage));
+
+            const auto& frame = tracer.getHistory().getReference(0);
+            expectEquals((int)frame.frameId, 7);
+            expectEquals(frame.numEvents, 2);
+            expect(frame.captureSeconds <= frame.receivedSeconds && frame.receivedSeconds <= frame.publishedSeconds, "Sensor side stamps out of order");
+            expect(frame.publishedSeconds <= frame.pickupSeconds && frame.pickupSeconds <= frame.smoothedSeconds, "Audio side stamps out of order");
+            expect(frame.smoothedSeconds <= frame.routedSeconds && frame.routedSeconds <= frame.emittedSeconds, "Output stamps out of order");
+
+            // The frame was captured 12 ms before it was picked up
+            float totalMs = tracer.getHistogram(LatencyTracer::total).getPercentile(0.5f);
+            expectWithinAbsoluteError(totalMs, 12.0f, 1.0f, "Capture to output should cover the frame's age");
+        }
+
+        beginTest("3. Frames Without Output Skip The Output Stages");
+        {
+            LatencyTracer tracer;
+            tracer.setEnabled(true);
+
+            tracer.beginBlock(makeFrame(3, 0.005));
+            tracer.markSmoothed();
+            tracer.markRouted();
+            tracer.endBlock(0, 0.0, true);
+            tracer.collect();
+
+            expectEquals(tracer.getHistory().size(), 1);
+            expect(tracer.getHistory().getReference(0).emittedSeconds == 0.0, "Nothing was emitted");
+            expectEquals(tracer.getHistogram(LatencyTracer::routing).getCount(), 1);
+            expectEquals(tracer.getHistogram(LatencyTracer::output).getCount(), 0);
+            expectEquals(tracer.getHistogram(LatencyTracer::total).getCount(), 0);
+        }
+
+        beginTest("4. Chrome Trace Has A Span Per Stage");
+        {
+            LatencyTracer tracer;
+            tracer.setEnabled(true);
+
+            for (int frameId = 1; frameId <= 2; ++frameId) {
+                tracer.beginBlock(makeFrame(frameId, 0.008));
+                tracer.markSmoothed();
+                tracer.markRouted();
+                tracer.endBlock(frameId == 1 ? 3 : 0, 0.001, false);
+            }
+
+            auto parsed = juce::JSON::parse(tracer.createChromeTrace());
+            auto* events = parsed.getProperty("traceEvents", juce::var()).getArray();
+            expect(events != nullptr, "traceEvents should be an array");
+
+            int metadata = 0, spans = 0, outputSpans = 0;
+            if (events != nullptr) {
+                for (const auto& event : *events) {
+                    if (event.getProperty("ph", juce::var()).toString() == "M") ++metadata;
+                    if (event.getProperty("ph", juce::var()).toString() != "X") continue;
+
+                    ++spans;
+                    if (event.getProperty("name", juce::var()).toString() == "output") ++outputSpans;
+                    expect((double)event.getProperty("dur", -1.0) >= 0.0, "Span durations can't be negative");
+                }
+            }
+
+            expectEquals(metadata, 5, "One name per track");
+            expectEquals(spans, 11, "Five spans per frame, plus output for the frame that sent something");
+            expectEquals(outputSpans, 1);
+        }
+
+        beginTest("5. Histogram Percentiles");
+        {
+            LatencyHistogram histogram(0.001f, 1000.0f);
+            for (int i = 0; i < 98; ++i) histogram.add(2.0f);
+            for (int i = 0; i < 2; ++i) histogram.add(40.0f);
+
+            expectEquals(histogram.getCount(), 100);
+            expectWithinAbsoluteError(histogram.getPercentile(0.5f), 2.0f, 0.2f);
+            expectWithinAbsoluteError(histogram.getPercentile(0.99f), 40.0f, 4.0f);
+
+            histogram.clear();
+            expectEquals(histogram.getCount(), 0);
+            expectEquals(histogram.getPercentile(0.99f), 0.0f);
+        }
+    }
+
+private:
+    // A frame as LeapService and the Leap thread would have stamped it, captured ageSeconds ago
+    static HandData makeFrame(int frameId, double ageSeconds) {
+        double now = LatencyTracer::now();
+
+        HandData hand;
+        hand.frameId = frameId;
+        hand.captureSeconds = now - ageSeconds;
+        hand.receivedSeconds = now - ageSeconds * 0.5;
+        hand.publishedSeconds = now - ageSeconds * 0.25;
+        return hand;
+    }
+};
+
+static LatencyTracerTests latencyTracerTestsInstance;
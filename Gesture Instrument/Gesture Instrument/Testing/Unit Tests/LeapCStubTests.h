@@ -0,0 +1,150 @@
+#pragma once
+#include <JuceHeader.h>
+#include "../../Source/Helpers/LeapService.h"
+
+// Only meaningful when the stub LeapC is linked in place of the SDK
+#if GESTURE_LEAPC_STUB
+#include "../../Source/LeapCStub/LeapCStub.h"
+
+class LeapCStubTests : public juce::UnitTest {
+public:
+    LeapCStubTests() : juce::UnitTest("LeapC Stub Tests") {}
+
+    void runTest() override {
+        beginTest("1. Opening A Connection Reports The Sensor");
+        {
+            LeapCStub::setFrameSource(nullptr);
+            LeapCStub::setDeviceConnected(true);
+
+            LeapService service;
+            HandData leftHand, rightHand;
+            bool isConnected = false;
+
+            service.pollHandData(leftHand, rightHand, isConnected);
+            expect(isConnected, "Connection and Device events should mark the sensor connected");
+            expect(!leftHand.isPresent && !rightHand.isPresent, "No source means no hands");
+        }
+
+        beginTest("2. Recorded Frames Reach HandData Through pollHandData");
+        {
+            std::vector<LeapCStub::Frame> frames(3);
+            for (int i = 0; i < 3; ++i) {
+                HandData right;
+                right.currentHandPositionX = 10.0f * (float)(i + 1);
+                right.currentHandPositionY = 250.0f;
+                right.pinchStrength = 0.9f;
+                right.fingers[1].tipY = 42.0f;
+                right.fingers[1].isExtended = true;
+
+                frames[(size_t)i].timestamp = 0;
+                frames[(size_t)i].hands.push_back(LeapCStub::makeHand(right, eLeapHandType_Right));
+            }
+
+            auto session = std::make_shared<LeapCStub::RecordedSession>(frames);
+            LeapCStub::setFrameSource(session);
+
+            LeapService service;
+            HandData leftHand, rightHand;
+            bool isConnected = false;
+
+            // Every frame is due at once, a single poll drains them and leaves the last one
+            service.pollHandData(leftHand, rightHand, isConnected);
+
+            expect(isConnected, "Tracking frames should keep the sensor connected");
+            expect(rightHand.isPresent && !leftHand.isPresent, "Only the right hand was recorded");
+            expectEquals(rightHand.currentHandPositionX, 30.0f, "The last recorded frame should win");
+            expectEquals(rightHand.fingers[1].tipY, 42.0f, "Finger joints should survive the round trip");
+            expect(rightHand.fingers[1].isExtended, "Extension should survive the round trip");
+            expect(rightHand.isPinching, "Pinch strength 0.9 should pinch");
+            expectEquals((int)rightHand.frameId, 3, "Frame ids should count up per connection");
+            expect(session->isFinished(), "A non looping session should finish");
+
+            LeapCStub::setFrameSource(nullptr);
+        }
+
+        beginTest("3. Frames Wait Until They Are Due");
+        {
+            std::vector<LeapCStub::Frame> frames(2);
+            frames[0].timestamp = 0;
+            frames[1].timestamp = 60 * 1000000LL;
+
+            auto session = std::make_shared<LeapCStub::RecordedSession>(frames);
+            LeapCStub::setFrameSource(session);
+
+            LeapService service;
+            HandData leftHand, rightHand;
+            bool isConnected = false;
+
+            service.pollHandData(leftHand, rightHand, isConnected);
+            expectEquals((int)leftHand.frameId, 1, "Only the first frame is due yet");
+            expect(!session->isFinished(), "The second frame is a minute away");
+
+            LeapCStub::setFrameSource(nullptr);
+        }
+
+        beginTest("4. Unplugging Clears The Hands");
+        {
+            auto generated = std::make_shared<LeapCStub::GeneratedHands>(1000.0, [](int, double, LeapCStub::Frame& frame) {
+                HandData left;
+                left.currentHandPositionX = -80.0f;
+                frame.hands.push_back(LeapCStub::makeHand(left, eLeapHandType_Left));
+                });
+
+            LeapCStub::setFrameSource(generated);
+
+            LeapService service;
+            HandData leftHand, rightHand;
+            bool isConnected = false;
+
+            service.pollHandData(leftHand, rightHand, isConnected);
+            expect(leftHand.isPresent, "Generated left hand should be present");
+            expectEquals(leftHand.currentHandPositionX, -80.0f);
+
+            LeapCStub::setDeviceConnected(false);
+            service.pollHandData(leftHand, rightHand, isConnected);
+
+            expect(!isConnected, "DeviceLost should mark the sensor disconnected");
+            expect(!leftHand.isPresent, "DeviceLost should clear the hands");
+
+            LeapCStub::setDeviceConnected(true);
+            LeapCStub::setFrameSource(nullptr);
+        }
+
+        beginTest("5. Every Drained Frame Reaches The Frame Callback");
+        {
+            std::vector<LeapCStub::Frame> frames(4);
+            for (int i = 0; i < 4; ++i) {
+                HandData left;
+                left.currentHandPositionY = 300.0f - 20.0f * (float)i;
+                frames[(size_t)i].timestamp = 0;
+                frames[(size_t)i].hands.push_back(LeapCStub::makeHand(left, eLeapHandType_Left));
+            }
+
+            LeapCStub::setFrameSource(std::make_shared<LeapCStub::RecordedSession>(frames));
+
+            LeapService service;
+            HandData leftHand, rightHand;
+            bool isConnected = false;
+
+            std::vector<long long> seenIds;
+            std::vector<float> seenHeights;
+            service.pollHandData(leftHand, rightHand, isConnected, [&](const HandData& left, const HandData&, bool) {
+                seenIds.push_back(left.frameId);
+                seenHeights.push_back(left.currentHandPositionY);
+                });
+
+            expectEquals((int)seenIds.size(), 4, "One poll drained four frames, the callback should see each of them");
+            if (seenIds.size() == 4) {
+                expectEquals((int)seenIds[0], 1);
+                expectEquals((int)seenIds[3], 4);
+                expectEquals(seenHeights[1], 280.0f, "Each call should carry its own frame, not the latest");
+            }
+            expectEquals(leftHand.currentHandPositionY, 240.0f, "The hands are still left at the last frame");
+
+            LeapCStub::setFrameSource(nullptr);
+        }
+    }
+};
+
+static LeapCStubTests leapCStubTestsInstance;
+#endif
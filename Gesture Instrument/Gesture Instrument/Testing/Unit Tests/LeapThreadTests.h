@@ -51,6 +51,56 @@ public:
             // stop thread
             testThread.shutdown();
         }
+
+        beginTest("Auto Range Steps Once Per Sensor Frame");
+        {
+            LeapThread testThread;
+            PlayArea wide;
+            wide.minX = -300.0f; wide.maxX = 300.0f;
+
+            testThread.setAutoRangeEnabled(true);
+            testThread.setAutoRangeSpeed(20.0f);
+            testThread.resetAutoRange(wide);
+
+            PlayArea ranged;
+            expect(!testThread.getAutoRangeArea(ranged), "An area was reported before any frame was ranged.");
+
+            // Same frames straight into a ranger, stepped by the sensor clock
+            AutoRanger reference;
+            reference.setMaxSpeed(20.0f);
+            reference.reset(wide);
+
+            HandData hand;
+            hand.isPresent = true;
+            hand.currentHandPositionY = 300.0f;
+            double lastFrameSeconds = 0.0;
+
+            for (int i = 0; i < 120 * 60; ++i) {
+                float phase = (float)(i % 480) / 480.0f;
+                hand.currentHandPositionX = (phase < 0.5f ? phase * 4.0f - 1.0f : 3.0f - phase * 4.0f) * 60.0f;
+                hand.frameId = i + 1;
+                hand.frameTimeSeconds = 1.0 + i / 120.0;
+
+                // The empty left hand carries the frame's stamp like a polled one does
+                HandData noHand = hand;
+                noHand.isPresent = false;
+
+                // Every frame arrives twice, as it does when the audio side polls faster than the sensor
+                testThread.injectFrame(noHand, hand, true);
+                testThread.injectFrame(noHand, hand, true);
+
+                float deltaSeconds = i == 0 ? 0.0f : (float)juce::jlimit(0.0, 0.1, hand.frameTimeSeconds - lastFrameSeconds);
+                reference.process(HandData(), hand, deltaSeconds);
+                lastFrameSeconds = hand.frameTimeSeconds;
+            }
+
+            expect(testThread.getAutoRangeArea(ranged), "No area was published after a minute of frames.");
+            expect(ranged == reference.getArea(), "The area should be one step per frame on the sensor clock, repeats included.");
+            expect(ranged.maxX < 200.0f, "The area did not close in on where the hand plays.");
+
+            testThread.resetAutoRange(PlayArea());
+            expect(!testThread.getAutoRangeArea(ranged), "The area from before the reset was still reported.");
+        }
     }
 };
 
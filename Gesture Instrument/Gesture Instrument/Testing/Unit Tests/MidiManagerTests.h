@@ -1,7 +1,7 @@
 #pragma once
 #include <JuceHeader.h>
 #include <atomic>
-#include "../../Source/MIDI/MIDIManager.h"
+#include "../../Source/MIDI/MidiManager.h"
 
 class MIDIManagerTests : public juce::UnitTest {
 public:
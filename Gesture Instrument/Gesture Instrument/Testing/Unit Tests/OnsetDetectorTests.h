@@ -0,0 +1,177 @@
+#pragma once
+#include <JuceHeader.h>
+#include "../../Source/Helpers/OnsetDetector.h"
+
+class OnsetDetectorTests : public juce::UnitTest {
+public:
+    OnsetDetectorTests() : juce::UnitTest("Onset Detector Tests") {}
+
+    void runTest() override {
+        beginTest("1. Fast Tap Fires Once");
+        {
+            OnsetDetector detector;
+            auto events = runPalmTap(detector, 1000.0f);
+
+            expectEquals((int)events.size(), 1, "A single palm tap should fire exactly one strike.");
+            if (!events.empty()) {
+                expectEquals(events[0].source, 0, "Strike was not reported on the palm.");
+                expectEquals(events[0].hand, 1, "Strike was reported on the wrong hand.");
+            }
+        }
+
+        beginTest("2. Harder Tap Gives Higher Velocity");
+        {
+            OnsetDetector soft, hard;
+            auto softEvents = runPalmTap(soft, 700.0f);
+            auto hardEvents = runPalmTap(hard, 1600.0f);
+
+            expect(softEvents.size() == 1 && hardEvents.size() == 1, "Both taps should fire.");
+            if (softEvents.size() == 1 && hardEvents.size() == 1)
+                expect(hardEvents[0].velocity > softEvents[0].velocity, "Strike velocity did not follow strike speed.");
+        }
+
+        beginTest("3. Slow Movement Does Not Fire");
+        {
+            OnsetDetector detector;
+            auto events = runPalmTap(detector, 150.0f);
+            expect(events.empty(), "A slow lowering of the hand was read as a strike.");
+        }
+
+        beginTest("4. Whole Hand Strike Only Fires The Palm");
+        {
+            // Fingertips travel with the palm, so relative to it they don't move
+            OnsetDetector detector;
+            HandData hand = makeHand();
+            std::vector<StrikeEvent> events;
+
+            for (int i = 0; i < 40; ++i) {
+                float y = heightAt(i, 1000.0f);
+                hand.currentHandPositionY = y;
+                for (int f = 0; f < 5; ++f) hand.fingers[f].tipY = y + 60.0f;
+                feed(detector, hand, i, events);
+            }
+
+            expectEquals((int)events.size(), 1, "Fingers fired along with the palm on a whole hand strike.");
+            if (!events.empty()) expectEquals(events[0].source, 0, "Whole hand strike was not reported on the palm.");
+        }
+
+        beginTest("5. Finger Tap Reports Its Finger");
+        {
+            OnsetDetector detector;
+            HandData hand = makeHand();
+            std::vector<StrikeEvent> events;
+
+            for (int i = 0; i < 40; ++i) {
+                for (int f = 0; f < 5; ++f) hand.fingers[f].tipY = 260.0f;
+                hand.fingers[1].tipY = 260.0f - (heightAt(0, 0.0f) - heightAt(i, 900.0f));
+                feed(detector, hand, i, events);
+            }
+
+            expectEquals((int)events.size(), 1, "Index finger tap should fire one strike.");
+            if (!events.empty()) expectEquals(events[0].source, 2, "Finger strike was reported on the wrong source.");
+        }
+
+        beginTest("6. Re-arms Between Taps");
+        {
+            OnsetDetector detector;
+            HandData hand = makeHand();
+            std::vector<StrikeEvent> events;
+
+            // Tap, lift back up slowly, tap again
+            for (int i = 0; i < 40; ++i) {
+                hand.currentHandPositionY = heightAt(i, 1000.0f);
+                feed(detector, hand, i, events);
+            }
+            float liftedFrom = hand.currentHandPositionY;
+            for (int i = 0; i < 60; ++i) {
+                hand.currentHandPositionY = liftedFrom + (200.0f - liftedFrom) * (float)(i + 1) / 60.0f;
+                feed(detector, hand, 40 + i, events);
+            }
+            for (int i = 0; i < 40; ++i) {
+                hand.currentHandPositionY = heightAt(i, 1000.0f);
+                feed(detector, hand, 100 + i, events);
+            }
+
+            expectEquals((int)events.size(), 2, "Detector did not re-arm for the second tap.");
+        }
+
+        beginTest("7. Resets When The Hand Leaves");
+        {
+            OnsetDetector detector;
+            HandData hand = makeHand();
+            std::vector<StrikeEvent> events;
+
+            feed(detector, hand, 0, events);
+
+            // Hand comes back 300mm lower, that jump is not a strike
+            hand.isPresent = false;
+            feed(detector, hand, 1, events);
+
+            hand.isPresent = true;
+            hand.currentHandPositionY = -100.0f;
+            for (int i = 2; i < 10; ++i) feed(detector, hand, i, events);
+
+            expect(events.empty(), "Re-entering lower down was read as a strike.");
+        }
+
+        beginTest("8. Strikes Keep Their Place In The Block");
+        {
+            // 512 samples at 48kHz, the block covers the 10.7ms before now
+            const double now = 100.0;
+            auto offsetFor = [now](double ageSeconds) {
+                StrikeEvent strike;
+                strike.captureSeconds = now - ageSeconds;
+                return getStrikeSampleOffset(strike, now, 48000.0, 512);
+                };
+
+            expectEquals(offsetFor(0.0), 511, "A strike from just now should go at the end of the block.");
+            expectEquals(offsetFor(256.0 / 48000.0), 255);
+            expectEquals(offsetFor(0.5), 0, "A strike older than the block can only go at the start.");
+            expectEquals(offsetFor(-0.001), 511, "Clock skew shouldn't push a strike past the block.");
+
+            expect(offsetFor(0.002) < offsetFor(0.001), "Two strikes in one block should keep their order.");
+            expectEquals(offsetFor(0.001) - offsetFor(0.002), 48, "and their spacing.");
+
+            StrikeEvent injected;
+            expectEquals(getStrikeSampleOffset(injected, now, 48000.0, 512), 0, "Without a capture time a strike goes at the start.");
+        }
+    }
+
+private:
+    static constexpr double frameSeconds = 1.0 / 120.0;
+
+    static HandData makeHand() {
+        HandData hand;
+        hand.isPresent = true;
+        hand.currentHandPositionY = 200.0f;
+        return hand;
+    }
+
+    // Held for 5 frames, falls at the given speed for 8 frames, then stops dead
+    static float heightAt(int frame, float speed) {
+        int fallingFrames = juce::jlimit(0, 8, frame - 5);
+        return 200.0f - speed * (float)(fallingFrames * frameSeconds);
+    }
+
+    static void feed(OnsetDetector& detector, HandData& hand, int frame, std::vector<StrikeEvent>& events) {
+        hand.frameId = frame + 1;
+        hand.frameTimeSeconds = 5.0 + frame * frameSeconds;
+
+        StrikeEvent out[OnsetDetector::numSources];
+        int count = detector.process(hand, 1, out);
+        events.insert(events.end(), out, out + count);
+    }
+
+    static std::vector<StrikeEvent> runPalmTap(OnsetDetector& detector, float speed) {
+        HandData hand = makeHand();
+        std::vector<StrikeEvent> events;
+
+        for (int i = 0; i < 40; ++i) {
+            hand.currentHandPositionY = heightAt(i, speed);
+            feed(detector, hand, i, events);
+        }
+        return events;
+    }
+};
+
+static OnsetDetectorTests onsetDetectorTestsInstance;
@@ -1,7 +1,7 @@
 #pragma once
 #include <JuceHeader.h>
 #include <atomic>
-#include "../../Source/OSC/OSCManager.h"
+#include "../../Source/OSC/OscManager.h"
 
 class OscManagerTests : public juce::UnitTest, private juce::OSCReceiver::ListenerWithOSCAddress<juce::OSCReceiver::RealtimeCallback> {
 public:
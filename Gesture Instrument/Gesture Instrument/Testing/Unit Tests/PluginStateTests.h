@@ -0,0 +1,213 @@
+#pragma once
+#include <JuceHeader.h>
+#include "../../Source/PluginProcessor.h"
+#include "../../Source/Helpers/PluginState.h"
+
+class PluginStateTests : public juce::UnitTest {
+public:
+    PluginStateTests() : juce::UnitTest("Plugin State Tests") {}
+
+    void runTest() override {
+        beginTest("1. Binary State Keeps Every Field");
+        {
+            PluginState saved;
+            saved.config = makeUnusualConfig();
+            saved.host.statsEnabled = true;
+            saved.host.statsHost = "10.0.0.7";
+            saved.host.statsPort = 9123;
+
+            juce::MemoryBlock data;
+            saved.write(data);
+
+            PluginState loaded;
+            expect(loaded.read(data.getData(), (int)data.getSize()));
+            expect(loaded.config.toXml()->isEquivalentTo(saved.config.toXml().get(), false), "Every preset field should read back as written");
+            expect(loaded.host.statsEnabled);
+            expectEquals(loaded.host.statsHost, juce::String("10.0.0.7"));
+            expectEquals(loaded.host.statsPort, 9123);
+        }
+
+        beginTest("2. Unknown And Missing Fields Fall Back To Defaults");
+        {
+            juce::MemoryBlock data;
+            {
+                juce::MemoryOutputStream out(data, false);
+                out.writeInt(PluginState::magic);
+                out.writeShort((short)(PluginState::formatVersion + 1));
+
+                // A field from a newer build, the root note, and the cutoff written at a size this build doesn't read
+                writeRecord(out, 9000, { 1, 2, 3 });
+                writeRecord(out, 3, { 7, 0, 0, 0 });
+                writeRecord(out, 64, { 0, 0 });
+            }
+
+            PluginState loaded;
+            expect(loaded.read(data.getData(), (int)data.getSize()), "A newer format version should still be read");
+            expectEquals(loaded.config.rootNote, 7);
+            expectEquals(loaded.config.staticCutoff, PresetConfig().staticCutoff, "A field of the wrong size should keep its default");
+            expectEquals(loaded.config.endNote, PresetConfig().endNote, "A field that isn't there should keep its default");
+        }
+
+        beginTest("3. Older XML State Still Loads");
+        {
+            auto config = makeUnusualConfig();
+            auto xml = config.toXml();
+            xml->setAttribute("statsPort", 9555);
+
+            juce::MemoryBlock data;
+            juce::AudioProcessor::copyXmlToBinary(*xml, data);
+
+            PluginState loaded;
+            expect(loaded.read(data.getData(), (int)data.getSize()));
+            expect(loaded.config.toXml()->isEquivalentTo(config.toXml().get(), false));
+            expectEquals(loaded.host.statsPort, 9555);
+
+            const char garbage[] = "not a plugin state";
+            expect(!loaded.read(garbage, (int)sizeof(garbage)), "Anything else should be refused");
+        }
+
+        beginTest("4. Binary State Is Smaller Than The XML It Replaces");
+        {
+            PluginState state;
+            state.config = makeUnusualConfig();
+
+            juce::MemoryBlock binary, xml;
+            state.write(binary);
+            juce::AudioProcessor::copyXmlToBinary(*state.config.toXml(), xml);
+
+            expectLessThan(binary.getSize() * 2, xml.getSize(), "Expected under half the size of the XML");
+        }
+
+        beginTest("5. A Restore Lands Whole At The Next Block");
+        {
+            GestureInstrumentAudioProcessor::isRunningInUnitTest = true;
+            GestureInstrumentAudioProcessor processor;
+            processor.setRateAndBufferSizeDetails(48000.0, 512);
+            processor.prepareToPlay(48000.0, 512);
+
+            juce::MemoryBlock data;
+            {
+                GestureInstrumentAudioProcessor source;
+                source.applyConfig(makeUnusualConfig());
+                source.getStateInformation(data);
+            }
+
+            processor.setStateInformation(data.getData(), (int)data.getSize());
+            expectEquals(processor.rootNote, 0, "Nothing should change until the audio thread takes it");
+
+            juce::MemoryBlock beforeBlock;
+            processor.getStateInformation(beforeBlock);
+            expect(beforeBlock == data, "Saving before the block should hand back the restored state");
+
+            juce::AudioBuffer<float> buffer(2, 512);
+            juce::MidiBuffer midi;
+            processor.processBlock(buffer, midi);
+
+            expectEquals(processor.rootNote, 5);
+            expectEquals(processor.staticCutoff, 0.25f);
+            expect(processor.leftXTarget == GestureTarget::Cutoff);
+            expectEquals((int)processor.customScaleIntervals.size(), 3);
+
+            juce::MemoryBlock afterBlock;
+            processor.getStateInformation(afterBlock);
+            expect(afterBlock == data, "The applied state should save exactly as it was restored");
+        }
+
+        beginTest("6. Before prepareToPlay A Restore Applies Straight Away");
+        {
+            GestureInstrumentAudioProcessor::isRunningInUnitTest = true;
+            GestureInstrumentAudioProcessor processor;
+
+            PluginState state;
+            state.config = makeUnusualConfig();
+            juce::MemoryBlock data;
+            state.write(data);
+
+            processor.setStateInformation(data.getData(), (int)data.getSize());
+            expectEquals(processor.rootNote, 5);
+            expect(processor.currentOutputMode == OutputMode::OSC_Only);
+
+            // The same once the host has stopped, for a suspended plugin or a Standalone without a device
+            processor.setRateAndBufferSizeDetails(48000.0, 512);
+            processor.prepareToPlay(48000.0, 512);
+            processor.releaseResources();
+
+            processor.loadPresetXml(PresetConfig().toXml().get());
+            expectEquals(processor.rootNote, 0);
+            expectEquals(processor.getAppliedConfigSerial(), 2, "The editor refreshes on the serial, so it has to move");
+        }
+
+        beginTest("7. A Preset Saved Before The Next Block Is The One Loaded");
+        {
+            GestureInstrumentAudioProcessor::isRunningInUnitTest = true;
+            GestureInstrumentAudioProcessor processor;
+            processor.setRateAndBufferSizeDetails(48000.0, 512);
+            processor.prepareToPlay(48000.0, 512);
+
+            processor.loadPresetXml(makeUnusualConfig().toXml().get());
+            expectEquals(processor.rootNote, 0, "While playing, the audio thread takes the request");
+
+            auto saved = PresetConfig::fromXml(*processor.createPresetXml());
+            expectEquals(saved.rootNote, 5, "Saving should hand back the preset that was just loaded");
+        }
+
+        beginTest("8. A Preset Switch Under Mute Is Sent Once It Lifts");
+        {
+            GestureInstrumentAudioProcessor::isRunningInUnitTest = true;
+            GestureInstrumentAudioProcessor processor;
+            processor.setRateAndBufferSizeDetails(48000.0, 512);
+            processor.prepareToPlay(48000.0, 512);
+            processor.currentOutputMode = OutputMode::MIDI_Only;
+
+            PresetConfig config;
+            config.outputMode = 1;
+            config.globalMute = true;
+            config.staticCutoff = 0.75f;
+
+            juce::AudioBuffer<float> buffer(2, 512);
+            juce::MidiBuffer midi;
+            processor.requestConfig(config);
+            processor.processBlock(buffer, midi);
+            expectEquals(countControllers(midi, 74), 0, "Nothing should be sent while muted");
+
+            processor.globalMute.store(false);
+            midi.clear();
+            processor.processBlock(buffer, midi);
+            expectEquals(countControllers(midi, 74), 2, "The new cutoff should go out on both hands' channels");
+        }
+    }
+
+private:
+    static int countControllers(const juce::MidiBuffer& midi, int controllerNumber) {
+        int count = 0;
+        for (const auto metadata : midi) {
+            auto message = metadata.getMessage();
+            if (message.isController() && message.getControllerNumber() == controllerNumber) ++count;
+        }
+        return count;
+    }
+
+    static PresetConfig makeUnusualConfig() {
+        PresetConfig config;
+        config.outputMode = 0;
+        config.rootNote = 5;
+        config.scaleType = 4;
+        config.customScaleIntervals = { { 0, 3, 7 }, 3 };
+        config.minWidthThreshold = -321.5f;
+        config.staticCutoff = 0.25f;
+        config.leftXTarget = 8;
+        config.rightChordDegrees[6] = true;
+        config.leftAllowedRoots[2] = false;
+        config.isMpeEnabled = true;
+        config.chordEngineEnabled = false;
+        return config;
+    }
+
+    static void writeRecord(juce::OutputStream& out, int id, std::initializer_list<juce::uint8> payload) {
+        out.writeShort((short)id);
+        out.writeShort((short)payload.size());
+        for (auto byte : payload) out.writeByte((char)byte);
+    }
+};
+
+static PluginStateTests pluginStateTestsInstance;
@@ -0,0 +1,150 @@
+#pragma once
+#include <JuceHeader.h>
+#include "../../Source/Helpers/PresetLibrary.h"
+
+class PresetLibraryTests : public juce::UnitTest {
+public:
+    PresetLibraryTests() : juce::UnitTest("Preset Library Tests") {}
+
+    void runTest() override {
+        auto root = juce::File::getSpecialLocation(juce::File::tempDirectory).getChildFile("GestureInstrumentPresetLibraryTests");
+        auto folder = root.getChildFile("Presets");
+        auto indexFile = root.getChildFile("PresetIndex.bin");
+
+        root.deleteRecursively();
+        folder.createDirectory();
+
+        writePreset(folder.getChildFile("Night Pad.xml"), makeConfig(0, 9, 2));
+        writePreset(folder.getChildFile("Bright Lead.xml"), makeConfig(1, 0, 1));
+        folder.getChildFile("Not A Preset.xml").replaceWithText("<SomethingElse/>");
+        folder.getChildFile("notes.txt").replaceWithText("not xml at all");
+
+        beginTest("1. Scanning Parses Every Preset In A Folder");
+        {
+            PresetLibrary library(indexFile);
+            library.addDirectory(folder);
+            library.scan();
+
+            auto presets = library.getPresets();
+            expectEquals((int)presets->size(), 2, "Only files holding a preset should be listed");
+            expectEquals((*presets)[0].name, juce::String("Bright Lead"), "Presets should be sorted by name");
+            expectEquals((*presets)[1].config.rootNote, 9);
+            expectEquals((*presets)[1].config.scaleType, 2);
+            expect((*presets)[1].summary.startsWith("OSC | A Minor"));
+            expect(indexFile.existsAsFile(), "The scan should leave an index behind");
+        }
+
+        beginTest("2. Search Matches Every Word In Any Order");
+        {
+            PresetLibrary library(indexFile);
+            library.addDirectory(folder);
+            library.scan();
+
+            const auto& presets = *library.getPresets();
+            expectEquals((int)PresetLibrary::search(presets, "").size(), 2, "An empty search should match everything");
+            expectEquals((int)PresetLibrary::search(presets, "  ").size(), 2);
+
+            auto matches = PresetLibrary::search(presets, "minor NIGHT");
+            expectEquals((int)matches.size(), 1);
+            expectEquals(presets[(size_t)matches[0]].name, juce::String("Night Pad"));
+
+            expectEquals((int)PresetLibrary::search(presets, "midi pitch").size(), 1, "Mappings should be searchable too");
+            expect(PresetLibrary::search(presets, "night midi").empty(), "Every word has to match");
+        }
+
+        beginTest("3. A Restart Reads The Index Instead Of The Files");
+        {
+            // Same size and time as before, so only the index can still know what it held
+            auto file = folder.getChildFile("Night Pad.xml");
+            auto modified = file.getLastModificationTime();
+            file.replaceWithText(juce::String::repeatedString("x", (int)file.getSize()));
+            file.setLastModificationTime(modified);
+
+            PresetLibrary library(indexFile);
+            library.scan();
+            expect(library.getDirectories().contains(folder), "Folders should come back from the index");
+
+            auto presets = library.getPresets();
+            expectEquals((int)presets->size(), 2);
+            expectEquals((*presets)[1].config.rootNote, 9, "An unchanged file shouldn't be parsed again");
+            expectEquals((*presets)[1].summary, PresetLibrary::describe(makeConfig(0, 9, 2)));
+
+            writePreset(file, makeConfig(0, 9, 2));
+        }
+
+        beginTest("4. Changes In The Folder Are Picked Up");
+        {
+            PresetLibrary library(indexFile);
+            library.scan();
+            int generation = library.getGeneration();
+
+            library.scan();
+            expectEquals(library.getGeneration(), generation, "Nothing changed, nothing should be published");
+
+            writePreset(folder.getChildFile("Night Pad.xml"), makeConfig(0, 11, 5));
+            writePreset(folder.getChildFile("Choir.xml"), makeConfig(1, 4, 1));
+            folder.getChildFile("Bright Lead.xml").deleteFile();
+            library.scan();
+
+            auto presets = library.getPresets();
+            expectGreaterThan(library.getGeneration(), generation);
+            expectEquals((int)presets->size(), 2);
+            expectEquals((*presets)[0].name, juce::String("Choir"));
+            expectEquals((*presets)[1].config.rootNote, 11, "A rewritten file should be parsed again");
+        }
+
+        beginTest("5. A Damaged Index Is Rebuilt From The Files");
+        {
+            indexFile.replaceWithText("definitely not an index");
+
+            PresetLibrary library(indexFile);
+            library.addDirectory(folder);
+            library.scan();
+
+            expectEquals((int)library.getPresets()->size(), 2);
+
+            juce::MemoryBlock data;
+            indexFile.loadFileAsData(data);
+            expectEquals(juce::MemoryInputStream(data, false).readInt(), PresetLibrary::indexMagic);
+        }
+
+        beginTest("6. Polls Only Scan Folders That Changed");
+        {
+            PresetLibrary library(indexFile);
+            library.addDirectory(folder);
+
+            expect(library.scanIfChanged(), "A new folder should be scanned");
+            expect(!library.scanIfChanged(), "Nothing has touched the folder since");
+
+            // Far enough from the folder's last change that the new one gets a different stamp
+            juce::Thread::sleep(50);
+
+            int generation = library.getGeneration();
+            writePreset(folder.getChildFile("Strings.xml"), makeConfig(1, 7, 1));
+
+            expect(library.scanIfChanged(), "Adding a preset changes the folder");
+            expectGreaterThan(library.getGeneration(), generation);
+            expectEquals((int)library.getPresets()->size(), 3);
+
+            library.rescan();
+            expect(library.scanIfChanged(), "Asking for a rescan should scan whatever the folder says");
+        }
+
+        root.deleteRecursively();
+    }
+
+private:
+    static PresetConfig makeConfig(int outputMode, int rootNote, int scaleType) {
+        PresetConfig config;
+        config.outputMode = outputMode;
+        config.rootNote = rootNote;
+        config.scaleType = scaleType;
+        return config;
+    }
+
+    static void writePreset(const juce::File& file, const PresetConfig& config) {
+        file.replaceWithText(config.toXml()->toString());
+    }
+};
+
+static PresetLibraryTests presetLibraryTestsInstance;
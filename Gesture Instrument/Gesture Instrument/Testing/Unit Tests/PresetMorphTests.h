@@ -0,0 +1,115 @@
+#pragma once
+#include <JuceHeader.h>
+#include "../../Source/Helpers/PresetMorph.h"
+
+class PresetMorphTests : public juce::UnitTest {
+public:
+    PresetMorphTests() : juce::UnitTest("Preset Morph Tests") {}
+
+    void runTest() override {
+        PresetConfig from, to;
+        from.staticCutoff = 0.2f;
+        to.staticCutoff = 0.8f;
+        from.staticReverb = 0.5f;
+        to.staticReverb = 0.5f;
+
+        int cutoff = indexOf(GestureTarget::Cutoff);
+        int reverb = indexOf(GestureTarget::Reverb);
+
+        beginTest("1. A Jump Lands On The New Preset Straight Away");
+        {
+            PresetMorph morph;
+            morph.start(from, to, {});
+            expect(morph.isActive(), "The first block still has to write the new values");
+
+            morph.advance(0.01f, -1.0f);
+            expectEquals(morph.getValue(cutoff), 0.8f);
+            expect(!morph.isActive());
+        }
+
+        beginTest("2. A Glide Moves Over Its Time And Stops At The End");
+        {
+            PresetTransition transition;
+            transition.morph = PresetTransition::Morph::time;
+            transition.morphSeconds = 1.0f;
+
+            PresetMorph morph;
+            morph.start(from, to, transition);
+
+            morph.advance(0.5f, -1.0f);
+            expectWithinAbsoluteError(morph.getValue(cutoff), 0.5f, 0.0001f, "Halfway through should be halfway there");
+            expect(morph.isActive());
+
+            morph.advance(0.75f, -1.0f);
+            expectEquals(morph.getValue(cutoff), 0.8f, "Overshooting the time should land exactly on the end value");
+            expect(!morph.isActive(), "The dials own the statics again once the glide ends");
+        }
+
+        beginTest("3. A Gesture Morph Follows The Hand And Holds Without It");
+        {
+            PresetTransition transition;
+            transition.morph = PresetTransition::Morph::rightY;
+
+            PresetMorph morph;
+            morph.start(from, to, transition);
+
+            morph.advance(0.01f, 0.25f);
+            expectWithinAbsoluteError(morph.getValue(cutoff), 0.35f, 0.0001f);
+
+            morph.advance(0.01f, -1.0f);
+            expectWithinAbsoluteError(morph.getValue(cutoff), 0.35f, 0.0001f, "An absent hand should hold the morph where it was");
+
+            morph.advance(100.0f, 1.0f);
+            expectEquals(morph.getValue(cutoff), 0.8f);
+            expect(morph.isActive(), "A gesture morph lasts until the next switch");
+        }
+
+        beginTest("4. Changes Are Sent Only When They Move Far Enough");
+        {
+            PresetTransition transition;
+            transition.morph = PresetTransition::Morph::time;
+            transition.morphSeconds = 1.0f;
+
+            PresetMorph morph;
+            morph.start(from, to, transition);
+            expect(!morph.takeChange(cutoff, 0.01f), "Nothing has moved yet");
+
+            morph.advance(0.01f, -1.0f);
+            expect(!morph.takeChange(cutoff, 0.01f), "Under the step, nothing should be sent");
+
+            morph.advance(0.1f, -1.0f);
+            expect(morph.takeChange(cutoff, 0.01f));
+            expect(!morph.takeChange(cutoff, 0.01f), "A sent value shouldn't be sent again");
+            expect(!morph.takeChange(reverb, 0.01f), "A static both presets share should never be sent");
+
+            morph.advance(0.885f, -1.0f);
+            morph.advance(0.01f, -1.0f);
+            expect(morph.takeChange(cutoff, 1.0f), "The end value should always be sent, however small the last step");
+        }
+
+        beginTest("5. Hand Position Covers The Play Area");
+        {
+            PlayArea area;
+            HandData left, right;
+            right.isPresent = true;
+            right.currentHandPositionX = 0.0f;
+            right.currentHandPositionY = 450.0f;
+            right.currentHandPositionZ = -150.0f;
+
+            using Morph = PresetTransition::Morph;
+            expectEquals(PresetMorph::getHandPosition(Morph::rightX, left, right, area), 0.5f);
+            expectEquals(PresetMorph::getHandPosition(Morph::rightY, left, right, area), 1.0f);
+            expectEquals(PresetMorph::getHandPosition(Morph::rightZ, left, right, area), 1.0f, "Z should be inverted like everywhere else");
+            expectEquals(PresetMorph::getHandPosition(Morph::leftX, left, right, area), -1.0f, "An absent hand has no position");
+        }
+    }
+
+private:
+    static int indexOf(GestureTarget target) {
+        for (int i = 0; i < PresetMorph::numStatics; ++i)
+            if (PresetMorph::statics[(size_t)i].target == target) return i;
+        return -1;
+    }
+};
+
+static PresetMorphTests presetMorphTestsInstance;
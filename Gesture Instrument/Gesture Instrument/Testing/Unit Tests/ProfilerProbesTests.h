@@ -0,0 +1,110 @@
+#pragma once
+#include <JuceHeader.h>
+#include <vector>
+#include "../../Source/Helpers/ProfilerProbes.h"
+
+class ProfilerProbesTests : public juce::UnitTest {
+public:
+    ProfilerProbesTests() : juce::UnitTest("Profiler Probes Tests") {}
+
+    void runTest() override {
+        beginTest("1. Percentiles Land Within A Bucket Of The Truth");
+        {
+            RollingHistogram histogram(0.001f, 1000.0f);
+
+            // 1 to 100 ms evenly, p50 is 50 and p99 is 99
+            for (int i = 1; i <= 100; ++i) histogram.add((float)i);
+
+            expectEquals(histogram.getCount(), 100);
+            expectWithinAbsoluteError(histogram.getPercentile(0.5f), 50.0f, 50.0f * 0.06f, "p50 is off by more than a bucket.");
+            expectWithinAbsoluteError(histogram.getPercentile(0.99f), 99.0f, 99.0f * 0.06f, "p99 is off by more than a bucket.");
+        }
+
+        beginTest("2. Rare Spikes Show In p99 But Not p50");
+        {
+            RollingHistogram histogram(0.001f, 1000.0f);
+
+            for (int i = 0; i < 980; ++i) histogram.add(0.2f);
+            for (int i = 0; i < 20; ++i) histogram.add(12.0f);
+
+            expect(histogram.getPercentile(0.5f) < 0.25f, "Rare spikes moved the median.");
+            expectWithinAbsoluteError(histogram.getPercentile(0.99f), 12.0f, 12.0f * 0.06f, "p99 did not land on the spike.");
+        }
+
+        beginTest("3. Old Samples Roll Out Of The Window");
+        {
+            RollingHistogram histogram(0.001f, 1000.0f);
+            histogram.add(500.0f);
+
+            for (int i = 0; i < RollingHistogram::numSlices - 1; ++i) {
+                histogram.advance();
+                histogram.add(1.0f);
+            }
+            expect(histogram.getPercentile(1.0f) > 400.0f, "Sample left the window too early.");
+
+            histogram.advance();
+            expectEquals(histogram.getCount(), RollingHistogram::numSlices - 1);
+            expect(histogram.getPercentile(1.0f) < 1.1f, "Sample outstayed the window.");
+        }
+
+        beginTest("4. Values Outside The Range Are Clamped");
+        {
+            RollingHistogram histogram(0.5f, 100.0f);
+
+            expectEquals(histogram.getPercentile(0.5f), 0.0f, "Empty window should read 0.");
+
+            histogram.add(0.0f);
+            expectEquals(histogram.getPercentile(0.5f), 0.0f, "Values below the range should read 0.");
+
+            histogram.clear();
+            histogram.add(1.0e6f);
+            expectWithinAbsoluteError(histogram.getPercentile(0.5f), 100.0f, 0.01f, "Values above the range should read as the top.");
+        }
+
+        beginTest("5. Ring Keeps Order And Counts What It Drops");
+        {
+            ProbeRing ring;
+            for (int i = 0; i < 2000; ++i) ring.push((float)i);
+
+            std::vector<float> drained;
+            ring.drain([&drained](float value) { drained.push_back(value); });
+
+            expect(!drained.empty() && drained.size() < 2000, "Ring should have filled up.");
+            expectEquals(ring.takeDropped(), 2000 - (int)drained.size());
+            expectEquals(ring.takeDropped(), 0);
+
+            bool inOrder = true;
+            for (size_t i = 0; i < drained.size(); ++i) inOrder = inOrder && drained[i] == (float)i;
+            expect(inOrder, "Samples came out of order.");
+
+            // Space is free again after a drain, and wraps around the end
+            for (int i = 0; i < 100; ++i) ring.push((float)i);
+            int count = 0;
+            ring.drain([&count](float) { ++count; });
+            expectEquals(count, 100);
+        }
+
+        beginTest("6. Probes Record Nothing While Disabled");
+        {
+            ProfilerProbes probes;
+            { ProfilerProbes::ScopedTimer timer(probes, ProfilerProbes::uiPaint); }
+            probes.push(ProfilerProbes::oscMessages, 3.0f);
+
+            int count = 0;
+            probes.getRing(ProfilerProbes::uiPaint).drain([&count](float) { ++count; });
+            probes.getRing(ProfilerProbes::oscMessages).drain([&count](float) { ++count; });
+            expectEquals(count, 0);
+
+            probes.setEnabled(true);
+            { ProfilerProbes::ScopedBlockTimer timer(probes, 480, 48000.0); }
+
+            float load = -1.0f;
+            probes.getRing(ProfilerProbes::blockTime).drain([&count](float) { ++count; });
+            probes.getRing(ProfilerProbes::blockLoad).drain([&load](float value) { load = value; });
+            expectEquals(count, 1);
+            expect(load >= 0.0f && load < 100.0f, "An empty block should use a fraction of its 10 ms.");
+        }
+    }
+};
+
+static ProfilerProbesTests profilerProbesTestsInstance;
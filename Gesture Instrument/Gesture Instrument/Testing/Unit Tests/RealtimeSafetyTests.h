@@ -0,0 +1,237 @@
+#pragma once
+#include <JuceHeader.h>
+#include "../../Source/Helpers/RealtimeVerifier.h"
+
+// Needs the verifier compiled in, GestureTests.jucer defines GESTURE_RT_VERIFY
+#if GESTURE_RT_VERIFY
+#include "SessionReplay.h"
+
+class RealtimeSafetyTests : public juce::UnitTest {
+public:
+    RealtimeSafetyTests() : juce::UnitTest("Realtime Safety Tests") {}
+
+    void runTest() override {
+        using Kind = RealtimeVerifier::Kind;
+
+        beginTest("1. Allocations In A Scope Are Blamed On The Innermost Site");
+        {
+            startChecking();
+            {
+                RealtimeVerifier::Scope scope(512, 48000.0);
+                RealtimeVerifier::onAllocation();
+
+                RealtimeVerifier::Site outer("Outer");
+                RealtimeVerifier::onAllocation();
+                {
+                    RealtimeVerifier::Site inner("Inner");
+                    RealtimeVerifier::onAllocation();
+                    RealtimeVerifier::onAllocation();
+                }
+                RealtimeVerifier::onAllocation();
+            }
+            auto violations = stopChecking();
+
+            expectEquals((int)violations.size(), 3, "One entry per site");
+            expectEquals(countOf(violations, Kind::allocation, "processBlock"), 1, "Outside any site it's processBlock's");
+            expectEquals(countOf(violations, Kind::allocation, "Outer"), 2, "Leaving Inner should hand blame back to Outer");
+            expectEquals(countOf(violations, Kind::allocation, "Inner"), 2);
+
+            for (const auto& violation : violations)
+                expect(violation.backtrace.isNotEmpty(), "Every violation keeps where it first happened");
+        }
+
+        beginTest("2. Nothing Is Recorded Outside A Scope Or While Disabled");
+        {
+            startChecking();
+            RealtimeVerifier::onAllocation();
+            RealtimeVerifier::onBlockingCall("Outside");
+            expectEquals((int)stopChecking().size(), 0, "Only the audio callback is checked");
+
+            RealtimeVerifier::clear();
+            {
+                RealtimeVerifier::Scope scope(512, 48000.0);
+                RealtimeVerifier::onAllocation();
+            }
+            expectEquals((int)RealtimeVerifier::getViolations().size(), 0, "A disabled verifier records nothing");
+        }
+
+        beginTest("3. Blocking On A Lock Is Reported, Trying It Is Not");
+        {
+            CheckedCriticalSection lock("Test::lock");
+
+            startChecking();
+            {
+                RealtimeVerifier::Scope scope(512, 48000.0);
+                { const CheckedCriticalSection::ScopedTryLockType tryLock(lock); }
+            }
+            expectEquals((int)stopChecking().size(), 0, "A try lock can't block the callback");
+
+            startChecking();
+            {
+                RealtimeVerifier::Scope scope(512, 48000.0);
+                { const CheckedCriticalSection::ScopedLockType blockingLock(lock); }
+            }
+            auto violations = stopChecking();
+
+            expectEquals(countOf(violations, Kind::lock, "processBlock"), 1);
+            if (violations.size() == 1) expectEquals(violations[0].detail, juce::String("Test::lock"), "The lock should be named");
+        }
+
+        beginTest("4. Loop Guards Trip Once Past The Limit");
+        {
+            startChecking();
+            {
+                RealtimeVerifier::Scope scope(512, 48000.0);
+
+                RealtimeVerifier::LoopGuard bounded("Bounded");
+                for (int i = 0; i < RealtimeVerifier::maxLoopIterations; ++i) bounded.iterate();
+
+                RealtimeVerifier::LoopGuard runaway("Runaway");
+                for (int i = 0; i < RealtimeVerifier::maxLoopIterations * 3; ++i) runaway.iterate();
+            }
+            auto violations = stopChecking();
+
+            expectEquals((int)violations.size(), 1, "Only the runaway loop should trip");
+            if (violations.size() == 1) {
+                expect(violations[0].kind == Kind::loop);
+                expectEquals(violations[0].detail, juce::String("Runaway"));
+                expectEquals(violations[0].count, 1, "A loop trips once however far past the limit it goes");
+            }
+        }
+
+        beginTest("5. Overruns Are Only Checked When Asked For");
+        {
+            startChecking();
+            {
+                RealtimeVerifier::Scope scope(64, 48000.0);
+                juce::Thread::sleep(5);
+            }
+            expectEquals((int)stopChecking().size(), 0, "The overrun check is off by default");
+
+            // 64 samples is 1.3 ms, so 5 ms is well past twice that
+            RealtimeVerifier::setOverrunFactor(2.0);
+            startChecking();
+            {
+                RealtimeVerifier::Scope scope(64, 48000.0);
+                juce::Thread::sleep(5);
+            }
+            auto violations = stopChecking();
+            RealtimeVerifier::setOverrunFactor(0.0);
+
+            expectEquals(countOf(violations, Kind::overrun, "processBlock"), 1);
+        }
+
+        beginTest("6. Every Form Of New Is Seen");
+        {
+            struct alignas(64) Aligned { float values[16]; };
+            static_assert(!std::is_base_of<juce::CriticalSection, CheckedCriticalSection>::value,
+                          "A CheckedCriticalSection must not be usable as an unchecked lock");
+
+            startChecking();
+            {
+                RealtimeVerifier::Scope scope(512, 48000.0);
+
+                // volatile so the compiler can't pair up and drop the allocations
+                int* volatile plain = new (std::nothrow) int(1);
+                Aligned* volatile aligned = new Aligned();
+                Aligned* volatile alignedArray = new (std::nothrow) Aligned[2];
+                delete plain;
+                delete aligned;
+                delete[] alignedArray;
+            }
+            auto violations = stopChecking();
+
+            expectEquals(countOf(violations, Kind::allocation, "processBlock"), 3, "Nothrow and over-aligned new go through the same check");
+        }
+
+        beginTest("7. Replayed Sessions Stay Inside The Known Violations");
+        {
+            for (const auto& scenario : SessionReplay::makeScenarios()) {
+                for (int blockSize : { 32, 256, 1024 }) {
+                    GestureInstrumentAudioProcessor::isRunningInUnitTest = true;
+                    GestureInstrumentAudioProcessor processor;
+
+                    startChecking();
+                    SessionReplay::play(processor, scenario, blockSize, 48000.0);
+                    auto violations = stopChecking();
+
+                    juce::String name = scenario.name + " @ " + juce::String(blockSize);
+                    for (const auto& violation : violations) {
+                        if (const char* reason = findKnownReason(violation)) {
+                            logMessage("   " + name + ": " + RealtimeVerifier::describe(violation) + ", known: " + reason);
+                            continue;
+                        }
+
+                        expect(false, name + ": " + RealtimeVerifier::describe(violation) + "\n" + violation.backtrace);
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    // Every site the audio path is known to violate from, with why. Logged rather than failed until they're fixed,
+    // a violation from any other site, or of another kind or detail from one of these, fails the test
+    struct KnownViolation {
+        RealtimeVerifier::Kind kind;
+        const char* site;
+        const char* detail;
+        const char* reason;
+    };
+
+    static const char* findKnownReason(const RealtimeVerifier::Violation& violation) {
+        using Kind = RealtimeVerifier::Kind;
+
+        static const char* oscBuilds = "OSC messages and their addresses are built per send";
+        static const char* oscSends = "OSC is sent over UDP from the audio thread";
+
+        static const KnownViolation known[] = {
+            { Kind::allocation, "MidiManager::processHandData", "", "chord shapes are built in std::vectors" },
+            { Kind::allocation, "OscManager::sendEnvelopeData", "", oscBuilds },
+            { Kind::allocation, "OscManager::sendGlobalWaveform", "", oscBuilds },
+            { Kind::allocation, "OscManager::sendGlobalVolume", "", oscBuilds },
+            { Kind::allocation, "OscManager::sendGlobalParameter", "", oscBuilds },
+            { Kind::allocation, "OscManager::sendRawData", "", oscBuilds },
+            { Kind::allocation, "OscManager::sendStrike", "", oscBuilds },
+            { Kind::allocation, "OscManager::sendMidiData", "", oscBuilds },
+            { Kind::allocation, "OscManager::processHandData", "", oscBuilds },
+            { Kind::allocation, "OscManager::panicLeft", "", oscBuilds },
+            { Kind::allocation, "OscManager::panicRight", "", oscBuilds },
+            { Kind::blockingCall, "OscManager::sendEnvelopeData", "OSCSender::send", oscSends },
+            { Kind::blockingCall, "OscManager::sendGlobalWaveform", "OSCSender::send", oscSends },
+            { Kind::blockingCall, "OscManager::sendGlobalVolume", "OSCSender::send", oscSends },
+            { Kind::blockingCall, "OscManager::sendGlobalParameter", "OSCSender::send", oscSends },
+            { Kind::blockingCall, "OscManager::sendRawData", "OSCSender::send", oscSends },
+            { Kind::blockingCall, "OscManager::sendStrike", "OSCSender::send", oscSends },
+            { Kind::blockingCall, "OscManager::sendMidiData", "OSCSender::send", oscSends },
+            { Kind::blockingCall, "OscManager::processHandData", "OSCSender::send", oscSends },
+            { Kind::blockingCall, "OscManager::panicLeft", "OSCSender::send", oscSends },
+            { Kind::blockingCall, "OscManager::panicRight", "OSCSender::send", oscSends }
+        };
+
+        for (const auto& entry : known)
+            if (violation.kind == entry.kind && violation.site == entry.site && violation.detail == entry.detail) return entry.reason;
+
+        return nullptr;
+    }
+
+    static void startChecking() {
+        RealtimeVerifier::clear();
+        RealtimeVerifier::setEnabled(true);
+    }
+
+    static std::vector<RealtimeVerifier::Violation> stopChecking() {
+        RealtimeVerifier::setEnabled(false);
+        return RealtimeVerifier::getViolations();
+    }
+
+    static int countOf(const std::vector<RealtimeVerifier::Violation>& violations, RealtimeVerifier::Kind kind, const char* site) {
+        for (const auto& violation : violations)
+            if (violation.kind == kind && violation.site == site) return violation.count;
+
+        return 0;
+    }
+};
+
+static RealtimeSafetyTests realtimeSafetyTestsInstance;
+#endif
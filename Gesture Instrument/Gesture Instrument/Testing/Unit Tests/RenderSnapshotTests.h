@@ -0,0 +1,78 @@
+#pragma once
+#include <JuceHeader.h>
+#include <thread>
+#include "../../Source/Helpers/RenderSnapshot.h"
+#include "../../Source/Helpers/TripleBuffer.h"
+
+class RenderSnapshotTests : public juce::UnitTest {
+public:
+    RenderSnapshotTests() : juce::UnitTest("Render Snapshot Tests") {}
+
+    void runTest() override {
+        beginTest("1. Nothing New Before The First Publish");
+        {
+            TripleBuffer<RenderSnapshot> buffer;
+            expect(!buffer.acquire(), "Reader saw a snapshot that was never published.");
+            expect(buffer.getReadBuffer().version == 0, "Initial snapshot was not empty.");
+        }
+
+        beginTest("2. Reader Gets The Latest Publish Once");
+        {
+            TripleBuffer<RenderSnapshot> buffer;
+
+            for (unsigned long long v = 1; v <= 3; ++v) {
+                buffer.getWriteBuffer().version = v;
+                buffer.publish();
+            }
+
+            expect(buffer.acquire(), "Published snapshot was not picked up.");
+            expect(buffer.getReadBuffer().version == 3, "Reader got an older snapshot than the last publish.");
+            expect(!buffer.acquire(), "The same snapshot was reported as new twice.");
+            expect(buffer.getReadBuffer().version == 3, "Read buffer changed without a new publish.");
+        }
+
+        beginTest("3. No Torn Frames Under Contention");
+        {
+            // Writer stamps every field with the same counter, a torn read would mix two counters
+            TripleBuffer<RenderSnapshot> buffer;
+            const int numFrames = 20000;
+            int tornFrames = 0, framesSeen = 0;
+            unsigned long long lastVersion = 0;
+            bool wentBackwards = false;
+
+            std::thread writer([&buffer, numFrames] {
+                for (int i = 1; i <= numFrames; ++i) {
+                    auto& s = buffer.getWriteBuffer();
+                    s.version = (unsigned long long)i;
+                    s.leftHand.currentHandPositionX = (float)i;
+                    for (int f = 0; f < 5; ++f) s.rightHand.fingers[f].tipY = (float)i;
+                    for (int n = 0; n < RenderSnapshot::maxNotes; ++n) s.leftNotes[n] = i;
+                    buffer.publish();
+                }
+                });
+
+            while (lastVersion < (unsigned long long)numFrames) {
+                if (!buffer.acquire()) continue;
+
+                const auto& s = buffer.getReadBuffer();
+                float stamp = (float)s.version;
+                bool isTorn = s.leftHand.currentHandPositionX != stamp;
+                for (int f = 0; f < 5; ++f) isTorn |= s.rightHand.fingers[f].tipY != stamp;
+                for (int n = 0; n < RenderSnapshot::maxNotes; ++n) isTorn |= s.leftNotes[n] != (int)s.version;
+
+                if (isTorn) ++tornFrames;
+                if (s.version <= lastVersion) wentBackwards = true;
+                lastVersion = s.version;
+                ++framesSeen;
+            }
+
+            writer.join();
+
+            expectEquals(tornFrames, 0, "Reader saw a snapshot mixed from two publishes.");
+            expect(!wentBackwards, "Reader was handed an older snapshot after a newer one.");
+            expect(framesSeen > 0, "Reader never saw a snapshot.");
+        }
+    }
+};
+
+static RenderSnapshotTests renderSnapshotTestsInstance;
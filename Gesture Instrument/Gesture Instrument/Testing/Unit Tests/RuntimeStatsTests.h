@@ -0,0 +1,150 @@
+#pragma once
+#include <JuceHeader.h>
+#include "../../Source/Helpers/RuntimeStats.h"
+#include "../../Source/OSC/StatsPublisher.h"
+
+class RuntimeStatsTests : public juce::UnitTest {
+public:
+    RuntimeStatsTests() : juce::UnitTest("Runtime Stats Tests") {}
+
+    void runTest() override {
+        beginTest("1. Nothing Is Counted While The Feed Is Off");
+        {
+            RuntimeStats stats;
+            stats.sensorFrame(1);
+            stats.sensorFrame(5);
+            stats.framePickedUp(5, 0.0, false);
+            stats.uiFrame();
+            { RuntimeStats::ScopedBlock block(stats, 512, 48000.0); }
+
+            auto s = stats.take(1.0);
+            expectEquals(s.sensorFps, 0.0f);
+            expectEquals(s.sensorDroppedPerSecond, 0.0f);
+            expectEquals(s.lockMisses, 0);
+            expectEquals(s.uiFps, 0.0f);
+            expectEquals(s.audioBlocksPerSecond, 0.0f);
+        }
+
+        beginTest("2. Sensor Rate And Drops Come From Frame Ids");
+        {
+            RuntimeStats stats;
+            stats.setEnabled(true);
+
+            // 10 frames arrive, 4 ids in between never do
+            for (long long id : { 1, 2, 3, 5, 6, 7, 10, 11, 12, 14 }) stats.sensorFrame(id);
+
+            auto s = stats.take(0.5);
+            expectWithinAbsoluteError(s.sensorFps, 20.0f, 1.0e-4f, "Rates are per second, not per period");
+            expectWithinAbsoluteError(s.sensorDroppedPerSecond, 8.0f, 1.0e-4f);
+
+            expectEquals(stats.take(1.0).sensorFps, 0.0f, "Taking a snapshot starts the counters again");
+        }
+
+        beginTest("3. Pickups Split Into Skipped, Repeated And Lock Misses");
+        {
+            RuntimeStats stats;
+            stats.setEnabled(true);
+
+            for (long long id = 1; id <= 6; ++id) stats.sensorFrame(id);
+
+            // Blocks saw frames 2, 2, 4, 6, 6, 6 and the lock was busy once
+            stats.framePickedUp(2, 0.0, true);
+            stats.framePickedUp(2, 0.0, false);
+            stats.framePickedUp(4, 0.0, true);
+            stats.framePickedUp(6, 0.0, true);
+            stats.framePickedUp(6, 0.0, true);
+            stats.framePickedUp(6, 0.0, true);
+
+            auto s = stats.take(1.0);
+            expectWithinAbsoluteError(s.framesSkippedPerSecond, 3.0f, 1.0e-4f, "Frames 1, 3 and 5 were never read");
+            expectWithinAbsoluteError(s.framesRepeatedPerSecond, 3.0f, 1.0e-4f);
+            expectEquals(s.lockMisses, 1);
+        }
+
+        beginTest("4. Staleness Is Publish To Pickup");
+        {
+            RuntimeStats stats;
+            stats.setEnabled(true);
+
+            double nowSeconds = juce::Time::getMillisecondCounterHiRes() * 0.001;
+            stats.framePickedUp(1, nowSeconds - 0.010, true);
+            stats.framePickedUp(2, nowSeconds - 0.030, true);
+
+            auto s = stats.take(1.0);
+            expectGreaterOrEqual(s.stalenessMaxMs, 30.0f);
+            expectGreaterOrEqual(s.stalenessMeanMs, 20.0f);
+            expectLessThan(s.stalenessMeanMs, s.stalenessMaxMs, "The mean should sit under the oldest pickup");
+        }
+
+        beginTest("5. MIDI Is Counted Per Channel");
+        {
+            RuntimeStats stats;
+            stats.setEnabled(true);
+
+            juce::MidiBuffer midi;
+            midi.addEvent(juce::MidiMessage::noteOn(1, 60, (juce::uint8)100), 0);
+            midi.addEvent(juce::MidiMessage::noteOn(3, 62, (juce::uint8)100), 10);
+            midi.addEvent(juce::MidiMessage::controllerEvent(3, 1, 64), 20);
+            stats.output(midi, 7);
+            stats.output(midi, 3);
+
+            auto s = stats.take(2.0);
+            expectWithinAbsoluteError(s.midiEventsPerSecond[0], 1.0f, 1.0e-4f);
+            expectWithinAbsoluteError(s.midiEventsPerSecond[2], 2.0f, 1.0e-4f);
+            expectEquals(s.midiEventsPerSecond[1], 0.0f);
+            expectWithinAbsoluteError(s.oscPacketsPerSecond, 5.0f, 1.0e-4f);
+        }
+
+        beginTest("6. Audio Load Is Time Spent Over Time Covered");
+        {
+            RuntimeStats stats;
+            stats.setEnabled(true);
+
+            // 480 samples is 10 ms, so 5 ms of work is about half
+            {
+                RuntimeStats::ScopedBlock block(stats, 480, 48000.0);
+                juce::Thread::sleep(5);
+            }
+            { RuntimeStats::ScopedBlock block(stats, 480, 48000.0); }
+
+            auto s = stats.take(1.0);
+            expectWithinAbsoluteError(s.audioBlocksPerSecond, 2.0f, 1.0e-4f);
+            expectGreaterOrEqual(s.audioLoadMaxPercent, 40.0f);
+            expectLessThan(s.audioLoadMeanPercent, s.audioLoadMaxPercent, "One idle block should pull the mean under the max");
+        }
+
+        beginTest("7. A Snapshot Becomes One Bundle");
+        {
+            RuntimeStats::Snapshot s;
+            s.periodSeconds = 1.0;
+            s.sensorFps = 110.0f;
+            s.lockMisses = 4;
+            s.midiEventsPerSecond[15] = 12.0f;
+
+            auto bundle = StatsPublisher::createBundle(s, "stage-left");
+            expectEquals(bundle.size(), 7);
+
+            bool foundMidi = false;
+            for (const auto& element : bundle) {
+                if (!element.isMessage()) continue;
+
+                const auto& message = element.getMessage();
+                auto address = message.getAddressPattern().toString();
+
+                if (address == "/stats/host") expectEquals(message[0].getString(), juce::String("stage-left"));
+                if (address == "/stats/sensor") expectEquals(message[0].getFloat32(), 110.0f);
+                if (address == "/stats/frames") expectEquals(message[4].getInt32(), 4);
+
+                if (address == "/stats/midi") {
+                    foundMidi = true;
+                    expectEquals(message.size(), RuntimeStats::numMidiChannels);
+                    expectEquals(message[15].getFloat32(), 12.0f);
+                }
+            }
+
+            expect(foundMidi, "Every channel's rate should be sent");
+        }
+    }
+};
+
+static RuntimeStatsTests runtimeStatsTestsInstance;
@@ -0,0 +1,270 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <functional>
+#include <vector>
+#include "../../Source/PluginProcessor.h"
+#include "../Benchmarks/SyntheticHands.h"
+
+// Sensor sessions that tests play through processBlock with the Leap thread off.
+// Frames are injected on the audio clock at the start of the block they're due in, the same way the Leap thread
+// would have published them, so a session plays back identically at any block size
+namespace SessionReplay {
+    struct Frame {
+        double timeSeconds = 0.0;
+        HandData left, right;
+        bool connected = true;
+    };
+
+    using Session = std::vector<Frame>;
+
+    // Both hands sweeping the play area, see SyntheticHands
+    inline Session makeSynthetic(double seconds, double rateHz = 120.0) {
+        SyntheticHands hands(rateHz);
+        Session session;
+
+        for (int i = 0; i < (int)(seconds * rateHz); ++i) {
+            Frame frame;
+            frame.timeSeconds = i / rateHz;
+            hands.generate(i, frame.left, frame.right);
+            session.push_back(frame);
+        }
+
+        return session;
+    }
+
+    // The synthetic hands, gone for the middle third so the disconnect panics run
+    inline Session makeEnterAndLeave(double seconds, double rateHz = 120.0) {
+        auto session = makeSynthetic(seconds, rateHz);
+
+        for (auto& frame : session) {
+            if (frame.timeSeconds < seconds / 3.0 || frame.timeSeconds >= seconds * 2.0 / 3.0) continue;
+            frame.left = {};
+            frame.right = {};
+        }
+
+        return session;
+    }
+
+    // The right palm dropping 60 mm in three frames twice a second, fast enough for the onset detector
+    inline Session makeStrikes(double seconds, double rateHz = 120.0) {
+        auto session = makeSynthetic(seconds, rateHz);
+        int framesPerStrike = juce::jmax(8, (int)(rateHz * 0.5));
+
+        for (size_t i = 0; i < session.size(); ++i) {
+            int phase = (int)i % framesPerStrike;
+            float drop = phase < 3 ? 20.0f * (float)phase : 60.0f * (1.0f - (float)(phase - 3) / (float)(framesPerStrike - 3));
+
+            auto& right = session[i].right;
+            right.currentHandPositionY = 300.0f - drop;
+            for (auto& finger : right.fingers) finger.tipY = right.currentHandPositionY - 20.0f;
+        }
+
+        return session;
+    }
+
+    // Sessions as text, so recordings can sit next to the golden files and show up in a diff.
+    // One frame per line: time, connected, then each hand as present followed by, if it is, palm, wrist, grab,
+    // pinch, isPinching and per finger its type, tip, joint1, joint2, knuckle and isExtended. # starts a comment
+    inline juce::String toText(const Session& session) {
+        juce::String text("# GestureInstrument session v1\n");
+
+        auto addHand = [&text](const HandData& hand) {
+            text << " " << (hand.isPresent ? 1 : 0);
+            if (!hand.isPresent) return;
+
+            text << " " << hand.currentHandPositionX << " " << hand.currentHandPositionY << " " << hand.currentHandPositionZ
+                 << " " << hand.currentWristRotation << " " << hand.grabStrength << " " << hand.pinchStrength << " " << (hand.isPinching ? 1 : 0);
+
+            for (const auto& f : hand.fingers) {
+                text << " " << f.type
+                     << " " << f.tipX << " " << f.tipY << " " << f.tipZ
+                     << " " << f.joint1X << " " << f.joint1Y << " " << f.joint1Z
+                     << " " << f.joint2X << " " << f.joint2Y << " " << f.joint2Z
+                     << " " << f.knuckleX << " " << f.knuckleY << " " << f.knuckleZ
+                     << " " << (f.isExtended ? 1 : 0);
+            }
+            };
+
+        for (const auto& frame : session) {
+            text << frame.timeSeconds << " " << (frame.connected ? 1 : 0);
+            addHand(frame.left);
+            addHand(frame.right);
+            text << "\n";
+        }
+
+        return text;
+    }
+
+    // Lines that don't parse are skipped
+    inline Session fromText(const juce::String& text) {
+        Session session;
+
+        for (auto line : juce::StringArray::fromLines(text)) {
+            line = line.upToFirstOccurrenceOf("#", false, false).trim();
+            if (line.isEmpty()) continue;
+
+            auto tokens = juce::StringArray::fromTokens(line, " ", "");
+            int next = 0;
+            bool isValid = true;
+
+            auto read = [&]() -> float {
+                if (next >= tokens.size()) {
+                    isValid = false;
+                    return 0.0f;
+                }
+                return tokens[next++].getFloatValue();
+                };
+
+            auto readHand = [&](HandData& hand) {
+                hand.isPresent = read() != 0.0f;
+                if (!hand.isPresent) return;
+
+                hand.currentHandPositionX = read(); hand.currentHandPositionY = read(); hand.currentHandPositionZ = read();
+                hand.currentWristRotation = read(); hand.grabStrength = read(); hand.pinchStrength = read();
+                hand.isPinching = read() != 0.0f;
+
+                for (auto& f : hand.fingers) {
+                    f.type = (int)read();
+                    f.tipX = read(); f.tipY = read(); f.tipZ = read();
+                    f.joint1X = read(); f.joint1Y = read(); f.joint1Z = read();
+                    f.joint2X = read(); f.joint2Y = read(); f.joint2Z = read();
+                    f.knuckleX = read(); f.knuckleY = read(); f.knuckleZ = read();
+                    f.isExtended = read() != 0.0f;
+                }
+                };
+
+            Frame frame;
+            frame.timeSeconds = next < tokens.size() ? tokens[next++].getDoubleValue() : 0.0;
+            frame.connected = read() != 0.0f;
+            readHand(frame.left);
+            readHand(frame.right);
+
+            if (isValid) session.push_back(frame);
+        }
+
+        return session;
+    }
+
+    inline bool save(const Session& session, const juce::File& file) { return file.replaceWithText(toText(session)); }
+    inline Session load(const juce::File& file) { return fromText(file.loadFileAsString()); }
+
+    inline double getLengthSeconds(const Session& session) {
+        return session.empty() ? 0.0 : session.back().timeSeconds;
+    }
+
+    using BlockCallback = std::function<void(int blockIndex, const juce::MidiBuffer& midi)>;
+
+    // Prepares the processor and plays the whole session, plus tailSeconds of silence from the sensor.
+    // onBlock sees each block's MIDI straight after processBlock
+    inline void play(GestureInstrumentAudioProcessor& processor, const Session& session, int blockSize, double sampleRate,
+                     const BlockCallback& onBlock = {}, double tailSeconds = 0.1) {
+        processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+        processor.prepareToPlay(sampleRate, blockSize);
+
+        // Hosts hand over buffers that are already big enough
+        juce::AudioBuffer<float> buffer(2, blockSize);
+        juce::MidiBuffer midi;
+        midi.ensureSize(16384);
+
+        int numBlocks = (int)std::ceil((getLengthSeconds(session) + tailSeconds) * sampleRate / blockSize);
+        size_t nextFrame = 0;
+
+        for (int block = 0; block < numBlocks; ++block) {
+            double blockStartSeconds = (double)block * blockSize / sampleRate;
+
+            while (nextFrame < session.size() && session[nextFrame].timeSeconds <= blockStartSeconds) {
+                Frame frame = session[nextFrame];
+
+                for (auto* hand : { &frame.left, &frame.right }) {
+                    hand->frameId = (long long)nextFrame + 1;
+                    hand->frameTimeSeconds = frame.timeSeconds;
+                    hand->captureSeconds = juce::Time::getMillisecondCounterHiRes() * 0.001;
+                }
+
+                processor.injectSensorFrame(frame.left, frame.right, frame.connected);
+                ++nextFrame;
+            }
+
+            midi.clear();
+            processor.processBlock(buffer, midi);
+            if (onBlock) onBlock(block, midi);
+        }
+
+        processor.releaseResources();
+    }
+
+    // A session and the settings to play it with
+    struct Scenario {
+        juce::String name; // Also names its golden files
+        Session session;
+        std::function<void(GestureInstrumentAudioProcessor&)> configure;
+        bool mutesHalfway = false; // Global mute from 0.5 s to 1 s
+    };
+
+    // Every output path the audio thread can take
+    inline std::vector<Scenario> makeScenarios() {
+        auto synthetic = makeSynthetic(2.0);
+        auto strikes = makeStrikes(2.0);
+        std::vector<Scenario> scenarios;
+
+        scenarios.push_back({ "midi", synthetic, [](GestureInstrumentAudioProcessor& p) {
+            p.currentOutputMode = OutputMode::MIDI_Only;
+            p.chordEngineEnabled.store(false);
+            } });
+
+        scenarios.push_back({ "midi_chords", synthetic, [](GestureInstrumentAudioProcessor& p) {
+            p.currentOutputMode = OutputMode::MIDI_Only;
+            p.chordEngineEnabled.store(true);
+            } });
+
+        scenarios.push_back({ "mpe", synthetic, [](GestureInstrumentAudioProcessor& p) {
+            p.currentOutputMode = OutputMode::MIDI_Only;
+            p.isMpeEnabled = true;
+            } });
+
+        scenarios.push_back({ "midi_strikes", strikes, [](GestureInstrumentAudioProcessor& p) {
+            p.currentOutputMode = OutputMode::MIDI_Only;
+            p.strikeTriggerEnabled.store(true);
+            } });
+
+        scenarios.push_back({ "midi_hands_leaving", makeEnterAndLeave(2.0), [](GestureInstrumentAudioProcessor& p) {
+            p.currentOutputMode = OutputMode::MIDI_Only;
+            } });
+
+        scenarios.push_back({ "midi_mute", synthetic, [](GestureInstrumentAudioProcessor& p) {
+            p.currentOutputMode = OutputMode::MIDI_Only;
+            }, true });
+
+        scenarios.push_back({ "osc", synthetic, [](GestureInstrumentAudioProcessor& p) {
+            p.currentOutputMode = OutputMode::OSC_Only;
+            } });
+
+        scenarios.push_back({ "osc_strikes", strikes, [](GestureInstrumentAudioProcessor& p) {
+            p.currentOutputMode = OutputMode::OSC_Only;
+            p.strikeTriggerEnabled.store(true);
+            } });
+
+        scenarios.push_back({ "osc_mute", synthetic, [](GestureInstrumentAudioProcessor& p) {
+            p.currentOutputMode = OutputMode::OSC_Only;
+            }, true });
+
+        return scenarios;
+    }
+
+    inline void play(GestureInstrumentAudioProcessor& processor, const Scenario& scenario, int blockSize, double sampleRate,
+                     const BlockCallback& onBlock = {}) {
+        if (scenario.configure) scenario.configure(processor);
+
+        int muteFrom = scenario.mutesHalfway ? (int)(0.5 * sampleRate / blockSize) : -1;
+        int muteTo = scenario.mutesHalfway ? (int)(1.0 * sampleRate / blockSize) : -1;
+
+        play(processor, scenario.session, blockSize, sampleRate, [&](int block, const juce::MidiBuffer& midi) {
+            if (onBlock) onBlock(block, midi);
+
+            // Takes effect from the next block
+            if (block + 1 == muteFrom) processor.globalMute.store(true);
+            if (block + 1 == muteTo) processor.globalMute.store(false);
+            });
+    }
+}
@@ -0,0 +1,190 @@
+#pragma once
+#include <JuceHeader.h>
+#include "../../Source/Helpers/OneEuroFilter.h"
+#include "../../Source/Helpers/FingerFilterBank.h"
+
+class SmoothingFilterTests : public juce::UnitTest {
+public:
+    SmoothingFilterTests() : juce::UnitTest("Adaptive Smoothing Filter Tests") {}
+
+    void runTest() override {
+        beginTest("1. Settles On A Held Position");
+        {
+            OneEuroFilter filter;
+            filter.setParameters(1.0f, 0.01f, 1.0f);
+
+            filter.process(0.0f, 0.01f);
+            float output = 0.0f;
+            for (int i = 0; i < 200; ++i) output = filter.process(100.0f, 0.01f);
+
+            expectWithinAbsoluteError(output, 100.0f, 0.01f, "Filter did not settle on a held position after 2 seconds.");
+        }
+
+        beginTest("2. Same Response At Any Block Size");
+        {
+            // 32 vs 1024 samples at 48kHz over the same 0.25 seconds
+            auto runStep = [](int blockSize) {
+                OneEuroFilter filter;
+                filter.setParameters(2.0f, 0.0f, 1.0f);
+                filter.process(0.0f, 0.0f);
+
+                float blockSeconds = (float)blockSize / 48000.0f;
+                int numBlocks = (int)std::round(0.25f * 48000.0f / (float)blockSize);
+
+                float output = 0.0f;
+                for (int i = 0; i < numBlocks; ++i) output = filter.process(100.0f, blockSeconds);
+                return output;
+                };
+
+            float smallBlocks = runStep(32);
+            float largeBlocks = runStep(1024);
+
+            expectWithinAbsoluteError(smallBlocks, largeBlocks, 1.0f, "Filter response changed with host buffer size.");
+        }
+
+        beginTest("3. Fast Movement Has Less Lag");
+        {
+            // Palm sweeping at 600 mm/s
+            auto trackingError = [](float beta) {
+                OneEuroFilter filter;
+                filter.setParameters(1.0f, beta, 1.0f);
+
+                float position = 0.0f, output = 0.0f;
+                for (int i = 0; i < 50; ++i) {
+                    position += 6.0f;
+                    output = filter.process(position, 0.01f);
+                }
+                return std::abs(position - output);
+                };
+
+            expect(trackingError(0.01f) < trackingError(0.0f) * 0.5f, "Speed coefficient failed to reduce lag on a fast sweep.");
+        }
+
+        beginTest("4. Hand Re-entry Starts From The Raw Frame");
+        {
+            PalmFilterBank bank;
+            HandData hand;
+            hand.isPresent = true;
+            hand.currentHandPositionY = 200.0f;
+            bank.process(hand, 0.01f);
+
+            hand.isPresent = false;
+            bank.process(hand, 0.01f);
+
+            hand.isPresent = true;
+            hand.currentHandPositionY = 400.0f;
+            hand.grabStrength = 1.0f;
+            bank.process(hand, 0.01f);
+
+            expectEquals(hand.currentHandPositionY, 400.0f, "Filter dragged the old position into a new hand entry.");
+            expectEquals(hand.grabStrength, 1.0f, "Grab was not reset with the hand.");
+        }
+
+        beginTest("5. Finger Joints Match The Single Channel Filter");
+        {
+            FingerFilterBank bank;
+            bank.setParameters(1.0f, 0.01f);
+
+            OneEuroFilter reference;
+            reference.setParameters(1.0f, 0.01f, 1.0f);
+
+            HandData hand;
+            hand.isPresent = true;
+
+            float expected = 0.0f;
+            for (int i = 0; i < 100; ++i) {
+                float raw = 50.0f * std::sin(i * 0.2f);
+                for (int f = 0; f < 5; ++f) {
+                    hand.fingers[f].tipY = raw;
+                    hand.fingers[f].knuckleX = raw + (float)f;
+                }
+
+                bank.process(hand, 0.01f);
+                expected = reference.process(raw, 0.01f);
+            }
+
+            for (int f = 0; f < 5; ++f)
+                expectWithinAbsoluteError(hand.fingers[f].tipY, expected, 0.001f, "Joint bank diverged from the scalar One Euro filter.");
+
+            expect(hand.fingers[4].knuckleX > hand.fingers[0].knuckleX, "Joints were mixed up between fingers.");
+        }
+
+        beginTest("6. Finger Joints Reset With The Hand");
+        {
+            FingerFilterBank bank;
+            HandData hand;
+            hand.isPresent = true;
+            hand.fingers[1].tipX = -80.0f;
+            bank.process(hand, 0.01f);
+
+            hand.isPresent = false;
+            bank.process(hand, 0.01f);
+
+            hand.isPresent = true;
+            hand.fingers[1].tipX = 120.0f;
+            bank.process(hand, 0.01f);
+
+            expectEquals(hand.fingers[1].tipX, 120.0f, "Old finger positions leaked into a new hand entry.");
+        }
+
+        beginTest("7. Small Blocks Step Once Per Sensor Frame");
+        {
+            // Palm sweeping at 600 mm/s, sampled by a 120 Hz sensor and read by the audio thread every block
+            const int sensorRate = 120;
+            const int totalSamples = 12288;
+
+            PalmFilterBank reference;
+            reference.setParameters(1.0f, 0.01f);
+            HandData referenceHand;
+            int lastFrame = totalSamples * sensorRate / 48000;
+            for (int frame = 0; frame <= lastFrame; ++frame) {
+                referenceHand = makeFrame(frame, sensorRate);
+                reference.process(referenceHand, 1.0f / (float)sensorRate);
+            }
+
+            auto runBlocks = [&](int blockSize) {
+                PalmFilterBank bank;
+                bank.setParameters(1.0f, 0.01f);
+                FingerFilterBank fingers;
+                SensorFrameClock clock;
+
+                HandData hand;
+                for (int samples = blockSize; samples <= totalSamples; samples += blockSize) {
+                    hand = makeFrame(samples * sensorRate / 48000, sensorRate);
+                    float frameSeconds = clock.advance(hand, (float)blockSize / 48000.0f);
+                    bank.process(hand, frameSeconds);
+                    fingers.process(hand, frameSeconds);
+                }
+                return hand;
+                };
+
+            for (int blockSize : { 32, 64, 256 }) {
+                auto hand = runBlocks(blockSize);
+                expectWithinAbsoluteError(hand.currentHandPositionX, referenceHand.currentHandPositionX, 0.001f,
+                    "Block size " + juce::String(blockSize) + " didn't filter like one step per sensor frame.");
+                expectWithinAbsoluteError(hand.fingers[0].tipX, hand.currentHandPositionX, 0.001f,
+                    "The finger bank should step on the same clock as the palm.");
+            }
+
+            SensorFrameClock clock;
+            auto frame = makeFrame(3, sensorRate);
+            clock.advance(frame, 0.001f);
+            expectEquals(clock.advance(frame, 0.001f), 0.0f, "A repeated frame shouldn't step the filters.");
+            expectWithinAbsoluteError(clock.advance(makeFrame(4, sensorRate), 0.001f), 1.0f / (float)sensorRate, 1.0e-5f,
+                "A new frame should step by the sensor interval, not the block length.");
+        }
+    }
+
+private:
+    static HandData makeFrame(int frame, int sensorRate) {
+        HandData hand;
+        hand.isPresent = true;
+        hand.frameId = frame + 1;
+        hand.frameTimeSeconds = 1.0 + (double)frame / sensorRate;
+        hand.currentHandPositionX = 600.0f * (float)frame / (float)sensorRate;
+        for (auto& finger : hand.fingers) finger.tipX = hand.currentHandPositionX;
+        return hand;
+    }
+};
+
+static SmoothingFilterTests smoothingFilterTestsInstance;
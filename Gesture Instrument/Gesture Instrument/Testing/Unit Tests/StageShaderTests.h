@@ -0,0 +1,363 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include "../../Source/UI/StageShaders.h"
+
+#if JUCE_LINUX
+ // Headless, so no X11 types in the EGL headers
+ #define EGL_NO_X11 1
+ #define MESA_EGL_NO_X11_HEADERS 1
+ #include <EGL/egl.h>
+ #include <EGL/eglext.h>
+#endif
+
+// Compiles the stage shaders on a headless 3.2 core context and draws with them into an offscreen framebuffer.
+// Linux only, Mesa's surfaceless EGL gives a context without a window or a display server
+class StageShaderTests : public juce::UnitTest {
+public:
+    StageShaderTests() : juce::UnitTest("Stage Shader Tests") {}
+
+    void runTest() override {
+#if JUCE_LINUX
+        beginTest("1. The Stage Shaders Compile And Link On A 3.2 Core Context");
+        HeadlessContext headless;
+        expect(headless.isCurrent, "No headless GL 3.2 core context, the stage shader tests need Mesa's EGL");
+        if (!headless.isCurrent) return;
+
+        Functions gl;
+        expect(gl.load(), "A GL 3.2 entry point is missing");
+        if (!gl.isLoaded) return;
+
+        juce::String log;
+        auto program = buildProgram(gl, log);
+        expect(program != 0, "The stage shaders didn't build: " + log);
+        if (program == 0) return;
+
+        for (auto* attribute : { "corner", "shapePoints", "shapeStyle", "shapeColour" })
+            expect(gl.getAttribLocation(program, attribute) >= 0, juce::String("The renderer needs the attribute ") + attribute);
+
+        beginTest("2. An Ellipse Renders Into An Offscreen Framebuffer");
+        {
+            Target target(gl);
+            expect(target.isComplete, "The offscreen framebuffer is incomplete");
+
+            // Filled red ellipse of radius 12 in the middle of the 64 x 64 target
+            draw(gl, program, makeShape(StageShape::ellipse, StageShape::noClip));
+            auto pixels = target.read();
+
+            expect(isRed(pixels, 32, 32), "The middle of the ellipse should be filled");
+            expect(isClear(pixels, 32 + 20, 32), "Outside the radius should be left clear");
+            expect(isClear(pixels, 2, 2), "The corner should be left clear");
+        }
+
+        beginTest("3. A Floor Clipped Shape Stays Inside The Floor");
+        {
+            Target target(gl);
+
+            // The floor covers the left half, the ellipse straddles its edge
+            draw(gl, program, makeShape(StageShape::ellipse, StageShape::floorClip), { 0.0f, 0.0f, 32.0f, 0.0f, 32.0f, 64.0f, 0.0f, 64.0f });
+            auto pixels = target.read();
+
+            expect(isRed(pixels, 26, 32), "Inside the floor should be drawn");
+            expect(isClear(pixels, 38, 32), "Past the floor edge should be clipped away");
+        }
+
+        beginTest("4. Segments Are Drawn Along Their Line");
+        {
+            Target target(gl);
+
+            auto line = makeShape(StageShape::segment, StageShape::noClip);
+            line.x0 = 8.0f; line.y0 = 16.0f; line.x1 = 56.0f; line.y1 = 16.0f;
+            line.width = 4.0f;
+
+            draw(gl, program, line);
+            auto pixels = target.read();
+
+            expect(isRed(pixels, 32, 16), "The middle of the segment should be drawn");
+            expect(isClear(pixels, 32, 24), "Away from the line should be left clear");
+            expect(isClear(pixels, 60, 16), "Past the end of the line should be left clear");
+        }
+
+        gl.deleteProgram(program);
+#else
+        beginTest("1. The Stage Shaders Compile And Link On A 3.2 Core Context");
+        logMessage("   Skipped, the headless GL context needs EGL on Linux");
+#endif
+    }
+
+#if JUCE_LINUX
+private:
+    static constexpr int targetSize = 64;
+
+    struct HeadlessContext {
+        HeadlessContext() {
+            auto getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+            if (getPlatformDisplay != nullptr) display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+            if (display == EGL_NO_DISPLAY) display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+
+            if (display == EGL_NO_DISPLAY || !eglInitialize(display, nullptr, nullptr)) {
+                display = EGL_NO_DISPLAY;
+                return;
+            }
+
+            const EGLint configAttributes[] = { EGL_SURFACE_TYPE, EGL_PBUFFER_BIT, EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_NONE };
+            EGLConfig config = nullptr;
+            EGLint numConfigs = 0;
+            if (!eglBindAPI(EGL_OPENGL_API) || !eglChooseConfig(display, configAttributes, &config, 1, &numConfigs) || numConfigs < 1) return;
+
+            // Same version the editor asks JUCE for
+            const EGLint contextAttributes[] = {
+                EGL_CONTEXT_MAJOR_VERSION, 3, EGL_CONTEXT_MINOR_VERSION, 2,
+                EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT, EGL_NONE
+            };
+
+            context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttributes);
+            if (context != EGL_NO_CONTEXT) isCurrent = eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context) == EGL_TRUE;
+        }
+
+        ~HeadlessContext() {
+            if (display == EGL_NO_DISPLAY) return;
+
+            eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+            if (context != EGL_NO_CONTEXT) eglDestroyContext(display, context);
+            eglTerminate(display);
+        }
+
+        EGLDisplay display = EGL_NO_DISPLAY;
+        EGLContext context = EGL_NO_CONTEXT;
+        bool isCurrent = false;
+    };
+
+    // Only the calls made here, fetched from EGL since nothing in the test runner has loaded GL
+    struct Functions {
+        using GLenum = unsigned int;
+        using GLuint = unsigned int;
+        using GLint = int;
+        using GLsizei = int;
+
+        GLuint (*createShader)(GLenum) = nullptr;
+        void (*shaderSource)(GLuint, GLsizei, const char* const*, const GLint*) = nullptr;
+        void (*compileShader)(GLuint) = nullptr;
+        void (*getShaderiv)(GLuint, GLenum, GLint*) = nullptr;
+        void (*getShaderInfoLog)(GLuint, GLsizei, GLsizei*, char*) = nullptr;
+        void (*deleteShader)(GLuint) = nullptr;
+        GLuint (*createProgram)() = nullptr;
+        void (*attachShader)(GLuint, GLuint) = nullptr;
+        void (*linkProgram)(GLuint) = nullptr;
+        void (*getProgramiv)(GLuint, GLenum, GLint*) = nullptr;
+        void (*getProgramInfoLog)(GLuint, GLsizei, GLsizei*, char*) = nullptr;
+        void (*deleteProgram)(GLuint) = nullptr;
+        void (*useProgram)(GLuint) = nullptr;
+        GLint (*getAttribLocation)(GLuint, const char*) = nullptr;
+        GLint (*getUniformLocation)(GLuint, const char*) = nullptr;
+        void (*uniform1f)(GLint, float) = nullptr;
+        void (*uniform2f)(GLint, float, float) = nullptr;
+        void (*uniform2fv)(GLint, GLsizei, const float*) = nullptr;
+        void (*genFramebuffers)(GLsizei, GLuint*) = nullptr;
+        void (*bindFramebuffer)(GLenum, GLuint) = nullptr;
+        void (*deleteFramebuffers)(GLsizei, const GLuint*) = nullptr;
+        GLenum (*checkFramebufferStatus)(GLenum) = nullptr;
+        void (*genRenderbuffers)(GLsizei, GLuint*) = nullptr;
+        void (*bindRenderbuffer)(GLenum, GLuint) = nullptr;
+        void (*renderbufferStorage)(GLenum, GLenum, GLsizei, GLsizei) = nullptr;
+        void (*framebufferRenderbuffer)(GLenum, GLenum, GLenum, GLuint) = nullptr;
+        void (*deleteRenderbuffers)(GLsizei, const GLuint*) = nullptr;
+        void (*genBuffers)(GLsizei, GLuint*) = nullptr;
+        void (*bindBuffer)(GLenum, GLuint) = nullptr;
+        void (*bufferData)(GLenum, std::ptrdiff_t, const void*, GLenum) = nullptr;
+        void (*deleteBuffers)(GLsizei, const GLuint*) = nullptr;
+        void (*genVertexArrays)(GLsizei, GLuint*) = nullptr;
+        void (*bindVertexArray)(GLuint) = nullptr;
+        void (*deleteVertexArrays)(GLsizei, const GLuint*) = nullptr;
+        void (*enableVertexAttribArray)(GLuint) = nullptr;
+        void (*vertexAttribPointer)(GLuint, GLint, GLenum, unsigned char, GLsizei, const void*) = nullptr;
+        void (*vertexAttribDivisor)(GLuint, GLuint) = nullptr;
+        void (*drawArraysInstanced)(GLenum, GLint, GLsizei, GLsizei) = nullptr;
+        void (*viewport)(GLint, GLint, GLsizei, GLsizei) = nullptr;
+        void (*clearColor)(float, float, float, float) = nullptr;
+        void (*clear)(GLenum) = nullptr;
+        void (*enable)(GLenum) = nullptr;
+        void (*blendFuncSeparate)(GLenum, GLenum, GLenum, GLenum) = nullptr;
+        void (*readPixels)(GLint, GLint, GLsizei, GLsizei, GLenum, GLenum, void*) = nullptr;
+
+        bool isLoaded = false;
+
+        bool load() {
+            isLoaded = get(createShader, "glCreateShader") && get(shaderSource, "glShaderSource") && get(compileShader, "glCompileShader")
+                && get(getShaderiv, "glGetShaderiv") && get(getShaderInfoLog, "glGetShaderInfoLog") && get(deleteShader, "glDeleteShader")
+                && get(createProgram, "glCreateProgram") && get(attachShader, "glAttachShader") && get(linkProgram, "glLinkProgram")
+                && get(getProgramiv, "glGetProgramiv") && get(getProgramInfoLog, "glGetProgramInfoLog") && get(deleteProgram, "glDeleteProgram")
+                && get(useProgram, "glUseProgram") && get(getAttribLocation, "glGetAttribLocation") && get(getUniformLocation, "glGetUniformLocation")
+                && get(uniform1f, "glUniform1f") && get(uniform2f, "glUniform2f") && get(uniform2fv, "glUniform2fv")
+                && get(genFramebuffers, "glGenFramebuffers") && get(bindFramebuffer, "glBindFramebuffer") && get(deleteFramebuffers, "glDeleteFramebuffers")
+                && get(checkFramebufferStatus, "glCheckFramebufferStatus") && get(genRenderbuffers, "glGenRenderbuffers")
+                && get(bindRenderbuffer, "glBindRenderbuffer") && get(renderbufferStorage, "glRenderbufferStorage")
+                && get(framebufferRenderbuffer, "glFramebufferRenderbuffer") && get(deleteRenderbuffers, "glDeleteRenderbuffers")
+                && get(genBuffers, "glGenBuffers") && get(bindBuffer, "glBindBuffer") && get(bufferData, "glBufferData") && get(deleteBuffers, "glDeleteBuffers")
+                && get(genVertexArrays, "glGenVertexArrays") && get(bindVertexArray, "glBindVertexArray") && get(deleteVertexArrays, "glDeleteVertexArrays")
+                && get(enableVertexAttribArray, "glEnableVertexAttribArray") && get(vertexAttribPointer, "glVertexAttribPointer")
+                && get(vertexAttribDivisor, "glVertexAttribDivisor") && get(drawArraysInstanced, "glDrawArraysInstanced")
+                && get(viewport, "glViewport") && get(clearColor, "glClearColor") && get(clear, "glClear") && get(enable, "glEnable")
+                && get(blendFuncSeparate, "glBlendFuncSeparate") && get(readPixels, "glReadPixels");
+            return isLoaded;
+        }
+
+        template <typename Function>
+        static bool get(Function& function, const char* name) {
+            function = reinterpret_cast<Function>(eglGetProcAddress(name));
+            return function != nullptr;
+        }
+    };
+
+    // GL enums the test needs, the same values as every gl.h
+    enum : unsigned int {
+        glFragmentShader = 0x8B30, glVertexShader = 0x8B31, glCompileStatus = 0x8B81, glLinkStatus = 0x8B82,
+        glFramebuffer = 0x8D40, glRenderbuffer = 0x8D41, glColourAttachment0 = 0x8CE0, glFramebufferComplete = 0x8CD5, glRgba8 = 0x8058,
+        glArrayBuffer = 0x8892, glStaticDraw = 0x88E4, glFloat = 0x1406, glTriangleStrip = 0x0005,
+        glColourBufferBit = 0x4000, glBlend = 0x0BE2, glSrcAlpha = 0x0302, glOneMinusSrcAlpha = 0x0303, glOne = 1,
+        glRgba = 0x1908, glUnsignedByte = 0x1401
+    };
+
+    // An RGBA8 renderbuffer the size of the target, bound for drawing while it exists
+    struct Target {
+        explicit Target(Functions& f) : gl(f) {
+            gl.genFramebuffers(1, &framebuffer);
+            gl.bindFramebuffer(glFramebuffer, framebuffer);
+            gl.genRenderbuffers(1, &colour);
+            gl.bindRenderbuffer(glRenderbuffer, colour);
+            gl.renderbufferStorage(glRenderbuffer, glRgba8, targetSize, targetSize);
+            gl.framebufferRenderbuffer(glFramebuffer, glColourAttachment0, glRenderbuffer, colour);
+            isComplete = gl.checkFramebufferStatus(glFramebuffer) == glFramebufferComplete;
+
+            gl.viewport(0, 0, targetSize, targetSize);
+            gl.clearColor(0.0f, 0.0f, 0.0f, 1.0f);
+            gl.clear(glColourBufferBit);
+        }
+
+        ~Target() {
+            gl.bindFramebuffer(glFramebuffer, 0);
+            gl.deleteRenderbuffers(1, &colour);
+            gl.deleteFramebuffers(1, &framebuffer);
+        }
+
+        std::vector<juce::uint8> read() {
+            std::vector<juce::uint8> pixels((size_t)(targetSize * targetSize * 4));
+            gl.readPixels(0, 0, targetSize, targetSize, glRgba, glUnsignedByte, pixels.data());
+            return pixels;
+        }
+
+        Functions& gl;
+        unsigned int framebuffer = 0, colour = 0;
+        bool isComplete = false;
+    };
+
+    static unsigned int compile(Functions& gl, unsigned int type, const char* source, juce::String& log) {
+        auto shader = gl.createShader(type);
+        gl.shaderSource(shader, 1, &source, nullptr);
+        gl.compileShader(shader);
+
+        int isCompiled = 0;
+        gl.getShaderiv(shader, glCompileStatus, &isCompiled);
+        if (isCompiled != 0) return shader;
+
+        char message[1024] = {};
+        gl.getShaderInfoLog(shader, (int)sizeof(message), nullptr, message);
+        log << message;
+        gl.deleteShader(shader);
+        return 0;
+    }
+
+    static unsigned int buildProgram(Functions& gl, juce::String& log) {
+        auto vertex = compile(gl, glVertexShader, StageShaders::vertexShaderSource, log);
+        auto fragment = compile(gl, glFragmentShader, StageShaders::fragmentShaderSource, log);
+        if (vertex == 0 || fragment == 0) return 0;
+
+        auto program = gl.createProgram();
+        gl.attachShader(program, vertex);
+        gl.attachShader(program, fragment);
+        gl.linkProgram(program);
+        gl.deleteShader(vertex);
+        gl.deleteShader(fragment);
+
+        int isLinked = 0;
+        gl.getProgramiv(program, glLinkStatus, &isLinked);
+        if (isLinked != 0) return program;
+
+        char message[1024] = {};
+        gl.getProgramInfoLog(program, (int)sizeof(message), nullptr, message);
+        log << message;
+        gl.deleteProgram(program);
+        return 0;
+    }
+
+    static StageShape makeShape(StageShape::Kind kind, StageShape::Clip clip) {
+        StageShape shape{};
+        shape.x0 = 32.0f; shape.y0 = 32.0f;
+        shape.x1 = 12.0f; shape.y1 = 12.0f;
+        shape.kind = (float)kind;
+        shape.clip = (float)clip;
+        shape.red = 1.0f; shape.alpha = 1.0f;
+        return shape;
+    }
+
+    // One instanced draw set up the way StageGLRenderer does it, a unit quad per instance
+    static void draw(Functions& gl, unsigned int program, const StageShape& shape, std::array<float, 8> floorQuad = {}) {
+        const float corners[] = { -1.0f, -1.0f, 1.0f, -1.0f, -1.0f, 1.0f, 1.0f, 1.0f };
+
+        unsigned int buffers[2] = {}, array = 0;
+        gl.genBuffers(2, buffers);
+        gl.genVertexArrays(1, &array);
+        gl.bindVertexArray(array);
+
+        gl.bindBuffer(glArrayBuffer, buffers[0]);
+        gl.bufferData(glArrayBuffer, sizeof(corners), corners, glStaticDraw);
+        auto corner = (unsigned int)gl.getAttribLocation(program, "corner");
+        gl.enableVertexAttribArray(corner);
+        gl.vertexAttribPointer(corner, 2, glFloat, 0, 0, nullptr);
+
+        gl.bindBuffer(glArrayBuffer, buffers[1]);
+        gl.bufferData(glArrayBuffer, sizeof(StageShape), &shape, glStaticDraw);
+        const char* perInstance[] = { "shapePoints", "shapeStyle", "shapeColour" };
+
+        for (int i = 0; i < 3; ++i) {
+            auto attribute = (unsigned int)gl.getAttribLocation(program, perInstance[i]);
+            gl.enableVertexAttribArray(attribute);
+            gl.vertexAttribPointer(attribute, 4, glFloat, 0, sizeof(StageShape), (const void*)(sizeof(float) * 4 * (size_t)i));
+            gl.vertexAttribDivisor(attribute, 1);
+        }
+
+        gl.enable(glBlend);
+        gl.blendFuncSeparate(glSrcAlpha, glOneMinusSrcAlpha, glOne, glOneMinusSrcAlpha);
+
+        gl.useProgram(program);
+        gl.uniform2f(gl.getUniformLocation(program, "viewportSize"), (float)targetSize, (float)targetSize);
+        gl.uniform1f(gl.getUniformLocation(program, "pixelSize"), 1.0f);
+        gl.uniform2fv(gl.getUniformLocation(program, "floorQuad"), 4, floorQuad.data());
+        gl.uniform2fv(gl.getUniformLocation(program, "wallQuad"), 4, floorQuad.data());
+
+        gl.drawArraysInstanced(glTriangleStrip, 0, 4, 1);
+
+        gl.useProgram(0);
+        gl.bindVertexArray(0);
+        gl.deleteVertexArrays(1, &array);
+        gl.deleteBuffers(2, buffers);
+    }
+
+    // Pixels come back bottom row first, the shaders put y = 0 at the top like the editor
+    static const juce::uint8* pixelAt(const std::vector<juce::uint8>& pixels, int x, int y) {
+        return pixels.data() + ((size_t)(targetSize - 1 - y) * targetSize + (size_t)x) * 4;
+    }
+
+    static bool isRed(const std::vector<juce::uint8>& pixels, int x, int y) {
+        auto* p = pixelAt(pixels, x, y);
+        return p[0] > 200 && p[1] < 50 && p[2] < 50;
+    }
+
+    static bool isClear(const std::vector<juce::uint8>& pixels, int x, int y) {
+        auto* p = pixelAt(pixels, x, y);
+        return p[0] < 50 && p[1] < 50 && p[2] < 50;
+    }
+#endif
+};
+
+static StageShaderTests stageShaderTestsInstance;
@@ -0,0 +1,152 @@
+#include <JuceHeader.h>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+#if JUCE_WINDOWS
+ #include <malloc.h>
+#endif
+
+#include "AutoRangerTests.h"
+#include "CalibrationTrackerTests.h"
+#include "GoldenOutputTests.h"
+#include "KalmanEstimatorTests.h"
+#include "LatencyTracerTests.h"
+#include "LeapCStubTests.h"
+#include "LeapServiceTests.h"
+#include "LeapThreadTests.h"
+#include "MidiManagerTests.h"
+#include "OnsetDetectorTests.h"
+#include "OscManagerTests.h"
+#include "PluginProcessorTests.h"
+#include "PluginStateTests.h"
+#include "PresetLibraryTests.h"
+#include "PresetMorphTests.h"
+#include "ProfilerProbesTests.h"
+#include "RealtimeSafetyTests.h"
+#include "RenderSnapshotTests.h"
+#include "RuntimeStatsTests.h"
+#include "ScaleQuantiserTests.h"
+#include "SmoothingFilterTests.h"
+#include "StageShaderTests.h"
+
+// Global allocator replacements so the real-time verifier sees heap allocations made inside processBlock.
+// Every form is replaced, plain, array, nothrow and over-aligned, so no allocation reaches the default one unseen
+namespace {
+    void* allocate(std::size_t size) noexcept {
+        RealtimeVerifier::onAllocation();
+        return std::malloc(size > 0 ? size : 1);
+    }
+
+    void* allocateAligned(std::size_t size, std::align_val_t alignment) noexcept {
+        RealtimeVerifier::onAllocation();
+        auto bytes = size > 0 ? size : 1;
+        auto align = juce::jmax(static_cast<std::size_t>(alignment), sizeof(void*));
+
+       #if JUCE_WINDOWS
+        return _aligned_malloc(bytes, align);
+       #else
+        void* p = nullptr;
+        return posix_memalign(&p, align, bytes) == 0 ? p : nullptr;
+       #endif
+    }
+
+    void freeAligned(void* p) noexcept {
+       #if JUCE_WINDOWS
+        _aligned_free(p);
+       #else
+        std::free(p);
+       #endif
+    }
+}
+
+void* operator new(std::size_t size) {
+    if (void* p = allocate(size)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    if (void* p = allocate(size)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    if (void* p = allocateAligned(size, alignment)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    if (void* p = allocateAligned(size, alignment)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return allocateAligned(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return allocateAligned(size, alignment); }
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+
+void operator delete(void* p, std::align_val_t) noexcept { freeAligned(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { freeAligned(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { freeAligned(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { freeAligned(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { freeAligned(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { freeAligned(p); }
+
+// Prints every result and counts the failures, without stopping at the first one
+class ConsoleTestRunner : public juce::UnitTestRunner {
+    void logMessage(const juce::String& message) override {
+        std::cout << message << std::endl;
+    }
+};
+
+// Usage: GestureTests [--list] [--test "name"] [--golden folder] [--update-golden]
+// Runs every suite in Testing/Unit Tests, or only those whose name contains the --test text.
+// --golden points the golden output tests at their files if they can't find them, --update-golden rewrites them.
+// Exit code is 1 if anything failed
+int main(int argc, char* argv[]) {
+    juce::ArgumentList args(argc, argv);
+
+    if (args.containsOption("--golden")) GoldenOutput::directory = args.getExistingFolderForOption("--golden");
+    GoldenOutput::shouldUpdate = args.containsOption("--update-golden");
+
+    // The processor and managers expect a message manager, same as in a host
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    auto& allTests = juce::UnitTest::getAllTests();
+
+    if (args.containsOption("--list")) {
+        for (auto* test : allTests) std::cout << test->getName() << std::endl;
+        return 0;
+    }
+
+    juce::Array<juce::UnitTest*> selected;
+    juce::String filter = args.containsOption("--test") ? args.getValueForOption("--test") : juce::String();
+
+    for (auto* test : allTests)
+        if (filter.isEmpty() || test->getName().containsIgnoreCase(filter)) selected.add(test);
+
+    if (selected.isEmpty()) {
+        std::cerr << "No test suite matches \"" << filter << "\"" << std::endl;
+        return 1;
+    }
+
+    ConsoleTestRunner runner;
+    runner.setAssertOnFailure(false);
+    runner.runTests(selected);
+
+    int passes = 0, failures = 0;
+    for (int i = 0; i < runner.getNumResults(); ++i) {
+        passes += runner.getResult(i)->passes;
+        failures += runner.getResult(i)->failures;
+    }
+
+    std::cout << std::endl << selected.size() << " suites, " << passes << " passed, " << failures << " failed" << std::endl;
+    return failures > 0 ? 1 : 0;
+}